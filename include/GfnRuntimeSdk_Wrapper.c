@@ -27,6 +27,9 @@
 
 
 #include "GfnRuntimeSdk_Wrapper.h"
+#include "GfnSdk_Platform.h"
+#include "GfnSdk_PersistentLog.h"
+#include "GfnSdk_SaveSnapshot.h"
 #ifdef _WIN32
 #include "GfnSdk_SecureLoadLibrary.h"
 #endif
@@ -58,35 +61,157 @@
 #   include <dlfcn.h>       // dlopen
 #   include <libgen.h>      // dirname
 #   include <unistd.h>      // readlink
+#   include <errno.h>       // errno
+#   include <fcntl.h>       // open
+#   include <sys/mman.h>    // mmap
+#   include <sys/eventfd.h> // eventfd
+#   include <dirent.h>      // opendir
 #   define GFN_SHARED_OBJECT "GfnSdk.so"
 #   define GFN_CLIENT_SHARED_LIBRARY "GfnRuntimeSdk.so"
 #   define GFN_SHARED_OBJECT_PATH "/opt/nvidia/GfnSdk/" GFN_SHARED_OBJECT
 #   define PLATFORM_MAX_PATH PATH_MAX
 
     void* g_gfnSdkModule = NULL;
-    CHAR_TYPE g_cloudLibraryPath[] = GFN_SHARED_OBJECT_PATH;
+    CHAR_TYPE g_cloudLibraryPath[PLATFORM_MAX_PATH] = GFN_SHARED_OBJECT_PATH;
 #else
 #   error "Unsupported platform"
 #endif
 
 #   define GFN_SDK_INIT_LOGGING() gfnInitLogging();
 #   define GFN_SDK_DEINIT_LOGGING() gfnDeinitLogging();
-#   define GFN_SDK_LOG(fmt, ...) gfnLog(__FUNCTION__, __LINE__, fmt, ##__VA_ARGS__)
+// Log lines below GFN_SDK_LOG_MIN_LEVEL (a GfnLogLevel value) are compiled out entirely. Lines at or
+// above it are filtered at runtime against the level set with GfnSetLogLevel or GFN_SDK_LOG_LEVEL, and
+// each call site is rate limited so that a line logged from a hot path cannot flood the log.
+#ifndef GFN_SDK_LOG_MIN_LEVEL
+#   define GFN_SDK_LOG_MIN_LEVEL 0
+#endif
+#   define GFN_SDK_LOG_AT(level, fmt, ...)                                                      \
+    do                                                                                      \
+    {                                                                                       \
+        if ((int32_t)(level) >= gfnAtomicLoadRelaxed32(&s_logLevel))                        \
+        {                                                                                   \
+            static gfnLogSite s_logSite = { { kGfnLogRateBurst, 0, 0 }, 0, 0 };             \
+            unsigned int suppressedLines = 0;                                               \
+            if (gfnLogRateLimitAcquire(&s_logSite.rateLimit, &suppressedLines))             \
+            {                                                                               \
+                gfnLog(&s_logSite, (int)(level), __FUNCTION__, __LINE__, suppressedLines,   \
+                    fmt, ##__VA_ARGS__);                                                    \
+            }                                                                               \
+        }                                                                                   \
+    } while (0)
+#if GFN_SDK_LOG_MIN_LEVEL <= 0
+#   define GFN_SDK_LOG_TRACE(fmt, ...) GFN_SDK_LOG_AT(gfnLogLevelTrace, fmt, ##__VA_ARGS__)
+#else
+#   define GFN_SDK_LOG_TRACE(fmt, ...) ((void)0)
+#endif
+#if GFN_SDK_LOG_MIN_LEVEL <= 1
+#   define GFN_SDK_LOG_DEBUG(fmt, ...) GFN_SDK_LOG_AT(gfnLogLevelDebug, fmt, ##__VA_ARGS__)
+#else
+#   define GFN_SDK_LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+#if GFN_SDK_LOG_MIN_LEVEL <= 2
+#   define GFN_SDK_LOG(fmt, ...) GFN_SDK_LOG_AT(gfnLogLevelInfo, fmt, ##__VA_ARGS__)
+#else
+#   define GFN_SDK_LOG(fmt, ...) ((void)0)
+#endif
+#if GFN_SDK_LOG_MIN_LEVEL <= 3
+#   define GFN_SDK_LOG_WARNING(fmt, ...) GFN_SDK_LOG_AT(gfnLogLevelWarning, fmt, ##__VA_ARGS__)
+#else
+#   define GFN_SDK_LOG_WARNING(fmt, ...) ((void)0)
+#endif
+#if GFN_SDK_LOG_MIN_LEVEL <= 4
+#   define GFN_SDK_LOG_ERROR(fmt, ...) GFN_SDK_LOG_AT(gfnLogLevelError, fmt, ##__VA_ARGS__)
+#else
+#   define GFN_SDK_LOG_ERROR(fmt, ...) ((void)0)
+#endif
+#   define kGfnLogRateBurst 20          // Lines a call site may log back to back
+#   define kGfnLogRateRefillMs 100      // A call site regains one line per interval, up to the burst
 #   define kGfnLogBufLen 1024
-    typedef struct gfnLogData
+#   define kGfnLogTimestampLen 24
+#   define kGfnLogRecordLen 512     // Text capacity of a queued record, longer lines are truncated in async mode
+#   define kGfnLogRingSize 512      // Number of queued records, must be a power of two
+#   define kGfnLogWakeThreshold (kGfnLogRingSize / 4)
+#   define kGfnLogWriterIntervalMs 20
+#   define kGfnPersistentLogDefaultSizeKb 4096  // Record ring of the persistent log, 32768 records
+#   define kGfnPersistentLogMinSizeKb 64
+#   define kGfnPersistentLogMaxSizeKb (1024 * 1024)
+    // Fixed-size log record passed from producer threads to the log writer thread
+    typedef struct gfnLogRecord
     {
-        char buffer[kGfnLogBufLen];
-#if _WIN32
-        SYSTEMTIME timeBuffer;
-#elif __linux__
-        struct tm timeBuffer;
-#endif
-    } gfnLogData;
-    static gfnLogData s_logData;
+        gfnAtomic32 sequence;
+        unsigned int length;
+        uint64_t timestampMs;
+        char text[kGfnLogRecordLen];
+    } gfnLogRecord;
+    // Bounded multi-producer, single-consumer queue of log records. Each record carries a sequence
+    // number that tells producers and the consumer whose turn it is to use the slot.
+    typedef struct gfnLogRing
+    {
+        gfnAtomic32 enqueuePos;
+        char padding0[GFN_CACHE_LINE_SIZE - sizeof(gfnAtomic32)];
+        gfnAtomic32 dequeuePos;
+        char padding1[GFN_CACHE_LINE_SIZE - sizeof(gfnAtomic32)];
+        gfnLogRecord records[kGfnLogRingSize];
+    } gfnLogRing;
     static FILE* s_logfile = NULL;
-    static void gfnLog(char const* func, int line, char const* format, ...);
+    static gfnMutex s_logLock = GFN_MUTEX_INITIALIZER;          // Serializes writes to the log file
+    static gfnMutex s_logLifecycleLock = GFN_MUTEX_INITIALIZER; // Serializes logging init, deinit and mode changes
+    static gfnMutex s_logWakeLock = GFN_MUTEX_INITIALIZER;
+    static gfnCondVar s_logWake = GFN_CONDVAR_INITIALIZER;
+    static gfnLogRing s_logRing;
+    static bool s_logRingInitialized = false;
+    static gfnThread s_logWriter;
+    // Per call site token bucket
+    typedef struct gfnLogRateLimit
+    {
+        gfnAtomic32 tokens;
+        gfnAtomic32 refillMs;
+        gfnAtomic32 suppressed;
+    } gfnLogRateLimit;
+    // Per call site state: the rate limit, and the call site's entry in the persistent log's site table
+    typedef struct gfnLogSite
+    {
+        gfnLogRateLimit rateLimit;
+        gfnAtomic32 persistentGeneration;   // Value of s_persistentLogGeneration persistentSite belongs to
+        int32_t persistentSite;
+    } gfnLogSite;
+    static gfnAtomic32 s_logLevel = gfnLogLevelInfo;
+    static bool s_logLevelSetByApi = false;
+    static bool s_logModeSetByApi = false;
+    static gfnAtomic32 s_logMode = gfnLogModeSynchronous;
+    static gfnAtomic32 s_logOverflowPolicy = gfnLogOverflowDrop;
+    static gfnAtomic32 s_logWriterRunning = 0;
+    static gfnAtomic32 s_logWriterStop = 0;
+    static gfnAtomic32 s_logWriterSleeping = 0;
+    static gfnAtomic32 s_logProducers = 0;
+    static gfnAtomic64 s_logLinesWritten = 0;
+    static gfnAtomic64 s_logLinesDropped = 0;
+    static uint64_t s_logTimestampSecond = 0;                   // Cached timestamp prefix, guarded by s_logLock
+    static char s_logTimestamp[kGfnLogTimestampLen];
+    static GFN_THREAD_LOCAL char t_logScratch[kGfnLogBufLen];   // Per-thread formatting buffer
+    static GFN_THREAD_LOCAL uint32_t t_logThreadId = 0;         // Cached, getting the thread id is a system call on Linux
+    static gfnAtomicPtr s_persistentLog = NULL;                 // Mapped gfnPersistentLogHeader while persistent logging is active
+    static gfnAtomic32 s_persistentLogWriters = 0;
+    static gfnAtomic32 s_persistentLogGeneration = 0;           // Incremented each time a persistent log is mapped
+    static gfnMutex s_persistentLogSiteLock = GFN_MUTEX_INITIALIZER;
+    static CHAR_TYPE s_persistentLogPath[PLATFORM_MAX_PATH];    // Set by GfnSetPersistentLogConfig, empty for the default path
+    static unsigned int s_persistentLogSizeKb = kGfnPersistentLogDefaultSizeKb;
+    static size_t s_persistentLogMappedSize = 0;
+#ifdef _WIN32
+    static HANDLE s_persistentLogFile = INVALID_HANDLE_VALUE;
+    static HANDLE s_persistentLogMapping = NULL;
+#endif
+    // Unused when GFN_SDK_LOG_MIN_LEVEL compiles out every log line
+    static GFN_MAYBE_UNUSED void gfnLog(gfnLogSite* site, int level, char const* func, int line, unsigned int suppressed, char const* format, ...);
+    static GFN_MAYBE_UNUSED bool gfnLogRateLimitAcquire(gfnLogRateLimit* limit, unsigned int* suppressed);
     static void gfnInitLogging(void);
     static void gfnDeinitLogging(void);
+    static void gfnOpenLogFile(void);
+    static void gfnOpenPersistentLog(void);
+    static void gfnClosePersistentLog(void);
+    static void gfnWakeLogWriter(void);
+    static unsigned int gfnDrainLogRing(void);
+    static GFN_THREAD_PROC gfnLogWriterThread(void* arg);
 bool g_LoggingInitialized = false;
 
 // Function declarations
@@ -144,45 +269,574 @@ typedef GfnRuntimeError(*gfnOpenURLOnClientFn)(const char* pchUrl);
 GfnRuntimeError gfnInitializeCloudSdk(void);
 GfnRuntimeError gfnShutDownCloudSdk(void);
 
+// Called from GfnShutdownSdk, defined with the session snapshot cache and the title index
+static void gfnResetSessionSnapshot(void);
+static void gfnResetTitleIndex(void);
+// Called from GfnShutdownSdk, defined with the action zones
+static void gfnResetActionZones(void);
+// Called from GfnShutdownSdk, defined with the network quality tracker
+static void gfnResetNetworkStats(void);
+// Called from GfnShutdownSdk, defined with the quality advisor
+static void gfnResetQualityAdvisor(void);
+// Called from GfnShutdownSdk, defined with the save scheduler
+static void gfnResetSaveScheduler(void);
+// Called from GfnShutdownSdk, defined with the save snapshots
+static void gfnResetSaveSnapshots(void);
+// Called from GfnShutdownSdk, defined with the pause controller
+static void gfnResetPauseController(void);
+// Called from GfnShutdownSdk, defined with the exit orchestrator
+static void gfnResetExitOrchestrator(void);
+// Called from GfnShutdownSdk, defined with the prefetcher
+static void gfnResetPrefetcher(void);
+// Called from GfnInitializeSdk, defined with the asynchronous initialization
+static void gfnWaitForPendingInitialization(void);
+
+// Every export the wrapper resolves from the GFN SDK libraries. Each entry names the dispatch table
+// member, its function pointer type and the exported symbol. The list is expanded once per table, so
+// the client and cloud tables are declared and bound from the same source and every API call is a
+// single indirect call through a table resolved at initialization time.
+#define GFN_SDK_LIBRARY_APIS(CLOUD_API, CLIENT_API)                                                                     \
+    CLIENT_API(InitializeRuntimeSdk, gfnInitializeRuntimeSdkFn, "gfnInitializeRuntimeSdk")                               \
+    CLIENT_API(ShutdownRuntimeSdk, gfnShutdownRuntimeSdkFn, "gfnShutdownRuntimeSdk")                                     \
+    CLIENT_API(RegisterStreamStatusCallback, gfnRegisterStreamStatusCallbackFn, "gfnRegisterStreamStatusCallback")       \
+    CLIENT_API(StartStream, gfnStartStreamFn, "gfnStartStream")                                                          \
+    CLIENT_API(StartStreamAsync, gfnStartStreamAsyncFn, "gfnStartStreamAsync")                                           \
+    CLIENT_API(StopStream, gfnStopStreamFn, "gfnStopStream")                                                             \
+    CLIENT_API(StopStreamAsync, gfnStopStreamAsyncFn, "gfnStopStreamAsync")                                              \
+    CLIENT_API(SendMessage, gfnSendMessageFn, "gfnSendMessage")                                                          \
+    CLIENT_API(RegisterMessageCallback, gfnRegisterMessageCallbackFn, "gfnRegisterMessageCallback")                      \
+    /* Old Initialization method. Deprecate when all libraries have updated to 1.7.1 or greater. */                      \
+    CLOUD_API(InitializeRuntimeSdk, gfnCloudInitializeRuntimeSdkFn, "gfnInitializeRuntimeSdk2")                          \
+    CLOUD_API(InitializeRuntimeSdkV3, gfnCloudInitializeRuntimeSdkV3Fn, "gfnInitializeRuntimeSdk3")                      \
+    CLOUD_API(ShutdownRuntimeSdk, gfnCloudShutdownRuntimeSdkFn, "gfnShutdownRuntimeSdk2")                                \
+    CLOUD_API(IsInitialized, gfnIsInitializedFn, "gfnIsInitialized")                                                     \
+    CLOUD_API(IsRunningInCloud, gfnIsRunningInCloudFn, "gfnIsRunningInCloud")                                            \
+    CLOUD_API(IsRunningInCloudSecure, gfnIsRunningInCloudSecureFn, "gfnIsRunningInCloudSecure")                          \
+    CLOUD_API(CloudCheck, gfnCloudCheckFn, "gfnCloudCheck")                                                              \
+    CLOUD_API(RegisterExitCallback, gfnRegisterCallbackFn, "gfnRegisterExitCallback")                                    \
+    CLOUD_API(RegisterSaveCallback, gfnRegisterCallbackFn, "gfnRegisterSaveCallback")                                    \
+    CLOUD_API(RegisterSessionInitCallback, gfnRegisterCallbackFn, "gfnRegisterSessionInitCallback")                      \
+    CLOUD_API(RegisterPauseCallback, gfnRegisterCallbackFn, "gfnRegisterPauseCallback")                                  \
+    CLOUD_API(RegisterInstallCallback, gfnRegisterCallbackFn, "gfnRegisterInstallCallback")                              \
+    CLOUD_API(IsTitleAvailable, gfnIsTitleAvailableFn, "gfnIsTitleAvailable")                                            \
+    CLOUD_API(GetTitlesAvailable, gfnGetTitlesAvailableFn, "gfnGetTitlesAvailable")                                      \
+    CLOUD_API(SetupTitle, gfnSetupTitleFn, "gfnSetupTitle")                                                              \
+    CLOUD_API(TitleExited, gfnTitleExitedFn, "gfnTitleExited")                                                           \
+    CLOUD_API(GetClientIp, gfnGetClientIpFn, "gfnGetClientIp")                                                           \
+    CLOUD_API(GetClientLanguageCode, gfnGetClientLanguageCodeFn, "gfnGetClientLanguageCode")                             \
+    CLOUD_API(GetClientCountryCode, gfnGetClientCountryCodeFn, "gfnGetClientCountryCode")                                \
+    CLOUD_API(GetPartnerData, gfnGetPartnerDataFn, "gfnGetPartnerData")                                                  \
+    CLOUD_API(GetPartnerSecureData, gfnGetPartnerSecureDataFn, "gfnGetPartnerSecureData")                                \
+    CLOUD_API(Free, gfnFreeFn, "gfnFree")                                                                                \
+    CLOUD_API(AppReady, gfnAppReadyFn, "gfnAppReady")                                                                    \
+    CLOUD_API(SetActionZone, gfnSetActionZoneFn, "gfnSetActionZone")                                                     \
+    CLOUD_API(SendMessage, gfnSendMessageFn, "gfnSendCustomMessageToClient")                                             \
+    CLOUD_API(GetClientInfo, gfnGetClientInfoFn, "gfnGetClientInfo")                                                     \
+    CLOUD_API(RegisterClientInfoCallback, gfnRegisterCallbackFn, "gfnRegisterClientInfoCallback")                        \
+    CLOUD_API(RegisterNetworkStatusCallback, gfnRegisteCallbackFnWithUIntParam, "gfnRegisterNetworkStatusCallback")      \
+    CLOUD_API(RegisterMessageCallback, gfnRegisterCallbackFn, "gfnRegisterCustomMessageCallback")                        \
+    CLOUD_API(OpenURLOnClient, gfnOpenURLOnClientFn, "gfnOpenURLOnClient")                                               \
+    CLOUD_API(GetSessionInfo, gfnGetSessionInfoFn, "gfnGetSessionInfo")
+
+#define GFN_SDK_API_IGNORE(member, type, symbol)
+#define GFN_SDK_API_DECLARE(member, type, symbol) type member;
+#define GFN_SDK_API_BIND(member, type, symbol) pLibrary->member = (type)gfnGetSymbol(pLibrary->handle, symbol);
+
 typedef struct GfnSdkCloudLibrary_t
 {
     void* handle;
-    gfnCloudInitializeRuntimeSdkFn InitializeRuntimeSdk;            // Old Initialization method. Deprecate when all libraries have updated to 1.7.1 or greater.
-    gfnCloudInitializeRuntimeSdkV3Fn InitializeRuntimeSdkV3;
-    gfnCloudShutdownRuntimeSdkFn ShutdownRuntimeSdk;
-    gfnIsInitializedFn IsInitialized;
-    gfnIsRunningInCloudFn IsRunningInCloud;
-    gfnIsRunningInCloudSecureFn IsRunningInCloudSecure;
-    gfnCloudCheckFn CloudCheck;
-    gfnRegisterCallbackFn RegisterExitCallback;
-    gfnRegisterCallbackFn RegisterSaveCallback;
-    gfnRegisterCallbackFn RegisterSessionInitCallback;
-    gfnRegisterCallbackFn RegisterPauseCallback;
-    gfnRegisterCallbackFn RegisterInstallCallback;
-    gfnIsTitleAvailableFn IsTitleAvailable;
-    gfnGetTitlesAvailableFn GetTitlesAvailable;
-    gfnSetupTitleFn SetupTitle;
-    gfnTitleExitedFn TitleExited;
-    gfnGetClientIpFn GetClientIp;
-    gfnGetClientLanguageCodeFn GetClientLanguageCode;
-    gfnGetClientCountryCodeFn GetClientCountryCode;
-    gfnGetPartnerDataFn GetPartnerData;
-    gfnGetPartnerSecureDataFn GetPartnerSecureData;
-    gfnFreeFn Free;
-    gfnAppReadyFn AppReady;
-    gfnSetActionZoneFn SetActionZone;
-    gfnSendMessageFn SendMessage;
-
-    gfnGetClientInfoFn GetClientInfo;
-    gfnRegisterCallbackFn RegisterClientInfoCallback;
-    gfnRegisteCallbackFnWithUIntParam RegisterNetworkStatusCallback;
-    gfnRegisterCallbackFn RegisterMessageCallback;
-    gfnOpenURLOnClientFn OpenURLOnClient;
-
-    gfnGetSessionInfoFn GetSessionInfo;
+    GFN_SDK_LIBRARY_APIS(GFN_SDK_API_DECLARE, GFN_SDK_API_IGNORE)
 } GfnSdkCloudLibrary;
+
+typedef struct GfnSdkClientLibrary_t
+{
+    void* handle;
+    GFN_SDK_LIBRARY_APIS(GFN_SDK_API_IGNORE, GFN_SDK_API_DECLARE)
+} GfnSdkClientLibrary;
+
 GfnSdkCloudLibrary* g_pCloudLibrary = NULL;
 GfnRuntimeError g_cloudLibraryStatus = gfnAPINotInit;
+static GfnSdkClientLibrary g_clientLibrary;
+
+// SDK state word. The low bits cache the cloud environment check (enum IsCloud) and the flags record
+// which libraries are loaded and callable. The cached environment check on every API call is a single
+// acquire load of this word.
+enum IsCloud{IsCloud_Unknown,IsCloud_Yes,IsCloud_No};
+#define GFN_STATE_ENV_MASK      0x3
+#define GFN_STATE_CLIENT_LIVE   0x4
+#define GFN_STATE_CLOUD_LIVE    0x8
+static gfnAtomic32 g_sdkState = IsCloud_Unknown;
+
+// Calls into a loaded library are counted in per-thread stripes so that threads calling concurrently
+// don't contend on one cache line. Shutdown clears the live flags first and then waits for the stripes
+// to drain before the libraries are unloaded, which makes it safe against calls already in flight.
+#define GFN_CALL_GUARD_STRIPES 64
+typedef struct gfnCallGuardStripe
+{
+    gfnAtomic32 inFlight;
+    char padding[GFN_CACHE_LINE_SIZE - sizeof(gfnAtomic32)];
+} gfnCallGuardStripe;
+static gfnCallGuardStripe g_callGuard[GFN_CALL_GUARD_STRIPES];
+static gfnAtomic32 g_nextCallGuardStripe = 0;
+static GFN_THREAD_LOCAL int t_callGuardStripe = -1;
+static GFN_THREAD_LOCAL int t_callGuardDepth = 0;
+
+static gfnCallGuardStripe* gfnGetCallGuardStripe(void)
+{
+    if (t_callGuardStripe < 0)
+    {
+        t_callGuardStripe = (gfnAtomicAdd32(&g_nextCallGuardStripe, 1) - 1) & (GFN_CALL_GUARD_STRIPES - 1);
+    }
+    return &g_callGuard[t_callGuardStripe];
+}
+
+// Returns true, with the guard held, if every library in liveMask is live
+static bool gfnEnterLibraryCall(int32_t liveMask)
+{
+    gfnCallGuardStripe* stripe = gfnGetCallGuardStripe();
+
+    gfnAtomicAdd32(&stripe->inFlight, 1);
+    if ((gfnAtomicLoad32(&g_sdkState) & liveMask) != liveMask)
+    {
+        gfnAtomicAdd32(&stripe->inFlight, -1);
+        return false;
+    }
+    t_callGuardDepth++;
+    return true;
+}
+
+static void gfnLeaveLibraryCall(void)
+{
+    t_callGuardDepth--;
+    gfnAtomicAdd32(&g_callGuard[t_callGuardStripe].inFlight, -1);
+}
+
+// Waits for all library calls to return. Calls held by this thread, for example when shutdown is
+// requested from inside a callback, are not waited for.
+static void gfnDrainLibraryCalls(void)
+{
+    for (;;)
+    {
+        int32_t inFlight = 0;
+        int i;
+        for (i = 0; i < GFN_CALL_GUARD_STRIPES; i++)
+        {
+            inFlight += gfnAtomicLoad32(&g_callGuard[i].inFlight);
+        }
+        if (inFlight <= t_callGuardDepth)
+        {
+            return;
+        }
+        gfnThreadYield();
+    }
+}
+
+// Tracing. While enabled, calls into the SDK libraries, callback deliveries and SDK initialization
+// are recorded as spans in a per-thread ring of the most recent kGfnTraceEventsPerThread spans, which
+// GfnTraceDump writes out as Chrome trace-event JSON. Each ring has a single writer, its own thread,
+// and publishes spans with a release store of the write count, so recording takes no locks. A thread's
+// ring is released to a pool when the thread exits, and keeps its spans for dumps until the next thread
+// that records a span reuses it. At most kGfnTraceMaxBuffers rings are allocated; a thread that finds
+// none free records nothing until one is released.
+// Defining GFN_SDK_WRAPPER_TRACE to 0 compiles the recording out, independently of the call statistics.
+#ifndef GFN_SDK_WRAPPER_TRACE
+#   define GFN_SDK_WRAPPER_TRACE 1
+#endif
+#define kGfnTraceEventsPerThread 4096
+#define kGfnTraceMaxBuffers 64
+
+typedef struct gfnTraceEvent
+{
+    const char* name;
+    const char* category;
+    uint64_t beginTicks;
+    uint64_t endTicks;
+    int32_t result;
+    bool hasResult;
+} gfnTraceEvent;
+
+typedef struct gfnTraceBuffer
+{
+    struct gfnTraceBuffer* next;
+    uint64_t threadId;
+    gfnAtomic32 owned;              // Set while a thread records into the ring
+    gfnAtomic32 written;            // Spans recorded so far, modulo 2^32
+    gfnAtomic32 full;               // Set once the ring has wrapped
+    gfnTraceEvent events[kGfnTraceEventsPerThread];
+} gfnTraceBuffer;
+
+static gfnAtomic32 s_traceEnabled = 0;
+static gfnAtomicPtr s_traceBuffers = NULL;
+static gfnMutex s_traceDumpLock = GFN_MUTEX_INITIALIZER;     // Serializes GfnTraceDump calls and ring reuse
+static gfnAtomic32 s_traceBufferCount = 0;                  // Rings allocated
+static gfnAtomic32 s_traceBuffersReleased = 0;              // Rings whose thread has exited
+static gfnThreadKey s_traceBufferKey;
+static bool s_traceBufferKeyCreated = false;                // Guarded by s_traceDumpLock
+static GFN_THREAD_LOCAL gfnTraceBuffer* t_traceBuffer = NULL;
+
+static inline bool gfnIsTracing(void)
+{
+#if GFN_SDK_WRAPPER_TRACE
+    return gfnAtomicLoadRelaxed32(&s_traceEnabled) != 0;
+#else
+    return false;
+#endif
+}
+
+// Runs on a thread that exits with a ring
+static GFN_THREAD_KEY_DESTRUCTOR gfnReleaseTraceBuffer(void* value)
+{
+    gfnTraceBuffer* buffer = (gfnTraceBuffer*)value;
+
+    if (buffer != NULL)
+    {
+        gfnAtomicStoreRelease32(&buffer->owned, 0);
+        gfnAtomicAdd32(&s_traceBuffersReleased, 1);
+    }
+}
+
+// Reuses a released ring, or allocates one while under the cap
+static gfnTraceBuffer* gfnCreateTraceBuffer(void)
+{
+    gfnTraceBuffer* buffer = NULL;
+
+    if (gfnAtomicLoadAcquire32(&s_traceBuffersReleased) == 0 && gfnAtomicLoadAcquire32(&s_traceBufferCount) >= kGfnTraceMaxBuffers)
+    {
+        return NULL;
+    }
+
+    // Held so that a dump in progress does not see a ring change hands
+    gfnMutexLock(&s_traceDumpLock);
+    if (!s_traceBufferKeyCreated)
+    {
+        s_traceBufferKeyCreated = gfnThreadKeyCreate(&s_traceBufferKey, gfnReleaseTraceBuffer);
+    }
+    if (gfnAtomicLoadAcquire32(&s_traceBuffersReleased) > 0)
+    {
+        for (buffer = (gfnTraceBuffer*)gfnAtomicLoadAcquirePtr(&s_traceBuffers); buffer != NULL; buffer = buffer->next)
+        {
+            if (gfnAtomicLoadAcquire32(&buffer->owned) == 0)
+            {
+                gfnAtomicAdd32(&s_traceBuffersReleased, -1);
+                gfnAtomicStoreRelease32(&buffer->full, 0);
+                gfnAtomicStoreRelease32(&buffer->written, 0);
+                break;
+            }
+        }
+    }
+    if (buffer == NULL && gfnAtomicLoadAcquire32(&s_traceBufferCount) < kGfnTraceMaxBuffers)
+    {
+        buffer = (gfnTraceBuffer*)calloc(1, sizeof(gfnTraceBuffer));
+        if (buffer != NULL)
+        {
+            gfnAtomicAdd32(&s_traceBufferCount, 1);
+            buffer->next = (gfnTraceBuffer*)gfnAtomicLoadAcquirePtr(&s_traceBuffers);
+            gfnAtomicStoreReleasePtr(&s_traceBuffers, buffer);
+        }
+    }
+    if (buffer != NULL)
+    {
+        buffer->threadId = gfnGetCurrentThreadId();
+        gfnAtomicStoreRelease32(&buffer->owned, 1);
+        // Without the key the ring is never released, which the cap still bounds
+        if (s_traceBufferKeyCreated)
+        {
+            gfnThreadKeySet(s_traceBufferKey, buffer);
+        }
+        t_traceBuffer = buffer;
+    }
+    gfnMutexUnlock(&s_traceDumpLock);
+    return buffer;
+}
+
+static void gfnRecordTraceEvent(const char* name, const char* category, uint64_t beginTicks, uint64_t endTicks,
+    int32_t result, bool hasResult)
+{
+    gfnTraceBuffer* buffer = t_traceBuffer != NULL ? t_traceBuffer : gfnCreateTraceBuffer();
+    gfnTraceEvent* event;
+    uint32_t position;
+
+    if (buffer == NULL)
+    {
+        return;
+    }
+    position = (uint32_t)gfnAtomicLoadRelaxed32(&buffer->written);
+    event = &buffer->events[position & (kGfnTraceEventsPerThread - 1)];
+    event->name = name;
+    event->category = category;
+    event->beginTicks = beginTicks;
+    event->endTicks = endTicks;
+    event->result = result;
+    event->hasResult = hasResult;
+    if (position + 1 == kGfnTraceEventsPerThread)
+    {
+        gfnAtomicStoreRelease32(&buffer->full, 1);
+    }
+    gfnAtomicStoreRelease32(&buffer->written, (int32_t)(position + 1));
+}
+
+// Returns the start time of a span, or 0 if tracing is off
+static inline uint64_t gfnBeginTraceSpan(void)
+{
+    return gfnIsTracing() ? gfnReadTicks() : 0;
+}
+
+static inline void gfnEndTraceSpan(const char* name, const char* category, uint64_t beginTicks, int32_t result, bool hasResult)
+{
+    if (beginTicks != 0)
+    {
+        gfnRecordTraceEvent(name, category, beginTicks, gfnReadTicks(), result, hasResult);
+    }
+}
+
+// GFN_SDK_TRACE_FILE names a file that tracing is written to at shutdown
+#define kGfnTraceFilePathLength 1024
+static CHAR_TYPE s_traceFilePath[kGfnTraceFilePathLength];
+
+// Enables tracing if GFN_SDK_TRACE_FILE is set in the environment
+static void gfnReadTraceFileFromEnvironment(void)
+{
+#ifdef _WIN32
+    DWORD length = GetEnvironmentVariableW(L"GFN_SDK_TRACE_FILE", s_traceFilePath, kGfnTraceFilePathLength);
+    if (length == 0 || length >= kGfnTraceFilePathLength)
+    {
+        s_traceFilePath[0] = L'\0';
+        return;
+    }
+#elif __linux__
+    char const* env = getenv("GFN_SDK_TRACE_FILE");
+    if (env == NULL || env[0] == '\0' || strlen(env) >= kGfnTraceFilePathLength)
+    {
+        s_traceFilePath[0] = '\0';
+        return;
+    }
+    strcpy(s_traceFilePath, env);
+#endif
+    gfnAtomicExchange32(&s_traceEnabled, 1);
+}
+
+// Per-API statistics. Every call into a library export is counted and, when it fails, also counted
+// against its error code. The latency of one call in GFN_SDK_WRAPPER_STATS_SAMPLE_INTERVAL per thread
+// is added to a log-linear histogram; reading the cycle counter is the most expensive part of the
+// instrumentation on virtualized hosts, so sampling keeps the typical cost to a single atomic add.
+// The counters are sharded by the call guard stripe of the calling thread so that concurrent callers
+// rarely write the same cache line, and the shards are merged when read. Latencies are recorded in
+// gfnReadTicks units and converted to nanoseconds on read. The counters are 64-bit so that a busy API
+// on a seat that runs for days cannot wrap them. Defining GFN_SDK_WRAPPER_STATS to 0 compiles the
+// counting out; library calls are still timed while they are traced.
+#ifndef GFN_SDK_WRAPPER_STATS
+#   define GFN_SDK_WRAPPER_STATS 1
+#endif
+#ifndef GFN_SDK_WRAPPER_STATS_SAMPLE_INTERVAL
+#   define GFN_SDK_WRAPPER_STATS_SAMPLE_INTERVAL 16
+#endif
+
+#define GFN_SDK_API_ID_CLOUD(member, type, symbol) gfnApiCloud##member,
+#define GFN_SDK_API_ID_CLIENT(member, type, symbol) gfnApiClient##member,
+#define GFN_SDK_API_NAME(member, type, symbol) symbol,
+#define GFN_SDK_API_IN_CLOUD(member, type, symbol) true,
+#define GFN_SDK_API_IN_CLIENT(member, type, symbol) false,
+
+typedef enum gfnApiId
+{
+    GFN_SDK_LIBRARY_APIS(GFN_SDK_API_ID_CLOUD, GFN_SDK_API_ID_CLIENT)
+    gfnApiCount
+} gfnApiId;
+
+// GfnWrapperStats must have room for every API
+typedef char gfnApiStatsCapacityCheck[(gfnApiCount <= GFN_WRAPPER_STATS_MAX_APIS) ? 1 : -1];
+
+static const char* const kGfnApiNames[gfnApiCount] = { GFN_SDK_LIBRARY_APIS(GFN_SDK_API_NAME, GFN_SDK_API_NAME) };
+static const bool kGfnApiInCloudLibrary[gfnApiCount] = { GFN_SDK_LIBRARY_APIS(GFN_SDK_API_IN_CLOUD, GFN_SDK_API_IN_CLIENT) };
+
+// One bucket per tick below 16 ticks, then four buckets per power of two up to 2^44 ticks
+#define GFN_STATS_LINEAR_BUCKETS 16
+#define GFN_STATS_LATENCY_BUCKETS (GFN_STATS_LINEAR_BUCKETS + (44 - 4) * 4)
+#define GFN_STATS_SHARDS 8
+
+typedef struct gfnApiStatsShard
+{
+    gfnAtomic64 calls;
+    gfnAtomic64 latency[GFN_STATS_LATENCY_BUCKETS];
+    gfnAtomic64 errors[GFN_WRAPPER_STATS_ERROR_CODES];
+} gfnApiStatsShard;
+
+static gfnApiStatsShard s_apiStats[GFN_STATS_SHARDS][gfnApiCount];
+#if GFN_SDK_WRAPPER_STATS
+static GFN_THREAD_LOCAL unsigned int t_statsSampleCountdown = 0;
+#endif
+
+// Shard the calling thread records into for the current context, defined with the SDK contexts
+static inline gfnApiStatsShard* gfnGetContextStatsShard(gfnApiId api);
+
+// Reference point for converting ticks to nanoseconds, taken when the SDK is first initialized
+static gfnAtomic32 s_statsClockState = 0;
+static uint64_t s_statsClockBaseTicks = 0;
+static uint64_t s_statsClockBaseNs = 0;
+
+static inline unsigned int gfnLatencyBucket(uint64_t ticks)
+{
+    unsigned int exponent;
+    unsigned int bucket;
+
+    if (ticks < GFN_STATS_LINEAR_BUCKETS)
+    {
+        return (unsigned int)ticks;
+    }
+    exponent = gfnHighestBit64(ticks);
+    bucket = GFN_STATS_LINEAR_BUCKETS + ((exponent - 4) << 2) + (unsigned int)((ticks >> (exponent - 2)) & 3);
+    return bucket < GFN_STATS_LATENCY_BUCKETS ? bucket : GFN_STATS_LATENCY_BUCKETS - 1;
+}
+
+// Smallest tick count above the range of the bucket
+static uint64_t gfnLatencyBucketLimit(unsigned int bucket)
+{
+    unsigned int next = bucket + 1;
+
+    if (next < GFN_STATS_LINEAR_BUCKETS)
+    {
+        return next;
+    }
+    return (uint64_t)(4 + ((next - GFN_STATS_LINEAR_BUCKETS) & 3)) << (((next - GFN_STATS_LINEAR_BUCKETS) >> 2) + 2);
+}
+
+// Start of a library call. startTicks is 0 unless the call's latency is sampled or it is traced.
+typedef struct gfnApiCallTiming
+{
+    uint64_t startTicks;
+    bool sampled;
+} gfnApiCallTiming;
+
+static inline void gfnStartApiCall(gfnApiCallTiming* timing)
+{
+#if GFN_SDK_WRAPPER_STATS
+    timing->sampled = (t_statsSampleCountdown-- == 0);
+    if (timing->sampled)
+    {
+        t_statsSampleCountdown = GFN_SDK_WRAPPER_STATS_SAMPLE_INTERVAL - 1;
+    }
+#else
+    timing->sampled = false;
+#endif
+    timing->startTicks = (timing->sampled || gfnIsTracing()) ? gfnReadTicks() : 0;
+}
+
+static inline void gfnRecordApiCall(gfnApiId api, GfnRuntimeError status, const gfnApiCallTiming* timing)
+{
+    gfnApiStatsShard* shard = gfnGetContextStatsShard(api);
+    uint64_t endTicks;
+
+#if GFN_SDK_WRAPPER_STATS
+    gfnAtomicAdd64(&shard->calls, 1);
+    if (status < 0)
+    {
+        gfnAtomicAdd64(&shard->errors[-status < GFN_WRAPPER_STATS_ERROR_CODES ? -status : 0], 1);
+    }
+#else
+    (void)shard;
+#endif
+    if (timing->startTicks != 0)
+    {
+        endTicks = gfnReadTicks();
+        if (timing->sampled)
+        {
+            gfnAtomicAdd64(&shard->latency[gfnLatencyBucket(endTicks - timing->startTicks)], 1);
+        }
+        if (gfnIsTracing())
+        {
+            gfnRecordTraceEvent(kGfnApiNames[api], kGfnApiInCloudLibrary[api] ? "cloud" : "client",
+                timing->startTicks, endTicks, status, true);
+        }
+    }
+}
+
+#if GFN_SDK_WRAPPER_STATS || GFN_SDK_WRAPPER_TRACE
+// Assigns the result of a library call to status and records it against api
+#   define GFN_TIMED_STATUS_CALL(status, api, ...)                                          \
+    {                                                                                       \
+        gfnApiCallTiming callTiming;                                                        \
+        gfnStartApiCall(&callTiming);                                                       \
+        status = (__VA_ARGS__);                                                             \
+        gfnRecordApiCall(api, status, &callTiming);                                         \
+    }
+// Same for library calls that return a value rather than a status; they are recorded as successful
+#   define GFN_TIMED_CALL(result, api, ...)                                                 \
+    {                                                                                       \
+        gfnApiCallTiming callTiming;                                                        \
+        gfnStartApiCall(&callTiming);                                                       \
+        result = (__VA_ARGS__);                                                             \
+        gfnRecordApiCall(api, gfnSuccess, &callTiming);                                     \
+    }
+#else
+#   define GFN_TIMED_STATUS_CALL(status, api, ...) { status = (__VA_ARGS__); }
+#   define GFN_TIMED_CALL(result, api, ...) { result = (__VA_ARGS__); }
+#endif
+
+static void gfnStartStatsClock(void)
+{
+    if (gfnAtomicLoadAcquire32(&s_statsClockState) == 0 && gfnAtomicCompareExchange32(&s_statsClockState, 0, 1) == 0)
+    {
+        s_statsClockBaseNs = gfnGetMonotonicNs();
+        s_statsClockBaseTicks = gfnReadTicks();
+        gfnAtomicStoreRelease32(&s_statsClockState, 2);
+    }
+}
+
+// Initialization phase timings. Nested initialization calls, such as GfnInitializeSdk calling
+// GfnInitializeSdkFromPathDefault, add to the timings of the outermost call.
+typedef enum gfnInitPhase
+{
+    gfnInitPhasePathResolution,
+    gfnInitPhaseClientLoad,
+    gfnInitPhaseClientInit,
+    gfnInitPhaseCloudLoad,
+    gfnInitPhaseSymbolBinding,
+    gfnInitPhaseCloudInit,
+    gfnInitPhaseCount
+} gfnInitPhase;
+
+static uint64_t s_initPhaseNs[gfnInitPhaseCount];
+static uint64_t s_initTotalNs = 0;
+static bool s_initTimingsValid = false;
+static gfnMutex s_initTimingsLock = GFN_MUTEX_INITIALIZER;
+static GFN_THREAD_LOCAL int t_initTimingDepth = 0;
+static GFN_THREAD_LOCAL uint64_t t_initTraceBeginTicks = 0;
+
+static uint64_t gfnBeginInitTimings(void)
+{
+    gfnStartStatsClock();
+    if (t_initTimingDepth++ == 0)
+    {
+        gfnReadTraceFileFromEnvironment();
+        t_initTraceBeginTicks = gfnBeginTraceSpan();
+        gfnMutexLock(&s_initTimingsLock);
+        memset(s_initPhaseNs, 0, sizeof(s_initPhaseNs));
+        s_initTotalNs = 0;
+        gfnMutexUnlock(&s_initTimingsLock);
+    }
+    return gfnGetMonotonicNs();
+}
+
+static void gfnEndInitTimings(uint64_t startNs, GfnRuntimeError status)
+{
+    if (--t_initTimingDepth == 0)
+    {
+        gfnMutexLock(&s_initTimingsLock);
+        s_initTotalNs = gfnGetMonotonicNs() - startNs;
+        s_initTimingsValid = true;
+        gfnMutexUnlock(&s_initTimingsLock);
+        gfnEndTraceSpan("GfnInitializeSdk", "wrapper", t_initTraceBeginTicks, status, true);
+    }
+}
+
+static void gfnRecordInitPhase(gfnInitPhase phase, uint64_t startNs)
+{
+    uint64_t elapsedNs = gfnGetMonotonicNs() - startNs;
+
+    gfnMutexLock(&s_initTimingsLock);
+    s_initPhaseNs[phase] += elapsedNs;
+    gfnMutexUnlock(&s_initTimingsLock);
+}
 
 inline bool GfnUtf8ToWide(const char* in, wchar_t* out, int outSize)
 {
@@ -257,6 +911,9 @@ static GfnRuntimeError gfnTranslateCloudStatus(int status)
 
 GfnRuntimeError gfnShutDownCloudSdk(void)
 {
+    gfnAtomicAnd32(&g_sdkState, ~(GFN_STATE_CLOUD_LIVE | GFN_STATE_ENV_MASK));
+    gfnDrainLibraryCalls();
+
     if (g_pCloudLibrary != NULL)
     {
         if (g_pCloudLibrary->ShutdownRuntimeSdk != NULL)
@@ -330,7 +987,7 @@ static void* gfnLoadLibrary(const CHAR_TYPE* path)
 #endif
 }
 
-static void* gfnGetSymbol(void* library, char* name)
+static void* gfnGetSymbol(void* library, const char* name)
 {
 #ifdef _WIN32
     return (void*)GetProcAddress((HMODULE)library, name);
@@ -339,6 +996,16 @@ static void* gfnGetSymbol(void* library, char* name)
 #endif
 }
 
+static void gfnBindCloudLibrary(GfnSdkCloudLibrary* pLibrary)
+{
+    GFN_SDK_LIBRARY_APIS(GFN_SDK_API_BIND, GFN_SDK_API_IGNORE)
+}
+
+static void gfnBindClientLibrary(GfnSdkClientLibrary* pLibrary)
+{
+    GFN_SDK_LIBRARY_APIS(GFN_SDK_API_IGNORE, GFN_SDK_API_BIND)
+}
+
 static GfnRuntimeError gfnGetDefaultClientLibraryPath(CHAR_TYPE* path)
 {
 #ifdef _WIN32
@@ -392,7 +1059,7 @@ static GfnRuntimeError gfnGetDefaultClientLibraryPath(CHAR_TYPE* path)
 
     // Append "GfnRuntimeSdk.so" to the directory path
     if (strlen(path) + strlen("/" GFN_CLIENT_SHARED_LIBRARY) + 1 > PLATFORM_MAX_PATH) {
-        GFN_SDK_LOG("ERROR: Could not get default client library path name: Path too long");
+        GFN_SDK_LOG_ERROR("ERROR: Could not get default client library path name: Path too long");
         return gfnInternalError;
     }
 
@@ -401,10 +1068,48 @@ static GfnRuntimeError gfnGetDefaultClientLibraryPath(CHAR_TYPE* path)
     return gfnSuccess;
 }
 
+// GFN_SDK_CLOUD_LIBRARY_PATH replaces the path of the cloud library, so that a stand-in such as the
+// mock runtime in tools/MockRuntime can be loaded off a GFN seat. Anyone who can set the environment
+// could otherwise load any library as the cloud library, and Linux has no signature check, so the
+// override is only compiled into builds that define GFN_SDK_ENABLE_LIBRARY_OVERRIDE to 1, such as the
+// wrapper tools. On Windows, release builds still require the library to pass the signature check.
+#ifndef GFN_SDK_ENABLE_LIBRARY_OVERRIDE
+#   define GFN_SDK_ENABLE_LIBRARY_OVERRIDE 0
+#endif
+
+static void gfnReadCloudLibraryPathFromEnvironment(void)
+{
+#if !GFN_SDK_ENABLE_LIBRARY_OVERRIDE
+#   ifdef __linux__
+    strcpy(g_cloudLibraryPath, GFN_SHARED_OBJECT_PATH);
+#   endif
+#elif defined(_WIN32)
+    wchar_t path[PLATFORM_MAX_PATH];
+    DWORD length = GetEnvironmentVariableW(L"GFN_SDK_CLOUD_LIBRARY_PATH", path, PLATFORM_MAX_PATH);
+    if (length > 0 && length < PLATFORM_MAX_PATH)
+    {
+        wcscpy_s(g_cloudLibraryPath, PLATFORM_MAX_PATH, path);
+        GFN_SDK_LOG("Cloud library path overridden by GFN_SDK_CLOUD_LIBRARY_PATH");
+    }
+#elif __linux__
+    char const* env = getenv("GFN_SDK_CLOUD_LIBRARY_PATH");
+    if (env != NULL && env[0] != '\0' && strlen(env) < PLATFORM_MAX_PATH)
+    {
+        strcpy(g_cloudLibraryPath, env);
+        GFN_SDK_LOG("Cloud library path overridden by GFN_SDK_CLOUD_LIBRARY_PATH: %s", env);
+    }
+    else
+    {
+        strcpy(g_cloudLibraryPath, GFN_SHARED_OBJECT_PATH);
+    }
+#endif
+}
+
 static GfnRuntimeError gfnLoadCloudLibrary(GfnSdkCloudLibrary** ppCloudLibrary)
 {
     void* library = NULL;
     GfnSdkCloudLibrary* pCloudLibrary = NULL;
+    uint64_t phaseStartNs = gfnGetMonotonicNs();
 
     // If we've already attempted to load this, return the previous results and library
     if (g_cloudLibraryStatus != gfnAPINotInit)
@@ -420,40 +1125,43 @@ static GfnRuntimeError gfnLoadCloudLibrary(GfnSdkCloudLibrary** ppCloudLibrary)
     {
         if (wcscat_s(g_cloudLibraryPath, PLATFORM_MAX_PATH, GFN_DLL_SUBPATH) != 0)
         {
-            GFN_SDK_LOG("FAIL: Unable to concatenate path to Runtime SDK binaries");
+            GFN_SDK_LOG_ERROR("FAIL: Unable to concatenate path to Runtime SDK binaries");
             return gfnInitFailure;
         }
     }
     else
     {
-        GFN_SDK_LOG("FAIL: Unable to get path to Runtime SDK binaries");
+        GFN_SDK_LOG_ERROR("FAIL: Unable to get path to Runtime SDK binaries");
         return gfnInitFailure;
     }
 #endif // _WIN32
+    gfnReadCloudLibraryPathFromEnvironment();
 
     if (!gfnPathExists(g_cloudLibraryPath))
     {
+        gfnRecordInitPhase(gfnInitPhaseCloudLoad, phaseStartNs);
         GFN_SDK_LOG("SUCCESS: Cloud library does not exist, this is running on the user client");
         return gfnCloudLibraryNotFound;
     }
 
     library = gfnLoadLibrary(g_cloudLibraryPath);
+    gfnRecordInitPhase(gfnInitPhaseCloudLoad, phaseStartNs);
     if (!library)
     {
 #ifdef _WIN32
         DWORD lastError = GetLastError();
         if (lastError == CRYPT_E_NO_MATCH)
         {
-            GFN_SDK_LOG("ERROR: GFN library failed to load due to invalid signature");
+            GFN_SDK_LOG_ERROR("ERROR: GFN library failed to load due to invalid signature");
             return gfnBinarySignatureInvalid;
         }
         else
         {
-            GFN_SDK_LOG("ERROR: GFN library is present but unable to be loaded! LastError=0x%08X", lastError);
+            GFN_SDK_LOG_ERROR("ERROR: GFN library is present but unable to be loaded! LastError=0x%08X", lastError);
             return gfnInitFailure;
         }
 #elif __linux__
-        GFN_SDK_LOG("GFN library is present but unable to be loaded! dlerror=%s", dlerror());
+        GFN_SDK_LOG_ERROR("GFN library is present but unable to be loaded! dlerror=%s", dlerror());
         return gfnInitFailure;
 #endif
     }
@@ -461,51 +1169,21 @@ static GfnRuntimeError gfnLoadCloudLibrary(GfnSdkCloudLibrary** ppCloudLibrary)
     pCloudLibrary = (GfnSdkCloudLibrary*)malloc(sizeof(GfnSdkCloudLibrary));
     if (pCloudLibrary == NULL)
     {
-        GFN_SDK_LOG("ERROR: Unable to allocate memory to hold GFN function pointers");
+        GFN_SDK_LOG_ERROR("ERROR: Unable to allocate memory to hold GFN function pointers");
         gfnFreeLibrary(library);
         return gfnUnableToAllocateMemory;
     }
 
     pCloudLibrary->handle = library;
-    // Old Initialization method. Deprecate when all libraries have updated to 1.7.1 or greater.
-    pCloudLibrary->InitializeRuntimeSdk = (gfnCloudInitializeRuntimeSdkFn)gfnGetSymbol(pCloudLibrary->handle, "gfnInitializeRuntimeSdk2");
-    pCloudLibrary->InitializeRuntimeSdkV3 = (gfnCloudInitializeRuntimeSdkV3Fn)gfnGetSymbol(pCloudLibrary->handle, "gfnInitializeRuntimeSdk3");
-    pCloudLibrary->ShutdownRuntimeSdk = (gfnCloudShutdownRuntimeSdkFn)gfnGetSymbol(pCloudLibrary->handle, "gfnShutdownRuntimeSdk2");
-    pCloudLibrary->IsInitialized = (gfnIsInitializedFn)gfnGetSymbol(pCloudLibrary->handle, "gfnIsInitialized");
-    pCloudLibrary->IsRunningInCloud = (gfnIsRunningInCloudFn)gfnGetSymbol(pCloudLibrary->handle, "gfnIsRunningInCloud");
-    pCloudLibrary->IsRunningInCloudSecure = (gfnIsRunningInCloudSecureFn)gfnGetSymbol(pCloudLibrary->handle, "gfnIsRunningInCloudSecure");
-    pCloudLibrary->CloudCheck = (gfnCloudCheckFn)gfnGetSymbol(pCloudLibrary->handle, "gfnCloudCheck");
-    pCloudLibrary->IsTitleAvailable = (gfnIsTitleAvailableFn)gfnGetSymbol(pCloudLibrary->handle, "gfnIsTitleAvailable");
-    pCloudLibrary->GetTitlesAvailable = (gfnGetTitlesAvailableFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetTitlesAvailable");
-    pCloudLibrary->SetupTitle = (gfnSetupTitleFn)gfnGetSymbol(pCloudLibrary->handle, "gfnSetupTitle");
-    pCloudLibrary->TitleExited = (gfnTitleExitedFn)gfnGetSymbol(pCloudLibrary->handle, "gfnTitleExited");
-    pCloudLibrary->GetClientIp = (gfnGetClientIpFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetClientIp");
-    pCloudLibrary->GetClientLanguageCode = (gfnGetClientLanguageCodeFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetClientLanguageCode");
-    pCloudLibrary->GetClientCountryCode = (gfnGetClientCountryCodeFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetClientCountryCode");
-    pCloudLibrary->GetPartnerData = (gfnGetPartnerDataFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetPartnerData");
-    pCloudLibrary->GetPartnerSecureData = (gfnGetPartnerSecureDataFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetPartnerSecureData");
-    pCloudLibrary->Free = (gfnFreeFn)gfnGetSymbol(pCloudLibrary->handle, "gfnFree");
-    pCloudLibrary->AppReady = (gfnAppReadyFn)gfnGetSymbol(pCloudLibrary->handle, "gfnAppReady");
-    pCloudLibrary->SetActionZone = (gfnSetActionZoneFn)gfnGetSymbol(pCloudLibrary->handle, "gfnSetActionZone");
-    pCloudLibrary->SendMessage = (gfnSendMessageFn)gfnGetSymbol(pCloudLibrary->handle, "gfnSendCustomMessageToClient");
-    pCloudLibrary->RegisterExitCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterExitCallback");
-    pCloudLibrary->RegisterPauseCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterPauseCallback");
-    pCloudLibrary->RegisterInstallCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterInstallCallback");
-    pCloudLibrary->RegisterSaveCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterSaveCallback");
-    pCloudLibrary->RegisterSessionInitCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterSessionInitCallback");
-
-    pCloudLibrary->GetClientInfo = (gfnGetClientInfoFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetClientInfo");
-    pCloudLibrary->RegisterClientInfoCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterClientInfoCallback");
-    pCloudLibrary->RegisterNetworkStatusCallback = (gfnRegisteCallbackFnWithUIntParam)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterNetworkStatusCallback");
-    pCloudLibrary->RegisterMessageCallback = (gfnRegisterCallbackFn)gfnGetSymbol(pCloudLibrary->handle, "gfnRegisterCustomMessageCallback");
-    pCloudLibrary->OpenURLOnClient = (gfnOpenURLOnClientFn)gfnGetSymbol(pCloudLibrary->handle, "gfnOpenURLOnClient");
-    pCloudLibrary->GetSessionInfo = (gfnGetSessionInfoFn)gfnGetSymbol(pCloudLibrary->handle, "gfnGetSessionInfo");
+    phaseStartNs = gfnGetMonotonicNs();
+    gfnBindCloudLibrary(pCloudLibrary);
+    gfnRecordInitPhase(gfnInitPhaseSymbolBinding, phaseStartNs);
 
     GFN_SDK_LOG("Successfully loaded cloud libary");
 
     if (pCloudLibrary->InitializeRuntimeSdk == NULL && pCloudLibrary->InitializeRuntimeSdkV3 == NULL)
     {
-        GFN_SDK_LOG("Unable to find initialize function pointer");
+        GFN_SDK_LOG_ERROR("Unable to find initialize function pointer");
         gfnFreeCloudLibrary(pCloudLibrary);
         return gfnAPINotFound;
     }
@@ -517,6 +1195,8 @@ static GfnRuntimeError gfnLoadCloudLibrary(GfnSdkCloudLibrary** ppCloudLibrary)
 
 GfnRuntimeError gfnInitializeCloudSdk(void)
 {
+    uint64_t phaseStartNs;
+
     // Already initialized, no need to re-initialize
     if (g_pCloudLibrary != NULL)
     {
@@ -529,6 +1209,7 @@ GfnRuntimeError gfnInitializeCloudSdk(void)
         return g_cloudLibraryStatus;
     }
 
+    phaseStartNs = gfnGetMonotonicNs();
     if (g_pCloudLibrary->InitializeRuntimeSdkV3)
     {
         g_cloudLibraryStatus = g_pCloudLibrary->InitializeRuntimeSdkV3(NVGFNSDK_VERSION_STR);
@@ -538,9 +1219,10 @@ GfnRuntimeError gfnInitializeCloudSdk(void)
     {
         g_cloudLibraryStatus = g_pCloudLibrary->InitializeRuntimeSdk((float)(NVGFNSDK_VERSION_SHORT));
     }
+    gfnRecordInitPhase(gfnInitPhaseCloudInit, phaseStartNs);
     if (GFNSDK_FAILED(g_cloudLibraryStatus))
     {
-        GFN_SDK_LOG("Call to cloud InitializeRuntimeSdk failed: %d", g_cloudLibraryStatus);
+        GFN_SDK_LOG_ERROR("Call to cloud InitializeRuntimeSdk failed: %d", g_cloudLibraryStatus);
         // If init fails, we shouldn't force the host application to hold a loaded reference to the cloud DLL.
         // Instead we will unload to make sure SDK is in a clean state in case the application tried to call
         // the Initialize API again.
@@ -548,1033 +1230,8870 @@ GfnRuntimeError gfnInitializeCloudSdk(void)
         g_pCloudLibrary = NULL;
         g_cloudLibraryStatus = gfnAPINotInit;
     }
+    else
+    {
+        // Publish the library only once it is fully initialized
+        gfnAtomicOr32(&g_sdkState, GFN_STATE_CLOUD_LIVE);
+    }
     return g_cloudLibraryStatus;
 }
 
-typedef struct _gfnUserContextCallbackWrapper
+// Callback registrations are kept in a fixed table with one slot per callback kind. The wrapper's
+// trampoline is registered with the SDK library once per library load, with the slot as its context;
+// re-registering only swaps the callback and user context stored in the slot, so no memory is
+// allocated to manage callbacks.
+typedef enum gfnCallbackKind
+{
+    gfnCallbackClientInfo,
+    gfnCallbackNetworkStatus,
+    gfnCallbackStreamStatus,
+    gfnCallbackExit,
+    gfnCallbackPause,
+    gfnCallbackInstall,
+    gfnCallbackSave,
+    gfnCallbackSessionInit,
+    gfnCallbackMessage,
+    gfnCallbackQualityAdvice,       // Called by the quality advisor, which registers no trampoline of its own
+    gfnCallbackKindCount
+} gfnCallbackKind;
+
+// Span names of callback deliveries in traces
+static const char* const kGfnCallbackNames[gfnCallbackKindCount] =
+{
+    "ClientInfoCallback",
+    "NetworkStatusCallback",
+    "StreamStatusCallback",
+    "ExitCallback",
+    "PauseCallback",
+    "InstallCallback",
+    "SaveCallback",
+    "SessionInitCallback",
+    "MessageCallback",
+    "QualityAdviceCallback"
+};
+
+typedef struct gfnCallbackSlot
+{
+    gfnAtomic32 sequence;           // Odd while the callback and context are being replaced
+    gfnAtomic32 active;             // Number of threads currently running the callback
+    gfnAtomicPtr fnCallback;
+    gfnAtomicPtr pUserContext;
+    bool registered;                // Trampoline registered with the loaded library, guarded by g_callbackLock
+    unsigned int param;             // Registration parameter, such as the network status update rate
+} gfnCallbackSlot;
+
+// A callback being dispatched through a slot
+typedef struct gfnCallbackInvocation
 {
+    gfnCallbackSlot* slot;
+    gfnCallbackSlot* previousSlot;
     void* fnCallback;
-    void* pOrigUserContext;
-} _gfnUserContextCallbackWrapper;
+    void* pUserContext;
+    gfnCallbackKind kind;
+    uint64_t traceBeginTicks;
+} gfnCallbackInvocation;
 
-enum IsCloud{IsCloud_Unknown,IsCloud_Yes,IsCloud_No};
-static enum IsCloud g_isCloud = IsCloud_Unknown;
-
-#define CHECK_NULL_PARAM(param)         \
-    if (!param)                         \
-    {                                   \
-        return gfnInvalidParameter;     \
-    }
-#define CHECK_CLOUD_ENVIRONMENT_IMPL(bUseCache)                                             \
-    if(g_isCloud == IsCloud_Unknown || !bUseCache)                                          \
-    {                                                                                       \
-        if (!g_pCloudLibrary && !g_gfnSdkModule)                                            \
-        {                                                                                   \
-            return gfnAPINotInit;                                                           \
-        }                                                                                   \
-        if (!g_pCloudLibrary || !g_pCloudLibrary->IsRunningInCloud)                         \
-        {                                                                                   \
-            GFN_SDK_LOG("Cannot call cloud function: Wrong environment");                   \
-            return gfnCallWrongEnvironment;                                                 \
-        }                                                                                   \
-        g_isCloud = ((bool)g_pCloudLibrary->IsRunningInCloud()) ? IsCloud_Yes : IsCloud_No; \
-    }                                                                                       \
-    if (g_isCloud == IsCloud_No)                                                            \
-    {                                                                                       \
-        GFN_SDK_LOG("Cannot call cloud function: Wrong environment");                       \
-        return gfnCallWrongEnvironment;                                                     \
-    }
-#define CHECK_CLOUD_ENVIRONMENT() CHECK_CLOUD_ENVIRONMENT_IMPL(true)
-#define CHECK_CLOUD_API_AVAILABLE(Fn)                                       \
-    if (g_pCloudLibrary->Fn == NULL)                                        \
-    {                                                                       \
-        GFN_SDK_LOG("Cannot call cloud function %s: API not found", #Fn);   \
-        return gfnAPINotFound;                                              \
-    }
-#define DELEGATE_TO_CLOUD_LIBRARY(Fn, ...)                              \
-    CHECK_CLOUD_API_AVAILABLE(Fn);                                      \
-    return gfnTranslateCloudStatus(g_pCloudLibrary->Fn(__VA_ARGS__));
+static gfnCallbackSlot g_callbackSlots[gfnCallbackKindCount];
+static gfnMutex g_callbackLock = GFN_MUTEX_INITIALIZER;
+static GFN_THREAD_LOCAL gfnCallbackSlot* t_dispatchingSlot = NULL;
 
-GfnRuntimeError GfnInitializeSdk(GfnDisplayLanguage language)
+static void gfnWriteCallbackSlot(gfnCallbackSlot* slot, void* fnCallback, void* pUserContext)
 {
-    // If "client" SDK is already initialized, then we're good to go.
-    // "server" SDK may or may not be initialized depending on mode.
-    GfnRuntimeError clientStatus = gfnSuccess;
-    GfnRuntimeError err = gfnSuccess;
+    gfnAtomicAdd32(&slot->sequence, 1);
+    gfnAtomicStoreReleasePtr(&slot->fnCallback, fnCallback);
+    gfnAtomicStoreReleasePtr(&slot->pUserContext, pUserContext);
+    gfnAtomicAdd32(&slot->sequence, 1);
+}
 
-    if (!g_LoggingInitialized)
+// Waits until no other thread is running the slot's callback
+static void gfnDrainCallbackSlot(gfnCallbackSlot* slot)
+{
+    int32_t own = (t_dispatchingSlot == slot) ? 1 : 0;
+    while (gfnAtomicLoad32(&slot->active) > own)
     {
-        GFN_SDK_INIT_LOGGING();
-        g_LoggingInitialized = true;
+        gfnThreadYield();
     }
+}
 
+// Reads a consistent callback and context from the slot. Returns false if no callback is registered.
+static bool gfnEnterCallbackSlot(gfnCallbackSlot* slot, gfnCallbackKind kind, gfnCallbackInvocation* invocation)
+{
+    int32_t sequence;
 
-    if (g_gfnSdkModule != NULL)
+    if (slot == NULL)
     {
-        GFN_SDK_LOG("Client library already initialized, no need to initialize again");
+        return false;
     }
-    else
+    gfnAtomicAdd32(&slot->active, 1);
+    for (;;)
     {
-        CHAR_TYPE* filename = (CHAR_TYPE*)malloc(sizeof(CHAR_TYPE) * PLATFORM_MAX_PATH);
-        if (!filename)
+        sequence = gfnAtomicLoad32(&slot->sequence);
+        if ((sequence & 1) == 0)
         {
-            return gfnInternalError;
+            invocation->fnCallback = gfnAtomicLoadAcquirePtr(&slot->fnCallback);
+            invocation->pUserContext = gfnAtomicLoadAcquirePtr(&slot->pUserContext);
+            if (gfnAtomicLoad32(&slot->sequence) == sequence)
+            {
+                break;
+            }
         }
+        gfnCpuRelax();
+    }
+    if (invocation->fnCallback == NULL)
+    {
+        gfnAtomicAdd32(&slot->active, -1);
+        return false;
+    }
+    invocation->slot = slot;
+    invocation->kind = kind;
+    invocation->previousSlot = t_dispatchingSlot;
+    invocation->traceBeginTicks = gfnBeginTraceSpan();
+    t_dispatchingSlot = slot;
+    return true;
+}
 
-        err = gfnGetDefaultClientLibraryPath(filename);
-        if (GFNSDK_FAILED(err))
+static void gfnLeaveCallbackSlot(gfnCallbackInvocation* invocation)
+{
+    gfnEndTraceSpan(kGfnCallbackNames[invocation->kind], "callback", invocation->traceBeginTicks, 0, false);
+    t_dispatchingSlot = invocation->previousSlot;
+    gfnAtomicAdd32(&invocation->slot->active, -1);
+}
+
+// SDK contexts. A context created with GfnCreateContext has its own callback registrations and call
+// statistics; the global API works on the default context, whose state is g_callbackSlots and
+// s_apiStats. The GfnContext* variants of the API make the context current for the calling thread
+// for the duration of the call. The libraries themselves are process-wide, so their bindings, the
+// environment check, the session snapshot cache and the request schedulers are shared by all contexts.
+//
+// Contexts are published in a fixed table that the trampolines scan without locks to deliver each
+// event to every context with a callback registered. Destroying a context removes it from the table
+// and then waits for trampolines still scanning it to finish before it is freed.
+#define kGfnMaxContexts 1024
+
+struct GfnSdkContext_t
+{
+    gfnCallbackSlot callbackSlots[gfnCallbackKindCount];
+    gfnApiStatsShard stats[gfnApiCount];    // Contexts are driven by fewer threads, so they have a single shard
+    unsigned int index;                     // Position in s_contexts
+};
+
+static gfnAtomicPtr s_contexts[kGfnMaxContexts];
+static gfnAtomic32 s_contextCount = 0;                          // One past the highest position in use
+static gfnMutex s_contextRegistryLock = GFN_MUTEX_INITIALIZER;  // Serializes changes to s_contexts
+static gfnAtomic32 s_callbackDispatchers = 0;                   // Threads scanning s_contexts in a trampoline
+static GFN_THREAD_LOCAL int t_callbackDispatchDepth = 0;
+static GFN_THREAD_LOCAL GfnSdkContext t_context = NULL;         // NULL for the default context
+
+static inline gfnCallbackSlot* gfnGetCallbackSlot(gfnCallbackKind kind)
+{
+    return t_context != NULL ? &t_context->callbackSlots[kind] : &g_callbackSlots[kind];
+}
+
+static inline gfnApiStatsShard* gfnGetContextStatsShard(gfnApiId api)
+{
+    return t_context != NULL ? &t_context->stats[api] : &s_apiStats[t_callGuardStripe & (GFN_STATS_SHARDS - 1)][api];
+}
+
+// Enters the next callback of the given kind, starting from the default context and then visiting each
+// created context. Returns false once every context has been visited. Used as
+//     for (cursor = 0; gfnNextCallback(kind, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+static bool gfnNextCallback(gfnCallbackKind kind, unsigned int* cursor, gfnCallbackInvocation* invocation)
+{
+    unsigned int count;
+
+    if (*cursor == 0)
+    {
+        gfnAtomicAdd32(&s_callbackDispatchers, 1);
+        t_callbackDispatchDepth++;
+        (*cursor)++;
+        if (gfnEnterCallbackSlot(&g_callbackSlots[kind], kind, invocation))
         {
-            free(filename);
-            return err;
+            return true;
+        }
+    }
+    count = (unsigned int)gfnAtomicLoadAcquire32(&s_contextCount);
+    while (*cursor <= count)
+    {
+        GfnSdkContext context = (GfnSdkContext)gfnAtomicLoadAcquirePtr(&s_contexts[*cursor - 1]);
+        (*cursor)++;
+        if (context != NULL && gfnEnterCallbackSlot(&context->callbackSlots[kind], kind, invocation))
+        {
+            return true;
         }
-
-        clientStatus = GfnInitializeSdkFromPathDefault(language, filename);
-        free(filename);
     }
+    t_callbackDispatchDepth--;
+    gfnAtomicAdd32(&s_callbackDispatchers, -1);
+    return false;
+}
 
-    if (GFNSDK_FAILED(clientStatus))
+// Waits for trampolines on other threads to stop scanning s_contexts
+static void gfnDrainCallbackDispatchers(void)
+{
+    while (gfnAtomicLoad32(&s_callbackDispatchers) > t_callbackDispatchDepth)
     {
-        GFN_SDK_LOG("Initialization failed: %d", clientStatus);
-        GfnShutdownSdk();
+        gfnThreadYield();
     }
+}
 
-    return clientStatus;
+// Stores the callback in the current context's slot with g_callbackLock held. Returns true if the trampoline
+// still has to be registered with the library, in which case the caller registers it and passes the result
+// to gfnEndCallbackRegistration. The library registration is process-wide and tracked in g_callbackSlots.
+static bool gfnBeginCallbackRegistration(gfnCallbackKind kind, void* fnCallback, void* pUserContext, unsigned int param)
+{
+    gfnCallbackSlot* registration = &g_callbackSlots[kind];
+
+    gfnMutexLock(&g_callbackLock);
+    gfnWriteCallbackSlot(gfnGetCallbackSlot(kind), fnCallback, pUserContext);
+    return !registration->registered || registration->param != param;
 }
 
-// On WIN32, this accepts a wide char string.
-// On all other platforms, this accepts a UTF-8 string.
-GfnRuntimeError GfnInitializeSdkFromPathDefault(GfnDisplayLanguage language, const CHAR_TYPE* sdkLibraryPath)
+static GfnRuntimeError gfnEndCallbackRegistration(gfnCallbackKind kind, unsigned int param, GfnRuntimeError status)
 {
-    gfnInitializeRuntimeSdkFn fnGfnInitializeRuntimeSdk = NULL;
-    GfnRuntimeError clientStatus = gfnSuccess;
-    GfnRuntimeError cloudStatus = gfnSuccess;
-    const CHAR_TYPE* filename = NULL;
+    gfnCallbackSlot* registration = &g_callbackSlots[kind];
 
-    // If "client" library is already initialized, then we're good to go.
-    if (g_gfnSdkModule != NULL)
+    if (GFNSDK_SUCCEEDED(status))
     {
-        GFN_SDK_LOG("Client library already initialized, no need to initialize again");
-        return gfnSuccess;
+        registration->registered = true;
+        registration->param = param;
     }
-
-    if (!g_LoggingInitialized)
+    else if (!registration->registered)
     {
-        GFN_SDK_INIT_LOGGING();
-        g_LoggingInitialized = true;
+        gfnWriteCallbackSlot(gfnGetCallbackSlot(kind), NULL, NULL);
     }
+    gfnMutexUnlock(&g_callbackLock);
+    return status;
+}
 
-    filename = gfnGetFilenameFromPath(sdkLibraryPath);
-    if (!filename || !gfnPathEqual(filename, GFN_CLIENT_SHARED_LIBRARY))
+// Removes the callback from the current context's slot. Once this returns, the callback is no longer
+// running on another thread and will not be called again.
+static GfnRuntimeError gfnUnregisterCallback(gfnCallbackKind kind)
+{
+    gfnCallbackSlot* slot = gfnGetCallbackSlot(kind);
+
+    gfnMutexLock(&g_callbackLock);
+    gfnWriteCallbackSlot(slot, NULL, NULL);
+    gfnMutexUnlock(&g_callbackLock);
+    gfnDrainCallbackSlot(slot);
+    return gfnSuccess;
+}
+
+// Empties every slot of every context. Called once the libraries are unloaded, so trampolines must be
+// registered again.
+static void gfnResetCallbackSlots(void)
+{
+    GfnSdkContext context;
+    int count;
+    int kind;
+    int i;
+
+    gfnMutexLock(&g_callbackLock);
+    gfnMutexLock(&s_contextRegistryLock);
+    for (kind = 0; kind < gfnCallbackKindCount; kind++)
     {
-        GFN_SDK_LOG("Invalid SDK library name");
-        return gfnInvalidParameter;
+        gfnWriteCallbackSlot(&g_callbackSlots[kind], NULL, NULL);
+        g_callbackSlots[kind].registered = false;
+        g_callbackSlots[kind].param = 0;
+    }
+    count = gfnAtomicLoadAcquire32(&s_contextCount);
+    for (i = 0; i < count; i++)
+    {
+        context = (GfnSdkContext)gfnAtomicLoadAcquirePtr(&s_contexts[i]);
+        for (kind = 0; context != NULL && kind < gfnCallbackKindCount; kind++)
+        {
+            gfnWriteCallbackSlot(&context->callbackSlots[kind], NULL, NULL);
+        }
     }
+    gfnMutexUnlock(&s_contextRegistryLock);
+    gfnMutexUnlock(&g_callbackLock);
+    for (kind = 0; kind < gfnCallbackKindCount; kind++)
+    {
+        gfnDrainCallbackSlot(&g_callbackSlots[kind]);
+    }
+    gfnDrainCallbackDispatchers();
+}
 
-    if (!gfnPathExists(sdkLibraryPath))
+#define CHECK_NULL_PARAM(param)         \
+    if (!param)                         \
+    {                                   \
+        return gfnInvalidParameter;     \
+    }
+
+// Queued callback delivery. In gfnCallbackDeliveryQueued mode, the ClientInfo, NetworkStatus, StreamStatus
+// and Message trampolines do not call the application; they record the event and signal the event handle,
+// and GfnPumpEvents delivers it later on the application's thread.
+//
+// ClientInfo and NetworkStatus updates are state, not events: each update type has a mailbox holding only
+// the newest value, so an application that pumps slowly sees one update per type rather than a backlog.
+// Quality advice is state too, and has a mailbox of its own.
+// StreamStatus transitions and messages are each delivered, in order, through a bounded MPSC ring.
+#define kGfnEventRingSize 256
+#define kGfnClientInfoMailboxCount (gfnClientDataChangeTypeMax + 1)
+#define kGfnNetworkStatusMailboxCount (gfnNetworkStatusChangeTypeMax + 1)
+
+typedef struct gfnEventMailbox
+{
+    gfnAtomic32 sequence;           // Odd while the value is being replaced
+    gfnAtomic32 delivered;          // Sequence of the last value taken; the value is pending while they differ
+    union
     {
-        clientStatus = gfnClientLibraryNotFound;
+        GfnClientInfoUpdateData clientInfo;
+        GfnNetworkStatusUpdateData networkStatus;
+        GfnQualityAdvice qualityAdvice;
+    } data;
+} gfnEventMailbox;
+
+typedef struct gfnQueuedEvent
+{
+    gfnAtomic32 sequence;           // Ring cell sequence, stored relative to the cell index
+    gfnCallbackKind kind;
+    union
+    {
+        GfnClientInfoUpdateData clientInfo;         // Update types without a mailbox
+        GfnNetworkStatusUpdateData networkStatus;
+        GfnStreamStatus streamStatus;
+        GfnString message;                          // Copy owned by the queue
+        GfnQualityAdvice qualityAdvice;             // Only taken from its mailbox, never queued in the ring
+    } data;
+} gfnQueuedEvent;
+
+typedef struct gfnEventRing
+{
+    gfnAtomic32 enqueuePos;
+    char pad0[GFN_CACHE_LINE_SIZE - sizeof(gfnAtomic32)];
+    gfnAtomic32 dequeuePos;
+    char pad1[GFN_CACHE_LINE_SIZE - sizeof(gfnAtomic32)];
+    gfnQueuedEvent events[kGfnEventRingSize];
+} gfnEventRing;
+
+static gfnAtomic32 s_callbackDeliveryMode = gfnCallbackDeliveryImmediate;
+static gfnEventMailbox s_clientInfoMailboxes[kGfnClientInfoMailboxCount];
+static gfnEventMailbox s_networkStatusMailboxes[kGfnNetworkStatusMailboxCount];
+static gfnEventMailbox s_qualityAdviceMailbox;
+static gfnEventRing s_eventRing;
+static gfnAtomic32 s_eventsDropped = 0;
+static gfnMutex s_eventPumpLock = GFN_MUTEX_INITIALIZER;    // Serializes ring consumers
+static gfnAtomic32 s_eventSignaled = 0;                     // Set while the event handle is signaled
+static gfnMutex s_eventHandleLock = GFN_MUTEX_INITIALIZER;
+// Created on first request and kept for the life of the process, since the application may keep it in
+// its wait set across a shutdown and a new initialization
+#ifdef _WIN32
+static gfnAtomicPtr s_eventHandle = NULL;
+#elif __linux__
+static gfnAtomic32 s_eventHandle = -1;
+#endif
+
+static bool gfnIsCallbackDeliveryQueued(void)
+{
+    return gfnAtomicLoadRelaxed32(&s_callbackDeliveryMode) == gfnCallbackDeliveryQueued;
+}
+
+// Events are only queued while some context has a callback for them, so nothing is left behind once
+// the slots are reset at shutdown
+static bool gfnHasCallback(gfnCallbackKind kind)
+{
+    GfnSdkContext context;
+    int count = gfnAtomicLoadAcquire32(&s_contextCount);
+    int i;
+
+    if (gfnAtomicLoadAcquirePtr(&g_callbackSlots[kind].fnCallback) != NULL)
+    {
+        return true;
     }
-    else
+    // Contexts are only freed once no trampoline is scanning the table
+    gfnAtomicAdd32(&s_callbackDispatchers, 1);
+    for (i = 0; i < count; i++)
     {
+        context = (GfnSdkContext)gfnAtomicLoadAcquirePtr(&s_contexts[i]);
+        if (context != NULL && gfnAtomicLoadAcquirePtr(&context->callbackSlots[kind].fnCallback) != NULL)
+        {
+            break;
+        }
+    }
+    gfnAtomicAdd32(&s_callbackDispatchers, -1);
+    return i < count;
+}
 
-        GFN_SDK_LOG("Initializing the GfnSdk");
-        // For security reasons, it is preferred to check the digital signature before loading the DLL.
-        // Such code is not provided here to reduce code complexity and library size, and in favor of
-        // any internal libraries built for this purpose.
-        g_gfnSdkModule = gfnLoadLibrary(sdkLibraryPath);
-        if (g_gfnSdkModule == NULL)
+// Signals the event handle, if the application has asked for one. Only the first event after a pump
+// makes the system call.
+static void gfnSignalEventHandle(void)
+{
+    if (gfnAtomicExchange32(&s_eventSignaled, 1) != 0)
+    {
+        return;
+    }
+#ifdef _WIN32
+    {
+        HANDLE handle = (HANDLE)gfnAtomicLoadAcquirePtr(&s_eventHandle);
+        if (handle != NULL)
         {
-            clientStatus = gfnClientLibraryNotFound;
+            SetEvent(handle);
+        }
+    }
+#elif __linux__
+    {
+        int fd = gfnAtomicLoadAcquire32(&s_eventHandle);
+        uint64_t one = 1;
+        if (fd >= 0 && write(fd, &one, sizeof(one)) < 0)
+        {
+            // The counter is already non-zero, which is all a waiter needs
+        }
+    }
+#endif
+}
+
+// Clears the event handle before the queue is drained, so events queued during the drain signal it again
+static void gfnResetEventHandle(void)
+{
+    gfnAtomicExchange32(&s_eventSignaled, 0);
 #ifdef _WIN32
-            DWORD lastError = GetLastError();
-            if (lastError == CRYPT_E_NO_MATCH)
-            {
-                GFN_SDK_LOG("ERROR: GFN library failed to load due to invalid signature");
-                clientStatus = gfnBinarySignatureInvalid;
-            }
+    {
+        HANDLE handle = (HANDLE)gfnAtomicLoadAcquirePtr(&s_eventHandle);
+        if (handle != NULL)
+        {
+            ResetEvent(handle);
+        }
+    }
 #elif __linux__
-            GFN_SDK_LOG("GFN client library is present but unable to be loaded! dlerror=%s", dlerror());
+    {
+        int fd = gfnAtomicLoadAcquire32(&s_eventHandle);
+        uint64_t count;
+        if (fd >= 0 && read(fd, &count, sizeof(count)) < 0)
+        {
+            // Nothing was signaled
+        }
+    }
 #endif
+}
+
+
+// Stores the newest value of a coalesced update. Returns true if the mailbox already held an
+// undelivered value, which this one replaced.
+static bool gfnPostToMailbox(gfnEventMailbox* mailbox, void const* data, size_t size)
+{
+    int32_t sequence;
+
+    // Writers are serialized by claiming the odd sequence
+    for (;;)
+    {
+        sequence = gfnAtomicLoadRelaxed32(&mailbox->sequence);
+        if ((sequence & 1) == 0 && gfnAtomicCompareExchange32(&mailbox->sequence, sequence, sequence + 1) == sequence)
+        {
+            break;
         }
-        else
+        gfnCpuRelax();
+    }
+    memcpy(&mailbox->data, data, size);
+    gfnAtomicStoreRelease32(&mailbox->sequence, sequence + 2);
+    return gfnAtomicLoadAcquire32(&mailbox->delivered) != sequence;
+}
+
+// Takes the undelivered value out of a mailbox. Returns false if there is none. Consumers are
+// serialized by s_eventPumpLock.
+static bool gfnTakeFromMailbox(gfnEventMailbox* mailbox, void* data, size_t size)
+{
+    int32_t sequence;
+
+    for (;;)
+    {
+        sequence = gfnAtomicLoad32(&mailbox->sequence);
+        if (sequence == gfnAtomicLoadRelaxed32(&mailbox->delivered))
+        {
+            return false;
+        }
+        if ((sequence & 1) == 0)
         {
-            fnGfnInitializeRuntimeSdk = (gfnInitializeRuntimeSdkFn)gfnGetSymbol(g_gfnSdkModule, "gfnInitializeRuntimeSdk");
-            if (fnGfnInitializeRuntimeSdk == NULL)
+            memcpy(data, &mailbox->data, size);
+            // Only the value that was copied is marked delivered, so a newer one stays pending
+            if (gfnAtomicLoad32(&mailbox->sequence) == sequence)
             {
-                clientStatus = gfnAPINotFound;
+                gfnAtomicStoreRelease32(&mailbox->delivered, sequence);
+                return true;
             }
-            else
+        }
+        gfnCpuRelax();
+    }
+}
+
+static bool gfnPushEvent(gfnQueuedEvent const* event)
+{
+    gfnQueuedEvent* cell;
+    int32_t pos = gfnAtomicLoadRelaxed32(&s_eventRing.enqueuePos);
+    int32_t diff;
+
+    for (;;)
+    {
+        cell = &s_eventRing.events[pos & (kGfnEventRingSize - 1)];
+        diff = gfnAtomicLoadAcquire32(&cell->sequence) + (pos & (kGfnEventRingSize - 1)) - pos;
+        if (diff == 0)
+        {
+            if (gfnAtomicCompareExchange32(&s_eventRing.enqueuePos, pos, pos + 1) == pos)
             {
-                clientStatus = (fnGfnInitializeRuntimeSdk)(language);
+                break;
             }
         }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        pos = gfnAtomicLoadRelaxed32(&s_eventRing.enqueuePos);
     }
-    // The gfnClientLibraryNotFound error means client library was not present.
-    // This is allowed in the GFN cloud environment for robustness reasons as all API
-    // calls are deferred to the cloud library, although this is not a recommended use case.
-    // Any other error, including presence of a client library that couldn't be validated, is fatal.
-    if (GFNSDK_FAILED(clientStatus) && clientStatus != gfnClientLibraryNotFound)
+    cell->kind = event->kind;
+    cell->data = event->data;
+    gfnAtomicStoreRelease32(&cell->sequence, pos + 1 - (pos & (kGfnEventRingSize - 1)));
+    return true;
+}
+
+// Removes the oldest event from the ring. Must be called with s_eventPumpLock held.
+static bool gfnPopEvent(gfnQueuedEvent* event)
+{
+    int32_t pos = gfnAtomicLoadRelaxed32(&s_eventRing.dequeuePos);
+    gfnQueuedEvent* cell = &s_eventRing.events[pos & (kGfnEventRingSize - 1)];
+
+    if (gfnAtomicLoadAcquire32(&cell->sequence) + (pos & (kGfnEventRingSize - 1)) - (pos + 1) < 0)
     {
-        GFN_SDK_LOG("Client SDK library init failed: %d", clientStatus);
-        GfnShutdownSdk();
-        return clientStatus;
+        return false;
     }
+    event->kind = cell->kind;
+    event->data = cell->data;
+    gfnAtomicStoreRelease32(&cell->sequence, pos + kGfnEventRingSize - (pos & (kGfnEventRingSize - 1)));
+    gfnAtomicStoreRelease32(&s_eventRing.dequeuePos, pos + 1);
+    return true;
+}
 
-    // With the client library loaded attempt to load the cloud Sdk library if available (inside GFN only) in order to use it
-    // directly for cloud API calls.
-    cloudStatus = gfnInitializeCloudSdk();
-    // gfnCloudLibraryNotFound is allowed, indicating that this is not running in a cloud environment.
-    // All other errors are fatal.
-    if (GFNSDK_FAILED(cloudStatus) && (cloudStatus != gfnCloudLibraryNotFound))
+static void gfnQueueEvent(gfnQueuedEvent const* event)
+{
+    if (!gfnPushEvent(event))
     {
-        GFN_SDK_LOG("Cloud library init failed: %d", cloudStatus);
-        GfnShutdownSdk();
-        return cloudStatus;
+        if (event->kind == gfnCallbackMessage)
+        {
+            free((void*)event->data.message.pchString);
+        }
+        gfnAtomicAdd32(&s_eventsDropped, 1);
+        GFN_SDK_LOG_WARNING("Event queue full, dropping event of kind %d. Is GfnPumpEvents being called?", (int)event->kind);
     }
+    gfnSignalEventHandle();
+}
 
-    // If we could find either SDK library, then this is a fatal condition.
-    if (clientStatus == gfnClientLibraryNotFound && cloudStatus == gfnCloudLibraryNotFound)
+static void gfnQueueClientInfoUpdate(GfnClientInfoUpdateData const* update)
+{
+    gfnQueuedEvent event;
+
+    if (!gfnHasCallback(gfnCallbackClientInfo))
     {
-        GFN_SDK_LOG("Failed to find any valid SDK libraries");
-        return clientStatus;
+        return;
+    }
+    if ((unsigned int)update->updateType < kGfnClientInfoMailboxCount)
+    {
+        gfnPostToMailbox(&s_clientInfoMailboxes[update->updateType], update, sizeof(*update));
+        gfnSignalEventHandle();
+        return;
     }
+    // Update types added to the SDK after this wrapper are queued without coalescing
+    event.kind = gfnCallbackClientInfo;
+    event.data.clientInfo = *update;
+    gfnQueueEvent(&event);
+}
 
-    GFN_SDK_LOG("Initialization successful");
+static void gfnQueueNetworkStatusUpdate(GfnNetworkStatusUpdateData const* update)
+{
+    gfnQueuedEvent event;
 
-    if (GFNSDK_SUCCEEDED(cloudStatus) && clientStatus == gfnClientLibraryNotFound)
+    if (!gfnHasCallback(gfnCallbackNetworkStatus))
     {
-        return gfnInitSuccessCloudOnly;
+        return;
     }
-    if (GFNSDK_SUCCEEDED(clientStatus) && cloudStatus == gfnCloudLibraryNotFound)
+    if ((unsigned int)update->updateType < kGfnNetworkStatusMailboxCount)
     {
-        return gfnInitSuccessClientOnly;
+        gfnPostToMailbox(&s_networkStatusMailboxes[update->updateType], update, sizeof(*update));
+        gfnSignalEventHandle();
+        return;
     }
+    event.kind = gfnCallbackNetworkStatus;
+    event.data.networkStatus = *update;
+    gfnQueueEvent(&event);
+}
 
-    return gfnSuccess;
+static void gfnQueueQualityAdvice(GfnQualityAdvice const* advice)
+{
+    if (!gfnHasCallback(gfnCallbackQualityAdvice))
+    {
+        return;
+    }
+    gfnPostToMailbox(&s_qualityAdviceMailbox, advice, sizeof(*advice));
+    gfnSignalEventHandle();
 }
 
-GfnRuntimeError GfnInitializeSdkFromPathA(GfnDisplayLanguage language, const char* utf8SdkLibraryPath)
+static void gfnQueueStreamStatus(GfnStreamStatus streamStatus)
 {
-    if (utf8SdkLibraryPath == NULL)
+    gfnQueuedEvent event;
+
+    if (!gfnHasCallback(gfnCallbackStreamStatus))
     {
-        GFN_SDK_LOG("Invalid SDK library path");
-        return gfnInvalidParameter;
+        return;
     }
+    event.kind = gfnCallbackStreamStatus;
+    event.data.streamStatus = streamStatus;
+    gfnQueueEvent(&event);
+}
 
-#ifdef _WIN32
-    // On windows, first convert to Unicode-16, then call the implementation.
-    size_t libPathSize = strlen(utf8SdkLibraryPath) + 1;
-    wchar_t* wSdkLibraryPath = (wchar_t*)malloc(libPathSize * sizeof(wchar_t));
-    if (!wSdkLibraryPath)
+static void gfnQueueMessage(GfnString const* message)
+{
+    gfnQueuedEvent event;
+    char* copy;
+
+    if (message == NULL || message->pchString == NULL || !gfnHasCallback(gfnCallbackMessage))
     {
-        GFN_SDK_LOG("Failed to allocate for SDK library path");
-        return gfnUnableToAllocateMemory;
+        return;
     }
-    int outSize = (int)libPathSize * sizeof(wchar_t);
-    if (!GfnUtf8ToWide(utf8SdkLibraryPath, wSdkLibraryPath, outSize))
+    copy = (char*)malloc((size_t)message->length + 1);
+    if (copy == NULL)
     {
-        GFN_SDK_LOG("Failed to convert SDK library path");
-        free(wSdkLibraryPath);
-        return gfnInternalError;
+        gfnAtomicAdd32(&s_eventsDropped, 1);
+        GFN_SDK_LOG_ERROR("Out of memory queueing a message of %u bytes, dropping it", message->length);
+        return;
     }
+    memcpy(copy, message->pchString, message->length);
+    copy[message->length] = '\0';
+    event.kind = gfnCallbackMessage;
+    event.data.message.pchString = copy;
+    event.data.message.length = message->length;
+    gfnQueueEvent(&event);
+}
 
-    GfnError status = GfnInitializeSdkFromPathDefault(language, wSdkLibraryPath);
-    free(wSdkLibraryPath);
-    return status;
-#elif __linux__
-    // On linux, this is the default encoding. Directly call the implementation.
-    return GfnInitializeSdkFromPathDefault(language, utf8SdkLibraryPath);
-#endif
+// Calls the application's callback for a queued event, if one is still registered
+static void gfnDeliverEvent(gfnQueuedEvent* event)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    for (cursor = 0; gfnNextCallback((gfnCallbackKind)event->kind, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        switch (event->kind)
+        {
+        case gfnCallbackClientInfo:
+            ((ClientInfoCallbackSig)invocation.fnCallback)(&event->data.clientInfo, invocation.pUserContext);
+            break;
+        case gfnCallbackNetworkStatus:
+            ((NetworkStatusCallbackSig)invocation.fnCallback)(&event->data.networkStatus, invocation.pUserContext);
+            break;
+        case gfnCallbackStreamStatus:
+            ((StreamStatusCallbackSig)invocation.fnCallback)(event->data.streamStatus, invocation.pUserContext);
+            break;
+        case gfnCallbackMessage:
+            ((MessageCallbackSig)invocation.fnCallback)(&event->data.message, invocation.pUserContext);
+            break;
+        case gfnCallbackQualityAdvice:
+            ((QualityAdviceCallbackSig)invocation.fnCallback)(&event->data.qualityAdvice, invocation.pUserContext);
+            break;
+        default:
+            break;
+        }
+    }
+    if (event->kind == gfnCallbackMessage)
+    {
+        free((void*)event->data.message.pchString);
+    }
+}
+
+// Takes the next event to deliver: coalesced updates first, then the ring in arrival order.
+// Must be called with s_eventPumpLock held.
+static bool gfnNextEvent(gfnQueuedEvent* event)
+{
+    unsigned int i;
+
+    for (i = 0; i < kGfnClientInfoMailboxCount; i++)
+    {
+        if (gfnTakeFromMailbox(&s_clientInfoMailboxes[i], &event->data.clientInfo, sizeof(event->data.clientInfo)))
+        {
+            event->kind = gfnCallbackClientInfo;
+            return true;
+        }
+    }
+    for (i = 0; i < kGfnNetworkStatusMailboxCount; i++)
+    {
+        if (gfnTakeFromMailbox(&s_networkStatusMailboxes[i], &event->data.networkStatus, sizeof(event->data.networkStatus)))
+        {
+            event->kind = gfnCallbackNetworkStatus;
+            return true;
+        }
+    }
+    if (gfnTakeFromMailbox(&s_qualityAdviceMailbox, &event->data.qualityAdvice, sizeof(event->data.qualityAdvice)))
+    {
+        event->kind = gfnCallbackQualityAdvice;
+        return true;
+    }
+    return gfnPopEvent(event);
+}
+
+// Drops every queued event and leaves the event handle unsignaled, but open. Called from shutdown, once
+// the trampolines can no longer run.
+static void gfnDiscardQueuedEvents(void)
+{
+    gfnQueuedEvent event;
+
+    gfnMutexLock(&s_eventPumpLock);
+    while (gfnNextEvent(&event))
+    {
+        if (event.kind == gfnCallbackMessage)
+        {
+            free((void*)event.data.message.pchString);
+        }
+    }
+    gfnResetEventHandle();
+    gfnMutexUnlock(&s_eventPumpLock);
+}
+
+GfnRuntimeError GfnSetCallbackDeliveryMode(GfnCallbackDeliveryMode mode)
+{
+    if (mode != gfnCallbackDeliveryImmediate && mode != gfnCallbackDeliveryQueued)
+    {
+        return gfnInvalidParameter;
+    }
+    gfnAtomicExchange32(&s_callbackDeliveryMode, (int32_t)mode);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnPumpEvents(unsigned int maxEvents, unsigned int budgetUs, unsigned int* eventsDelivered)
+{
+    gfnQueuedEvent event;
+    unsigned int delivered = 0;
+    uint64_t deadlineNs = 0;
+    bool more = true;
+
+    if (t_dispatchingSlot != NULL)
+    {
+        // Pumping from inside a callback would deliver events out of order
+        return gfnCallWrongEnvironment;
+    }
+    if (budgetUs != 0)
+    {
+        deadlineNs = gfnGetMonotonicNs() + (uint64_t)budgetUs * 1000;
+    }
+
+    gfnMutexLock(&s_eventPumpLock);
+    gfnResetEventHandle();
+    while (maxEvents == 0 || delivered < maxEvents)
+    {
+        more = gfnNextEvent(&event);
+        if (!more)
+        {
+            break;
+        }
+        gfnDeliverEvent(&event);
+        delivered++;
+        if (deadlineNs != 0 && gfnGetMonotonicNs() >= deadlineNs)
+        {
+            break;
+        }
+    }
+    gfnMutexUnlock(&s_eventPumpLock);
+
+    if (more)
+    {
+        // Stopped early; keep the handle signaled so the application's wait loop comes back for the rest
+        gfnSignalEventHandle();
+    }
+    if (eventsDelivered != NULL)
+    {
+        *eventsDelivered = delivered;
+    }
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnGetEventHandle(GfnEventHandle* eventHandle)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(eventHandle);
+    gfnMutexLock(&s_eventHandleLock);
+#ifdef _WIN32
+    if (gfnAtomicLoadAcquirePtr(&s_eventHandle) == NULL)
+    {
+        HANDLE handle = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (handle == NULL)
+        {
+            GFN_SDK_LOG_ERROR("CreateEvent failed: %d", (int)GetLastError());
+            status = gfnInternalError;
+        }
+        gfnAtomicStoreReleasePtr(&s_eventHandle, handle);
+    }
+    *eventHandle = (HANDLE)gfnAtomicLoadAcquirePtr(&s_eventHandle);
+#elif __linux__
+    if (gfnAtomicLoadAcquire32(&s_eventHandle) < 0)
+    {
+        int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0)
+        {
+            GFN_SDK_LOG_ERROR("eventfd failed: %d", errno);
+            status = gfnInternalError;
+        }
+        gfnAtomicStoreRelease32(&s_eventHandle, fd);
+    }
+    *eventHandle = gfnAtomicLoadAcquire32(&s_eventHandle);
+#endif
+    if (GFNSDK_SUCCEEDED(status) && gfnAtomicExchange32(&s_eventSignaled, 0) != 0)
+    {
+        // Events were queued before the handle existed
+        gfnSignalEventHandle();
+    }
+    gfnMutexUnlock(&s_eventHandleLock);
+    return status;
+}
+
+// Slow path of the cloud environment check: asks the cloud library and caches the answer in the state word
+static GfnRuntimeError gfnResolveCloudEnvironment(int32_t state, bool bUseCache)
+{
+    int32_t env = state & GFN_STATE_ENV_MASK;
+
+    if (env == IsCloud_Unknown || !bUseCache)
+    {
+        if ((state & (GFN_STATE_CLIENT_LIVE | GFN_STATE_CLOUD_LIVE)) == 0)
+        {
+            return gfnAPINotInit;
+        }
+        if (!gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))
+        {
+            GFN_SDK_LOG_WARNING("Cannot call cloud function: Wrong environment");
+            return gfnCallWrongEnvironment;
+        }
+        if (!g_pCloudLibrary->IsRunningInCloud)
+        {
+            gfnLeaveLibraryCall();
+            GFN_SDK_LOG_WARNING("Cannot call cloud function: Wrong environment");
+            return gfnCallWrongEnvironment;
+        }
+        env = ((bool)g_pCloudLibrary->IsRunningInCloud()) ? IsCloud_Yes : IsCloud_No;
+        gfnLeaveLibraryCall();
+
+        // Only cache the answer if the libraries were not reloaded or unloaded in the meantime
+        gfnAtomicCompareExchange32(&g_sdkState, state, (state & ~GFN_STATE_ENV_MASK) | env);
+    }
+    if (env == IsCloud_No)
+    {
+        GFN_SDK_LOG_WARNING("Cannot call cloud function: Wrong environment");
+        return gfnCallWrongEnvironment;
+    }
+    return gfnSuccess;
+}
+
+static inline GfnRuntimeError gfnCheckCloudEnvironment(bool bUseCache)
+{
+    int32_t state = gfnAtomicLoadAcquire32(&g_sdkState);
+    if (bUseCache && (state & GFN_STATE_ENV_MASK) == IsCloud_Yes)
+    {
+        return gfnSuccess;
+    }
+    return gfnResolveCloudEnvironment(state, bUseCache);
+}
+
+#define CHECK_CLOUD_ENVIRONMENT_IMPL(bUseCache)                                             \
+    {                                                                                       \
+        GfnRuntimeError envStatus = gfnCheckCloudEnvironment(bUseCache);                    \
+        if (envStatus != gfnSuccess)                                                        \
+        {                                                                                   \
+            return envStatus;                                                               \
+        }                                                                                   \
+    }
+#define CHECK_CLOUD_ENVIRONMENT() CHECK_CLOUD_ENVIRONMENT_IMPL(true)
+#define CALL_CLOUD_LIBRARY(status, Fn, ...)                                                 \
+    {                                                                                       \
+        status = gfnAPINotInit;                                                             \
+        if (gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))                                      \
+        {                                                                                   \
+            if (g_pCloudLibrary->Fn == NULL)                                                \
+            {                                                                               \
+                GFN_SDK_LOG_WARNING("Cannot call cloud function %s: API not found", #Fn);   \
+                status = gfnAPINotFound;                                                    \
+            }                                                                               \
+            else                                                                            \
+            {                                                                               \
+                GFN_TIMED_STATUS_CALL(status, gfnApiCloud##Fn,                              \
+                    gfnTranslateCloudStatus(g_pCloudLibrary->Fn(__VA_ARGS__)));             \
+            }                                                                               \
+            gfnLeaveLibraryCall();                                                          \
+        }                                                                                   \
+    }
+#define DELEGATE_TO_CLOUD_LIBRARY(Fn, ...)                                                  \
+    {                                                                                       \
+        GfnRuntimeError delegateStatus;                                                     \
+        CALL_CLOUD_LIBRARY(delegateStatus, Fn, __VA_ARGS__);                                \
+        return delegateStatus;                                                              \
+    }
+#define CALL_CLIENT_LIBRARY(status, Fn, ...)                                                \
+    {                                                                                       \
+        status = gfnAPINotInit;                                                             \
+        if (gfnEnterLibraryCall(GFN_STATE_CLIENT_LIVE))                                     \
+        {                                                                                   \
+            if (g_clientLibrary.Fn == NULL)                                                 \
+            {                                                                               \
+                status = gfnAPINotFound;                                                    \
+            }                                                                               \
+            else                                                                            \
+            {                                                                               \
+                GFN_TIMED_STATUS_CALL(status, gfnApiClient##Fn,                             \
+                    g_clientLibrary.Fn(__VA_ARGS__));                                       \
+            }                                                                               \
+            gfnLeaveLibraryCall();                                                          \
+        }                                                                                   \
+    }
+#define DELEGATE_TO_CLIENT_LIBRARY(Fn, ...)                                                 \
+    {                                                                                       \
+        GfnRuntimeError delegateStatus;                                                     \
+        CALL_CLIENT_LIBRARY(delegateStatus, Fn, __VA_ARGS__);                               \
+        return delegateStatus;                                                              \
+    }
+
+static GfnRuntimeError gfnInitializeSdk(GfnDisplayLanguage language)
+{
+    // If "client" SDK is already initialized, then we're good to go.
+    // "server" SDK may or may not be initialized depending on mode.
+    GfnRuntimeError clientStatus = gfnSuccess;
+    GfnRuntimeError err = gfnSuccess;
+    uint64_t phaseStartNs;
+
+    if (!g_LoggingInitialized)
+    {
+        GFN_SDK_INIT_LOGGING();
+        g_LoggingInitialized = true;
+    }
+
+
+    if (g_gfnSdkModule != NULL)
+    {
+        GFN_SDK_LOG("Client library already initialized, no need to initialize again");
+    }
+    else
+    {
+        CHAR_TYPE* filename = (CHAR_TYPE*)malloc(sizeof(CHAR_TYPE) * PLATFORM_MAX_PATH);
+        if (!filename)
+        {
+            return gfnInternalError;
+        }
+
+        phaseStartNs = gfnGetMonotonicNs();
+        err = gfnGetDefaultClientLibraryPath(filename);
+        gfnRecordInitPhase(gfnInitPhasePathResolution, phaseStartNs);
+        if (GFNSDK_FAILED(err))
+        {
+            free(filename);
+            return err;
+        }
+
+        clientStatus = GfnInitializeSdkFromPathDefault(language, filename);
+        free(filename);
+    }
+
+    if (GFNSDK_FAILED(clientStatus))
+    {
+        GFN_SDK_LOG_ERROR("Initialization failed: %d", clientStatus);
+        GfnShutdownSdk();
+    }
+
+    return clientStatus;
+}
+
+GfnRuntimeError GfnInitializeSdk(GfnDisplayLanguage language)
+{
+    uint64_t startNs;
+    GfnRuntimeError status;
+
+    gfnWaitForPendingInitialization();
+    startNs = gfnBeginInitTimings();
+    status = gfnInitializeSdk(language);
+    gfnEndInitTimings(startNs, status);
+    return status;
+}
+
+static GfnRuntimeError gfnInitializeSdkFromPath(GfnDisplayLanguage language, const CHAR_TYPE* sdkLibraryPath)
+{
+    GfnRuntimeError clientStatus = gfnSuccess;
+    GfnRuntimeError cloudStatus = gfnSuccess;
+    const CHAR_TYPE* filename = NULL;
+    uint64_t phaseStartNs;
+
+    // If "client" library is already initialized, then we're good to go.
+    if (g_gfnSdkModule != NULL)
+    {
+        GFN_SDK_LOG("Client library already initialized, no need to initialize again");
+        return gfnSuccess;
+    }
+
+    if (!g_LoggingInitialized)
+    {
+        GFN_SDK_INIT_LOGGING();
+        g_LoggingInitialized = true;
+    }
+
+    phaseStartNs = gfnGetMonotonicNs();
+    filename = gfnGetFilenameFromPath(sdkLibraryPath);
+    if (!filename || !gfnPathEqual(filename, GFN_CLIENT_SHARED_LIBRARY))
+    {
+        GFN_SDK_LOG_ERROR("Invalid SDK library name");
+        return gfnInvalidParameter;
+    }
+
+    if (!gfnPathExists(sdkLibraryPath))
+    {
+        gfnRecordInitPhase(gfnInitPhasePathResolution, phaseStartNs);
+        clientStatus = gfnClientLibraryNotFound;
+    }
+    else
+    {
+
+        gfnRecordInitPhase(gfnInitPhasePathResolution, phaseStartNs);
+        GFN_SDK_LOG("Initializing the GfnSdk");
+        // For security reasons, it is preferred to check the digital signature before loading the DLL.
+        // Such code is not provided here to reduce code complexity and library size, and in favor of
+        // any internal libraries built for this purpose.
+        phaseStartNs = gfnGetMonotonicNs();
+        g_gfnSdkModule = gfnLoadLibrary(sdkLibraryPath);
+        gfnRecordInitPhase(gfnInitPhaseClientLoad, phaseStartNs);
+        if (g_gfnSdkModule == NULL)
+        {
+            clientStatus = gfnClientLibraryNotFound;
+#ifdef _WIN32
+            DWORD lastError = GetLastError();
+            if (lastError == CRYPT_E_NO_MATCH)
+            {
+                GFN_SDK_LOG_ERROR("ERROR: GFN library failed to load due to invalid signature");
+                clientStatus = gfnBinarySignatureInvalid;
+            }
+#elif __linux__
+            GFN_SDK_LOG_ERROR("GFN client library is present but unable to be loaded! dlerror=%s", dlerror());
+#endif
+        }
+        else
+        {
+            // Resolve every client export once so API calls never need a symbol lookup
+            g_clientLibrary.handle = g_gfnSdkModule;
+            phaseStartNs = gfnGetMonotonicNs();
+            gfnBindClientLibrary(&g_clientLibrary);
+            gfnRecordInitPhase(gfnInitPhaseSymbolBinding, phaseStartNs);
+            if (g_clientLibrary.InitializeRuntimeSdk == NULL)
+            {
+                clientStatus = gfnAPINotFound;
+            }
+            else
+            {
+                phaseStartNs = gfnGetMonotonicNs();
+                clientStatus = g_clientLibrary.InitializeRuntimeSdk(language);
+                gfnRecordInitPhase(gfnInitPhaseClientInit, phaseStartNs);
+            }
+            if (GFNSDK_SUCCEEDED(clientStatus))
+            {
+                gfnAtomicOr32(&g_sdkState, GFN_STATE_CLIENT_LIVE);
+            }
+        }
+    }
+    // The gfnClientLibraryNotFound error means client library was not present.
+    // This is allowed in the GFN cloud environment for robustness reasons as all API
+    // calls are deferred to the cloud library, although this is not a recommended use case.
+    // Any other error, including presence of a client library that couldn't be validated, is fatal.
+    if (GFNSDK_FAILED(clientStatus) && clientStatus != gfnClientLibraryNotFound)
+    {
+        GFN_SDK_LOG_ERROR("Client SDK library init failed: %d", clientStatus);
+        GfnShutdownSdk();
+        return clientStatus;
+    }
+
+    // With the client library loaded attempt to load the cloud Sdk library if available (inside GFN only) in order to use it
+    // directly for cloud API calls.
+    cloudStatus = gfnInitializeCloudSdk();
+    // gfnCloudLibraryNotFound is allowed, indicating that this is not running in a cloud environment.
+    // All other errors are fatal.
+    if (GFNSDK_FAILED(cloudStatus) && (cloudStatus != gfnCloudLibraryNotFound))
+    {
+        GFN_SDK_LOG_ERROR("Cloud library init failed: %d", cloudStatus);
+        GfnShutdownSdk();
+        return cloudStatus;
+    }
+
+    // If we could find either SDK library, then this is a fatal condition.
+    if (clientStatus == gfnClientLibraryNotFound && cloudStatus == gfnCloudLibraryNotFound)
+    {
+        GFN_SDK_LOG_ERROR("Failed to find any valid SDK libraries");
+        return clientStatus;
+    }
+
+    GFN_SDK_LOG("Initialization successful");
+
+    if (GFNSDK_SUCCEEDED(cloudStatus) && clientStatus == gfnClientLibraryNotFound)
+    {
+        return gfnInitSuccessCloudOnly;
+    }
+    if (GFNSDK_SUCCEEDED(clientStatus) && cloudStatus == gfnCloudLibraryNotFound)
+    {
+        return gfnInitSuccessClientOnly;
+    }
+
+    return gfnSuccess;
+}
+
+// On WIN32, this accepts a wide char string.
+// On all other platforms, this accepts a UTF-8 string.
+GfnRuntimeError GfnInitializeSdkFromPathDefault(GfnDisplayLanguage language, const CHAR_TYPE* sdkLibraryPath)
+{
+    uint64_t startNs;
+    GfnRuntimeError status;
+
+    gfnWaitForPendingInitialization();
+    startNs = gfnBeginInitTimings();
+    status = gfnInitializeSdkFromPath(language, sdkLibraryPath);
+    gfnEndInitTimings(startNs, status);
+    return status;
+}
+
+GfnRuntimeError GfnInitializeSdkFromPathA(GfnDisplayLanguage language, const char* utf8SdkLibraryPath)
+{
+    if (utf8SdkLibraryPath == NULL)
+    {
+        GFN_SDK_LOG_ERROR("Invalid SDK library path");
+        return gfnInvalidParameter;
+    }
+
+#ifdef _WIN32
+    // On windows, first convert to Unicode-16, then call the implementation.
+    size_t libPathSize = strlen(utf8SdkLibraryPath) + 1;
+    wchar_t* wSdkLibraryPath = (wchar_t*)malloc(libPathSize * sizeof(wchar_t));
+    if (!wSdkLibraryPath)
+    {
+        GFN_SDK_LOG_ERROR("Failed to allocate for SDK library path");
+        return gfnUnableToAllocateMemory;
+    }
+    int outSize = (int)libPathSize * sizeof(wchar_t);
+    if (!GfnUtf8ToWide(utf8SdkLibraryPath, wSdkLibraryPath, outSize))
+    {
+        GFN_SDK_LOG_ERROR("Failed to convert SDK library path");
+        free(wSdkLibraryPath);
+        return gfnInternalError;
+    }
+
+    GfnError status = GfnInitializeSdkFromPathDefault(language, wSdkLibraryPath);
+    free(wSdkLibraryPath);
+    return status;
+#elif __linux__
+    // On linux, this is the default encoding. Directly call the implementation.
+    return GfnInitializeSdkFromPathDefault(language, utf8SdkLibraryPath);
+#endif
+}
+
+GfnRuntimeError GfnInitializeSdkFromPathW(GfnDisplayLanguage language, const wchar_t* wSdkLibraryPath)
+{
+    if (wSdkLibraryPath == NULL)
+    {
+        GFN_SDK_LOG_ERROR("Invalid SDK library path");
+        return gfnInvalidParameter;
+    }
+
+#ifdef _WIN32
+    // On windows, this is the default encoding. Directly call the implementation.
+    return GfnInitializeSdkFromPathDefault(language, wSdkLibraryPath);
+#elif __linux__
+    (void)language;
+    GFN_SDK_LOG_WARNING("GfnInitializeSdkFromPathW is unsupported on linux");
+    return gfnInvalidParameter;
+#endif
+}
+
+// Asynchronous initialization. At most one initialization runs in the background at a time; other
+// initialization and shutdown calls wait for it to complete first.
+struct GfnInitOperation
+{
+    gfnThread thread;
+    GfnDisplayLanguage language;
+    InitCompleteCallbackSig callback;
+    void* pUserContext;
+    bool complete;                  // Guarded by s_initOperationLock
+    GfnRuntimeError result;
+};
+
+static GfnInitHandle s_pendingInit = NULL;
+static gfnMutex s_initOperationLock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_initOperationDone = GFN_CONDVAR_INITIALIZER;
+static GFN_THREAD_LOCAL bool t_initWorker = false;
+
+static GFN_THREAD_PROC gfnInitializeSdkThread(void* arg)
+{
+    GfnInitHandle operation = (GfnInitHandle)arg;
+    GfnRuntimeError result;
+    uint64_t startNs;
+
+    t_initWorker = true;
+    startNs = gfnBeginInitTimings();
+    result = gfnInitializeSdk(operation->language);
+    gfnEndInitTimings(startNs, result);
+
+    gfnMutexLock(&s_initOperationLock);
+    operation->result = result;
+    operation->complete = true;
+    s_pendingInit = NULL;
+    gfnCondVarBroadcast(&s_initOperationDone);
+    gfnMutexUnlock(&s_initOperationLock);
+
+    if (operation->callback != NULL)
+    {
+        operation->callback(result, operation->pUserContext);
+    }
+    return GFN_THREAD_RETURN;
+}
+
+// Waits for a background initialization to complete, unless called from that initialization. Must be
+// called with s_initOperationLock held, so the caller can start the next one before another thread does.
+static void gfnWaitForPendingInitializationLocked(void)
+{
+    if (t_initWorker)
+    {
+        return;
+    }
+    while (s_pendingInit != NULL)
+    {
+        gfnCondVarWaitForever(&s_initOperationDone, &s_initOperationLock);
+    }
+}
+
+static void gfnWaitForPendingInitialization(void)
+{
+    gfnMutexLock(&s_initOperationLock);
+    gfnWaitForPendingInitializationLocked();
+    gfnMutexUnlock(&s_initOperationLock);
+}
+
+GfnRuntimeError GfnInitializeSdkAsync(GfnDisplayLanguage language, InitCompleteCallbackSig callback, void* pUserContext, GfnInitHandle* handle)
+{
+    GfnInitHandle operation;
+
+    CHECK_NULL_PARAM(handle);
+    *handle = NULL;
+    operation = (GfnInitHandle)calloc(1, sizeof(*operation));
+    if (operation == NULL)
+    {
+        return gfnUnableToAllocateMemory;
+    }
+    operation->language = language;
+    operation->callback = callback;
+    operation->pUserContext = pUserContext;
+
+    gfnMutexLock(&s_initOperationLock);
+    gfnWaitForPendingInitializationLocked();
+    s_pendingInit = operation;
+    if (!gfnThreadCreate(&operation->thread, gfnInitializeSdkThread, operation))
+    {
+        s_pendingInit = NULL;
+        gfnMutexUnlock(&s_initOperationLock);
+        free(operation);
+        return gfnInternalError;
+    }
+    gfnMutexUnlock(&s_initOperationLock);
+    *handle = operation;
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnWaitForInitialization(GfnInitHandle handle, unsigned int timeoutMs, GfnRuntimeError* result)
+{
+    uint64_t deadlineNs;
+    uint64_t nowNs;
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(handle);
+    deadlineNs = gfnGetMonotonicNs() + (uint64_t)timeoutMs * 1000000;
+    gfnMutexLock(&s_initOperationLock);
+    while (!handle->complete)
+    {
+        if (timeoutMs == GFN_INIT_WAIT_INFINITE)
+        {
+            gfnCondVarWaitForever(&s_initOperationDone, &s_initOperationLock);
+            continue;
+        }
+        nowNs = gfnGetMonotonicNs();
+        if (nowNs >= deadlineNs)
+        {
+            status = gfnTimedOut;
+            break;
+        }
+        gfnCondVarWait(&s_initOperationDone, &s_initOperationLock, (unsigned int)((deadlineNs - nowNs + 999999) / 1000000));
+    }
+    if (status == gfnSuccess && result != NULL)
+    {
+        *result = handle->result;
+    }
+    gfnMutexUnlock(&s_initOperationLock);
+    return status;
+}
+
+GfnRuntimeError GfnPollInitialization(GfnInitHandle handle, bool* complete, GfnRuntimeError* result)
+{
+    CHECK_NULL_PARAM(handle);
+    CHECK_NULL_PARAM(complete);
+    gfnMutexLock(&s_initOperationLock);
+    *complete = handle->complete;
+    if (handle->complete && result != NULL)
+    {
+        *result = handle->result;
+    }
+    gfnMutexUnlock(&s_initOperationLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnReleaseInitHandle(GfnInitHandle handle)
+{
+    CHECK_NULL_PARAM(handle);
+    if (t_initWorker)
+    {
+        // The worker thread cannot join itself, for example when released from the completion callback
+        return gfnCallWrongEnvironment;
+    }
+    gfnThreadJoin(handle->thread);
+    free(handle);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnGetInitTimings(GfnInitTimings* timings)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(timings);
+    gfnMutexLock(&s_initTimingsLock);
+    if (!s_initTimingsValid)
+    {
+        status = gfnNoData;
+    }
+    else
+    {
+        timings->pathResolutionUs = s_initPhaseNs[gfnInitPhasePathResolution] / 1000;
+        timings->clientLoadUs = s_initPhaseNs[gfnInitPhaseClientLoad] / 1000;
+        timings->clientInitUs = s_initPhaseNs[gfnInitPhaseClientInit] / 1000;
+        timings->cloudLoadUs = s_initPhaseNs[gfnInitPhaseCloudLoad] / 1000;
+        timings->symbolBindingUs = s_initPhaseNs[gfnInitPhaseSymbolBinding] / 1000;
+        timings->cloudInitUs = s_initPhaseNs[gfnInitPhaseCloudInit] / 1000;
+        timings->totalUs = s_initTotalNs / 1000;
+    }
+    gfnMutexUnlock(&s_initTimingsLock);
+    return status;
+}
+
+GfnRuntimeError GfnShutdownSdk(void)
+{
+    gfnWaitForPendingInitialization();
+
+    // Stop new calls from entering either library and wait for calls already in flight to return
+    gfnAtomicAnd32(&g_sdkState, ~(GFN_STATE_CLIENT_LIVE | GFN_STATE_CLOUD_LIVE | GFN_STATE_ENV_MASK));
+    gfnDrainLibraryCalls();
+
+    gfnResetSaveScheduler();
+    gfnResetSaveSnapshots();
+    gfnResetPauseController();
+    gfnResetExitOrchestrator();
+    gfnResetPrefetcher();
+    gfnShutDownCloudSdk();
+    gfnResetCallbackSlots();
+    gfnDiscardQueuedEvents();
+    gfnResetSessionSnapshot();
+    gfnResetTitleIndex();
+    gfnResetActionZones();
+    gfnResetNetworkStats();
+    gfnResetQualityAdvisor();
+    if (s_traceFilePath[0] != 0)
+    {
+        GfnTraceDump(s_traceFilePath);
+    }
+
+    if (g_gfnSdkModule == NULL)
+    {
+        // Not initialized, no need to shutdown
+        return gfnSuccess;
+    }
+
+    if (g_clientLibrary.ShutdownRuntimeSdk == NULL)
+    {
+        return gfnAPINotFound;
+    }
+
+    g_clientLibrary.ShutdownRuntimeSdk();
+
+    gfnFreeLibrary(g_gfnSdkModule);
+    g_gfnSdkModule = NULL;
+    memset(&g_clientLibrary, 0, sizeof(g_clientLibrary));
+
+    GFN_SDK_DEINIT_LOGGING();
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnIsRunningInCloud(bool* runningInCloud)
+{
+    CHECK_NULL_PARAM(runningInCloud);
+    *runningInCloud = false;
+
+    if ((gfnAtomicLoadAcquire32(&g_sdkState) & (GFN_STATE_CLIENT_LIVE | GFN_STATE_CLOUD_LIVE)) == 0)
+    {
+        return gfnAPINotInit;
+    }
+
+    if (!gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))
+    {
+        GFN_SDK_LOG_DEBUG("No cloud library present, call succeeds");
+        return gfnSuccess;
+    }
+
+    if (g_pCloudLibrary->IsRunningInCloud == NULL)
+    {
+        gfnLeaveLibraryCall();
+        GFN_SDK_LOG_WARNING("API Not Found");
+        return gfnAPINotFound;
+    }
+
+    GFN_TIMED_CALL(*runningInCloud, gfnApiCloudIsRunningInCloud, (bool)g_pCloudLibrary->IsRunningInCloud());
+    gfnLeaveLibraryCall();
+
+    GFN_SDK_LOG_DEBUG("Success: %d", *runningInCloud);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnIsRunningInCloudSecure(GfnIsRunningInCloudAssurance* assurance)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(assurance);
+    *assurance = gfnNotCloud;
+
+    if ((gfnAtomicLoadAcquire32(&g_sdkState) & (GFN_STATE_CLIENT_LIVE | GFN_STATE_CLOUD_LIVE)) == 0)
+    {
+        return gfnAPINotInit;
+    }
+
+#ifdef _WIN32
+    if (wcslen(g_cloudLibraryPath) == 0)
+#elif __linux__
+    if (strlen(g_cloudLibraryPath) == 0)
+#endif
+    {
+        GFN_SDK_LOG("Cloud library path not defined, which denotes an API call without Initialize succeeding, treating as not in cloud");
+        return gfnSuccess;
+    }
+
+#ifdef _WIN32
+    if (gfnCheckLibraryGfnSignatureW(g_cloudLibraryPath) == FALSE)
+    {
+        GFN_SDK_LOG("Cloud library path does not have valid GFN signing, treating as not in cloud");
+        return gfnSuccess;
+    }
+#endif
+
+    if (!gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))
+    {
+        GFN_SDK_LOG_DEBUG("No cloud library present, call succeeds");
+        return gfnSuccess;
+    }
+
+    if (g_pCloudLibrary->IsRunningInCloudSecure == NULL)
+    {
+        gfnLeaveLibraryCall();
+        GFN_SDK_LOG_WARNING("API Not Found");
+        return gfnAPINotFound;
+    }
+
+    GFN_TIMED_STATUS_CALL(status, gfnApiCloudIsRunningInCloudSecure,
+        gfnTranslateCloudStatus(g_pCloudLibrary->IsRunningInCloudSecure(assurance)));
+    gfnLeaveLibraryCall();
+    GFN_SDK_LOG_DEBUG("status=%d assurance=%d", status, *assurance);
+
+    return status;
+}
+
+// Request scheduler for the cloud APIs that the SDK throttles. Each scheduled request type has:
+// - single-flight: a caller arriving while an identical request is in flight waits for it and shares its
+//   result instead of calling the library again;
+// - a client-side token bucket, so bursts are spread out before they reach the SDK's own limit;
+// - retries of throttled calls with jittered exponential backoff, bounded by a deadline.
+// Strings handed out by scheduled requests are copies owned by the wrapper; GfnFree recognizes and
+// releases them.
+
+// Result of one library call, shared with every caller that joined it
+typedef struct gfnRequestResult
+{
+    GfnRuntimeError status;
+    bool isCloudEnvironment;
+    char* data;                     // Copy of the returned string or attestation data, or NULL
+    unsigned int length;
+} gfnRequestResult;
+
+typedef GfnRuntimeError(*gfnRequestExecuteFn)(void const* request, gfnRequestResult* result);
+
+// A library call in progress, joined by the requests with the same key
+typedef struct gfnRequestFlight
+{
+    struct gfnRequestFlight* next;
+    bool hasKey;
+    char* key;
+    unsigned int keyLength;
+    bool completed;
+    unsigned int joined;                // Requests still to copy the result; the last one frees the flight
+    gfnRequestResult result;
+} gfnRequestFlight;
+
+typedef struct gfnRequestScheduler
+{
+    bool configured;                    // Fields up to the counters are guarded by s_requestSchedulerLock
+    GfnRequestSchedulerConfig config;
+    double tokens;                      // Token bucket
+    uint64_t refilledNs;
+    gfnRequestFlight* flights;          // Calls in progress, one per key
+    gfnAtomic64 requests;
+    gfnAtomic64 libraryCalls;
+    gfnAtomic64 deduplicated;
+    gfnAtomic64 throttled;
+    gfnAtomic64 retries;
+    gfnAtomic64 rateLimited;
+} gfnRequestScheduler;
+
+// No rate limit and a single attempt, so calls never sleep on the caller's thread until the application
+// sets a policy
+static const GfnRequestSchedulerConfig kGfnDefaultRequestSchedulerConfig = { 0, 1000, 100, 2000, 0 };
+
+// Scheduled requests are rare, so one lock covers all of them. Requests with different keys still call
+// the library concurrently, and waiters only wake when a flight of their own request completes.
+static gfnRequestScheduler s_requestSchedulers[gfnScheduledRequestCount];
+static gfnMutex s_requestSchedulerLock = GFN_MUTEX_INITIALIZER;
+// Broadcast when a flight of the request completes
+static gfnCondVar s_requestSchedulerCompleted[gfnScheduledRequestCount] =
+{
+    GFN_CONDVAR_INITIALIZER, GFN_CONDVAR_INITIALIZER, GFN_CONDVAR_INITIALIZER
+};
+
+// Wrapper-owned strings returned to the application, released through GfnFree. Their addresses are kept
+// in a fixed set so GfnFree tells them from the SDK library's strings without a lock: a string lives in
+// one of the kGfnOwnedStringProbes slots that follow its hash, and is inserted and removed with a
+// compare-exchange. When every slot a string could use is taken, it is not handed out.
+#define kGfnOwnedStringSlots 4096
+#define kGfnOwnedStringProbes 32
+
+static gfnAtomicPtr s_ownedStrings[kGfnOwnedStringSlots];
+
+static unsigned int gfnOwnedStringSlot(char const* data)
+{
+    return (unsigned int)((((uint64_t)(uintptr_t)data >> 4) * 0x9E3779B97F4A7C15ull) >> 52) & (kGfnOwnedStringSlots - 1);
+}
+
+static char const* gfnCreateOwnedString(char const* data, unsigned int length)
+{
+    char* copy = (char*)malloc((size_t)length + 1);
+    unsigned int slot;
+    unsigned int probe;
+
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    memcpy(copy, data, length);
+    copy[length] = '\0';
+    slot = gfnOwnedStringSlot(copy);
+    for (probe = 0; probe < kGfnOwnedStringProbes; probe++)
+    {
+        if (gfnAtomicCompareExchangePtr(&s_ownedStrings[(slot + probe) & (kGfnOwnedStringSlots - 1)], NULL, copy) == NULL)
+        {
+            return copy;
+        }
+    }
+    GFN_SDK_LOG_WARNING("Too many strings not released with GfnFree");
+    free(copy);
+    return NULL;
+}
+
+// Frees the string if the wrapper handed it out. Returns false if it belongs to the SDK library.
+static bool gfnReleaseOwnedString(char const* data)
+{
+    unsigned int slot = gfnOwnedStringSlot(data);
+    unsigned int probe;
+    gfnAtomicPtr* entry;
+
+    for (probe = 0; probe < kGfnOwnedStringProbes; probe++)
+    {
+        entry = &s_ownedStrings[(slot + probe) & (kGfnOwnedStringSlots - 1)];
+        if (gfnAtomicLoadAcquirePtr(entry) == (void*)data && gfnAtomicCompareExchangePtr(entry, (void*)data, NULL) == (void*)data)
+        {
+            free((void*)data);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Must be called with s_requestSchedulerLock held
+static GfnRequestSchedulerConfig const* gfnGetRequestSchedulerConfig(gfnRequestScheduler* scheduler)
+{
+    if (!scheduler->configured)
+    {
+        scheduler->config = kGfnDefaultRequestSchedulerConfig;
+        scheduler->configured = true;
+    }
+    return &scheduler->config;
+}
+
+// Takes a token from the bucket. Returns 0 on success, otherwise how long until the next token is due.
+// Must be called with s_requestSchedulerLock held.
+static uint64_t gfnTakeRequestToken(gfnRequestScheduler* scheduler, uint64_t nowNs)
+{
+    double refillNs = (double)gfnGetRequestSchedulerConfig(scheduler)->refillMs * 1000000.0;
+
+    if (scheduler->config.burst == 0)
+    {
+        return 0;
+    }
+    if (refillNs <= 0.0)
+    {
+        scheduler->tokens = (double)scheduler->config.burst;
+    }
+    else
+    {
+        scheduler->tokens += (double)(nowNs - scheduler->refilledNs) / refillNs;
+        if (scheduler->tokens > (double)scheduler->config.burst)
+        {
+            scheduler->tokens = (double)scheduler->config.burst;
+        }
+    }
+    scheduler->refilledNs = nowNs;
+    if (scheduler->tokens >= 1.0)
+    {
+        scheduler->tokens -= 1.0;
+        return 0;
+    }
+    return (uint64_t)((1.0 - scheduler->tokens) * refillNs) + 1;
+}
+
+// Returns a random delay between half and all of the backoff, so callers that were throttled together
+// do not retry together
+static unsigned int gfnJitterBackoff(unsigned int backoffMs)
+{
+    static GFN_THREAD_LOCAL uint32_t t_random = 0;
+    uint32_t x = t_random;
+
+    if (x == 0)
+    {
+        x = (uint32_t)gfnGetMonotonicNs() | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t_random = x;
+    return backoffMs / 2 + (backoffMs > 1 ? x % (backoffMs - backoffMs / 2 + 1) : 0);
+}
+
+// Calls the library within the rate limit, retrying while throttled until the deadline passes
+static GfnRuntimeError gfnExecuteScheduledRequest(gfnRequestScheduler* scheduler, gfnRequestExecuteFn execute,
+    void const* request, gfnRequestResult* result)
+{
+    GfnRequestSchedulerConfig config;
+    uint64_t startNs = gfnGetMonotonicNs();
+    uint64_t deadlineNs;
+    uint64_t nowNs;
+    uint64_t waitNs;
+    unsigned int backoffMs;
+    unsigned int delayMs;
+    GfnRuntimeError status;
+
+    gfnMutexLock(&s_requestSchedulerLock);
+    config = *gfnGetRequestSchedulerConfig(scheduler);
+    gfnMutexUnlock(&s_requestSchedulerLock);
+    deadlineNs = startNs + (uint64_t)config.deadlineMs * 1000000;
+    backoffMs = config.initialBackoffMs;
+
+    for (;;)
+    {
+        nowNs = gfnGetMonotonicNs();
+        gfnMutexLock(&s_requestSchedulerLock);
+        waitNs = gfnTakeRequestToken(scheduler, nowNs);
+        gfnMutexUnlock(&s_requestSchedulerLock);
+        if (waitNs != 0)
+        {
+            if (nowNs + waitNs > deadlineNs)
+            {
+                gfnAtomicAdd64(&scheduler->rateLimited, 1);
+                GFN_SDK_LOG_DEBUG("Request rate limit reached, not calling the SDK library");
+                result->status = gfnThrottled;
+                return gfnThrottled;
+            }
+            gfnSleepMs((unsigned int)((waitNs + 999999) / 1000000));
+            continue;
+        }
+
+        gfnAtomicAdd64(&scheduler->libraryCalls, 1);
+        status = execute(request, result);
+        if (status != gfnThrottled)
+        {
+            return status;
+        }
+        gfnAtomicAdd64(&scheduler->throttled, 1);
+
+        delayMs = gfnJitterBackoff(backoffMs);
+        nowNs = gfnGetMonotonicNs();
+        if (nowNs + (uint64_t)delayMs * 1000000 > deadlineNs)
+        {
+            GFN_SDK_LOG_DEBUG("Request throttled, retry deadline reached");
+            return status;
+        }
+        gfnAtomicAdd64(&scheduler->retries, 1);
+        GFN_SDK_LOG_DEBUG("Request throttled, retrying in %u ms", delayMs);
+        gfnSleepMs(delayMs);
+        backoffMs = (backoffMs > config.maxBackoffMs / 2) ? config.maxBackoffMs : backoffMs * 2;
+    }
+}
+
+// Copies a shared result for one caller
+static void gfnCopyRequestResult(gfnRequestResult const* shared, gfnRequestResult* result)
+{
+    *result = *shared;
+    result->data = NULL;
+    if (shared->data != NULL)
+    {
+        result->data = (char*)gfnCreateOwnedString(shared->data, shared->length);
+        if (result->data == NULL)
+        {
+            result->status = gfnInternalError;
+        }
+    }
+}
+
+// Copies the result of a completed flight for one caller, and frees the flight once every caller that
+// joined it has its copy. Must be called with s_requestSchedulerLock held.
+static void gfnLeaveRequestFlight(gfnRequestFlight* flight, gfnRequestResult* result)
+{
+    gfnCopyRequestResult(&flight->result, result);
+    if (--flight->joined == 0)
+    {
+        free(flight->result.data);
+        free(flight->key);
+        free(flight);
+    }
+}
+
+// Runs a request through the scheduler. Overlapping requests with the same key share one library call; a
+// NULL key is distinct from every non-NULL key, including an empty one. On return, result->data is a
+// wrapper-owned string for the caller to release with GfnFree.
+static GfnRuntimeError gfnScheduleRequest(GfnScheduledRequest kind, char const* key, unsigned int keyLength,
+    gfnRequestExecuteFn execute, void const* request, gfnRequestResult* result)
+{
+    gfnRequestScheduler* scheduler = &s_requestSchedulers[kind];
+    gfnRequestFlight* flight;
+    gfnRequestFlight** link;
+    gfnRequestResult fresh;
+
+    memset(result, 0, sizeof(*result));
+    gfnAtomicAdd64(&scheduler->requests, 1);
+    gfnMutexLock(&s_requestSchedulerLock);
+    for (flight = scheduler->flights; flight != NULL; flight = flight->next)
+    {
+        if (flight->hasKey == (key != NULL) && flight->keyLength == keyLength
+            && (keyLength == 0 || memcmp(flight->key, key, keyLength) == 0))
+        {
+            break;
+        }
+    }
+    if (flight != NULL)
+    {
+        flight->joined++;
+        while (!flight->completed)
+        {
+            gfnCondVarWaitForever(&s_requestSchedulerCompleted[kind], &s_requestSchedulerLock);
+        }
+        gfnAtomicAdd64(&scheduler->deduplicated, 1);
+        gfnLeaveRequestFlight(flight, result);
+        gfnMutexUnlock(&s_requestSchedulerLock);
+        return result->status;
+    }
+
+    flight = (gfnRequestFlight*)calloc(1, sizeof(gfnRequestFlight));
+    if (flight != NULL && keyLength > 0)
+    {
+        flight->key = (char*)malloc(keyLength);
+        if (flight->key == NULL)
+        {
+            free(flight);
+            flight = NULL;
+        }
+    }
+    if (flight == NULL)
+    {
+        gfnMutexUnlock(&s_requestSchedulerLock);
+        result->status = gfnInternalError;
+        return result->status;
+    }
+    if (keyLength > 0)
+    {
+        memcpy(flight->key, key, keyLength);
+    }
+    flight->hasKey = (key != NULL);
+    flight->keyLength = keyLength;
+    flight->joined = 1;
+    flight->next = scheduler->flights;
+    scheduler->flights = flight;
+    gfnMutexUnlock(&s_requestSchedulerLock);
+
+    memset(&fresh, 0, sizeof(fresh));
+    fresh.status = gfnExecuteScheduledRequest(scheduler, execute, request, &fresh);
+
+    gfnMutexLock(&s_requestSchedulerLock);
+    for (link = &scheduler->flights; *link != flight; link = &(*link)->next)
+    {
+    }
+    // Later requests with this key make a new call instead of joining a completed one
+    *link = flight->next;
+    flight->result = fresh;
+    flight->completed = true;
+    gfnCondVarBroadcast(&s_requestSchedulerCompleted[kind]);
+    gfnLeaveRequestFlight(flight, result);
+    gfnMutexUnlock(&s_requestSchedulerLock);
+    return result->status;
+}
+
+// Calls a cloud library API returning a library-allocated string, and keeps a copy of it in the result
+#define EXECUTE_CLOUD_STRING_REQUEST(result, Fn)                                            \
+    {                                                                                       \
+        const char* text = NULL;                                                            \
+        GfnRuntimeError freeStatus;                                                         \
+        CALL_CLOUD_LIBRARY(result->status, Fn, &text);                                      \
+        if (GFNSDK_SUCCEEDED(result->status) && text != NULL)                               \
+        {                                                                                   \
+            result->length = (unsigned int)strlen(text);                                    \
+            result->data = (char*)malloc((size_t)result->length + 1);                       \
+            if (result->data == NULL)                                                       \
+            {                                                                               \
+                result->status = gfnInternalError;                                          \
+            }                                                                               \
+            else                                                                            \
+            {                                                                               \
+                memcpy(result->data, text, (size_t)result->length + 1);                    \
+            }                                                                               \
+            CALL_CLOUD_LIBRARY(freeStatus, Free, &text);                                    \
+            (void)freeStatus;                                                               \
+        }                                                                                   \
+        return result->status;                                                              \
+    }
+
+static GfnRuntimeError gfnExecuteGetPartnerData(void const* request, gfnRequestResult* result)
+{
+    (void)request;
+    EXECUTE_CLOUD_STRING_REQUEST(result, GetPartnerData);
+}
+
+static GfnRuntimeError gfnExecuteGetPartnerSecureData(void const* request, gfnRequestResult* result)
+{
+    (void)request;
+    EXECUTE_CLOUD_STRING_REQUEST(result, GetPartnerSecureData);
+}
+
+static GfnRuntimeError gfnExecuteCloudCheck(void const* request, gfnRequestResult* result)
+{
+    GfnCloudCheckChallenge const* challenge = (GfnCloudCheckChallenge const*)request;
+    GfnCloudCheckResponse response = { NULL, 0 };
+    GfnRuntimeError freeStatus;
+
+    result->isCloudEnvironment = false;
+    CALL_CLOUD_LIBRARY(result->status, CloudCheck, challenge, (challenge != NULL) ? &response : NULL, &result->isCloudEnvironment);
+    if (result->status == gfnAPINotInit)
+    {
+        // The cloud library went away, which means this is not a cloud environment
+        result->status = gfnSuccess;
+        result->isCloudEnvironment = false;
+    }
+    if (response.attestationData != NULL)
+    {
+        result->data = (char*)malloc((size_t)response.attestationDataSize + 1);
+        if (result->data == NULL)
+        {
+            result->status = gfnInternalError;
+        }
+        else
+        {
+            memcpy(result->data, response.attestationData, response.attestationDataSize);
+            result->data[response.attestationDataSize] = '\0';
+            result->length = response.attestationDataSize;
+        }
+        CALL_CLOUD_LIBRARY(freeStatus, Free, &response.attestationData);
+        (void)freeStatus;
+    }
+    return result->status;
+}
+
+GfnRuntimeError GfnSetRequestSchedulerConfig(GfnScheduledRequest request, const GfnRequestSchedulerConfig* config)
+{
+    gfnRequestScheduler* scheduler;
+
+    CHECK_NULL_PARAM(config);
+    if ((unsigned int)request >= gfnScheduledRequestCount || config->maxBackoffMs < config->initialBackoffMs)
+    {
+        return gfnInvalidParameter;
+    }
+    scheduler = &s_requestSchedulers[request];
+    gfnMutexLock(&s_requestSchedulerLock);
+    scheduler->config = *config;
+    scheduler->configured = true;
+    scheduler->tokens = (double)config->burst;
+    scheduler->refilledNs = gfnGetMonotonicNs();
+    gfnMutexUnlock(&s_requestSchedulerLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnGetRequestSchedulerStats(GfnScheduledRequest request, GfnRequestSchedulerStats* stats)
+{
+    gfnRequestScheduler* scheduler;
+
+    CHECK_NULL_PARAM(stats);
+    if ((unsigned int)request >= gfnScheduledRequestCount)
+    {
+        return gfnInvalidParameter;
+    }
+    scheduler = &s_requestSchedulers[request];
+    stats->requests = (uint64_t)gfnAtomicLoadRelaxed64(&scheduler->requests);
+    stats->libraryCalls = (uint64_t)gfnAtomicLoadRelaxed64(&scheduler->libraryCalls);
+    stats->deduplicated = (uint64_t)gfnAtomicLoadRelaxed64(&scheduler->deduplicated);
+    stats->throttled = (uint64_t)gfnAtomicLoadRelaxed64(&scheduler->throttled);
+    stats->retries = (uint64_t)gfnAtomicLoadRelaxed64(&scheduler->retries);
+    stats->rateLimited = (uint64_t)gfnAtomicLoadRelaxed64(&scheduler->rateLimited);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnCloudCheck(const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment)
+{
+    gfnRequestResult result;
+    char const* key = NULL;
+
+    if (isCloudEnvironment != NULL)
+    {
+        *isCloudEnvironment = false;
+    }
+
+    if ((gfnAtomicLoadAcquire32(&g_sdkState) & (GFN_STATE_CLIENT_LIVE | GFN_STATE_CLOUD_LIVE)) == 0)
+    {
+        return gfnAPINotInit;
+    }
+
+#ifdef _WIN32
+    if (wcslen(g_cloudLibraryPath) == 0)
+#elif __linux__
+    if (strlen(g_cloudLibraryPath) == 0)
+#endif
+    {
+        GFN_SDK_LOG("Cloud library path not defined, which denotes an API call without Initialize succeeding, treating as not in cloud");
+        return gfnSuccess;
+    }
+
+    if ((gfnAtomicLoadAcquire32(&g_sdkState) & GFN_STATE_CLOUD_LIVE) == 0)
+    {
+        GFN_SDK_LOG_DEBUG("No cloud library present, call succeeds");
+        return gfnSuccess;
+    }
+
+    if (challenge != NULL)
+    {
+        if (response == NULL)
+        {
+            return gfnInvalidParameter;
+        }
+        response->attestationData = NULL;
+        response->attestationDataSize = 0;
+        // Only checks with the same nonce can share a response
+        key = (challenge->nonce != NULL) ? challenge->nonce : "";
+    }
+
+    gfnScheduleRequest(gfnScheduledCloudCheck, key, (challenge != NULL && challenge->nonce != NULL) ? challenge->nonceSize : 0,
+        &gfnExecuteCloudCheck, challenge, &result);
+    if (isCloudEnvironment != NULL)
+    {
+        *isCloudEnvironment = result.isCloudEnvironment;
+    }
+    if (response != NULL && result.data != NULL)
+    {
+        response->attestationData = result.data;
+        response->attestationDataSize = result.length;
+    }
+    GFN_SDK_LOG_DEBUG("status=%d isCloudEnvironment=%d", result.status, result.isCloudEnvironment);
+
+    return result.status;
+}
+
+#define TESTME(lib, fn) lib->fn()
+
+GfnRuntimeError GfnFree(const char** data)
+{
+    CHECK_NULL_PARAM(data);
+    if (*data != NULL && gfnReleaseOwnedString(*data))
+    {
+        *data = NULL;
+        return gfnSuccess;
+    }
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(Free, data);
+}
+
+GfnRuntimeError GfnGetClientIpV4(const char ** clientIp)
+{
+    CHECK_NULL_PARAM(clientIp);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(GetClientIp, clientIp);
+}
+
+GfnRuntimeError GfnGetClientLanguageCode(const char** languageCode)
+{
+    CHECK_NULL_PARAM(languageCode);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(GetClientLanguageCode, languageCode);
+}
+
+GfnRuntimeError GfnGetClientCountryCode(char* countryCode, unsigned int length)
+{
+    CHECK_NULL_PARAM(countryCode);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(GetClientCountryCode, countryCode, length);
+}
+
+GfnRuntimeError GfnGetPartnerData(const char** partnerData)
+{
+    gfnRequestResult result;
+
+    CHECK_NULL_PARAM(partnerData);
+    CHECK_CLOUD_ENVIRONMENT();
+    *partnerData = NULL;
+    gfnScheduleRequest(gfnScheduledPartnerData, NULL, 0, &gfnExecuteGetPartnerData, NULL, &result);
+    *partnerData = result.data;
+    return result.status;
+}
+
+GfnRuntimeError GfnGetPartnerSecureData(const char** partnerSecureData)
+{
+    gfnRequestResult result;
+
+    CHECK_NULL_PARAM(partnerSecureData);
+    CHECK_CLOUD_ENVIRONMENT();
+    *partnerSecureData = NULL;
+    gfnScheduleRequest(gfnScheduledPartnerSecureData, NULL, 0, &gfnExecuteGetPartnerSecureData, NULL, &result);
+    *partnerSecureData = result.data;
+    return result.status;
+}
+
+// Title availability index. GfnIsTitleAvailable, GfnAreTitlesAvailable and GfnGetTitlesAvailable are
+// answered from a hash set of the list returned by the cloud library's gfnGetTitlesAvailable, so a
+// launcher checking thousands of titles makes no call into the library per title. The list is fetched
+// on first use and again once the refresh interval has passed or a SessionInit or Install callback
+// arrives; a refresh that returns the same list keeps the current index. One caller refreshes the
+// index while others keep using the previous one.
+//
+// The index is published in one of a few slots, which readers pin the way GfnGetNetworkStats pins its
+// snapshot buffers: a reader adds to s_titleIndexState, which holds the current slot in its low bits and
+// the number of readers that pinned it above them, and unpins in s_titleIndexPins once done. Publishing
+// moves the readers counted in the state to the pins of the slot they read, and a refresh only reuses a
+// slot with no pins, freeing the index it held. Readers that keep calling therefore never hold up the
+// retirement of an index they are not using.
+#define kGfnTitleIndexRetryMs 1000      // Wait before refetching after a failed refresh
+#define kGfnTitleIndexSlots 4           // Must be a power of two
+#define kGfnTitleIndexReader 4          // One pinned reader in s_titleIndexState, above the slot bits
+
+typedef struct gfnTitleSlot
+{
+    uint32_t hash;
+    uint32_t offset;                    // Position of the identifier in gfnTitleIndex::names
+    uint32_t length;                    // 0 for an empty slot
+} gfnTitleSlot;
+
+typedef struct gfnTitleIndex
+{
+    unsigned int count;                 // Identifiers in the index
+    unsigned int mask;                  // Number of slots minus one
+    unsigned int listLength;
+    gfnTitleSlot* slots;
+    char* list;                         // The list as returned by the library
+    char* names;                        // The identifiers, each NULL terminated
+} gfnTitleIndex;
+
+static gfnAtomicPtr s_titleIndexSlots[kGfnTitleIndexSlots];    // Written with s_titleIndexRefreshLock held
+static gfnAtomic64 s_titleIndexState = 0;
+static gfnAtomic64 s_titleIndexPins[kGfnTitleIndexSlots];
+static gfnAtomic64 s_titleIndexNextRefreshNs = 0;
+static gfnAtomic32 s_titleIndexGeneration = 0;
+static gfnAtomic32 s_titleIndexFetchedGeneration = -1;
+static gfnAtomic32 s_titleIndexRefreshMs = 60000;
+static gfnMutex s_titleIndexRefreshLock = GFN_MUTEX_INITIALIZER;
+
+static void gfnInvalidateTitleIndex(void)
+{
+    gfnAtomicAdd32(&s_titleIndexGeneration, 1);
+}
+
+// FNV-1a
+static uint32_t gfnHashTitleId(char const* id, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned char)id[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static gfnTitleSlot const* gfnFindTitleSlot(gfnTitleIndex const* index, char const* id, size_t length, uint32_t hash)
+{
+    uint32_t position = hash & index->mask;
+    gfnTitleSlot const* slot;
+
+    for (;;)
+    {
+        slot = &index->slots[position];
+        if (slot->length == 0
+            || (slot->hash == hash && slot->length == length && memcmp(&index->names[slot->offset], id, length) == 0))
+        {
+            return slot;
+        }
+        position = (position + 1) & index->mask;
+    }
+}
+
+static bool gfnIndexHasTitle(gfnTitleIndex const* index, char const* platformAppId)
+{
+    size_t length;
+
+    if (platformAppId == NULL)
+    {
+        return false;
+    }
+    length = strlen(platformAppId);
+    return length != 0 && gfnFindTitleSlot(index, platformAppId, length, gfnHashTitleId(platformAppId, length))->length != 0;
+}
+
+static bool gfnIsTitleListSeparator(char c)
+{
+    return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Builds an index of a comma-delimited list. The index, its slots and both copies of the list are one
+// allocation. Returns NULL if out of memory.
+static gfnTitleIndex* gfnBuildTitleIndex(char const* list)
+{
+    size_t listLength = strlen(list);
+    unsigned int tokens = 1;
+    unsigned int slotCount = 16;
+    gfnTitleIndex* index;
+    gfnTitleSlot* slot;
+    char* name;
+    char* end;
+    size_t i;
+    size_t length;
+    uint32_t hash;
+
+    for (i = 0; i < listLength; i++)
+    {
+        tokens += (list[i] == ',') ? 1 : 0;
+    }
+    // Keep the load factor at or below one half
+    while (slotCount < tokens * 2)
+    {
+        slotCount *= 2;
+    }
+    index = (gfnTitleIndex*)calloc(1, sizeof(gfnTitleIndex) + slotCount * sizeof(gfnTitleSlot) + 2 * (listLength + 1));
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    index->mask = slotCount - 1;
+    index->listLength = (unsigned int)listLength;
+    index->slots = (gfnTitleSlot*)(index + 1);
+    index->list = (char*)(index->slots + slotCount);
+    index->names = index->list + listLength + 1;
+    memcpy(index->list, list, listLength + 1);
+    memcpy(index->names, list, listLength + 1);
+
+    for (name = index->names; *name != '\0'; name = end)
+    {
+        while (gfnIsTitleListSeparator(*name))
+        {
+            *name++ = '\0';
+        }
+        for (end = name; *end != '\0' && !gfnIsTitleListSeparator(*end); end++)
+        {
+        }
+        length = (size_t)(end - name);
+        if (length == 0)
+        {
+            continue;
+        }
+        hash = gfnHashTitleId(name, length);
+        slot = (gfnTitleSlot*)gfnFindTitleSlot(index, name, length, hash);
+        if (slot->length == 0)
+        {
+            slot->hash = hash;
+            slot->offset = (uint32_t)(name - index->names);
+            slot->length = (uint32_t)length;
+            index->count++;
+        }
+    }
+    return index;
+}
+
+// The index in the current slot. Only the refresh, which holds s_titleIndexRefreshLock, may dereference
+// it without pinning it.
+static gfnTitleIndex* gfnCurrentTitleIndex(void)
+{
+    return (gfnTitleIndex*)gfnAtomicLoadAcquirePtr(&s_titleIndexSlots[gfnAtomicLoadRelaxed64(&s_titleIndexState) & (kGfnTitleIndexSlots - 1)]);
+}
+
+// Pins the current slot for a reader and returns it, for gfnUnpinTitleIndex
+static unsigned int gfnPinTitleIndex(gfnTitleIndex const** index)
+{
+    int64_t state = gfnAtomicAdd64(&s_titleIndexState, kGfnTitleIndexReader) - kGfnTitleIndexReader;
+    unsigned int slot = (unsigned int)state & (kGfnTitleIndexSlots - 1);
+
+    *index = (gfnTitleIndex const*)gfnAtomicLoadAcquirePtr(&s_titleIndexSlots[slot]);
+    return slot;
+}
+
+static void gfnUnpinTitleIndex(unsigned int slot)
+{
+    gfnAtomicAdd64(&s_titleIndexPins[slot], -1);
+}
+
+// Publishes the index in a slot that no reader has pinned, freeing the index the slot held. Returns
+// false if every other slot is still pinned. Must be called with s_titleIndexRefreshLock held.
+static bool gfnReplaceTitleIndex(gfnTitleIndex* index)
+{
+    int64_t current = gfnAtomicLoadRelaxed64(&s_titleIndexState) & (kGfnTitleIndexSlots - 1);
+    int64_t previous;
+    unsigned int slot = 0;
+    unsigned int i;
+
+    for (i = 1; i < kGfnTitleIndexSlots; i++)
+    {
+        slot = (unsigned int)(current + i) & (kGfnTitleIndexSlots - 1);
+        if (gfnAtomicLoadRelaxed64(&s_titleIndexPins[slot]) == 0)
+        {
+            break;
+        }
+    }
+    if (i == kGfnTitleIndexSlots)
+    {
+        return false;
+    }
+    gfnAtomicFence();
+    free(gfnAtomicLoadAcquirePtr(&s_titleIndexSlots[slot]));
+    gfnAtomicStoreReleasePtr(&s_titleIndexSlots[slot], index);
+    previous = gfnAtomicExchange64(&s_titleIndexState, (int64_t)slot);
+    gfnAtomicAdd64(&s_titleIndexPins[previous & (kGfnTitleIndexSlots - 1)], previous / kGfnTitleIndexReader);
+    return true;
+}
+
+static bool gfnIsTitleIndexDue(void)
+{
+    return gfnAtomicLoadAcquire32(&s_titleIndexFetchedGeneration) != gfnAtomicLoadAcquire32(&s_titleIndexGeneration)
+        || gfnGetMonotonicNs() >= (uint64_t)gfnAtomicLoadRelaxed64(&s_titleIndexNextRefreshNs);
+}
+
+// Must be called with s_titleIndexRefreshLock held
+static void gfnFetchTitleIndex(void)
+{
+    int32_t generation = gfnAtomicLoadAcquire32(&s_titleIndexGeneration);
+    uint64_t intervalNs = (uint64_t)(uint32_t)gfnAtomicLoadRelaxed32(&s_titleIndexRefreshMs) * 1000000;
+    uint64_t retryNs = kGfnTitleIndexRetryMs * 1000000ULL;
+    gfnTitleIndex const* current = gfnCurrentTitleIndex();
+    gfnTitleIndex* index;
+    char const* list = NULL;
+    GfnRuntimeError status;
+    GfnRuntimeError freeStatus;
+
+    CALL_CLOUD_LIBRARY(status, GetTitlesAvailable, &list);
+    if (GFNSDK_FAILED(status) || list == NULL)
+    {
+        // Keep the current index, if any, and retry shortly. Until there is an index, callers ask the
+        // library directly.
+        GFN_SDK_LOG_DEBUG("Title list refresh failed: %d", status);
+        if (status == gfnAPINotFound || intervalNs < retryNs)
+        {
+            retryNs = intervalNs;
+        }
+        gfnAtomicStoreRelaxed64(&s_titleIndexNextRefreshNs, (int64_t)(gfnGetMonotonicNs() + retryNs));
+        gfnAtomicStoreRelease32(&s_titleIndexFetchedGeneration, generation);
+        return;
+    }
+    if (current == NULL || strcmp(current->list, list) != 0)
+    {
+        index = gfnBuildTitleIndex(list);
+        if (index != NULL && !gfnReplaceTitleIndex(index))
+        {
+            // Readers still hold every other slot; keep the current index and try again shortly
+            GFN_SDK_LOG_DEBUG("Title index slots all in use, keeping the current index");
+            free(index);
+            intervalNs = (intervalNs < retryNs) ? intervalNs : retryNs;
+        }
+        else if (index != NULL)
+        {
+            GFN_SDK_LOG_DEBUG("Title index rebuilt with %u titles", index->count);
+        }
+    }
+    CALL_CLOUD_LIBRARY(freeStatus, Free, &list);
+    (void)freeStatus;
+    gfnAtomicStoreRelaxed64(&s_titleIndexNextRefreshNs, (int64_t)(gfnGetMonotonicNs() + intervalNs));
+    gfnAtomicStoreRelease32(&s_titleIndexFetchedGeneration, generation);
+}
+
+// Refreshes the index if it is stale, enters the library call guard and pins the index. On success,
+// *index is the index to use until gfnLeaveTitleIndex, or NULL if the index is disabled or could not
+// be fetched, in which case the caller asks the library directly.
+static GfnRuntimeError gfnEnterTitleIndex(gfnTitleIndex const** index, unsigned int* pin)
+{
+    bool hasIndex;
+
+    *index = NULL;
+    if (gfnAtomicLoadRelaxed32(&s_titleIndexRefreshMs) != 0 && gfnIsTitleIndexDue())
+    {
+        hasIndex = gfnCurrentTitleIndex() != NULL;
+        if (hasIndex && !gfnMutexTryLock(&s_titleIndexRefreshLock))
+        {
+            // Another thread is refreshing; use the previous index rather than wait for it
+            GFN_SDK_LOG_TRACE("Title index refresh in progress, using previous index");
+        }
+        else
+        {
+            if (!hasIndex)
+            {
+                gfnMutexLock(&s_titleIndexRefreshLock);
+            }
+            // The refresh may have completed while acquiring the lock
+            if (gfnIsTitleIndexDue())
+            {
+                gfnFetchTitleIndex();
+            }
+            gfnMutexUnlock(&s_titleIndexRefreshLock);
+        }
+    }
+    if (!gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))
+    {
+        return gfnAPINotInit;
+    }
+    *pin = gfnPinTitleIndex(index);
+    if (gfnAtomicLoadRelaxed32(&s_titleIndexRefreshMs) == 0)
+    {
+        *index = NULL;
+    }
+    return gfnSuccess;
+}
+
+static void gfnLeaveTitleIndex(unsigned int pin)
+{
+    gfnUnpinTitleIndex(pin);
+    gfnLeaveLibraryCall();
+}
+
+// Asks the library directly. Must be called inside the library call guard.
+static GfnRuntimeError gfnQueryTitleAvailable(char const* platformAppId, bool* isAvailable)
+{
+    if (g_pCloudLibrary->IsTitleAvailable == NULL)
+    {
+        GFN_SDK_LOG_WARNING("Cannot call cloud function %s: API not found", "IsTitleAvailable");
+        return gfnAPINotFound;
+    }
+    GFN_TIMED_CALL(*isAvailable, gfnApiCloudIsTitleAvailable, (bool)g_pCloudLibrary->IsTitleAvailable(platformAppId));
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnIsTitleAvailable(const char* platformAppId, bool* isAvailable)
+{
+    gfnTitleIndex const* index;
+    unsigned int pin;
+    GfnRuntimeError status;
+
+    CHECK_NULL_PARAM(isAvailable);
+    *isAvailable = false;
+
+    CHECK_NULL_PARAM(platformAppId);
+    CHECK_CLOUD_ENVIRONMENT();
+    status = gfnEnterTitleIndex(&index, &pin);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+    if (index != NULL)
+    {
+        *isAvailable = gfnIndexHasTitle(index, platformAppId);
+    }
+    else
+    {
+        status = gfnQueryTitleAvailable(platformAppId, isAvailable);
+    }
+    gfnLeaveTitleIndex(pin);
+
+    return status;
+}
+
+GfnRuntimeError GfnAreTitlesAvailable(const char** platformAppIds, unsigned int count, bool* isAvailable)
+{
+    gfnTitleIndex const* index;
+    unsigned int pin;
+    GfnRuntimeError status;
+    unsigned int i;
+
+    CHECK_NULL_PARAM(isAvailable);
+    memset(isAvailable, 0, count * sizeof(bool));
+
+    CHECK_NULL_PARAM(platformAppIds);
+    CHECK_CLOUD_ENVIRONMENT();
+    status = gfnEnterTitleIndex(&index, &pin);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+    for (i = 0; i < count && GFNSDK_SUCCEEDED(status); i++)
+    {
+        if (index != NULL)
+        {
+            isAvailable[i] = gfnIndexHasTitle(index, platformAppIds[i]);
+        }
+        else if (platformAppIds[i] != NULL)
+        {
+            status = gfnQueryTitleAvailable(platformAppIds[i], &isAvailable[i]);
+        }
+    }
+    gfnLeaveTitleIndex(pin);
+
+    return status;
+}
+
+GfnRuntimeError GfnGetTitlesAvailable(const char** platformAppIds)
+{
+    gfnTitleIndex const* index;
+    unsigned int pin;
+    GfnRuntimeError status;
+
+    CHECK_NULL_PARAM(platformAppIds);
+    CHECK_CLOUD_ENVIRONMENT();
+    status = gfnEnterTitleIndex(&index, &pin);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+    if (index != NULL)
+    {
+        // Handed out as a wrapper-owned copy, which GfnFree releases
+        *platformAppIds = gfnCreateOwnedString(index->list, index->listLength);
+        gfnLeaveTitleIndex(pin);
+        return (*platformAppIds != NULL) ? gfnSuccess : gfnInternalError;
+    }
+    gfnLeaveTitleIndex(pin);
+    DELEGATE_TO_CLOUD_LIBRARY(GetTitlesAvailable, platformAppIds);
+}
+
+GfnRuntimeError GfnSetTitleIndexRefreshInterval(unsigned int intervalMs)
+{
+    gfnAtomicExchange32(&s_titleIndexRefreshMs, (int32_t)intervalMs);
+    gfnAtomicStoreRelaxed64(&s_titleIndexNextRefreshNs, 0);
+    gfnInvalidateTitleIndex();
+    return gfnSuccess;
+}
+
+// Drops the index, so the next session fetches the list again. Called from shutdown, once no reader can
+// hold a slot.
+static void gfnResetTitleIndex(void)
+{
+    unsigned int slot;
+
+    gfnMutexLock(&s_titleIndexRefreshLock);
+    for (slot = 0; slot < kGfnTitleIndexSlots; slot++)
+    {
+        free(gfnAtomicLoadAcquirePtr(&s_titleIndexSlots[slot]));
+        gfnAtomicStoreReleasePtr(&s_titleIndexSlots[slot], NULL);
+    }
+    gfnAtomicStoreRelaxed64(&s_titleIndexNextRefreshNs, 0);
+    gfnMutexUnlock(&s_titleIndexRefreshLock);
+    gfnInvalidateTitleIndex();
+}
+
+
+GfnRuntimeError GfnGetClientInfo(GfnClientInfo* clientInfo)
+{
+    GFN_SDK_LOG_TRACE("Calling GfnGetClientInfo");
+    CHECK_NULL_PARAM(clientInfo);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(GetClientInfo, clientInfo);
+}
+
+// Session snapshot cache. GfnGetSessionSnapshot serves a copy of the cached snapshot until its TTL expires
+// or a ClientInfo or NetworkStatus update invalidates it. One caller refreshes it from the cloud library
+// while others keep reading the previous copy through the seqlock.
+typedef struct gfnSessionSnapshotCache
+{
+    gfnAtomic32 sequence;           // Odd while the snapshot is being replaced
+    bool valid;
+    int32_t generation;             // Value of s_sessionSnapshotGeneration when the snapshot was fetched
+    uint64_t fetchedNs;
+    GfnSessionSnapshot snapshot;
+} gfnSessionSnapshotCache;
+
+static gfnSessionSnapshotCache s_sessionSnapshot;
+static gfnAtomic32 s_sessionSnapshotGeneration = 0;
+static gfnAtomic32 s_sessionSnapshotTtlMs = 1000;
+static gfnMutex s_sessionSnapshotRefreshLock = GFN_MUTEX_INITIALIZER;
+
+static void gfnInvalidateSessionSnapshot(void)
+{
+    gfnAtomicAdd32(&s_sessionSnapshotGeneration, 1);
+}
+
+static void gfnReadSessionSnapshotCache(gfnSessionSnapshotCache* copy)
+{
+    int32_t sequence;
+
+    for (;;)
+    {
+        sequence = gfnAtomicLoadAcquire32(&s_sessionSnapshot.sequence);
+        if ((sequence & 1) == 0)
+        {
+            copy->valid = s_sessionSnapshot.valid;
+            copy->generation = s_sessionSnapshot.generation;
+            copy->fetchedNs = s_sessionSnapshot.fetchedNs;
+            memcpy(&copy->snapshot, &s_sessionSnapshot.snapshot, sizeof(copy->snapshot));
+            gfnAtomicFence();
+            if (gfnAtomicLoadRelaxed32(&s_sessionSnapshot.sequence) == sequence)
+            {
+                return;
+            }
+        }
+        gfnCpuRelax();
+    }
+}
+
+// Must be called with s_sessionSnapshotRefreshLock held, which makes it the only writer
+static void gfnWriteSessionSnapshotCache(bool valid, int32_t generation, uint64_t fetchedNs, GfnSessionSnapshot const* snapshot)
+{
+    gfnAtomicAdd32(&s_sessionSnapshot.sequence, 1);
+    s_sessionSnapshot.valid = valid;
+    s_sessionSnapshot.generation = generation;
+    s_sessionSnapshot.fetchedNs = fetchedNs;
+    if (snapshot != NULL)
+    {
+        memcpy(&s_sessionSnapshot.snapshot, snapshot, sizeof(s_sessionSnapshot.snapshot));
+    }
+    gfnAtomicAdd32(&s_sessionSnapshot.sequence, 1);
+}
+
+static bool gfnIsSessionSnapshotFresh(gfnSessionSnapshotCache const* cache, uint64_t nowNs)
+{
+    return cache->valid
+        && cache->generation == gfnAtomicLoadAcquire32(&s_sessionSnapshotGeneration)
+        && nowNs - cache->fetchedNs < (uint64_t)(uint32_t)gfnAtomicLoadRelaxed32(&s_sessionSnapshotTtlMs) * 1000000;
+}
+
+// Copies a string returned by the library into a fixed buffer, truncating it if needed. Returns its full length.
+static unsigned int gfnCopyCloudString(char const* source, char* buffer, unsigned int size)
+{
+    size_t length = strlen(source);
+
+    if (size > 0)
+    {
+        size_t copied = (length < size) ? length : size - 1;
+        memcpy(buffer, source, copied);
+        buffer[copied] = '\0';
+    }
+    return (unsigned int)length;
+}
+
+// Queries every part of the snapshot from the cloud library. Parts that fail with gfnThrottled keep the
+// value from the previous snapshot, if it had one.
+static void gfnFetchSessionSnapshot(GfnSessionSnapshot* snapshot, GfnSessionSnapshot const* previous)
+{
+    char const* text = NULL;
+    GfnRuntimeError freeStatus;
+    gfnRequestResult partnerData;
+
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    CALL_CLOUD_LIBRARY(snapshot->clientInfoStatus, GetClientInfo, &snapshot->clientInfo);
+    if (snapshot->clientInfoStatus == gfnThrottled && previous != NULL && GFNSDK_SUCCEEDED(previous->clientInfoStatus))
+    {
+        snapshot->clientInfoStatus = previous->clientInfoStatus;
+        snapshot->clientInfo = previous->clientInfo;
+    }
+
+    CALL_CLOUD_LIBRARY(snapshot->sessionInfoStatus, GetSessionInfo, &snapshot->sessionInfo);
+    if (snapshot->sessionInfoStatus == gfnThrottled && previous != NULL && GFNSDK_SUCCEEDED(previous->sessionInfoStatus))
+    {
+        snapshot->sessionInfoStatus = previous->sessionInfoStatus;
+        snapshot->sessionInfo = previous->sessionInfo;
+    }
+
+    CALL_CLOUD_LIBRARY(snapshot->languageCodeStatus, GetClientLanguageCode, &text);
+    if (GFNSDK_SUCCEEDED(snapshot->languageCodeStatus) && text != NULL)
+    {
+        gfnCopyCloudString(text, snapshot->languageCode, sizeof(snapshot->languageCode));
+        CALL_CLOUD_LIBRARY(freeStatus, Free, &text);
+        (void)freeStatus;
+    }
+    else if (snapshot->languageCodeStatus == gfnThrottled && previous != NULL && GFNSDK_SUCCEEDED(previous->languageCodeStatus))
+    {
+        snapshot->languageCodeStatus = previous->languageCodeStatus;
+        memcpy(snapshot->languageCode, previous->languageCode, sizeof(snapshot->languageCode));
+    }
+
+    CALL_CLOUD_LIBRARY(snapshot->countryCodeStatus, GetClientCountryCode, snapshot->countryCode, sizeof(snapshot->countryCode));
+    if (snapshot->countryCodeStatus == gfnThrottled && previous != NULL && GFNSDK_SUCCEEDED(previous->countryCodeStatus))
+    {
+        snapshot->countryCodeStatus = previous->countryCodeStatus;
+        memcpy(snapshot->countryCode, previous->countryCode, sizeof(snapshot->countryCode));
+    }
+
+    // Partner data shares the request scheduler's rate limit with GfnGetPartnerData
+    snapshot->partnerDataStatus = gfnScheduleRequest(gfnScheduledPartnerData, NULL, 0, &gfnExecuteGetPartnerData, NULL, &partnerData);
+    if (partnerData.data != NULL)
+    {
+        snapshot->partnerDataLength = gfnCopyCloudString(partnerData.data, snapshot->partnerData, sizeof(snapshot->partnerData));
+        gfnReleaseOwnedString(partnerData.data);
+    }
+    else if (snapshot->partnerDataStatus == gfnThrottled && previous != NULL && GFNSDK_SUCCEEDED(previous->partnerDataStatus))
+    {
+        snapshot->partnerDataStatus = previous->partnerDataStatus;
+        snapshot->partnerDataLength = previous->partnerDataLength;
+        memcpy(snapshot->partnerData, previous->partnerData, sizeof(snapshot->partnerData));
+    }
+}
+
+static GfnRuntimeError gfnSessionSnapshotResult(GfnSessionSnapshot const* snapshot)
+{
+    if (GFNSDK_SUCCEEDED(snapshot->clientInfoStatus) || GFNSDK_SUCCEEDED(snapshot->sessionInfoStatus)
+        || GFNSDK_SUCCEEDED(snapshot->languageCodeStatus) || GFNSDK_SUCCEEDED(snapshot->countryCodeStatus)
+        || GFNSDK_SUCCEEDED(snapshot->partnerDataStatus))
+    {
+        return gfnSuccess;
+    }
+    return snapshot->clientInfoStatus;
+}
+
+GfnRuntimeError GfnGetSessionSnapshot(GfnSessionSnapshot* snapshot)
+{
+    gfnSessionSnapshotCache cache;
+    int32_t generation;
+    uint64_t nowNs;
+
+    CHECK_NULL_PARAM(snapshot);
+    CHECK_CLOUD_ENVIRONMENT();
+
+    gfnReadSessionSnapshotCache(&cache);
+    nowNs = gfnGetMonotonicNs();
+    if (!gfnIsSessionSnapshotFresh(&cache, nowNs))
+    {
+        if (cache.valid && !gfnMutexTryLock(&s_sessionSnapshotRefreshLock))
+        {
+            // Another thread is refreshing; serve the previous snapshot rather than wait for it
+            GFN_SDK_LOG_TRACE("Session snapshot refresh in progress, returning previous snapshot");
+        }
+        else
+        {
+            if (!cache.valid)
+            {
+                gfnMutexLock(&s_sessionSnapshotRefreshLock);
+            }
+            // The refresh may have completed while acquiring the lock
+            gfnReadSessionSnapshotCache(&cache);
+            nowNs = gfnGetMonotonicNs();
+            if (!gfnIsSessionSnapshotFresh(&cache, nowNs))
+            {
+                GFN_SDK_LOG_DEBUG("Refreshing session snapshot");
+                generation = gfnAtomicLoadAcquire32(&s_sessionSnapshotGeneration);
+                gfnFetchSessionSnapshot(snapshot, cache.valid ? &cache.snapshot : NULL);
+                gfnWriteSessionSnapshotCache(true, generation, nowNs, snapshot);
+                gfnMutexUnlock(&s_sessionSnapshotRefreshLock);
+                snapshot->ageMs = 0;
+                return gfnSessionSnapshotResult(snapshot);
+            }
+            gfnMutexUnlock(&s_sessionSnapshotRefreshLock);
+        }
+    }
+    memcpy(snapshot, &cache.snapshot, sizeof(*snapshot));
+    snapshot->ageMs = (unsigned int)((nowNs - cache.fetchedNs) / 1000000);
+    return gfnSessionSnapshotResult(snapshot);
+}
+
+GfnRuntimeError GfnSetSessionSnapshotTtl(unsigned int ttlMs)
+{
+    gfnAtomicExchange32(&s_sessionSnapshotTtlMs, (int32_t)ttlMs);
+    gfnInvalidateSessionSnapshot();
+    return gfnSuccess;
+}
+
+// Drops the cached snapshot, so the next session starts without stale data
+static void gfnResetSessionSnapshot(void)
+{
+    gfnMutexLock(&s_sessionSnapshotRefreshLock);
+    gfnWriteSessionSnapshotCache(false, 0, 0, NULL);
+    gfnMutexUnlock(&s_sessionSnapshotRefreshLock);
+    gfnInvalidateSessionSnapshot();
+}
+
+// Defined with the quality advisor
+static void gfnAdviseOnClientInfo(GfnClientInfoUpdateData const* update);
+
+static void GFN_CALLBACK _gfnClientInfoCallbackWrapper(int status, void* updateData, void* pData)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pData;
+    (void)status;
+    GFN_SDK_LOG_TRACE("ClientInfo update received");
+    gfnInvalidateSessionSnapshot();
+    if (updateData != NULL)
+    {
+        gfnAdviseOnClientInfo((GfnClientInfoUpdateData const*)updateData);
+    }
+
+    if (gfnIsCallbackDeliveryQueued())
+    {
+        gfnQueueClientInfoUpdate((GfnClientInfoUpdateData *)updateData);
+        return;
+    }
+
+    for (cursor = 0; gfnNextCallback(gfnCallbackClientInfo, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((ClientInfoCallbackSig)invocation.fnCallback)((GfnClientInfoUpdateData *)updateData, invocation.pUserContext);
+    }
+}
+
+GfnRuntimeError GfnRegisterClientInfoCallback(ClientInfoCallbackSig clientInfoCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(clientInfoCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+    GFN_SDK_LOG("Registering for ClientInfo updates");
+    if (gfnBeginCallbackRegistration(gfnCallbackClientInfo, (void*)clientInfoCallback, pUserContext, 0))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterClientInfoCallback, &_gfnClientInfoCallbackWrapper, &g_callbackSlots[gfnCallbackClientInfo]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackClientInfo, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterClientInfoCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackClientInfo);
+}
+
+GfnRuntimeError GfnGetSessionInfo(GfnSessionInfo* sessionInfo)
+{
+    GFN_SDK_LOG_TRACE("Calling GfnGetSessionInfo");
+    CHECK_NULL_PARAM(sessionInfo);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(GetSessionInfo, sessionInfo);
+}
+
+// Network quality tracking. The NetworkStatus trampoline records every latency update in a ring of
+// samples, which each sliding window covers from its oldest sample to the newest. A window keeps the
+// sum of its latencies and of the changes between them, a latency histogram for the percentiles, and
+// monotonic queues of sample positions whose front is the lowest and highest latency in the window,
+// so recording an update costs the same however long the windows are.
+//
+// Updates are recorded under s_networkStatsLock, and each one publishes a complete GfnNetworkStats into
+// one of a few snapshot buffers, so GfnGetNetworkStats reads are wait-free: a reader pins the current
+// buffer by adding to s_networkStatsState, which holds the buffer index in its low bits and the number
+// of readers that pinned it above them, copies the buffer and unpins it in s_networkStatsPins. When a
+// new buffer is published, the readers counted in the state are moved to the pins of the buffer they
+// read, and the writer only fills buffers with no pins. In the unlikely case that every other buffer is
+// still pinned, the update is recorded without being published.
+#define kGfnNetworkSampleCapacity 2048          // Samples the windows can hold, must be a power of two
+#define kGfnNetworkHistogramBuckets 512         // 1 ms buckets up to 255 ms, then 8 ms buckets
+#define kGfnNetworkStatsBuffers 4               // Snapshot buffers, must be a power of two
+#define kGfnNetworkStatsReader 4                // One pinned reader in s_networkStatsState, above the index bits
+
+typedef struct gfnNetworkSample
+{
+    uint64_t timestampNs;
+    uint32_t latencyMs;
+} gfnNetworkSample;
+
+// Sliding window over the sample ring. Positions count samples since the tracker was created, so the
+// ring index of a position is position & (kGfnNetworkSampleCapacity - 1).
+typedef struct gfnNetworkWindow
+{
+    uint32_t head;                  // Position of the oldest sample in the window
+    uint64_t sumMs;
+    uint64_t sumChangeMs;           // Sum of the absolute changes between consecutive samples in the window
+    uint32_t minQueue[kGfnNetworkSampleCapacity];   // Positions with increasing latencies from minFront
+    uint32_t maxQueue[kGfnNetworkSampleCapacity];   // Positions with decreasing latencies from maxFront
+    uint32_t minFront;
+    uint32_t minBack;
+    uint32_t maxFront;
+    uint32_t maxBack;
+    uint32_t histogram[kGfnNetworkHistogramBuckets];
+} gfnNetworkWindow;
+
+typedef struct gfnNetworkTracker
+{
+    gfnNetworkSample samples[kGfnNetworkSampleCapacity];
+    uint32_t next;                  // Position of the next sample
+    gfnNetworkWindow windows[GFN_NETWORK_STATS_WINDOW_COUNT];
+    uint64_t updateCount;
+    uint64_t lastUpdateNs;
+    uint32_t latestMs;
+    float ewmaMs;
+    float jitterMs;
+} gfnNetworkTracker;
+
+typedef struct gfnNetworkStatsSnapshot
+{
+    GfnNetworkStats stats;
+    uint64_t lastUpdateNs;
+} gfnNetworkStatsSnapshot;
+
+static gfnMutex s_networkStatsLock = GFN_MUTEX_INITIALIZER;
+static gfnNetworkTracker* s_networkTracker = NULL;      // Allocated on the first update, guarded by s_networkStatsLock
+static GfnNetworkStatsConfig s_networkStatsConfig = { 1000, { 10000, 60000, 300000 } };    // Guarded by s_networkStatsLock
+static gfnNetworkStatsSnapshot s_networkStatsBuffers[kGfnNetworkStatsBuffers];
+static gfnAtomic64 s_networkStatsState = 0;
+static gfnAtomic64 s_networkStatsPins[kGfnNetworkStatsBuffers];
+static gfnAtomic32 s_networkStatsSubscribed = 0;        // Set once the trampoline is registered for the tracker
+static bool s_networkStatsOwnRate = false;              // The library registration is the wrapper's own, at the
+                                                        // configured update rate. Guarded by g_callbackLock.
+
+static unsigned int gfnNetworkHistogramBucket(uint32_t latencyMs)
+{
+    unsigned int bucket = (latencyMs < 256) ? latencyMs : 256 + (latencyMs - 256) / 8;
+    return (bucket < kGfnNetworkHistogramBuckets) ? bucket : kGfnNetworkHistogramBuckets - 1;
+}
+
+// Latency a bucket stands for: its value below 256 ms, and its middle above
+static uint32_t gfnNetworkHistogramLatency(unsigned int bucket)
+{
+    return (bucket < 256) ? bucket : 256 + (bucket - 256) * 8 + 4;
+}
+
+static uint32_t gfnNetworkLatencyAt(gfnNetworkTracker const* tracker, uint32_t position)
+{
+    return tracker->samples[position & (kGfnNetworkSampleCapacity - 1)].latencyMs;
+}
+
+static uint32_t gfnNetworkLatencyChange(uint32_t a, uint32_t b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+// Adds the sample at position, the newest, to a window
+static void gfnAddNetworkSample(gfnNetworkTracker* tracker, gfnNetworkWindow* window, uint32_t position)
+{
+    uint32_t latencyMs = gfnNetworkLatencyAt(tracker, position);
+
+    if (window->head != position)
+    {
+        window->sumChangeMs += gfnNetworkLatencyChange(latencyMs, gfnNetworkLatencyAt(tracker, position - 1));
+    }
+    window->sumMs += latencyMs;
+    window->histogram[gfnNetworkHistogramBucket(latencyMs)]++;
+
+    while (window->minBack != window->minFront &&
+        gfnNetworkLatencyAt(tracker, window->minQueue[(window->minBack - 1) & (kGfnNetworkSampleCapacity - 1)]) >= latencyMs)
+    {
+        window->minBack--;
+    }
+    window->minQueue[window->minBack++ & (kGfnNetworkSampleCapacity - 1)] = position;
+    while (window->maxBack != window->maxFront &&
+        gfnNetworkLatencyAt(tracker, window->maxQueue[(window->maxBack - 1) & (kGfnNetworkSampleCapacity - 1)]) <= latencyMs)
+    {
+        window->maxBack--;
+    }
+    window->maxQueue[window->maxBack++ & (kGfnNetworkSampleCapacity - 1)] = position;
+}
+
+// Removes the oldest sample from a window
+static void gfnExpireNetworkSample(gfnNetworkTracker* tracker, gfnNetworkWindow* window)
+{
+    uint32_t position = window->head;
+    uint32_t latencyMs = gfnNetworkLatencyAt(tracker, position);
+
+    window->sumMs -= latencyMs;
+    window->histogram[gfnNetworkHistogramBucket(latencyMs)]--;
+    if (position + 1 != tracker->next)
+    {
+        window->sumChangeMs -= gfnNetworkLatencyChange(latencyMs, gfnNetworkLatencyAt(tracker, position + 1));
+    }
+    if (window->minFront != window->minBack && window->minQueue[window->minFront & (kGfnNetworkSampleCapacity - 1)] == position)
+    {
+        window->minFront++;
+    }
+    if (window->maxFront != window->maxBack && window->maxQueue[window->maxFront & (kGfnNetworkSampleCapacity - 1)] == position)
+    {
+        window->maxFront++;
+    }
+    window->head++;
+}
+
+// Latency at a percentile of a window, by nearest rank over the histogram
+static uint32_t gfnNetworkWindowPercentile(gfnNetworkWindow const* window, uint32_t count, unsigned int percent)
+{
+    uint32_t rank = (count * percent + 99) / 100;
+    uint32_t seen = 0;
+    unsigned int bucket;
+
+    for (bucket = 0; bucket < kGfnNetworkHistogramBuckets; bucket++)
+    {
+        seen += window->histogram[bucket];
+        if (seen >= rank && seen > 0)
+        {
+            return gfnNetworkHistogramLatency(bucket);
+        }
+    }
+    return gfnNetworkHistogramLatency(kGfnNetworkHistogramBuckets - 1);
+}
+
+static uint32_t gfnClampNetworkLatency(uint32_t latencyMs, uint32_t minMs, uint32_t maxMs)
+{
+    return (latencyMs < minMs) ? minMs : (latencyMs > maxMs) ? maxMs : latencyMs;
+}
+
+static void gfnFillNetworkStats(gfnNetworkTracker const* tracker, gfnNetworkStatsSnapshot* snapshot)
+{
+    GfnNetworkWindowStats* stats;
+    gfnNetworkWindow const* window;
+    uint32_t count;
+    int i;
+
+    memset(snapshot, 0, sizeof(*snapshot));
+    for (i = 0; i < GFN_NETWORK_STATS_WINDOW_COUNT; i++)
+    {
+        snapshot->stats.windows[i].windowMs = s_networkStatsConfig.windowMs[i];
+    }
+    if (tracker == NULL)
+    {
+        return;
+    }
+
+    snapshot->lastUpdateNs = tracker->lastUpdateNs;
+    snapshot->stats.updateCount = tracker->updateCount;
+    snapshot->stats.latestMs = tracker->latestMs;
+    snapshot->stats.ewmaMs = tracker->ewmaMs;
+    snapshot->stats.jitterMs = tracker->jitterMs;
+    for (i = 0; i < GFN_NETWORK_STATS_WINDOW_COUNT; i++)
+    {
+        window = &tracker->windows[i];
+        stats = &snapshot->stats.windows[i];
+        count = tracker->next - window->head;
+        if (count == 0)
+        {
+            continue;
+        }
+        stats->sampleCount = count;
+        stats->coveredMs = (unsigned int)((tracker->samples[(tracker->next - 1) & (kGfnNetworkSampleCapacity - 1)].timestampNs -
+            tracker->samples[window->head & (kGfnNetworkSampleCapacity - 1)].timestampNs) / 1000000ULL);
+        stats->minMs = gfnNetworkLatencyAt(tracker, window->minQueue[window->minFront & (kGfnNetworkSampleCapacity - 1)]);
+        stats->maxMs = gfnNetworkLatencyAt(tracker, window->maxQueue[window->maxFront & (kGfnNetworkSampleCapacity - 1)]);
+        stats->p50Ms = gfnClampNetworkLatency(gfnNetworkWindowPercentile(window, count, 50), stats->minMs, stats->maxMs);
+        stats->p95Ms = gfnClampNetworkLatency(gfnNetworkWindowPercentile(window, count, 95), stats->minMs, stats->maxMs);
+        stats->p99Ms = gfnClampNetworkLatency(gfnNetworkWindowPercentile(window, count, 99), stats->minMs, stats->maxMs);
+        stats->meanMs = (float)((double)window->sumMs / count);
+        stats->jitterMs = (count > 1) ? (float)((double)window->sumChangeMs / (count - 1)) : 0.0f;
+    }
+}
+
+// Fills a snapshot buffer that no reader has pinned and makes it the current one. Must be called with
+// s_networkStatsLock held.
+static void gfnPublishNetworkStats(gfnNetworkTracker const* tracker)
+{
+    int64_t current = gfnAtomicLoadRelaxed64(&s_networkStatsState) & (kGfnNetworkStatsBuffers - 1);
+    int64_t previous;
+    unsigned int index = 0;
+    unsigned int i;
+
+    for (i = 1; i < kGfnNetworkStatsBuffers; i++)
+    {
+        index = (unsigned int)(current + i) & (kGfnNetworkStatsBuffers - 1);
+        if (gfnAtomicLoadRelaxed64(&s_networkStatsPins[index]) == 0)
+        {
+            break;
+        }
+    }
+    if (i == kGfnNetworkStatsBuffers)
+    {
+        return;
+    }
+    gfnAtomicFence();
+    gfnFillNetworkStats(tracker, &s_networkStatsBuffers[index]);
+    previous = gfnAtomicExchange64(&s_networkStatsState, (int64_t)index);
+    gfnAtomicAdd64(&s_networkStatsPins[previous & (kGfnNetworkStatsBuffers - 1)], previous / kGfnNetworkStatsReader);
+}
+
+// Records the latency of a network status update. Returns the smoothed latency.
+static float gfnRecordNetworkLatency(uint32_t latencyMs)
+{
+    uint64_t nowNs = gfnGetMonotonicNs();
+    gfnNetworkTracker* tracker;
+    gfnNetworkWindow* window;
+    uint64_t windowNs;
+    uint32_t position;
+    float ewmaMs;
+    int i;
+
+    gfnMutexLock(&s_networkStatsLock);
+    if (s_networkTracker == NULL)
+    {
+        s_networkTracker = (gfnNetworkTracker*)calloc(1, sizeof(gfnNetworkTracker));
+    }
+    tracker = s_networkTracker;
+    if (tracker == NULL)
+    {
+        gfnMutexUnlock(&s_networkStatsLock);
+        return (float)latencyMs;
+    }
+
+    if (tracker->updateCount == 0)
+    {
+        tracker->ewmaMs = (float)latencyMs;
+    }
+    else
+    {
+        tracker->ewmaMs += ((float)latencyMs - tracker->ewmaMs) / 8.0f;
+        tracker->jitterMs += ((float)gfnNetworkLatencyChange(latencyMs, tracker->latestMs) - tracker->jitterMs) / 16.0f;
+    }
+    tracker->latestMs = latencyMs;
+    tracker->lastUpdateNs = nowNs;
+    tracker->updateCount++;
+
+    // The sample about to be overwritten leaves the windows that still hold it
+    position = tracker->next;
+    for (i = 0; i < GFN_NETWORK_STATS_WINDOW_COUNT; i++)
+    {
+        if (position - tracker->windows[i].head >= kGfnNetworkSampleCapacity)
+        {
+            gfnExpireNetworkSample(tracker, &tracker->windows[i]);
+        }
+    }
+    tracker->samples[position & (kGfnNetworkSampleCapacity - 1)].timestampNs = nowNs;
+    tracker->samples[position & (kGfnNetworkSampleCapacity - 1)].latencyMs = latencyMs;
+    for (i = 0; i < GFN_NETWORK_STATS_WINDOW_COUNT; i++)
+    {
+        gfnAddNetworkSample(tracker, &tracker->windows[i], position);
+    }
+    tracker->next = position + 1;
+
+    for (i = 0; i < GFN_NETWORK_STATS_WINDOW_COUNT; i++)
+    {
+        window = &tracker->windows[i];
+        windowNs = (uint64_t)s_networkStatsConfig.windowMs[i] * 1000000ULL;
+        while (window->head != tracker->next &&
+            nowNs - tracker->samples[window->head & (kGfnNetworkSampleCapacity - 1)].timestampNs > windowNs)
+        {
+            gfnExpireNetworkSample(tracker, window);
+        }
+    }
+
+    gfnPublishNetworkStats(tracker);
+    ewmaMs = tracker->ewmaMs;
+    gfnMutexUnlock(&s_networkStatsLock);
+    return ewmaMs;
+}
+
+static void gfnResetNetworkStats(void)
+{
+    gfnMutexLock(&s_networkStatsLock);
+    free(s_networkTracker);
+    s_networkTracker = NULL;
+    // The libraries are unloaded, so the trampoline has to be registered again
+    gfnAtomicExchange32(&s_networkStatsSubscribed, 0);
+    gfnPublishNetworkStats(NULL);
+    gfnMutexUnlock(&s_networkStatsLock);
+}
+
+// Defined with the quality advisor
+static void gfnAdviseOnLatency(float smoothedMs);
+
+static void GFN_CALLBACK _gfnNetworkStatusCallbackWrapper(int status, void* updateData, void* pData)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+    GfnNetworkStatusUpdateData const* update = (GfnNetworkStatusUpdateData const*)updateData;
+
+    (void)pData;
+    (void)status;
+    GFN_SDK_LOG_TRACE("Network performance update received");
+    gfnInvalidateSessionSnapshot();
+    if (update != NULL && update->updateType == gfnRTDAverageLatency)
+    {
+        gfnAdviseOnLatency(gfnRecordNetworkLatency(update->data.RTDAverageLatencyMs));
+    }
+
+    if (gfnIsCallbackDeliveryQueued())
+    {
+        gfnQueueNetworkStatusUpdate((GfnNetworkStatusUpdateData *)updateData);
+        return;
+    }
+
+    for (cursor = 0; gfnNextCallback(gfnCallbackNetworkStatus, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((NetworkStatusCallbackSig)invocation.fnCallback)((GfnNetworkStatusUpdateData *)updateData, invocation.pUserContext);
+    }
+}
+
+GfnRuntimeError GfnRegisterNetworkStatusCallback(NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(networkStatusCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+    GFN_SDK_LOG("Registering for NetworkStatus updates");
+    // The update rate is part of the library registration, so a new rate registers the trampoline again
+    if (gfnBeginCallbackRegistration(gfnCallbackNetworkStatus, (void*)networkStatusCallback, pUserContext, updateRateMs))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterNetworkStatusCallback, &_gfnNetworkStatusCallbackWrapper, updateRateMs, &g_callbackSlots[gfnCallbackNetworkStatus]);
+        if (GFNSDK_SUCCEEDED(status))
+        {
+            s_networkStatsOwnRate = false;
+        }
+    }
+    return gfnEndCallbackRegistration(gfnCallbackNetworkStatus, updateRateMs, status);
+}
+
+GfnRuntimeError GfnUnregisterNetworkStatusCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackNetworkStatus);
+}
+
+// Registers the NetworkStatus trampoline with the cloud library for the wrapper's own use, at the update
+// rate of the network statistics, unless a callback registration already did. The registration is
+// process-wide and outlives unregistering the application callback, so the trampoline keeps receiving
+// updates until the SDK is shut down. Must be called with g_callbackLock held.
+static GfnRuntimeError gfnRegisterNetworkStatusTrampoline(void)
+{
+    GfnRuntimeError status = gfnSuccess;
+    gfnCallbackSlot* registration = &g_callbackSlots[gfnCallbackNetworkStatus];
+    unsigned int updateRateMs;
+
+    if (registration->registered)
+    {
+        return gfnSuccess;
+    }
+    gfnMutexLock(&s_networkStatsLock);
+    updateRateMs = s_networkStatsConfig.updateRateMs;
+    gfnMutexUnlock(&s_networkStatsLock);
+
+    GFN_SDK_LOG("Registering for NetworkStatus updates at %u ms for the wrapper", updateRateMs);
+    CALL_CLOUD_LIBRARY(status, RegisterNetworkStatusCallback, &_gfnNetworkStatusCallbackWrapper, updateRateMs, registration);
+    if (GFNSDK_SUCCEEDED(status))
+    {
+        registration->registered = true;
+        registration->param = updateRateMs;
+        s_networkStatsOwnRate = true;
+    }
+    return status;
+}
+
+// Registers the wrapper's own subscription again when the configured update rate changes. A rate set by
+// an application callback registration is left alone.
+static GfnRuntimeError gfnUpdateNetworkStatusRate(unsigned int updateRateMs)
+{
+    GfnRuntimeError status = gfnSuccess;
+    gfnCallbackSlot* registration = &g_callbackSlots[gfnCallbackNetworkStatus];
+
+    gfnMutexLock(&g_callbackLock);
+    if (s_networkStatsOwnRate && registration->registered && registration->param != updateRateMs)
+    {
+        GFN_SDK_LOG("Registering for NetworkStatus updates again at %u ms for the wrapper", updateRateMs);
+        CALL_CLOUD_LIBRARY(status, RegisterNetworkStatusCallback, &_gfnNetworkStatusCallbackWrapper, updateRateMs, registration);
+        if (GFNSDK_SUCCEEDED(status))
+        {
+            registration->param = updateRateMs;
+        }
+    }
+    gfnMutexUnlock(&g_callbackLock);
+    return status;
+}
+
+// Subscribes the network quality tracker to network status updates
+static GfnRuntimeError gfnSubscribeNetworkStats(void)
+{
+    GfnRuntimeError status;
+
+    CHECK_CLOUD_ENVIRONMENT();
+
+    gfnMutexLock(&s_networkStatsLock);
+    if (s_networkTracker == NULL)
+    {
+        // Reports the window lengths until the first update
+        gfnPublishNetworkStats(NULL);
+    }
+    gfnMutexUnlock(&s_networkStatsLock);
+
+    gfnMutexLock(&g_callbackLock);
+    status = gfnRegisterNetworkStatusTrampoline();
+    if (GFNSDK_SUCCEEDED(status))
+    {
+        gfnAtomicExchange32(&s_networkStatsSubscribed, 1);
+    }
+    gfnMutexUnlock(&g_callbackLock);
+    return status;
+}
+
+GfnRuntimeError GfnGetNetworkStats(GfnNetworkStats* stats)
+{
+    GfnRuntimeError status;
+    int64_t state;
+    unsigned int index;
+    uint64_t lastUpdateNs;
+    uint64_t ageMs;
+
+    CHECK_NULL_PARAM(stats);
+    if (!gfnAtomicLoadAcquire32(&s_networkStatsSubscribed))
+    {
+        status = gfnSubscribeNetworkStats();
+        if (GFNSDK_FAILED(status))
+        {
+            return status;
+        }
+    }
+
+    state = gfnAtomicAdd64(&s_networkStatsState, kGfnNetworkStatsReader) - kGfnNetworkStatsReader;
+    index = (unsigned int)state & (kGfnNetworkStatsBuffers - 1);
+    *stats = s_networkStatsBuffers[index].stats;
+    lastUpdateNs = s_networkStatsBuffers[index].lastUpdateNs;
+    gfnAtomicAdd64(&s_networkStatsPins[index], -1);
+
+    if (lastUpdateNs != 0)
+    {
+        ageMs = (gfnGetMonotonicNs() - lastUpdateNs) / 1000000ULL;
+        stats->lastUpdateAgeMs = (ageMs < 0xFFFFFFFFULL) ? (unsigned int)ageMs : 0xFFFFFFFFu;
+        stats->lastUpdateAgeMs = (stats->lastUpdateAgeMs != 0) ? stats->lastUpdateAgeMs : 1;
+    }
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnSetNetworkStatsConfig(const GfnNetworkStatsConfig* config)
+{
+    bool windowsChanged = false;
+    int i;
+
+    CHECK_NULL_PARAM(config);
+    if (config->updateRateMs == 0)
+    {
+        return gfnInvalidParameter;
+    }
+    for (i = 0; i < GFN_NETWORK_STATS_WINDOW_COUNT; i++)
+    {
+        if (config->windowMs[i] == 0 || (i > 0 && config->windowMs[i] <= config->windowMs[i - 1]))
+        {
+            return gfnInvalidParameter;
+        }
+    }
+    // A window needs one sample per update within it, plus the one at its start
+    if (config->windowMs[GFN_NETWORK_STATS_WINDOW_COUNT - 1] / config->updateRateMs >= kGfnNetworkSampleCapacity)
+    {
+        return gfnInvalidParameter;
+    }
+
+    gfnMutexLock(&s_networkStatsLock);
+    windowsChanged = memcmp(s_networkStatsConfig.windowMs, config->windowMs, sizeof(config->windowMs)) != 0;
+    s_networkStatsConfig = *config;
+    if (windowsChanged)
+    {
+        free(s_networkTracker);
+        s_networkTracker = NULL;
+        gfnPublishNetworkStats(NULL);
+    }
+    gfnMutexUnlock(&s_networkStatsLock);
+    return gfnUpdateNetworkStatusRate(config->updateRateMs);
+}
+
+// Quality advisor. The advisor keeps its inputs, the client resolution and safe zone, whether RTX is
+// enabled and the smoothed round trip delay, in the advice itself, and recomputes the recommendation
+// from them on every ClientInfo and network status update. The latency tier only moves up once the
+// delay reaches the threshold of the next tier, only moves down once it falls hysteresisMs below the
+// threshold of the current one, and only changes once holdMs have passed since its last change; the
+// frame rate cap follows the tier. When the result differs from the current advice, its revision is
+// bumped and it is delivered through the gfnCallbackQualityAdvice slots, outside the advisor lock.
+static gfnMutex s_qualityAdvisorLock = GFN_MUTEX_INITIALIZER;
+static GfnQualityAdvisorConfig s_qualityAdvisorConfig =         // Guarded by s_qualityAdvisorLock
+{
+    2160, 1080, { 40, 80, 150 }, 10, 5000, { 60, 60, 60, 30 }
+};
+static GfnQualityAdvice s_qualityAdvice;                        // Guarded by s_qualityAdvisorLock
+static uint64_t s_qualityTierChangedNs = 0;                     // Guarded by s_qualityAdvisorLock
+static gfnAtomic32 s_qualityAdvisorStarted = 0;
+
+// Latency tier for a round trip delay, moving at most as far from the current tier as the hysteresis allows
+static GfnLatencyCompensationTier gfnChooseLatencyTier(GfnLatencyCompensationTier current, unsigned int rtdMs,
+    GfnQualityAdvisorConfig const* config)
+{
+    int tier = (int)current;
+
+    while (tier < GFN_LATENCY_COMPENSATION_TIER_COUNT - 1 && rtdMs >= config->tierThresholdMs[tier])
+    {
+        tier++;
+    }
+    while (tier > 0 && rtdMs + config->hysteresisMs < config->tierThresholdMs[tier - 1])
+    {
+        tier--;
+    }
+    return (GfnLatencyCompensationTier)tier;
+}
+
+// Scales the client resolution down, keeping its aspect ratio, until its shorter side fits the height limit
+static void gfnFitRenderResolution(GfnQualityAdvice* advice, GfnQualityAdvisorConfig const* config)
+{
+    unsigned int limit = advice->rtxEnabled ? config->maxRenderHeight : config->maxRenderHeightNonRtx;
+    unsigned int shortSide = (advice->clientWidth < advice->clientHeight) ? advice->clientWidth : advice->clientHeight;
+
+    if (shortSide <= limit)
+    {
+        advice->renderWidth = advice->clientWidth;
+        advice->renderHeight = advice->clientHeight;
+        return;
+    }
+    // Even dimensions, as video encoders expect
+    advice->renderWidth = (unsigned int)((uint64_t)advice->clientWidth * limit / shortSide) & ~1u;
+    advice->renderHeight = (unsigned int)((uint64_t)advice->clientHeight * limit / shortSide) & ~1u;
+}
+
+static bool gfnQualityAdviceEquals(GfnQualityAdvice const* a, GfnQualityAdvice const* b)
+{
+    return a->renderWidth == b->renderWidth && a->renderHeight == b->renderHeight &&
+        a->frameRateCap == b->frameRateCap && a->latencyCompensation == b->latencyCompensation &&
+        a->clientWidth == b->clientWidth && a->clientHeight == b->clientHeight &&
+        a->safeZone.value1 == b->safeZone.value1 && a->safeZone.value2 == b->safeZone.value2 &&
+        a->safeZone.value3 == b->safeZone.value3 && a->safeZone.value4 == b->safeZone.value4 &&
+        a->safeZone.normalized == b->safeZone.normalized && a->safeZone.format == b->safeZone.format &&
+        a->rtxEnabled == b->rtxEnabled;
+}
+
+// Recomputes the recommendation from the inputs in next and makes it the current advice if it changed.
+// Returns true if it did. The smoothed delay alone is not a change, so it does not cause a delivery.
+// Must be called with s_qualityAdvisorLock held.
+static bool gfnRefreshQualityAdvice(GfnQualityAdvice* next, uint64_t nowNs)
+{
+    GfnQualityAdvisorConfig const* config = &s_qualityAdvisorConfig;
+    GfnLatencyCompensationTier tier = gfnChooseLatencyTier(next->latencyCompensation, next->rtdMs, config);
+
+    if (tier != next->latencyCompensation &&
+        (next->revision == 0 || nowNs - s_qualityTierChangedNs >= (uint64_t)config->holdMs * 1000000ULL))
+    {
+        next->latencyCompensation = tier;
+        s_qualityTierChangedNs = nowNs;
+    }
+    next->frameRateCap = config->frameRateCap[next->latencyCompensation];
+    gfnFitRenderResolution(next, config);
+
+    if (next->revision != 0 && gfnQualityAdviceEquals(next, &s_qualityAdvice))
+    {
+        s_qualityAdvice.rtdMs = next->rtdMs;
+        return false;
+    }
+    next->revision++;
+    s_qualityAdvice = *next;
+    return true;
+}
+
+static void gfnDeliverQualityAdvice(GfnQualityAdvice const* advice)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    GFN_SDK_LOG("Quality advice %llu: render %ux%u, frame rate cap %u, latency compensation %d at %u ms",
+        (unsigned long long)advice->revision, advice->renderWidth, advice->renderHeight, advice->frameRateCap,
+        (int)advice->latencyCompensation, advice->rtdMs);
+    if (gfnIsCallbackDeliveryQueued())
+    {
+        gfnQueueQualityAdvice(advice);
+        return;
+    }
+    for (cursor = 0; gfnNextCallback(gfnCallbackQualityAdvice, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((QualityAdviceCallbackSig)invocation.fnCallback)(advice, invocation.pUserContext);
+    }
+}
+
+static void gfnAdviseOnClientInfo(GfnClientInfoUpdateData const* update)
+{
+    GfnQualityAdvice next;
+    bool changed;
+
+    if (!gfnAtomicLoadAcquire32(&s_qualityAdvisorStarted) ||
+        (update->updateType != gfnClientResolution && update->updateType != gfnSafeZone))
+    {
+        return;
+    }
+    gfnMutexLock(&s_qualityAdvisorLock);
+    next = s_qualityAdvice;
+    if (update->updateType == gfnClientResolution)
+    {
+        next.clientWidth = update->data.clientResolution.horizontalPixels;
+        next.clientHeight = update->data.clientResolution.verticalPixels;
+    }
+    else
+    {
+        next.safeZone = update->data.safeZone;
+    }
+    changed = next.revision != 0 && gfnRefreshQualityAdvice(&next, gfnGetMonotonicNs());
+    gfnMutexUnlock(&s_qualityAdvisorLock);
+    if (changed)
+    {
+        gfnDeliverQualityAdvice(&next);
+    }
+}
+
+static void gfnAdviseOnLatency(float smoothedMs)
+{
+    GfnQualityAdvice next;
+    bool changed;
+
+    if (!gfnAtomicLoadAcquire32(&s_qualityAdvisorStarted))
+    {
+        return;
+    }
+    gfnMutexLock(&s_qualityAdvisorLock);
+    next = s_qualityAdvice;
+    next.rtdMs = (unsigned int)(smoothedMs + 0.5f);
+    changed = next.revision != 0 && gfnRefreshQualityAdvice(&next, gfnGetMonotonicNs());
+    gfnMutexUnlock(&s_qualityAdvisorLock);
+    if (changed)
+    {
+        gfnDeliverQualityAdvice(&next);
+    }
+}
+
+// Subscribes the advisor to ClientInfo and network status updates and computes the first advice from the
+// client and session info. The gfnCallbackQualityAdvice registration tracks whether the advisor runs.
+// Must be called with g_callbackLock held.
+static GfnRuntimeError gfnStartQualityAdvisor(void)
+{
+    GfnRuntimeError status = gfnSuccess;
+    gfnCallbackSlot* clientInfoRegistration = &g_callbackSlots[gfnCallbackClientInfo];
+    GfnClientInfo clientInfo;
+    GfnSessionInfo sessionInfo;
+    GfnQualityAdvice next;
+
+    if (g_callbackSlots[gfnCallbackQualityAdvice].registered)
+    {
+        return gfnSuccess;
+    }
+    if (!clientInfoRegistration->registered)
+    {
+        GFN_SDK_LOG("Registering for ClientInfo updates for the quality advisor");
+        CALL_CLOUD_LIBRARY(status, RegisterClientInfoCallback, &_gfnClientInfoCallbackWrapper, clientInfoRegistration);
+        if (GFNSDK_FAILED(status))
+        {
+            return status;
+        }
+        clientInfoRegistration->registered = true;
+        clientInfoRegistration->param = 0;
+    }
+    status = gfnRegisterNetworkStatusTrampoline();
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+
+    // Missing info only leaves the advice without a resolution until the next update
+    memset(&clientInfo, 0, sizeof(clientInfo));
+    memset(&sessionInfo, 0, sizeof(sessionInfo));
+    CALL_CLOUD_LIBRARY(status, GetClientInfo, &clientInfo);
+    if (GFNSDK_FAILED(status))
+    {
+        GFN_SDK_LOG_WARNING("Quality advisor could not read the client info: %d", (int)status);
+    }
+    CALL_CLOUD_LIBRARY(status, GetSessionInfo, &sessionInfo);
+    if (GFNSDK_FAILED(status))
+    {
+        GFN_SDK_LOG_WARNING("Quality advisor could not read the session info: %d", (int)status);
+    }
+
+    gfnMutexLock(&s_qualityAdvisorLock);
+    memset(&next, 0, sizeof(next));
+    next.clientWidth = clientInfo.clientResolution.horizontalPixels;
+    next.clientHeight = clientInfo.clientResolution.verticalPixels;
+    next.rtdMs = clientInfo.RTDAverageLatencyMs;
+    next.rtxEnabled = sessionInfo.sessionRTXEnabled;
+    gfnRefreshQualityAdvice(&next, gfnGetMonotonicNs());
+    gfnMutexUnlock(&s_qualityAdvisorLock);
+
+    g_callbackSlots[gfnCallbackQualityAdvice].registered = true;
+    gfnAtomicExchange32(&s_qualityAdvisorStarted, 1);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnRegisterQualityAdviceCallback(QualityAdviceCallbackSig adviceCallback, void* userContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(adviceCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+    GFN_SDK_LOG("Registering for quality advice");
+    if (gfnBeginCallbackRegistration(gfnCallbackQualityAdvice, (void*)adviceCallback, userContext, 0))
+    {
+        status = gfnStartQualityAdvisor();
+    }
+    return gfnEndCallbackRegistration(gfnCallbackQualityAdvice, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterQualityAdviceCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackQualityAdvice);
+}
+
+GfnRuntimeError GfnGetQualityAdvice(GfnQualityAdvice* advice)
+{
+    GfnRuntimeError status;
+
+    CHECK_NULL_PARAM(advice);
+    CHECK_CLOUD_ENVIRONMENT();
+    if (!gfnAtomicLoadAcquire32(&s_qualityAdvisorStarted))
+    {
+        gfnMutexLock(&g_callbackLock);
+        status = gfnStartQualityAdvisor();
+        gfnMutexUnlock(&g_callbackLock);
+        if (GFNSDK_FAILED(status))
+        {
+            return status;
+        }
+    }
+    gfnMutexLock(&s_qualityAdvisorLock);
+    *advice = s_qualityAdvice;
+    gfnMutexUnlock(&s_qualityAdvisorLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnSetQualityAdvisorConfig(const GfnQualityAdvisorConfig* config)
+{
+    int i;
+
+    CHECK_NULL_PARAM(config);
+    if (config->maxRenderHeight == 0 || config->maxRenderHeightNonRtx == 0)
+    {
+        return gfnInvalidParameter;
+    }
+    for (i = 0; i < GFN_LATENCY_COMPENSATION_TIER_COUNT; i++)
+    {
+        if (config->frameRateCap[i] == 0 ||
+            (i > 0 && i < GFN_LATENCY_COMPENSATION_TIER_COUNT - 1 && config->tierThresholdMs[i] <= config->tierThresholdMs[i - 1]))
+        {
+            return gfnInvalidParameter;
+        }
+    }
+
+    gfnMutexLock(&s_qualityAdvisorLock);
+    s_qualityAdvisorConfig = *config;
+    gfnMutexUnlock(&s_qualityAdvisorLock);
+    return gfnSuccess;
+}
+
+// Stops the advisor. Its registration was dropped with the callback slots.
+static void gfnResetQualityAdvisor(void)
+{
+    gfnAtomicExchange32(&s_qualityAdvisorStarted, 0);
+    gfnMutexLock(&s_qualityAdvisorLock);
+    memset(&s_qualityAdvice, 0, sizeof(s_qualityAdvice));
+    s_qualityTierChangedNs = 0;
+    gfnMutexUnlock(&s_qualityAdvisorLock);
+}
+
+// Defined with the pause controller
+static void gfnPauseOnStreamStatus(GfnStreamStatus streamStatus);
+
+static GfnApplicationCallbackResult GFN_CALLBACK _gfnStreamStatusCallbackWrapper(GfnStreamStatus streamStatus, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+    GfnApplicationCallbackResult result;
+
+    (void)pContext;
+    gfnPauseOnStreamStatus(streamStatus);
+    if (gfnIsCallbackDeliveryQueued())
+    {
+        gfnQueueStreamStatus(streamStatus);
+        return crCallbackSuccess;
+    }
+    // Each context answers; the event fails if any of them fails it
+    result = crCallbackSuccess;
+    for (cursor = 0; gfnNextCallback(gfnCallbackStreamStatus, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        if (((StreamStatusCallbackSig)invocation.fnCallback)(streamStatus, invocation.pUserContext) != crCallbackSuccess)
+        {
+            result = crCallbackFailure;
+        }
+    }
+    return result;
+}
+
+GfnRuntimeError GfnRegisterStreamStatusCallback(StreamStatusCallbackSig streamStatusCallback, void* userContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(streamStatusCallback);
+    if (gfnBeginCallbackRegistration(gfnCallbackStreamStatus, (void*)streamStatusCallback, userContext, 0))
+    {
+        CALL_CLIENT_LIBRARY(status, RegisterStreamStatusCallback, &_gfnStreamStatusCallbackWrapper, &g_callbackSlots[gfnCallbackStreamStatus]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackStreamStatus, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterStreamStatusCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackStreamStatus);
+}
+
+GfnRuntimeError GfnStartStream(StartStreamInput * startStreamInput, StartStreamResponse* response)
+{
+    DELEGATE_TO_CLIENT_LIBRARY(StartStream, startStreamInput, response);
+}
+
+GfnRuntimeError GfnStartStreamAsync(const StartStreamInput* startStreamInput, StartStreamCallbackSig cb, void* context, unsigned int timeoutMs)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    if (!gfnEnterLibraryCall(GFN_STATE_CLIENT_LIVE))
+    {
+        return gfnAPINotInit;
+    }
+    if (g_clientLibrary.StartStreamAsync == NULL)
+    {
+        status = gfnAPINotFound;
+    }
+    else
+    {
+        g_clientLibrary.StartStreamAsync(startStreamInput, cb, context, timeoutMs);
+    }
+    gfnLeaveLibraryCall();
+
+    return status;
+}
+
+GfnRuntimeError GfnStopStream(void)
+{
+    DELEGATE_TO_CLIENT_LIBRARY(StopStream);
+}
+
+GfnRuntimeError GfnStopStreamAsync(StopStreamCallbackSig cb, void* context, unsigned int timeoutMs)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    if (!gfnEnterLibraryCall(GFN_STATE_CLIENT_LIVE))
+    {
+        return gfnAPINotInit;
+    }
+    if (g_clientLibrary.StopStreamAsync == NULL)
+    {
+        status = gfnAPINotFound;
+    }
+    else
+    {
+        g_clientLibrary.StopStreamAsync(cb, context, timeoutMs);
+    }
+    gfnLeaveLibraryCall();
+
+    return status;
+}
+
+GfnRuntimeError GfnSetupTitle(const char* platformAppId)
+{
+    CHECK_NULL_PARAM(platformAppId);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(SetupTitle, platformAppId);
+}
+
+GfnRuntimeError GfnTitleExited(const char* platformId, const char* platformAppId)
+{
+    CHECK_NULL_PARAM(platformId);
+    CHECK_NULL_PARAM(platformAppId);
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(TitleExited, platformId, platformAppId);
+}
+
+GfnRuntimeError GfnAppReady(bool success, const char* status)
+{
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(AppReady, success, status);
+}
+
+// Action zones. The wrapper remembers the zones it has set in the cloud library, keyed by type and id,
+// so GfnSetActionZones only calls the library for zones that were added, moved by more than the
+// configured epsilon, or removed. With coalescing configured, a set submitted less than coalesceMs
+// after the last flush is held and replaced by later sets until the next flush. GfnSetActionZone
+// always calls the library, so the library still validates every call, and records the result so
+// later sets are compared against it.
+typedef struct gfnActionZoneEntry
+{
+    GfnActionType type;
+    unsigned int id;
+    GfnRect zone;
+    unsigned int order;                 // Position in the submitted set, so the last duplicate wins
+} gfnActionZoneEntry;
+
+// Everything below is guarded by s_actionZoneLock, which is also held while the library is called so
+// updates reach it in the order they were made
+static gfnMutex s_actionZoneLock = GFN_MUTEX_INITIALIZER;
+static GfnActionZoneConfig s_actionZoneConfig = { 0.0001f, 0 };
+static GfnActionZoneStats s_actionZoneStats;
+static gfnActionZoneEntry* s_actionZones = NULL;            // Zones set in the library, sorted by key
+static unsigned int s_actionZoneCount = 0;
+static unsigned int s_actionZoneCapacity = 0;
+static gfnActionZoneEntry* s_pendingActionZones = NULL;     // Set waiting for the next flush
+static unsigned int s_pendingActionZoneCount = 0;
+static unsigned int s_pendingActionZoneCapacity = 0;
+static bool s_actionZonesPending = false;
+static uint64_t s_actionZonesFlushedNs = 0;
+
+static int gfnCompareActionZoneKeys(gfnActionZoneEntry const* a, gfnActionZoneEntry const* b)
+{
+    if (a->type != b->type)
+    {
+        return (a->type < b->type) ? -1 : 1;
+    }
+    if (a->id != b->id)
+    {
+        return (a->id < b->id) ? -1 : 1;
+    }
+    return 0;
+}
+
+static int gfnCompareActionZones(void const* a, void const* b)
+{
+    gfnActionZoneEntry const* zoneA = (gfnActionZoneEntry const*)a;
+    gfnActionZoneEntry const* zoneB = (gfnActionZoneEntry const*)b;
+    int keys = gfnCompareActionZoneKeys(zoneA, zoneB);
+
+    if (keys != 0)
+    {
+        return keys;
+    }
+    return (zoneA->order < zoneB->order) ? -1 : (zoneA->order > zoneB->order) ? 1 : 0;
+}
+
+static bool gfnActionZoneValuesMatch(float a, float b, float epsilon)
+{
+    return (a > b) ? a - b <= epsilon : b - a <= epsilon;
+}
+
+static bool gfnActionZoneRectsMatch(GfnRect const* a, GfnRect const* b, float epsilon)
+{
+    return a->normalized == b->normalized && a->format == b->format
+        && gfnActionZoneValuesMatch(a->value1, b->value1, epsilon) && gfnActionZoneValuesMatch(a->value2, b->value2, epsilon)
+        && gfnActionZoneValuesMatch(a->value3, b->value3, epsilon) && gfnActionZoneValuesMatch(a->value4, b->value4, epsilon);
+}
+
+static bool gfnReserveActionZones(gfnActionZoneEntry** zones, unsigned int* capacity, unsigned int count)
+{
+    gfnActionZoneEntry* grown;
+    unsigned int newCapacity = (*capacity != 0) ? *capacity : 16;
+
+    if (count <= *capacity)
+    {
+        return true;
+    }
+    while (newCapacity < count)
+    {
+        newCapacity *= 2;
+    }
+    grown = (gfnActionZoneEntry*)realloc(*zones, newCapacity * sizeof(gfnActionZoneEntry));
+    if (grown == NULL)
+    {
+        return false;
+    }
+    *zones = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+// Returns the position of the zone with the same key as entry in s_actionZones, or where it would go
+static unsigned int gfnFindActionZone(gfnActionZoneEntry const* entry)
+{
+    unsigned int low = 0;
+    unsigned int high = s_actionZoneCount;
+    unsigned int middle;
+
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+        if (gfnCompareActionZoneKeys(&s_actionZones[middle], entry) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Sets or removes one zone in the library, unless diff is set and that would not change it, and records
+// the result. Must be called with s_actionZoneLock held.
+static GfnRuntimeError gfnForwardActionZone(gfnActionZoneEntry const* entry, bool set, bool diff)
+{
+    unsigned int position = gfnFindActionZone(entry);
+    bool known = position < s_actionZoneCount && gfnCompareActionZoneKeys(&s_actionZones[position], entry) == 0;
+    GfnRect zone;
+    GfnRuntimeError status;
+
+    if (diff && (set ? (known && gfnActionZoneRectsMatch(&s_actionZones[position].zone, &entry->zone, s_actionZoneConfig.epsilon)) : !known))
+    {
+        s_actionZoneStats.unchanged++;
+        return gfnSuccess;
+    }
+    if (set && !known && !gfnReserveActionZones(&s_actionZones, &s_actionZoneCapacity, s_actionZoneCount + 1))
+    {
+        return gfnUnableToAllocateMemory;
+    }
+    zone = entry->zone;
+    CALL_CLOUD_LIBRARY(status, SetActionZone, entry->type, entry->id, set ? &zone : NULL);
+    if (GFNSDK_FAILED(status))
+    {
+        // Left as it was, so the next update tries again
+        s_actionZoneStats.errors++;
+        return status;
+    }
+    if (!set)
+    {
+        s_actionZoneStats.removed++;
+        if (!known)
+        {
+            return gfnSuccess;
+        }
+        memmove(&s_actionZones[position], &s_actionZones[position + 1], (s_actionZoneCount - position - 1) * sizeof(gfnActionZoneEntry));
+        s_actionZoneCount--;
+        return gfnSuccess;
+    }
+    s_actionZoneStats.forwarded++;
+    if (!known)
+    {
+        memmove(&s_actionZones[position + 1], &s_actionZones[position], (s_actionZoneCount - position) * sizeof(gfnActionZoneEntry));
+        s_actionZoneCount++;
+    }
+    s_actionZones[position] = *entry;
+    return gfnSuccess;
+}
+
+// Makes the zones in the library match the pending set. Must be called with s_actionZoneLock held.
+// Returns the first error, after trying every zone.
+static GfnRuntimeError gfnFlushActionZones(void)
+{
+    GfnRuntimeError status = gfnSuccess;
+    GfnRuntimeError zoneStatus;
+    gfnActionZoneEntry removed;
+    unsigned int count = 0;
+    unsigned int i;
+    unsigned int j;
+
+    if (!s_actionZonesPending)
+    {
+        return gfnSuccess;
+    }
+    s_actionZonesPending = false;
+    s_actionZonesFlushedNs = gfnGetMonotonicNs();
+    s_actionZoneStats.flushes++;
+
+    // Sort the set by key and keep the last of any duplicates
+    qsort(s_pendingActionZones, s_pendingActionZoneCount, sizeof(gfnActionZoneEntry), gfnCompareActionZones);
+    for (i = 0; i < s_pendingActionZoneCount; i++)
+    {
+        if (i + 1 < s_pendingActionZoneCount && gfnCompareActionZoneKeys(&s_pendingActionZones[i], &s_pendingActionZones[i + 1]) == 0)
+        {
+            s_actionZoneStats.unchanged++;
+            continue;
+        }
+        s_pendingActionZones[count++] = s_pendingActionZones[i];
+    }
+
+    // Remove zones missing from the set, walking both sorted lists. Removals shift s_actionZones down,
+    // so j only advances past zones that are kept.
+    for (i = 0, j = 0; j < s_actionZoneCount; )
+    {
+        while (i < count && gfnCompareActionZoneKeys(&s_pendingActionZones[i], &s_actionZones[j]) < 0)
+        {
+            i++;
+        }
+        if (i < count && gfnCompareActionZoneKeys(&s_pendingActionZones[i], &s_actionZones[j]) == 0)
+        {
+            j++;
+            continue;
+        }
+        removed = s_actionZones[j];
+        zoneStatus = gfnForwardActionZone(&removed, false, true);
+        if (GFNSDK_FAILED(zoneStatus))
+        {
+            status = GFNSDK_FAILED(status) ? status : zoneStatus;
+            j++;
+        }
+    }
+
+    // Then add and move the zones in the set
+    for (i = 0; i < count; i++)
+    {
+        zoneStatus = gfnForwardActionZone(&s_pendingActionZones[i], true, true);
+        if (GFNSDK_FAILED(zoneStatus) && GFNSDK_SUCCEEDED(status))
+        {
+            status = zoneStatus;
+        }
+    }
+    return status;
+}
+
+GfnRuntimeError GfnSetActionZone(GfnActionType type, unsigned int id, GfnRect* zone)
+{
+    gfnActionZoneEntry entry;
+    GfnRuntimeError status;
+    GfnRuntimeError flushStatus;
+
+    CHECK_CLOUD_ENVIRONMENT();
+    memset(&entry, 0, sizeof(entry));
+    entry.type = type;
+    entry.id = id;
+    if (zone != NULL)
+    {
+        entry.zone = *zone;
+    }
+    gfnMutexLock(&s_actionZoneLock);
+    // A pending set was submitted first, so it is applied first
+    flushStatus = gfnFlushActionZones();
+    s_actionZoneStats.submitted++;
+    status = gfnForwardActionZone(&entry, zone != NULL, false);
+    gfnMutexUnlock(&s_actionZoneLock);
+    return GFNSDK_FAILED(flushStatus) ? flushStatus : status;
+}
+
+GfnRuntimeError GfnSetActionZones(const GfnActionZone* zones, unsigned int count)
+{
+    GfnRuntimeError status = gfnSuccess;
+    unsigned int i;
+
+    if (zones == NULL && count != 0)
+    {
+        return gfnInvalidParameter;
+    }
+    CHECK_CLOUD_ENVIRONMENT();
+    gfnMutexLock(&s_actionZoneLock);
+    if (!gfnReserveActionZones(&s_pendingActionZones, &s_pendingActionZoneCapacity, count))
+    {
+        gfnMutexUnlock(&s_actionZoneLock);
+        return gfnUnableToAllocateMemory;
+    }
+    if (s_actionZonesPending)
+    {
+        s_actionZoneStats.coalesced += s_pendingActionZoneCount;
+    }
+    for (i = 0; i < count; i++)
+    {
+        s_pendingActionZones[i].type = zones[i].type;
+        s_pendingActionZones[i].id = zones[i].id;
+        s_pendingActionZones[i].zone = zones[i].zone;
+        s_pendingActionZones[i].order = i;
+    }
+    s_pendingActionZoneCount = count;
+    s_actionZonesPending = true;
+    s_actionZoneStats.submitted += count;
+    if (s_actionZoneConfig.coalesceMs == 0
+        || gfnGetMonotonicNs() - s_actionZonesFlushedNs >= (uint64_t)s_actionZoneConfig.coalesceMs * 1000000)
+    {
+        status = gfnFlushActionZones();
+    }
+    gfnMutexUnlock(&s_actionZoneLock);
+    return status;
+}
+
+GfnRuntimeError GfnFlushActionZones(void)
+{
+    GfnRuntimeError status;
+
+    CHECK_CLOUD_ENVIRONMENT();
+    gfnMutexLock(&s_actionZoneLock);
+    status = gfnFlushActionZones();
+    gfnMutexUnlock(&s_actionZoneLock);
+    return status;
+}
+
+GfnRuntimeError GfnSetActionZoneConfig(const GfnActionZoneConfig* config)
+{
+    CHECK_NULL_PARAM(config);
+    // Written this way so that NaN is rejected too
+    if (!(config->epsilon >= 0.0f))
+    {
+        return gfnInvalidParameter;
+    }
+    gfnMutexLock(&s_actionZoneLock);
+    s_actionZoneConfig = *config;
+    gfnMutexUnlock(&s_actionZoneLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnGetActionZoneStats(GfnActionZoneStats* stats)
+{
+    CHECK_NULL_PARAM(stats);
+    gfnMutexLock(&s_actionZoneLock);
+    *stats = s_actionZoneStats;
+    gfnMutexUnlock(&s_actionZoneLock);
+    return gfnSuccess;
+}
+
+// The zones set in the library belong to the session that ends with shutdown
+static void gfnResetActionZones(void)
+{
+    gfnMutexLock(&s_actionZoneLock);
+    free(s_actionZones);
+    free(s_pendingActionZones);
+    s_actionZones = NULL;
+    s_actionZoneCount = 0;
+    s_actionZoneCapacity = 0;
+    s_pendingActionZones = NULL;
+    s_pendingActionZoneCount = 0;
+    s_pendingActionZoneCapacity = 0;
+    s_actionZonesPending = false;
+    s_actionZonesFlushedNs = 0;
+    gfnMutexUnlock(&s_actionZoneLock);
+}
+
+GfnRuntimeError GfnSendMessage(const char* pchMessage, unsigned int length) {
+    GfnRuntimeError status = gfnSuccess;
+
+    // Prefer the cloud library when it is loaded and exports the API, otherwise fall back to the client library
+    if (gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))
+    {
+        if (g_pCloudLibrary->SendMessage != NULL)
+        {
+            GFN_TIMED_STATUS_CALL(status, gfnApiCloudSendMessage,
+                gfnTranslateCloudStatus(g_pCloudLibrary->SendMessage(pchMessage, length)));
+            gfnLeaveLibraryCall();
+            return status;
+        }
+        gfnLeaveLibraryCall();
+    }
+    DELEGATE_TO_CLIENT_LIBRARY(SendMessage, pchMessage, length);
+}
+
+GfnRuntimeError GfnOpenURLOnClient(const char* pchUrl) {
+    CHECK_CLOUD_ENVIRONMENT();
+    DELEGATE_TO_CLOUD_LIBRARY(OpenURLOnClient, pchUrl);
+}
+
+// Defined with the exit orchestrator
+static void gfnExitOnExitCallback(void);
+
+static void GFN_CALLBACK _gfnExitCallbackWrapper(int status, void* pUnused, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pContext;
+    (void)status;
+    (void)pUnused;
+    for (cursor = 0; gfnNextCallback(gfnCallbackExit, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((ExitCallbackSig)invocation.fnCallback)(invocation.pUserContext);
+    }
+    // Runs the exit tasks and shuts the SDK down, so it comes after every callback
+    gfnExitOnExitCallback();
+}
+
+GfnRuntimeError GfnRegisterExitCallback(ExitCallbackSig exitCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(exitCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+
+    GFN_SDK_LOG("Registering for Exit Callback updates");
+
+    if (gfnBeginCallbackRegistration(gfnCallbackExit, (void*)exitCallback, pUserContext, 0))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterExitCallback, &_gfnExitCallbackWrapper, &g_callbackSlots[gfnCallbackExit]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackExit, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterExitCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackExit);
+}
+
+// Defined with the pause controller
+static void gfnPauseOnPauseCallback(void);
+
+static void GFN_CALLBACK _gfnPauseCallbackWrapper(int status, void* pUnused, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pContext;
+    (void)status;
+    (void)pUnused;
+    // Trims the seat before the application shows its pause screen
+    gfnPauseOnPauseCallback();
+    for (cursor = 0; gfnNextCallback(gfnCallbackPause, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((PauseCallbackSig)invocation.fnCallback)(invocation.pUserContext);
+    }
+}
+
+GfnRuntimeError GfnRegisterPauseCallback(PauseCallbackSig pauseCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(pauseCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+
+    GFN_SDK_LOG("Registering for Pause Callback updates");
+
+    if (gfnBeginCallbackRegistration(gfnCallbackPause, (void*)pauseCallback, pUserContext, 0))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterPauseCallback, &_gfnPauseCallbackWrapper, &g_callbackSlots[gfnCallbackPause]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackPause, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterPauseCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackPause);
+}
+
+// Defined with the prefetcher
+static void gfnPrefetchOnInstall(TitleInstallationInformation const* installation);
+
+static void GFN_CALLBACK _gfnInstallCallbackWrapper(int status, void* pTitleInstallationInformation, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pContext;
+    (void)status;
+    gfnInvalidateTitleIndex();
+    gfnPrefetchOnInstall((TitleInstallationInformation const*)pTitleInstallationInformation);
+    for (cursor = 0; gfnNextCallback(gfnCallbackInstall, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((InstallCallbackSig)invocation.fnCallback)((TitleInstallationInformation*)pTitleInstallationInformation, invocation.pUserContext);
+    }
+}
+
+GfnRuntimeError GfnRegisterInstallCallback(InstallCallbackSig installCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(installCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+
+    GFN_SDK_LOG("Registering for Install Callback updates");
+
+    if (gfnBeginCallbackRegistration(gfnCallbackInstall, (void*)installCallback, pUserContext, 0))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterInstallCallback, &_gfnInstallCallbackWrapper, &g_callbackSlots[gfnCallbackInstall]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackInstall, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterInstallCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackInstall);
+}
+
+// Defined with the save scheduler
+static void gfnAnswerSaveRequest(void);
+
+static void GFN_CALLBACK _gfnSaveCallbackWrapper(int status, void* pUnused, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pContext;
+    (void)status;
+    (void)pUnused;
+    gfnAnswerSaveRequest();
+    for (cursor = 0; gfnNextCallback(gfnCallbackSave, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((SaveCallbackSig)invocation.fnCallback)(invocation.pUserContext);
+    }
+}
+
+GfnRuntimeError GfnRegisterSaveCallback(SaveCallbackSig saveCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(saveCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+
+    GFN_SDK_LOG("Registering for Save Callback updates");
+
+    if (gfnBeginCallbackRegistration(gfnCallbackSave, (void*)saveCallback, pUserContext, 0))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterSaveCallback, &_gfnSaveCallbackWrapper, &g_callbackSlots[gfnCallbackSave]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackSave, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterSaveCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackSave);
+}
+
+// Save scheduler. A background thread reads the session info every pollIntervalSec and keeps the end of
+// the session as a monotonic deadline, so the time remaining is known between reads without calling the
+// SDK library. Scheduled saves start leadTimeSec before the deadline and are spaced intervalSec apart
+// from the start of the previous attempt, whether it was scheduled or requested. The Save trampoline
+// answers GeForce NOW's SaveCallback before calling the application's callbacks: it waits for a save in
+// progress, then runs the job only if no save completed within freshnessSec.
+//
+// s_saveJobLock is held while a job runs, so jobs never overlap; it is taken before s_saveSchedulerLock,
+// which guards the rest of the state and is never held while calling the job or the SDK library.
+#define kGfnSaveNotDue UINT64_MAX
+
+static gfnMutex s_saveSchedulerLifecycleLock = GFN_MUTEX_INITIALIZER;  // Serializes starting and stopping
+static gfnMutex s_saveJobLock = GFN_MUTEX_INITIALIZER;
+static gfnMutex s_saveSchedulerLock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_saveSchedulerWake = GFN_CONDVAR_INITIALIZER;
+static gfnThread s_saveSchedulerThread;
+static gfnAtomic32 s_saveSchedulerRunning = 0;
+static GFN_THREAD_LOCAL bool t_runningSaveJob = false;
+
+// Guarded by s_saveSchedulerLock
+static SaveJobCallbackSig s_saveJob = NULL;
+static void* s_saveJobContext = NULL;
+static GfnSaveSchedulerConfig s_saveSchedulerConfig;
+static bool s_saveSchedulerStop = false;
+static bool s_saveSessionKnown = false;         // The session info was read at least once
+static bool s_saveSessionLimited = false;
+static uint64_t s_saveDeadlineNs = 0;           // Monotonic time at which the session ends
+static uint64_t s_saveNextPollNs = 0;
+static uint64_t s_saveLastAttemptNs = 0;
+static uint64_t s_saveLastCompletedNs = 0;
+static GfnSaveSchedulerStatus s_saveSchedulerCounters;
+
+static const GfnSaveSchedulerConfig kGfnDefaultSaveSchedulerConfig = { 300, 60, 60, 30 };
+
+// Time remaining in the session. Must be called with s_saveSchedulerLock held.
+static unsigned int gfnSaveTimeRemainingSec(uint64_t nowNs)
+{
+    if (!s_saveSessionLimited || nowNs >= s_saveDeadlineNs)
+    {
+        return 0;
+    }
+    return (unsigned int)((s_saveDeadlineNs - nowNs) / 1000000000ULL);
+}
+
+// Monotonic time of the next scheduled save, or kGfnSaveNotDue. Must be called with s_saveSchedulerLock held.
+static uint64_t gfnNextSaveDueNs(void)
+{
+    uint64_t leadNs = (uint64_t)s_saveSchedulerConfig.leadTimeSec * 1000000000ULL;
+    uint64_t dueNs = (s_saveDeadlineNs > leadNs) ? s_saveDeadlineNs - leadNs : 0;
+
+    if (!s_saveSessionKnown || !s_saveSessionLimited)
+    {
+        return kGfnSaveNotDue;
+    }
+    if (s_saveLastAttemptNs != 0 && s_saveLastAttemptNs + (uint64_t)s_saveSchedulerConfig.intervalSec * 1000000000ULL > dueNs)
+    {
+        dueNs = s_saveLastAttemptNs + (uint64_t)s_saveSchedulerConfig.intervalSec * 1000000000ULL;
+    }
+    return (dueNs < s_saveDeadlineNs) ? dueNs : kGfnSaveNotDue;
+}
+
+// Runs the application's save job. Must be called with s_saveJobLock held. Returns false if the
+// scheduler is stopped.
+static bool gfnRunSaveJob(GfnSaveReason reason)
+{
+    SaveJobCallbackSig job;
+    void* context;
+    unsigned int remainingSec;
+    GfnApplicationCallbackResult result;
+    uint64_t beginNs = gfnGetMonotonicNs();
+
+    gfnMutexLock(&s_saveSchedulerLock);
+    job = s_saveJob;
+    context = s_saveJobContext;
+    remainingSec = gfnSaveTimeRemainingSec(beginNs);
+    s_saveLastAttemptNs = beginNs;
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    if (job == NULL)
+    {
+        return false;
+    }
+
+    GFN_SDK_LOG("Running the %s save job, %u s left in the session",
+        (reason == gfnSaveReasonScheduled) ? "scheduled" : "requested", remainingSec);
+    t_runningSaveJob = true;
+    result = job(reason, remainingSec, context);
+    t_runningSaveJob = false;
+
+    gfnMutexLock(&s_saveSchedulerLock);
+    if (reason == gfnSaveReasonScheduled)
+    {
+        s_saveSchedulerCounters.scheduledSaves++;
+    }
+    else
+    {
+        s_saveSchedulerCounters.requestedSaves++;
+    }
+    if (result == crCallbackSuccess)
+    {
+        s_saveLastCompletedNs = gfnGetMonotonicNs();
+    }
+    else
+    {
+        s_saveSchedulerCounters.failedSaves++;
+        GFN_SDK_LOG_WARNING("Save job failed after %llu ms",
+            (unsigned long long)((gfnGetMonotonicNs() - beginNs) / 1000000));
+    }
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    return true;
+}
+
+// Answers GeForce NOW's SaveCallback from a recent save, or by running the job
+static void gfnAnswerSaveRequest(void)
+{
+    uint64_t ageNs;
+    bool recent;
+
+    if (!gfnAtomicLoadAcquire32(&s_saveSchedulerRunning))
+    {
+        return;
+    }
+    // Waits for a save in progress, which then counts as recent
+    gfnMutexLock(&s_saveJobLock);
+    gfnMutexLock(&s_saveSchedulerLock);
+    ageNs = gfnGetMonotonicNs() - s_saveLastCompletedNs;
+    recent = s_saveLastCompletedNs != 0 && ageNs <= (uint64_t)s_saveSchedulerConfig.freshnessSec * 1000000000ULL;
+    if (recent)
+    {
+        s_saveSchedulerCounters.recentSaveAnswers++;
+    }
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    if (recent)
+    {
+        GFN_SDK_LOG("Answering the SaveCallback with the save completed %llu ms ago", (unsigned long long)(ageNs / 1000000));
+    }
+    else
+    {
+        gfnRunSaveJob(gfnSaveReasonRequested);
+    }
+    gfnMutexUnlock(&s_saveJobLock);
+}
+
+// Reads the session info and moves the deadline. Must be called without s_saveSchedulerLock held.
+static void gfnPollSessionDeadline(void)
+{
+    GfnRuntimeError status;
+    GfnSessionInfo sessionInfo;
+    uint64_t nowNs;
+
+    memset(&sessionInfo, 0, sizeof(sessionInfo));
+    CALL_CLOUD_LIBRARY(status, GetSessionInfo, &sessionInfo);
+    nowNs = gfnGetMonotonicNs();
+
+    gfnMutexLock(&s_saveSchedulerLock);
+    s_saveSchedulerCounters.sessionInfoPolls++;
+    s_saveNextPollNs = nowNs + (uint64_t)s_saveSchedulerConfig.pollIntervalSec * 1000000000ULL;
+    if (GFNSDK_SUCCEEDED(status))
+    {
+        // A session without a limit reports neither a duration nor a time remaining
+        s_saveSessionKnown = true;
+        s_saveSessionLimited = sessionInfo.sessionMaxDurationSec != 0 || sessionInfo.sessionTimeRemainingSec != 0;
+        s_saveDeadlineNs = nowNs + (uint64_t)sessionInfo.sessionTimeRemainingSec * 1000000000ULL;
+    }
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    if (GFNSDK_FAILED(status))
+    {
+        GFN_SDK_LOG_WARNING("Save scheduler could not read the session info: %d", (int)status);
+    }
+}
+
+static GFN_THREAD_PROC gfnSaveSchedulerThread(void* arg)
+{
+    uint64_t nowNs;
+    uint64_t dueNs;
+    uint64_t wakeNs;
+
+    (void)arg;
+    gfnMutexLock(&s_saveSchedulerLock);
+    while (!s_saveSchedulerStop)
+    {
+        nowNs = gfnGetMonotonicNs();
+        if (nowNs >= s_saveNextPollNs)
+        {
+            gfnMutexUnlock(&s_saveSchedulerLock);
+            gfnPollSessionDeadline();
+            gfnMutexLock(&s_saveSchedulerLock);
+            continue;
+        }
+        dueNs = gfnNextSaveDueNs();
+        if (nowNs >= dueNs)
+        {
+            gfnMutexUnlock(&s_saveSchedulerLock);
+            gfnMutexLock(&s_saveJobLock);
+            // A requested save may have run while waiting for the lock
+            gfnMutexLock(&s_saveSchedulerLock);
+            dueNs = gfnNextSaveDueNs();
+            gfnMutexUnlock(&s_saveSchedulerLock);
+            if (gfnGetMonotonicNs() >= dueNs)
+            {
+                gfnRunSaveJob(gfnSaveReasonScheduled);
+            }
+            gfnMutexUnlock(&s_saveJobLock);
+            gfnMutexLock(&s_saveSchedulerLock);
+            continue;
+        }
+        wakeNs = (dueNs < s_saveNextPollNs) ? dueNs : s_saveNextPollNs;
+        gfnCondVarWait(&s_saveSchedulerWake, &s_saveSchedulerLock, (unsigned int)((wakeNs - nowNs + 999999) / 1000000));
+    }
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    return GFN_THREAD_RETURN;
+}
+
+GfnRuntimeError GfnStartSaveScheduler(SaveJobCallbackSig saveJob, void* userContext, const GfnSaveSchedulerConfig* config)
+{
+    GfnRuntimeError status = gfnSuccess;
+    gfnCallbackSlot* registration = &g_callbackSlots[gfnCallbackSave];
+
+    CHECK_NULL_PARAM(saveJob);
+    if (config == NULL)
+    {
+        config = &kGfnDefaultSaveSchedulerConfig;
+    }
+    if (config->leadTimeSec == 0 || config->intervalSec == 0 || config->pollIntervalSec == 0)
+    {
+        return gfnInvalidParameter;
+    }
+    CHECK_CLOUD_ENVIRONMENT();
+
+    gfnMutexLock(&g_callbackLock);
+    if (!registration->registered)
+    {
+        GFN_SDK_LOG("Registering for Save Callback updates for the save scheduler");
+        CALL_CLOUD_LIBRARY(status, RegisterSaveCallback, &_gfnSaveCallbackWrapper, registration);
+        if (GFNSDK_SUCCEEDED(status))
+        {
+            registration->registered = true;
+            registration->param = 0;
+        }
+    }
+    gfnMutexUnlock(&g_callbackLock);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+
+    gfnMutexLock(&s_saveSchedulerLifecycleLock);
+    gfnMutexLock(&s_saveSchedulerLock);
+    s_saveJob = saveJob;
+    s_saveJobContext = userContext;
+    s_saveSchedulerConfig = *config;
+    if (gfnAtomicLoadAcquire32(&s_saveSchedulerRunning))
+    {
+        // Picks up the new lead time and intervals
+        gfnCondVarSignal(&s_saveSchedulerWake);
+        gfnMutexUnlock(&s_saveSchedulerLock);
+        gfnMutexUnlock(&s_saveSchedulerLifecycleLock);
+        return gfnSuccess;
+    }
+    s_saveSchedulerStop = false;
+    s_saveSessionKnown = false;
+    s_saveNextPollNs = 0;
+    s_saveLastAttemptNs = 0;
+    s_saveLastCompletedNs = 0;
+    memset(&s_saveSchedulerCounters, 0, sizeof(s_saveSchedulerCounters));
+    gfnMutexUnlock(&s_saveSchedulerLock);
+
+    if (!gfnThreadCreate(&s_saveSchedulerThread, gfnSaveSchedulerThread, NULL))
+    {
+        gfnMutexLock(&s_saveSchedulerLock);
+        s_saveJob = NULL;
+        s_saveJobContext = NULL;
+        gfnMutexUnlock(&s_saveSchedulerLock);
+        gfnMutexUnlock(&s_saveSchedulerLifecycleLock);
+        return gfnInternalError;
+    }
+    gfnAtomicExchange32(&s_saveSchedulerRunning, 1);
+    gfnMutexUnlock(&s_saveSchedulerLifecycleLock);
+    GFN_SDK_LOG("Save scheduler started: lead time %u s, interval %u s, poll interval %u s",
+        config->leadTimeSec, config->intervalSec, config->pollIntervalSec);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnStopSaveScheduler(void)
+{
+    if (t_runningSaveJob)
+    {
+        // Stopping waits for the job to return
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_saveSchedulerLifecycleLock);
+    if (!gfnAtomicLoadAcquire32(&s_saveSchedulerRunning))
+    {
+        gfnMutexUnlock(&s_saveSchedulerLifecycleLock);
+        return gfnSuccess;
+    }
+    gfnMutexLock(&s_saveSchedulerLock);
+    s_saveSchedulerStop = true;
+    gfnCondVarSignal(&s_saveSchedulerWake);
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    gfnThreadJoin(s_saveSchedulerThread);
+
+    // A SaveCallback still running the job finishes before the job is cleared
+    gfnMutexLock(&s_saveJobLock);
+    gfnMutexLock(&s_saveSchedulerLock);
+    s_saveJob = NULL;
+    s_saveJobContext = NULL;
+    gfnAtomicExchange32(&s_saveSchedulerRunning, 0);
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    gfnMutexUnlock(&s_saveJobLock);
+    gfnMutexUnlock(&s_saveSchedulerLifecycleLock);
+    GFN_SDK_LOG("Save scheduler stopped");
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnGetSaveSchedulerStatus(GfnSaveSchedulerStatus* status)
+{
+    uint64_t nowNs = gfnGetMonotonicNs();
+    uint64_t dueNs;
+    uint64_t ageMs;
+
+    CHECK_NULL_PARAM(status);
+    gfnMutexLock(&s_saveSchedulerLock);
+    *status = s_saveSchedulerCounters;
+    status->running = gfnAtomicLoadAcquire32(&s_saveSchedulerRunning) != 0;
+    status->sessionLimited = s_saveSessionKnown && s_saveSessionLimited;
+    status->sessionTimeRemainingSec = s_saveSessionKnown ? gfnSaveTimeRemainingSec(nowNs) : 0;
+    dueNs = status->running ? gfnNextSaveDueNs() : kGfnSaveNotDue;
+    status->saveScheduled = dueNs != kGfnSaveNotDue;
+    status->nextSaveInMs = (status->saveScheduled && dueNs > nowNs) ? (unsigned int)((dueNs - nowNs) / 1000000) : 0;
+    if (s_saveLastCompletedNs != 0)
+    {
+        ageMs = (nowNs - s_saveLastCompletedNs) / 1000000;
+        status->lastSaveAgeMs = (ageMs == 0) ? 1 : (ageMs < 0xFFFFFFFFULL) ? (unsigned int)ageMs : 0xFFFFFFFFu;
+    }
+    gfnMutexUnlock(&s_saveSchedulerLock);
+    return gfnSuccess;
+}
+
+static void gfnResetSaveScheduler(void)
+{
+    if (t_runningSaveJob)
+    {
+        GFN_SDK_LOG_WARNING("GfnShutdownSdk called from the save job; the save scheduler keeps running until GfnStopSaveScheduler");
+        return;
+    }
+    GfnStopSaveScheduler();
+}
+
+// Save snapshots. Two buffers, each large enough for every region, take turns: a capture copies the
+// regions into the buffer the writer thread is not using and marks it pending, replacing a pending
+// capture the writer has not picked up yet, so a capture never waits for I/O or allocates memory. The
+// writer compresses the pending buffer into its own scratch buffer and writes it to a temporary file,
+// which is flushed to the disk and renamed over the snapshot file. The file format, the compressor and
+// the file I/O are in GfnSdk_SaveSnapshot.c.
+//
+// The regions, the buffers and the configuration belong to the application and are kept when the SDK is
+// shut down; only the writer thread is stopped, and the next capture starts it again.
+#define kGfnSaveSnapshotNone -1                 // No buffer in s_saveSnapshotPending or s_saveSnapshotWriting
+
+typedef struct gfnSaveRegion
+{
+    const void* data;               // NULL for a free slot
+    size_t size;
+} gfnSaveRegion;
+
+typedef struct gfnSaveSnapshotBuffer
+{
+    uint8_t* data;
+    size_t capacity;
+    size_t size;
+    uint64_t snapshotId;
+    uint32_t regionCount;
+    uint64_t regionSizes[GFN_SAVE_REGION_CAPACITY];
+} gfnSaveSnapshotBuffer;
+
+static gfnMutex s_saveSnapshotLock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_saveSnapshotWake = GFN_CONDVAR_INITIALIZER;     // A capture is pending, or the writer must stop
+static gfnCondVar s_saveSnapshotDone = GFN_CONDVAR_INITIALIZER;     // A write finished
+
+// Guarded by s_saveSnapshotLock
+static gfnSaveRegion s_saveRegions[GFN_SAVE_REGION_CAPACITY];
+static size_t s_saveRegionBytes = 0;
+static gfnSaveSnapshotBuffer s_saveSnapshotBuffers[2];
+static int s_saveSnapshotPending = kGfnSaveSnapshotNone;
+static int s_saveSnapshotWriting = kGfnSaveSnapshotNone;
+static CHAR_TYPE s_saveSnapshotPath[PLATFORM_MAX_PATH];
+static bool s_saveSnapshotCompress = false;
+static uint64_t s_saveSnapshotLastId = 0;
+static uint64_t s_saveSnapshotLastFinishedId = 0;  // Most recent snapshot whose write completed or failed
+static GfnSaveSnapshotStatus s_saveSnapshotStatus;
+static bool s_saveSnapshotWriterRunning = false;
+static bool s_saveSnapshotWriterStop = false;
+static gfnThread s_saveSnapshotWriter;
+
+static GFN_THREAD_PROC gfnSaveSnapshotWriterThread(void* arg)
+{
+    CHAR_TYPE path[PLATFORM_MAX_PATH];
+    gfnSaveSnapshotBuffer* buffer;
+    gfnSaveSnapshotHeader header;
+    GfnRuntimeError result;
+    uint32_t* table = (uint32_t*)malloc(kGfnSaveSnapshotHashTableSize);
+    uint8_t* scratch = NULL;
+    size_t scratchCapacity = 0;
+    uint8_t const* stored;
+    bool compress;
+    uint64_t beginNs;
+
+    (void)arg;
+    gfnMutexLock(&s_saveSnapshotLock);
+    for (;;)
+    {
+        while (s_saveSnapshotPending == kGfnSaveSnapshotNone && !s_saveSnapshotWriterStop)
+        {
+            gfnCondVarWait(&s_saveSnapshotWake, &s_saveSnapshotLock, 1000);
+        }
+        // A pending snapshot is written before stopping
+        if (s_saveSnapshotPending == kGfnSaveSnapshotNone)
+        {
+            break;
+        }
+        s_saveSnapshotWriting = s_saveSnapshotPending;
+        s_saveSnapshotPending = kGfnSaveSnapshotNone;
+        buffer = &s_saveSnapshotBuffers[s_saveSnapshotWriting];
+        memcpy(path, s_saveSnapshotPath, sizeof(path));
+        compress = s_saveSnapshotCompress;
+        gfnMutexUnlock(&s_saveSnapshotLock);
+
+        // The buffer is not touched by captures or region changes while it is being written
+        beginNs = gfnGetMonotonicNs();
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, kGfnSaveSnapshotMagic, sizeof(header.magic));
+        header.version = kGfnSaveSnapshotVersion;
+        header.regionCount = buffer->regionCount;
+        header.headerSize = sizeof(header);
+        header.snapshotId = buffer->snapshotId;
+        header.rawSize = buffer->size;
+        header.storedSize = buffer->size;
+        header.checksum = gfnSaveSnapshotChecksum(buffer->data, buffer->size);
+        stored = buffer->data;
+        if (compress && table != NULL && scratchCapacity < buffer->size)
+        {
+            free(scratch);
+            scratch = (uint8_t*)malloc(buffer->size);
+            scratchCapacity = (scratch != NULL) ? buffer->size : 0;
+        }
+        if (compress && table != NULL && scratch != NULL)
+        {
+            // Data that does not shrink is stored as is
+            header.storedSize = gfnCompressSnapshot(buffer->data, buffer->size, scratch, buffer->size, table);
+            if (header.storedSize != 0)
+            {
+                header.flags |= kGfnSaveSnapshotCompressed;
+                stored = scratch;
+            }
+            else
+            {
+                header.storedSize = buffer->size;
+            }
+        }
+        result = gfnWriteSnapshotFile(path, &header, buffer->regionSizes, stored);
+
+        gfnMutexLock(&s_saveSnapshotLock);
+        s_saveSnapshotWriting = kGfnSaveSnapshotNone;
+        s_saveSnapshotLastFinishedId = header.snapshotId;
+        s_saveSnapshotStatus.lastWriteResult = result;
+        s_saveSnapshotStatus.lastWriteMs = (unsigned int)((gfnGetMonotonicNs() - beginNs) / 1000000);
+        s_saveSnapshotStatus.lastRawBytes = header.rawSize;
+        s_saveSnapshotStatus.lastStoredBytes = header.storedSize;
+        if (GFNSDK_SUCCEEDED(result))
+        {
+            s_saveSnapshotStatus.lastWrittenId = header.snapshotId;
+            s_saveSnapshotStatus.writes++;
+        }
+        else
+        {
+            s_saveSnapshotStatus.failures++;
+            GFN_SDK_LOG_ERROR("Could not write save snapshot %llu", (unsigned long long)header.snapshotId);
+        }
+        gfnCondVarBroadcast(&s_saveSnapshotDone);
+    }
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    free(scratch);
+    free(table);
+    return GFN_THREAD_RETURN;
+}
+
+// Must be called with s_saveSnapshotLock held
+static bool gfnStartSaveSnapshotWriter(void)
+{
+    if (!s_saveSnapshotWriterRunning)
+    {
+        s_saveSnapshotWriterStop = false;
+        if (!gfnThreadCreate(&s_saveSnapshotWriter, gfnSaveSnapshotWriterThread, NULL))
+        {
+            return false;
+        }
+        s_saveSnapshotWriterRunning = true;
+    }
+    return true;
+}
+
+GfnRuntimeError GfnSetSaveSnapshotConfig(const CHAR_TYPE* path, bool compress)
+{
+    size_t pathLength;
+
+    CHECK_NULL_PARAM(path);
+#ifdef _WIN32
+    pathLength = wcslen(path);
+#elif __linux__
+    pathLength = strlen(path);
+#endif
+    if (pathLength == 0 || pathLength + sizeof(".tmp") > PLATFORM_MAX_PATH)
+    {
+        return gfnInvalidParameter;
+    }
+    gfnMutexLock(&s_saveSnapshotLock);
+    memset(s_saveSnapshotPath, 0, sizeof(s_saveSnapshotPath));
+    memcpy(s_saveSnapshotPath, path, pathLength * sizeof(CHAR_TYPE));
+    s_saveSnapshotCompress = compress;
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnAddSaveRegion(const void* data, size_t size, unsigned int* regionId)
+{
+    uint8_t* grown;
+    size_t total;
+    unsigned int slot;
+    int i;
+
+    CHECK_NULL_PARAM(data);
+    CHECK_NULL_PARAM(regionId);
+    if (size == 0)
+    {
+        return gfnInvalidParameter;
+    }
+
+    gfnMutexLock(&s_saveSnapshotLock);
+    for (slot = 0; slot < GFN_SAVE_REGION_CAPACITY && s_saveRegions[slot].data != NULL; slot++)
+    {
+    }
+    total = s_saveRegionBytes + size;
+    if (slot == GFN_SAVE_REGION_CAPACITY || total < size || total > 0xFFFFFFFFu)
+    {
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        return gfnUnableToAllocateMemory;
+    }
+    // The buffer being written cannot move
+    while (s_saveSnapshotWriting != kGfnSaveSnapshotNone)
+    {
+        gfnCondVarWait(&s_saveSnapshotDone, &s_saveSnapshotLock, 100);
+    }
+    for (i = 0; i < 2; i++)
+    {
+        if (s_saveSnapshotBuffers[i].capacity < total)
+        {
+            grown = (uint8_t*)realloc(s_saveSnapshotBuffers[i].data, total);
+            if (grown == NULL)
+            {
+                gfnMutexUnlock(&s_saveSnapshotLock);
+                return gfnUnableToAllocateMemory;
+            }
+            s_saveSnapshotBuffers[i].data = grown;
+            s_saveSnapshotBuffers[i].capacity = total;
+        }
+    }
+    if (!gfnStartSaveSnapshotWriter())
+    {
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        return gfnInternalError;
+    }
+    s_saveRegions[slot].data = data;
+    s_saveRegions[slot].size = size;
+    s_saveRegionBytes = total;
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    *regionId = slot + 1;
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnRemoveSaveRegion(unsigned int regionId)
+{
+    GfnRuntimeError status = gfnInvalidParameter;
+
+    gfnMutexLock(&s_saveSnapshotLock);
+    if (regionId != 0 && regionId <= GFN_SAVE_REGION_CAPACITY && s_saveRegions[regionId - 1].data != NULL)
+    {
+        s_saveRegionBytes -= s_saveRegions[regionId - 1].size;
+        s_saveRegions[regionId - 1].data = NULL;
+        s_saveRegions[regionId - 1].size = 0;
+        status = gfnSuccess;
+    }
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    return status;
+}
+
+GfnRuntimeError GfnCaptureSaveSnapshot(uint64_t* snapshotId)
+{
+    uint64_t beginNs = gfnGetMonotonicNs();
+    gfnSaveSnapshotBuffer* buffer;
+    int target;
+    int i;
+
+    gfnMutexLock(&s_saveSnapshotLock);
+    if (s_saveSnapshotPath[0] == 0)
+    {
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        return gfnAPINotInit;
+    }
+    if (s_saveRegionBytes == 0)
+    {
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        return gfnNoData;
+    }
+    // Stopped by a shutdown since the regions were added
+    if (!gfnStartSaveSnapshotWriter())
+    {
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        return gfnInternalError;
+    }
+    target = (s_saveSnapshotWriting == 0) ? 1 : 0;
+    if (s_saveSnapshotPending != kGfnSaveSnapshotNone)
+    {
+        // With one buffer being written, the pending capture is in the other one
+        target = s_saveSnapshotPending;
+        s_saveSnapshotStatus.superseded++;
+    }
+    buffer = &s_saveSnapshotBuffers[target];
+    buffer->size = 0;
+    buffer->regionCount = 0;
+    for (i = 0; i < GFN_SAVE_REGION_CAPACITY; i++)
+    {
+        if (s_saveRegions[i].data != NULL)
+        {
+            memcpy(buffer->data + buffer->size, s_saveRegions[i].data, s_saveRegions[i].size);
+            buffer->size += s_saveRegions[i].size;
+            buffer->regionSizes[buffer->regionCount++] = s_saveRegions[i].size;
+        }
+    }
+    buffer->snapshotId = ++s_saveSnapshotLastId;
+    s_saveSnapshotPending = target;
+    s_saveSnapshotStatus.captures++;
+    s_saveSnapshotStatus.lastCapturedId = buffer->snapshotId;
+    s_saveSnapshotStatus.lastCaptureUs = (unsigned int)((gfnGetMonotonicNs() - beginNs) / 1000);
+    if (snapshotId != NULL)
+    {
+        *snapshotId = buffer->snapshotId;
+    }
+    gfnCondVarSignal(&s_saveSnapshotWake);
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnWaitForSaveSnapshot(uint64_t snapshotId, unsigned int timeoutMs)
+{
+    uint64_t deadlineNs = gfnGetMonotonicNs() + (uint64_t)timeoutMs * 1000000;
+    uint64_t nowNs;
+    GfnRuntimeError status;
+
+    gfnMutexLock(&s_saveSnapshotLock);
+    if (snapshotId == 0)
+    {
+        snapshotId = s_saveSnapshotLastId;
+    }
+    if (snapshotId == 0 || snapshotId > s_saveSnapshotLastId)
+    {
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        return gfnInvalidParameter;
+    }
+    for (;;)
+    {
+        // Snapshots are written in order, so a later write covers a superseded one
+        if (s_saveSnapshotStatus.lastWrittenId >= snapshotId)
+        {
+            status = gfnSuccess;
+            break;
+        }
+        if (s_saveSnapshotLastFinishedId >= snapshotId)
+        {
+            status = s_saveSnapshotStatus.lastWriteResult;
+            break;
+        }
+        nowNs = gfnGetMonotonicNs();
+        if (nowNs >= deadlineNs)
+        {
+            status = gfnTimedOut;
+            break;
+        }
+        gfnCondVarWait(&s_saveSnapshotDone, &s_saveSnapshotLock, (unsigned int)((deadlineNs - nowNs + 999999) / 1000000));
+    }
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    return status;
+}
+
+GfnRuntimeError GfnGetSaveSnapshotStatus(GfnSaveSnapshotStatus* status)
+{
+    CHECK_NULL_PARAM(status);
+    gfnMutexLock(&s_saveSnapshotLock);
+    *status = s_saveSnapshotStatus;
+    status->pending = s_saveSnapshotPending != kGfnSaveSnapshotNone;
+    status->writing = s_saveSnapshotWriting != kGfnSaveSnapshotNone;
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnLoadSaveSnapshot(const CHAR_TYPE* path)
+{
+    CHAR_TYPE configuredPath[PLATFORM_MAX_PATH];
+    gfnSaveSnapshotHeader header;
+    GfnRuntimeError status;
+    uint8_t* file = NULL;
+    uint8_t* raw = NULL;
+    uint8_t const* payload = NULL;
+    uint64_t regionSize = 0;
+    size_t fileSize = 0;
+    size_t offset;
+    uint32_t region;
+    int i;
+
+    if (path == NULL)
+    {
+        gfnMutexLock(&s_saveSnapshotLock);
+        memcpy(configuredPath, s_saveSnapshotPath, sizeof(configuredPath));
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        if (configuredPath[0] == 0)
+        {
+            return gfnInvalidParameter;
+        }
+        path = configuredPath;
+    }
+    status = gfnReadSnapshotFile(path, &file, &fileSize);
+    if (GFNSDK_FAILED(status))
+    {
+        free(file);
+        return status;
+    }
+
+    if (!gfnParseSnapshotHeader(file, fileSize, GFN_SAVE_REGION_CAPACITY, &header))
+    {
+        free(file);
+        GFN_SDK_LOG_WARNING("Not a valid save snapshot file");
+        return gfnInternalError;
+    }
+    status = gfnDecodeSnapshotData(file, &header, &raw, &payload);
+    if (GFNSDK_FAILED(status))
+    {
+        free(raw);
+        free(file);
+        GFN_SDK_LOG_WARNING("Save snapshot file is corrupted");
+        return status;
+    }
+
+    // Every region must match before any of them is written
+    gfnMutexLock(&s_saveSnapshotLock);
+    region = 0;
+    for (i = 0; i < GFN_SAVE_REGION_CAPACITY && GFNSDK_SUCCEEDED(status); i++)
+    {
+        if (s_saveRegions[i].data == NULL)
+        {
+            continue;
+        }
+        if (region < header.regionCount)
+        {
+            regionSize = gfnSnapshotRegionSize(file, region);
+        }
+        if (region >= header.regionCount || regionSize != s_saveRegions[i].size)
+        {
+            status = gfnInvalidParameter;
+        }
+        region++;
+    }
+    if (GFNSDK_SUCCEEDED(status) && region != header.regionCount)
+    {
+        status = gfnInvalidParameter;
+    }
+    for (i = 0, offset = 0; i < GFN_SAVE_REGION_CAPACITY && GFNSDK_SUCCEEDED(status); i++)
+    {
+        if (s_saveRegions[i].data != NULL)
+        {
+            memcpy((void*)s_saveRegions[i].data, payload + offset, s_saveRegions[i].size);
+            offset += s_saveRegions[i].size;
+        }
+    }
+    gfnMutexUnlock(&s_saveSnapshotLock);
+    free(raw);
+    free(file);
+    if (GFNSDK_FAILED(status))
+    {
+        GFN_SDK_LOG_WARNING("Save snapshot regions do not match the regions added");
+    }
+    return status;
+}
+
+// Writes a pending snapshot and stops the writer. The regions, buffers and configuration are kept for
+// the next session.
+static void gfnResetSaveSnapshots(void)
+{
+    gfnMutexLock(&s_saveSnapshotLock);
+    if (s_saveSnapshotWriterRunning)
+    {
+        s_saveSnapshotWriterStop = true;
+        gfnCondVarSignal(&s_saveSnapshotWake);
+        gfnMutexUnlock(&s_saveSnapshotLock);
+        gfnThreadJoin(s_saveSnapshotWriter);
+        gfnMutexLock(&s_saveSnapshotLock);
+        s_saveSnapshotWriterRunning = false;
+    }
+    gfnMutexUnlock(&s_saveSnapshotLock);
+}
+
+// Pause controller. s_pauseTransitionLock serializes pauses, resumes and changes to the pools, and is held
+// while calling the release and restore functions of the pools, so those run on one thread at a time and
+// never see a pool removed under them. s_pauseLock guards the state, is taken after
+// s_pauseTransitionLock and is never held while calling the application.
+//
+// The Pause and StreamStatus trampolines only record the event for the pause thread, which runs the
+// transition, so the application's functions never run on the GeForce NOW callback thread and that
+// thread never waits for a transition. s_pauseLifecycleLock serializes starting and stopping the pause
+// thread and is taken before the other two.
+//
+// The pools belong to the application and are kept when the SDK is shut down.
+#define kGfnDefaultPausedFrameIntervalMs 100
+
+typedef struct gfnPauseResourceSlot
+{
+    GfnPauseResourcePool pool;
+    bool used;
+} gfnPauseResourceSlot;
+
+static gfnMutex s_pauseLifecycleLock = GFN_MUTEX_INITIALIZER;
+static gfnMutex s_pauseTransitionLock = GFN_MUTEX_INITIALIZER;
+static gfnMutex s_pauseLock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_pauseResumed = GFN_CONDVAR_INITIALIZER;
+static gfnCondVar s_pauseEventWake = GFN_CONDVAR_INITIALIZER;     // An event is pending, or the pause thread must stop
+static GFN_THREAD_LOCAL bool t_inPauseTransition = false;
+
+// Guarded by s_pauseLifecycleLock
+static gfnThread s_pauseThread;
+static bool s_pauseThreadRunning = false;
+
+// Guarded by both locks, read under either
+static gfnPauseResourceSlot s_pausePools[GFN_PAUSE_RESOURCE_POOL_CAPACITY];
+
+// Guarded by s_pauseLock
+static GfnPauseControllerConfig s_pauseConfig = { kGfnDefaultPausedFrameIntervalMs, true };
+static GfnPauseControllerStatus s_pauseStatus;
+static uint64_t s_pausedNs = 0;
+static uint64_t s_pausedFrameNs = 0;
+static bool s_pauseThreadStop = false;
+static bool s_pauseCallbackPending = false;    // A PauseCallback the pause thread has not handled yet
+static bool s_pauseFocusPending = false;       // A focus change the pause thread has not handled yet
+static bool s_pauseFocusLost = false;          // Latest focus change
+
+// Orders the pools in use by priority, then by identifier. Returns the number of pools.
+static unsigned int gfnSortPauseResourcePools(unsigned int* order)
+{
+    unsigned int count = 0;
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < GFN_PAUSE_RESOURCE_POOL_CAPACITY; i++)
+    {
+        if (!s_pausePools[i].used)
+        {
+            continue;
+        }
+        for (j = count; j > 0 && s_pausePools[order[j - 1]].pool.priority > s_pausePools[i].pool.priority; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+        count++;
+    }
+    return count;
+}
+
+// Hands the whole pages of a pool's reclaimable memory back to the system. Returns the bytes handed back.
+static size_t gfnReclaimPauseResourceMemory(GfnPauseResourcePool const* pool)
+{
+    uintptr_t begin;
+    uintptr_t end;
+    size_t pageSize;
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+
+    GetSystemInfo(&systemInfo);
+    pageSize = systemInfo.dwPageSize;
+#elif __linux__
+    pageSize = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    // Discarding the pages loses their contents, so only pools that opt in are touched
+    if (!pool->discardReclaimable || pool->reclaimable == NULL)
+    {
+        return 0;
+    }
+    begin = ((uintptr_t)pool->reclaimable + pageSize - 1) & ~(uintptr_t)(pageSize - 1);
+    end = ((uintptr_t)pool->reclaimable + pool->reclaimableSize) & ~(uintptr_t)(pageSize - 1);
+    if (end <= begin)
+    {
+        return 0;
+    }
+#ifdef _WIN32
+    // MEM_RESET keeps the pages committed but lets the system discard them instead of paging them out
+    if (VirtualAlloc((void*)begin, end - begin, MEM_RESET, PAGE_READWRITE) == NULL)
+    {
+        GFN_SDK_LOG_WARNING("Could not reclaim pause resource memory: %lu", GetLastError());
+        return 0;
+    }
+#elif __linux__
+    if (madvise((void*)begin, end - begin, MADV_DONTNEED) != 0)
+    {
+        GFN_SDK_LOG_WARNING("Could not reclaim pause resource memory: %d", errno);
+        return 0;
+    }
+#endif
+    return end - begin;
+}
+
+// Pauses the seat and releases the pools. Must be called with s_pauseTransitionLock held.
+static void gfnEnterPause(GfnPauseReason reason)
+{
+    unsigned int order[GFN_PAUSE_RESOURCE_POOL_CAPACITY];
+    unsigned int count;
+    uint64_t beginNs = gfnGetMonotonicNs();
+    uint64_t reclaimedBytes = 0;
+    GfnPauseResourcePool const* pool;
+
+    gfnMutexLock(&s_pauseLock);
+    if (s_pauseStatus.paused)
+    {
+        gfnMutexUnlock(&s_pauseLock);
+        return;
+    }
+    // Throttle the frame loop and park the workers before the pools go away
+    s_pauseStatus.paused = true;
+    s_pauseStatus.reason = reason;
+    s_pauseStatus.pauses++;
+    s_pausedNs = beginNs;
+    s_pausedFrameNs = beginNs;
+    gfnMutexUnlock(&s_pauseLock);
+    GFN_SDK_LOG("Pausing the seat, reason %d", (int)reason);
+
+    t_inPauseTransition = true;
+    count = gfnSortPauseResourcePools(order);
+    while (count > 0)
+    {
+        pool = &s_pausePools[order[--count]].pool;
+        if (pool->release != NULL)
+        {
+            pool->release(pool->userContext);
+        }
+        reclaimedBytes += gfnReclaimPauseResourceMemory(pool);
+    }
+    t_inPauseTransition = false;
+
+    gfnMutexLock(&s_pauseLock);
+    s_pauseStatus.lastReleaseUs = (unsigned int)((gfnGetMonotonicNs() - beginNs) / 1000);
+    s_pauseStatus.reclaimedBytes = reclaimedBytes;
+    gfnMutexUnlock(&s_pauseLock);
+}
+
+// Restores the pools, then resumes the seat. Must be called with s_pauseTransitionLock held.
+static void gfnLeavePause(void)
+{
+    unsigned int order[GFN_PAUSE_RESOURCE_POOL_CAPACITY];
+    unsigned int count;
+    unsigned int i;
+    unsigned int slowestPoolId = 0;
+    uint64_t slowestNs = 0;
+    uint64_t beginNs = gfnGetMonotonicNs();
+    uint64_t poolBeginNs;
+    uint64_t endNs;
+    GfnPauseResourcePool const* pool;
+
+    gfnMutexLock(&s_pauseLock);
+    if (!s_pauseStatus.paused)
+    {
+        gfnMutexUnlock(&s_pauseLock);
+        return;
+    }
+    gfnMutexUnlock(&s_pauseLock);
+
+    t_inPauseTransition = true;
+    count = gfnSortPauseResourcePools(order);
+    endNs = beginNs;
+    for (i = 0; i < count; i++)
+    {
+        pool = &s_pausePools[order[i]].pool;
+        if (pool->restore == NULL)
+        {
+            continue;
+        }
+        poolBeginNs = endNs;
+        pool->restore(pool->userContext);
+        endNs = gfnGetMonotonicNs();
+        if (endNs - poolBeginNs >= slowestNs)
+        {
+            slowestNs = endNs - poolBeginNs;
+            slowestPoolId = order[i] + 1;
+        }
+    }
+    t_inPauseTransition = false;
+
+    gfnMutexLock(&s_pauseLock);
+    endNs = gfnGetMonotonicNs();
+    s_pauseStatus.paused = false;
+    s_pauseStatus.reason = gfnPauseReasonNone;
+    s_pauseStatus.resumes++;
+    s_pauseStatus.lastResumeUs = (unsigned int)((endNs - beginNs) / 1000);
+    s_pauseStatus.slowestRestorePoolId = slowestPoolId;
+    s_pauseStatus.slowestRestoreUs = (unsigned int)(slowestNs / 1000);
+    GFN_SDK_LOG("Resumed the seat in %llu us after %llu ms paused", (unsigned long long)((endNs - beginNs) / 1000),
+        (unsigned long long)((endNs - s_pausedNs) / 1000000));
+    gfnCondVarBroadcast(&s_pauseResumed);
+    gfnMutexUnlock(&s_pauseLock);
+}
+
+static GFN_THREAD_PROC gfnPauseThread(void* arg)
+{
+    bool pauseCallback;
+    bool focusChanged;
+    bool focusLost;
+    bool focusPaused;
+
+    (void)arg;
+    gfnMutexLock(&s_pauseLock);
+    for (;;)
+    {
+        while (!s_pauseCallbackPending && !s_pauseFocusPending && !s_pauseThreadStop)
+        {
+            gfnCondVarWaitForever(&s_pauseEventWake, &s_pauseLock);
+        }
+        if (s_pauseThreadStop)
+        {
+            break;
+        }
+        pauseCallback = s_pauseCallbackPending;
+        focusChanged = s_pauseFocusPending;
+        focusLost = s_pauseFocusLost;
+        s_pauseCallbackPending = false;
+        s_pauseFocusPending = false;
+        gfnMutexUnlock(&s_pauseLock);
+
+        gfnMutexLock(&s_pauseTransitionLock);
+        if (pauseCallback)
+        {
+            gfnEnterPause(gfnPauseReasonPauseCallback);
+        }
+        if (focusChanged && focusLost)
+        {
+            gfnEnterPause(gfnPauseReasonLostInputFocus);
+        }
+        else if (focusChanged)
+        {
+            // Regaining focus does not end a pause that GeForce NOW or the application asked for
+            gfnMutexLock(&s_pauseLock);
+            focusPaused = s_pauseStatus.reason == gfnPauseReasonLostInputFocus;
+            gfnMutexUnlock(&s_pauseLock);
+            if (focusPaused)
+            {
+                gfnLeavePause();
+            }
+        }
+        gfnMutexUnlock(&s_pauseTransitionLock);
+        gfnMutexLock(&s_pauseLock);
+    }
+    gfnMutexUnlock(&s_pauseLock);
+    return GFN_THREAD_RETURN;
+}
+
+// Must be called with s_pauseLifecycleLock held, and not from the pause thread
+static bool gfnStartPauseThread(void)
+{
+    if (s_pauseThreadRunning)
+    {
+        return true;
+    }
+    gfnMutexLock(&s_pauseLock);
+    s_pauseThreadStop = false;
+    s_pauseCallbackPending = false;
+    s_pauseFocusPending = false;
+    gfnMutexUnlock(&s_pauseLock);
+    if (!gfnThreadCreate(&s_pauseThread, gfnPauseThread, NULL))
+    {
+        return false;
+    }
+    s_pauseThreadRunning = true;
+    return true;
+}
+
+// Drops the events the pause thread has not handled. Must be called with s_pauseLifecycleLock held, and
+// not from the pause thread.
+static void gfnStopPauseThread(void)
+{
+    if (!s_pauseThreadRunning)
+    {
+        return;
+    }
+    gfnMutexLock(&s_pauseLock);
+    s_pauseThreadStop = true;
+    gfnCondVarSignal(&s_pauseEventWake);
+    gfnMutexUnlock(&s_pauseLock);
+    gfnThreadJoin(s_pauseThread);
+    s_pauseThreadRunning = false;
+}
+
+// Called from the PauseCallback trampoline on the GeForce NOW callback thread
+static void gfnPauseOnPauseCallback(void)
+{
+    gfnMutexLock(&s_pauseLock);
+    if (s_pauseStatus.started)
+    {
+        s_pauseCallbackPending = true;
+        gfnCondVarSignal(&s_pauseEventWake);
+    }
+    gfnMutexUnlock(&s_pauseLock);
+}
+
+// Called from the StreamStatus trampoline on the GeForce NOW callback thread
+static void gfnPauseOnStreamStatus(GfnStreamStatus streamStatus)
+{
+    if (streamStatus != GfnStreamStatusLostInputFocus && streamStatus != GfnStreamStatusGotInputFocus)
+    {
+        return;
+    }
+    gfnMutexLock(&s_pauseLock);
+    if (s_pauseStatus.started && s_pauseConfig.pauseOnFocusLoss)
+    {
+        s_pauseFocusPending = true;
+        s_pauseFocusLost = streamStatus == GfnStreamStatusLostInputFocus;
+        gfnCondVarSignal(&s_pauseEventWake);
+    }
+    gfnMutexUnlock(&s_pauseLock);
+}
+
+// Registers the Pause and StreamStatus trampolines with whichever SDK library is loaded, unless a
+// callback registration already did. Like the NetworkStatus trampoline, the registrations last until the
+// SDK is shut down. Must be called with g_callbackLock held.
+static GfnRuntimeError gfnRegisterPauseTrampolines(bool followFocus)
+{
+    GfnRuntimeError pauseStatus = gfnSuccess;
+    GfnRuntimeError focusStatus = gfnAPINotInit;
+    gfnCallbackSlot* pauseRegistration = &g_callbackSlots[gfnCallbackPause];
+    gfnCallbackSlot* focusRegistration = &g_callbackSlots[gfnCallbackStreamStatus];
+
+    if (!pauseRegistration->registered)
+    {
+        GFN_SDK_LOG("Registering for Pause Callback updates for the pause controller");
+        CALL_CLOUD_LIBRARY(pauseStatus, RegisterPauseCallback, &_gfnPauseCallbackWrapper, pauseRegistration);
+        if (GFNSDK_SUCCEEDED(pauseStatus))
+        {
+            pauseRegistration->registered = true;
+            pauseRegistration->param = 0;
+        }
+    }
+    if (followFocus && !focusRegistration->registered)
+    {
+        GFN_SDK_LOG("Registering for StreamStatus updates for the pause controller");
+        CALL_CLIENT_LIBRARY(focusStatus, RegisterStreamStatusCallback, &_gfnStreamStatusCallbackWrapper, focusRegistration);
+        if (GFNSDK_SUCCEEDED(focusStatus))
+        {
+            focusRegistration->registered = true;
+            focusRegistration->param = 0;
+        }
+    }
+    else if (focusRegistration->registered)
+    {
+        focusStatus = gfnSuccess;
+    }
+    // Games get the PauseCallback and streaming clients get the StreamStatus; either one is enough
+    return (GFNSDK_SUCCEEDED(pauseStatus) || GFNSDK_SUCCEEDED(focusStatus)) ? gfnSuccess : pauseStatus;
+}
+
+GfnRuntimeError GfnStartPauseController(const GfnPauseControllerConfig* config)
+{
+    GfnPauseControllerConfig next = { kGfnDefaultPausedFrameIntervalMs, true };
+    GfnRuntimeError status;
+
+    if (config != NULL)
+    {
+        next = *config;
+    }
+    if (next.pausedFrameIntervalMs == 0)
+    {
+        return gfnInvalidParameter;
+    }
+
+    gfnMutexLock(&g_callbackLock);
+    status = gfnRegisterPauseTrampolines(next.pauseOnFocusLoss);
+    gfnMutexUnlock(&g_callbackLock);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+    gfnMutexLock(&s_pauseLifecycleLock);
+    if (!gfnStartPauseThread())
+    {
+        gfnMutexUnlock(&s_pauseLifecycleLock);
+        return gfnInternalError;
+    }
+    gfnMutexLock(&s_pauseLock);
+    s_pauseConfig = next;
+    s_pauseStatus.started = true;
+    gfnMutexUnlock(&s_pauseLock);
+    gfnMutexUnlock(&s_pauseLifecycleLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnStopPauseController(void)
+{
+    if (t_inPauseTransition)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_pauseLifecycleLock);
+    gfnMutexLock(&s_pauseLock);
+    s_pauseStatus.started = false;
+    gfnMutexUnlock(&s_pauseLock);
+    gfnStopPauseThread();
+    gfnMutexLock(&s_pauseTransitionLock);
+    gfnLeavePause();
+    gfnMutexUnlock(&s_pauseTransitionLock);
+    gfnMutexUnlock(&s_pauseLifecycleLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnSetPaused(bool paused)
+{
+    if (t_inPauseTransition)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_pauseTransitionLock);
+    if (paused)
+    {
+        gfnEnterPause(gfnPauseReasonApplication);
+    }
+    else
+    {
+        gfnLeavePause();
+    }
+    gfnMutexUnlock(&s_pauseTransitionLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnAddPauseResourcePool(const GfnPauseResourcePool* pool, unsigned int* poolId)
+{
+    unsigned int slot;
+
+    CHECK_NULL_PARAM(pool);
+    CHECK_NULL_PARAM(poolId);
+    if (pool->release == NULL && pool->restore == NULL &&
+        (!pool->discardReclaimable || pool->reclaimable == NULL || pool->reclaimableSize == 0))
+    {
+        return gfnInvalidParameter;
+    }
+    if (t_inPauseTransition)
+    {
+        return gfnCallWrongEnvironment;
+    }
+
+    gfnMutexLock(&s_pauseTransitionLock);
+    for (slot = 0; slot < GFN_PAUSE_RESOURCE_POOL_CAPACITY && s_pausePools[slot].used; slot++)
+    {
+    }
+    if (slot == GFN_PAUSE_RESOURCE_POOL_CAPACITY)
+    {
+        gfnMutexUnlock(&s_pauseTransitionLock);
+        return gfnUnableToAllocateMemory;
+    }
+    gfnMutexLock(&s_pauseLock);
+    s_pausePools[slot].pool = *pool;
+    s_pausePools[slot].used = true;
+    s_pauseStatus.pools++;
+    gfnMutexUnlock(&s_pauseLock);
+    gfnMutexUnlock(&s_pauseTransitionLock);
+    *poolId = slot + 1;
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnRemovePauseResourcePool(unsigned int poolId)
+{
+    GfnRuntimeError status = gfnInvalidParameter;
+
+    if (t_inPauseTransition)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_pauseTransitionLock);
+    if (poolId != 0 && poolId <= GFN_PAUSE_RESOURCE_POOL_CAPACITY && s_pausePools[poolId - 1].used)
+    {
+        gfnMutexLock(&s_pauseLock);
+        memset(&s_pausePools[poolId - 1], 0, sizeof(s_pausePools[poolId - 1]));
+        s_pauseStatus.pools--;
+        gfnMutexUnlock(&s_pauseLock);
+        status = gfnSuccess;
+    }
+    gfnMutexUnlock(&s_pauseTransitionLock);
+    return status;
+}
+
+bool GfnThrottlePausedFrame(void)
+{
+    uint64_t nowNs;
+    uint64_t deadlineNs;
+    bool paused;
+
+    gfnMutexLock(&s_pauseLock);
+    deadlineNs = s_pausedFrameNs + (uint64_t)s_pauseConfig.pausedFrameIntervalMs * 1000000;
+    for (;;)
+    {
+        nowNs = gfnGetMonotonicNs();
+        if (!s_pauseStatus.paused || nowNs >= deadlineNs)
+        {
+            break;
+        }
+        gfnCondVarWait(&s_pauseResumed, &s_pauseLock, (unsigned int)((deadlineNs - nowNs + 999999) / 1000000));
+    }
+    paused = s_pauseStatus.paused;
+    if (paused)
+    {
+        s_pausedFrameNs = nowNs;
+    }
+    gfnMutexUnlock(&s_pauseLock);
+    return paused;
+}
+
+bool GfnParkPausedWorker(unsigned int timeoutMs)
+{
+    uint64_t deadlineNs = gfnGetMonotonicNs() + (uint64_t)timeoutMs * 1000000;
+    uint64_t nowNs;
+    bool paused;
+
+    gfnMutexLock(&s_pauseLock);
+    s_pauseStatus.parkedWorkers++;
+    for (;;)
+    {
+        nowNs = gfnGetMonotonicNs();
+        if (!s_pauseStatus.paused || nowNs >= deadlineNs)
+        {
+            break;
+        }
+        gfnCondVarWait(&s_pauseResumed, &s_pauseLock, (unsigned int)((deadlineNs - nowNs + 999999) / 1000000));
+    }
+    s_pauseStatus.parkedWorkers--;
+    paused = s_pauseStatus.paused;
+    gfnMutexUnlock(&s_pauseLock);
+    return paused;
+}
+
+GfnRuntimeError GfnGetPauseControllerStatus(GfnPauseControllerStatus* status)
+{
+    CHECK_NULL_PARAM(status);
+    gfnMutexLock(&s_pauseLock);
+    *status = s_pauseStatus;
+    status->pausedForMs = status->paused ? (unsigned int)((gfnGetMonotonicNs() - s_pausedNs) / 1000000) : 0;
+    gfnMutexUnlock(&s_pauseLock);
+    return gfnSuccess;
+}
+
+// Stops the controller, resumes the seat, releasing the throttled and parked threads, and resets the
+// counters. The pools are kept for the next session; the event registrations were dropped with the
+// callback slots, so the controller must be started again.
+static void gfnResetPauseController(void)
+{
+    unsigned int parkedWorkers;
+    unsigned int pools;
+
+    if (t_inPauseTransition)
+    {
+        GFN_SDK_LOG_WARNING("GfnShutdownSdk called while pausing or resuming; the pause controller keeps running");
+        return;
+    }
+    gfnMutexLock(&s_pauseLifecycleLock);
+    gfnMutexLock(&s_pauseLock);
+    s_pauseStatus.started = false;
+    gfnMutexUnlock(&s_pauseLock);
+    gfnStopPauseThread();
+    gfnMutexLock(&s_pauseTransitionLock);
+    gfnLeavePause();
+    gfnMutexLock(&s_pauseLock);
+    // Woken workers may not have left GfnParkPausedWorker yet
+    parkedWorkers = s_pauseStatus.parkedWorkers;
+    pools = s_pauseStatus.pools;
+    memset(&s_pauseStatus, 0, sizeof(s_pauseStatus));
+    s_pauseStatus.parkedWorkers = parkedWorkers;
+    s_pauseStatus.pools = pools;
+    s_pauseConfig.pausedFrameIntervalMs = kGfnDefaultPausedFrameIntervalMs;
+    s_pauseConfig.pauseOnFocusLoss = true;
+    gfnMutexUnlock(&s_pauseLock);
+    gfnMutexUnlock(&s_pauseTransitionLock);
+    gfnMutexUnlock(&s_pauseLifecycleLock);
+}
+
+// Exit orchestrator. A run of the exit tasks is a dependency graph: a task is ready once every task it
+// depends on has finished or been skipped, and the thread running the exit and the worker threads each
+// start the ready task with the highest priority until none is left. Dependencies can only name tasks
+// added earlier, so the graph has no cycles and every run ends.
+//
+// s_exitLifecycleLock serializes starting, stopping, runs and changes to the tasks, and is held for the
+// whole run, so the tasks do not change under the workers. s_exitLock guards the state of the run and the
+// report, is taken after s_exitLifecycleLock and is never held while calling a task.
+//
+// The ExitCallback runs the tasks on the GeForce NOW callback thread, which belongs to the cloud library.
+// Shutting the SDK down there would unload that library under its own thread, so the shutdown, when the
+// configuration asks for it, runs on a detached thread of the wrapper.
+#define kGfnDefaultExitDeadlineMs 2000
+#define kGfnDefaultExitWorkerThreads 3
+
+typedef struct gfnExitTaskSlot
+{
+    GfnExitTask task;
+    char name[32];
+    bool used;
+    bool started;                   // Started or skipped in the current run, guarded by s_exitLock
+    unsigned int waitingOn;         // Dependencies not finished in the current run, guarded by s_exitLock
+} gfnExitTaskSlot;
+
+static gfnMutex s_exitLifecycleLock = GFN_MUTEX_INITIALIZER;
+static gfnMutex s_exitLock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_exitWake = GFN_CONDVAR_INITIALIZER;    // A run started, a task finished, or the workers must stop
+static gfnAtomic32 s_exitOrchestratorStarted = 0;
+static GFN_THREAD_LOCAL bool t_runningExitTask = false;
+
+// Guarded by s_exitLifecycleLock
+static gfnExitTaskSlot s_exitTasks[GFN_EXIT_TASK_CAPACITY];
+static GfnExitOrchestratorConfig s_exitConfig = { kGfnDefaultExitDeadlineMs, 0, false };
+static gfnThread s_exitWorkers[GFN_EXIT_WORKER_CAPACITY];
+static unsigned int s_exitWorkerCount = 0;
+
+// Guarded by s_exitLock
+static uint32_t s_exitGeneration = 0;       // Incremented by each run, so a worker joins every run once
+static uint32_t s_exitWorkersGeneration = 0; // Generation when the workers were started
+static unsigned int s_exitRemaining = 0;    // Tasks of the current run not finished or skipped
+static uint64_t s_exitBeginNs = 0;
+static uint64_t s_exitDeadlineNs = 0;
+static bool s_exitWorkersStop = false;
+static GfnExitReport s_exitReport;
+
+// Lets the tasks waiting on a finished or skipped task start. Must be called with s_exitLock held.
+static void gfnFinishExitTask(unsigned int index)
+{
+    unsigned int i;
+    unsigned int d;
+
+    s_exitRemaining--;
+    for (i = 0; i < GFN_EXIT_TASK_CAPACITY; i++)
+    {
+        for (d = 0; s_exitTasks[i].used && !s_exitTasks[i].started && d < GFN_EXIT_TASK_MAX_DEPENDENCIES; d++)
+        {
+            if (s_exitTasks[i].task.dependencies[d] == index + 1)
+            {
+                s_exitTasks[i].waitingOn--;
+            }
+        }
+    }
+    gfnCondVarBroadcast(&s_exitWake);
+}
+
+static GfnExitTaskReport* gfnAddExitTaskReport(unsigned int index, unsigned int worker, uint64_t startNs)
+{
+    GfnExitTaskReport* entry = &s_exitReport.tasks[s_exitReport.taskCount++];
+
+    memcpy(entry->name, s_exitTasks[index].name, sizeof(entry->name));
+    entry->taskId = index + 1;
+    entry->critical = s_exitTasks[index].task.critical;
+    entry->worker = worker;
+    entry->startUs = (unsigned int)((startNs - s_exitBeginNs) / 1000);
+    return entry;
+}
+
+// Marks the ready task with the highest priority as started and returns it, skipping the ready tasks that
+// are not critical once the deadline has passed. Returns -1 if no task is ready. Must be called with
+// s_exitLock held.
+static int gfnNextExitTask(unsigned int worker)
+{
+    uint64_t nowNs = gfnGetMonotonicNs();
+    gfnExitTaskSlot* slot;
+    bool skipped;
+    int best;
+    int i;
+
+    do
+    {
+        skipped = false;
+        best = -1;
+        for (i = 0; i < GFN_EXIT_TASK_CAPACITY; i++)
+        {
+            slot = &s_exitTasks[i];
+            if (!slot->used || slot->started || slot->waitingOn != 0)
+            {
+                continue;
+            }
+            if (!slot->task.critical && nowNs >= s_exitDeadlineNs)
+            {
+                // Skipping a task can make tasks earlier in the table ready, so the scan starts over
+                slot->started = true;
+                gfnAddExitTaskReport((unsigned int)i, worker, nowNs)->state = gfnExitTaskSkipped;
+                gfnFinishExitTask((unsigned int)i);
+                skipped = true;
+            }
+            else if (best < 0 || slot->task.priority > s_exitTasks[best].task.priority)
+            {
+                best = i;
+            }
+        }
+    } while (skipped && best < 0);
+    if (best >= 0)
+    {
+        s_exitTasks[best].started = true;
+    }
+    return best;
+}
+
+// Runs ready tasks until every task of the run has finished or been skipped. Must be called with
+// s_exitLock held.
+static void gfnWorkOnExitTasks(unsigned int worker)
+{
+    ExitTaskCallbackSig run;
+    void* userContext;
+    GfnExitTaskReport* entry;
+    GfnApplicationCallbackResult result;
+    uint64_t startNs;
+    int index;
+
+    while (s_exitRemaining > 0)
+    {
+        index = gfnNextExitTask(worker);
+        if (index < 0)
+        {
+            gfnCondVarWait(&s_exitWake, &s_exitLock, 100);
+            continue;
+        }
+        startNs = gfnGetMonotonicNs();
+        entry = gfnAddExitTaskReport((unsigned int)index, worker, startNs);
+        run = s_exitTasks[index].task.run;
+        userContext = s_exitTasks[index].task.userContext;
+        gfnMutexUnlock(&s_exitLock);
+
+        t_runningExitTask = true;
+        result = run(userContext);
+        t_runningExitTask = false;
+
+        gfnMutexLock(&s_exitLock);
+        entry->durationUs = (unsigned int)((gfnGetMonotonicNs() - startNs) / 1000);
+        entry->state = (result == crCallbackSuccess) ? gfnExitTaskSucceeded : gfnExitTaskFailed;
+        gfnFinishExitTask((unsigned int)index);
+    }
+}
+
+static GFN_THREAD_PROC gfnExitWorkerThread(void* arg)
+{
+    unsigned int worker = (unsigned int)(uintptr_t)arg;
+    uint32_t seenGeneration;
+
+    gfnMutexLock(&s_exitLock);
+    // A worker scheduled late still joins a run that started after GfnStartExitOrchestrator returned
+    seenGeneration = s_exitWorkersGeneration;
+    for (;;)
+    {
+        while (seenGeneration == s_exitGeneration && !s_exitWorkersStop)
+        {
+            gfnCondVarWait(&s_exitWake, &s_exitLock, 1000);
+        }
+        if (s_exitWorkersStop)
+        {
+            break;
+        }
+        seenGeneration = s_exitGeneration;
+        gfnWorkOnExitTasks(worker);
+    }
+    gfnMutexUnlock(&s_exitLock);
+    return GFN_THREAD_RETURN;
+}
+
+// Must be called with s_exitLifecycleLock held
+static void gfnStopExitWorkers(void)
+{
+    unsigned int i;
+
+    gfnMutexLock(&s_exitLock);
+    s_exitWorkersStop = true;
+    gfnCondVarBroadcast(&s_exitWake);
+    gfnMutexUnlock(&s_exitLock);
+    for (i = 0; i < s_exitWorkerCount; i++)
+    {
+        gfnThreadJoin(s_exitWorkers[i]);
+    }
+    s_exitWorkerCount = 0;
+}
+
+// Must be called with s_exitLifecycleLock held
+static bool gfnStartExitWorkers(unsigned int count)
+{
+    gfnMutexLock(&s_exitLock);
+    s_exitWorkersStop = false;
+    s_exitWorkersGeneration = s_exitGeneration;
+    gfnMutexUnlock(&s_exitLock);
+    for (s_exitWorkerCount = 0; s_exitWorkerCount < count; s_exitWorkerCount++)
+    {
+        // Worker 0 is the thread running the exit
+        if (!gfnThreadCreate(&s_exitWorkers[s_exitWorkerCount], gfnExitWorkerThread, (void*)(uintptr_t)(s_exitWorkerCount + 1)))
+        {
+            gfnStopExitWorkers();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs every task and fills in the report. Must be called with s_exitLifecycleLock held.
+static void gfnRunExitTaskGraph(void)
+{
+    gfnExitTaskSlot* slot;
+    GfnExitTaskReport* entry;
+    unsigned int count = 0;
+    unsigned int i;
+    unsigned int d;
+
+    for (i = 0; i < GFN_EXIT_TASK_CAPACITY; i++)
+    {
+        count += s_exitTasks[i].used ? 1 : 0;
+    }
+    if (count == 0)
+    {
+        return;
+    }
+
+    gfnMutexLock(&s_exitLock);
+    memset(&s_exitReport, 0, sizeof(s_exitReport));
+    s_exitReport.deadlineMs = s_exitConfig.deadlineMs;
+    for (i = 0; i < GFN_EXIT_TASK_CAPACITY; i++)
+    {
+        slot = &s_exitTasks[i];
+        slot->started = false;
+        slot->waitingOn = 0;
+        for (d = 0; d < GFN_EXIT_TASK_MAX_DEPENDENCIES; d++)
+        {
+            slot->waitingOn += (slot->task.dependencies[d] != 0) ? 1 : 0;
+        }
+    }
+    s_exitRemaining = count;
+    s_exitBeginNs = gfnGetMonotonicNs();
+    s_exitDeadlineNs = s_exitBeginNs + (uint64_t)s_exitConfig.deadlineMs * 1000000;
+    s_exitGeneration++;
+    gfnCondVarBroadcast(&s_exitWake);
+    gfnWorkOnExitTasks(0);
+
+    // Every task has finished once the thread running the exit runs out of tasks
+    s_exitReport.ran = true;
+    s_exitReport.totalUs = (unsigned int)((gfnGetMonotonicNs() - s_exitBeginNs) / 1000);
+    s_exitReport.deadlineExceeded = s_exitReport.totalUs > (uint64_t)s_exitConfig.deadlineMs * 1000;
+    for (i = 0; i < s_exitReport.taskCount; i++)
+    {
+        entry = &s_exitReport.tasks[i];
+        s_exitReport.succeeded += (entry->state == gfnExitTaskSucceeded) ? 1 : 0;
+        s_exitReport.failed += (entry->state == gfnExitTaskFailed) ? 1 : 0;
+        s_exitReport.skipped += (entry->state == gfnExitTaskSkipped) ? 1 : 0;
+        GFN_SDK_LOG("Exit task %s %s, started at %u us, took %u us on worker %u", entry->name,
+            (entry->state == gfnExitTaskSkipped) ? "skipped" : (entry->state == gfnExitTaskFailed) ? "failed" : "succeeded",
+            entry->startUs, entry->durationUs, entry->worker);
+    }
+    GFN_SDK_LOG("Exit tasks took %u us of a %u ms deadline: %u succeeded, %u failed, %u skipped",
+        s_exitReport.totalUs, s_exitReport.deadlineMs, s_exitReport.succeeded, s_exitReport.failed, s_exitReport.skipped);
+    gfnMutexUnlock(&s_exitLock);
+}
+
+static GFN_THREAD_PROC gfnExitShutdownThread(void* arg)
+{
+    (void)arg;
+    GFN_SDK_LOG("Shutting down the SDK after the exit tasks");
+    GfnShutdownSdk();
+    return GFN_THREAD_RETURN;
+}
+
+static void gfnExitOnExitCallback(void)
+{
+    gfnThread thread;
+    bool shutDown;
+
+    if (!gfnAtomicLoadAcquire32(&s_exitOrchestratorStarted))
+    {
+        return;
+    }
+    GFN_SDK_LOG("Running the exit tasks for the ExitCallback");
+    gfnMutexLock(&s_exitLifecycleLock);
+    gfnRunExitTaskGraph();
+    shutDown = s_exitConfig.shutDownSdk;
+    gfnMutexUnlock(&s_exitLifecycleLock);
+    if (!shutDown)
+    {
+        return;
+    }
+    if (gfnThreadCreate(&thread, gfnExitShutdownThread, NULL))
+    {
+        gfnThreadDetach(thread);
+    }
+    else
+    {
+        GFN_SDK_LOG_ERROR("Could not start the thread shutting down the SDK after the exit tasks");
+    }
+}
+
+// Registers the Exit trampoline with the cloud library unless a callback registration already did. Like
+// the NetworkStatus trampoline, the registration lasts until the SDK is shut down. Must be called with
+// g_callbackLock held.
+static GfnRuntimeError gfnRegisterExitTrampoline(void)
+{
+    GfnRuntimeError status = gfnSuccess;
+    gfnCallbackSlot* registration = &g_callbackSlots[gfnCallbackExit];
+
+    if (registration->registered)
+    {
+        return gfnSuccess;
+    }
+    GFN_SDK_LOG("Registering for Exit Callback updates for the exit orchestrator");
+    CALL_CLOUD_LIBRARY(status, RegisterExitCallback, &_gfnExitCallbackWrapper, registration);
+    if (GFNSDK_SUCCEEDED(status))
+    {
+        registration->registered = true;
+        registration->param = 0;
+    }
+    return status;
+}
+
+GfnRuntimeError GfnStartExitOrchestrator(const GfnExitOrchestratorConfig* config)
+{
+    GfnExitOrchestratorConfig next = { kGfnDefaultExitDeadlineMs, kGfnDefaultExitWorkerThreads, false };
+    GfnRuntimeError status;
+
+    if (config != NULL)
+    {
+        next = *config;
+    }
+    if (next.workerThreads > GFN_EXIT_WORKER_CAPACITY)
+    {
+        return gfnInvalidParameter;
+    }
+    if (t_runningExitTask)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    CHECK_CLOUD_ENVIRONMENT();
+
+    gfnMutexLock(&g_callbackLock);
+    status = gfnRegisterExitTrampoline();
+    gfnMutexUnlock(&g_callbackLock);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+
+    gfnMutexLock(&s_exitLifecycleLock);
+    if (s_exitWorkerCount != next.workerThreads)
+    {
+        gfnStopExitWorkers();
+        if (!gfnStartExitWorkers(next.workerThreads))
+        {
+            gfnAtomicExchange32(&s_exitOrchestratorStarted, 0);
+            gfnMutexUnlock(&s_exitLifecycleLock);
+            return gfnInternalError;
+        }
+    }
+    s_exitConfig = next;
+    gfnAtomicExchange32(&s_exitOrchestratorStarted, 1);
+    gfnMutexUnlock(&s_exitLifecycleLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnStopExitOrchestrator(void)
+{
+    if (t_runningExitTask)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_exitLifecycleLock);
+    gfnAtomicExchange32(&s_exitOrchestratorStarted, 0);
+    gfnStopExitWorkers();
+    s_exitConfig.deadlineMs = kGfnDefaultExitDeadlineMs;
+    s_exitConfig.workerThreads = 0;
+    s_exitConfig.shutDownSdk = false;
+    gfnMutexUnlock(&s_exitLifecycleLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnAddExitTask(const GfnExitTask* task, unsigned int* taskId)
+{
+    unsigned int slot;
+    unsigned int dependency;
+    int d;
+
+    CHECK_NULL_PARAM(task);
+    CHECK_NULL_PARAM(task->run);
+    CHECK_NULL_PARAM(taskId);
+    if (t_runningExitTask)
+    {
+        return gfnCallWrongEnvironment;
+    }
+
+    gfnMutexLock(&s_exitLifecycleLock);
+    for (d = 0; d < GFN_EXIT_TASK_MAX_DEPENDENCIES; d++)
+    {
+        dependency = task->dependencies[d];
+        if (dependency != 0 && (dependency > GFN_EXIT_TASK_CAPACITY || !s_exitTasks[dependency - 1].used))
+        {
+            gfnMutexUnlock(&s_exitLifecycleLock);
+            return gfnInvalidParameter;
+        }
+    }
+    for (slot = 0; slot < GFN_EXIT_TASK_CAPACITY && s_exitTasks[slot].used; slot++)
+    {
+    }
+    if (slot == GFN_EXIT_TASK_CAPACITY)
+    {
+        gfnMutexUnlock(&s_exitLifecycleLock);
+        return gfnUnableToAllocateMemory;
+    }
+    memset(&s_exitTasks[slot], 0, sizeof(s_exitTasks[slot]));
+    s_exitTasks[slot].task = *task;
+    s_exitTasks[slot].used = true;
+    if (task->name != NULL)
+    {
+        snprintf(s_exitTasks[slot].name, sizeof(s_exitTasks[slot].name), "%s", task->name);
+    }
+    else
+    {
+        snprintf(s_exitTasks[slot].name, sizeof(s_exitTasks[slot].name), "task %u", slot + 1);
+    }
+    s_exitTasks[slot].task.name = s_exitTasks[slot].name;
+    gfnMutexUnlock(&s_exitLifecycleLock);
+    *taskId = slot + 1;
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnRemoveExitTask(unsigned int taskId)
+{
+    GfnRuntimeError status = gfnInvalidParameter;
+    unsigned int i;
+    int d;
+
+    if (t_runningExitTask)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_exitLifecycleLock);
+    if (taskId != 0 && taskId <= GFN_EXIT_TASK_CAPACITY && s_exitTasks[taskId - 1].used)
+    {
+        status = gfnSuccess;
+        // A later task could take the identifier, so a task still depended on stays
+        for (i = 0; i < GFN_EXIT_TASK_CAPACITY; i++)
+        {
+            for (d = 0; s_exitTasks[i].used && d < GFN_EXIT_TASK_MAX_DEPENDENCIES; d++)
+            {
+                if (s_exitTasks[i].task.dependencies[d] == taskId)
+                {
+                    status = gfnInvalidParameter;
+                }
+            }
+        }
+        if (GFNSDK_SUCCEEDED(status))
+        {
+            memset(&s_exitTasks[taskId - 1], 0, sizeof(s_exitTasks[taskId - 1]));
+        }
+    }
+    gfnMutexUnlock(&s_exitLifecycleLock);
+    return status;
+}
+
+GfnRuntimeError GfnRunExitTasks(void)
+{
+    if (t_runningExitTask)
+    {
+        return gfnCallWrongEnvironment;
+    }
+    gfnMutexLock(&s_exitLifecycleLock);
+    gfnRunExitTaskGraph();
+    gfnMutexUnlock(&s_exitLifecycleLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnGetExitReport(GfnExitReport* report)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(report);
+    gfnMutexLock(&s_exitLock);
+    if (!s_exitReport.ran)
+    {
+        status = gfnNoData;
+    }
+    else
+    {
+        *report = s_exitReport;
+    }
+    gfnMutexUnlock(&s_exitLock);
+    return status;
+}
+
+// Stops the workers and drops the tasks. The report is kept, since the exit can shut the SDK down.
+static void gfnResetExitOrchestrator(void)
+{
+    if (t_runningExitTask)
+    {
+        GFN_SDK_LOG_WARNING("GfnShutdownSdk called from an exit task; the exit orchestrator keeps its tasks");
+        return;
+    }
+    GfnStopExitOrchestrator();
+    gfnMutexLock(&s_exitLifecycleLock);
+    memset(s_exitTasks, 0, sizeof(s_exitTasks));
+    gfnMutexUnlock(&s_exitLifecycleLock);
+}
+
+// Prefetcher. A prefetch warms the file cache in two phases sharing one pool of threads: the entries of
+// the manifest are claimed in order, and once they are all claimed, the threads take directories off a
+// shared stack, push the subdirectories they find and warm the files the manifest did not list. The
+// prefetch ends when the manifest and the stack are empty and no thread is listing a directory, or
+// once the budget is used up. Symbolic links and reparse points are not followed, so the walk ends.
+//
+// The InstallCallback arrives on the GeForce NOW callback thread, so the Install trampoline only copies
+// the paths and wakes the coordinator thread, which stops the previous prefetch, parses the manifest and
+// starts the new one. A request the coordinator has not picked up yet is replaced by a newer one.
+//
+// s_prefetchCoordinatorLock serializes starting and stopping the coordinator and is taken before
+// s_prefetchLifecycleLock, which the coordinator takes. s_prefetchLifecycleLock serializes starting and
+// stopping prefetches. s_prefetchLock guards the state of the prefetch and the pending request, and is
+// never held while touching the file system.
+#define kGfnDefaultPrefetchThreads 4
+#define kGfnPrefetchReadSize (1024 * 1024)     // Size of the reads that warm a file on Windows
+
+typedef struct gfnPrefetchEntry
+{
+    CHAR_TYPE* path;
+    uint64_t offset;
+    uint64_t length;                // 0 for the rest of the file
+} gfnPrefetchEntry;
+
+static gfnMutex s_prefetchCoordinatorLock = GFN_MUTEX_INITIALIZER;
+static gfnMutex s_prefetchLifecycleLock = GFN_MUTEX_INITIALIZER;
+static gfnMutex s_prefetchLock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_prefetchWake = GFN_CONDVAR_INITIALIZER;    // A directory was queued or listed, or the prefetch ended
+static gfnCondVar s_prefetchRequestWake = GFN_CONDVAR_INITIALIZER; // A request is pending, or the coordinator must stop
+static gfnAtomic32 s_prefetcherStarted = 0;
+static gfnAtomic32 s_prefetchCancelled = 0;                 // Read without the lock between reads of a file
+
+// Guarded by s_prefetchCoordinatorLock
+static gfnThread s_prefetchCoordinator;
+static bool s_prefetchCoordinatorRunning = false;
+
+// Guarded by s_prefetchLifecycleLock
+static CHAR_TYPE s_prefetchManifestPath[PLATFORM_MAX_PATH];
+static GfnPrefetchConfig s_prefetchConfig = { 0, 0, kGfnDefaultPrefetchThreads };
+static gfnThread s_prefetchThreads[GFN_PREFETCH_THREAD_CAPACITY];
+static unsigned int s_prefetchThreadCount = 0;
+
+// Guarded by s_prefetchLock
+static gfnPrefetchEntry* s_prefetchManifest = NULL;
+static unsigned int s_prefetchManifestNext = 0;         // Next entry to claim
+static unsigned int s_prefetchManifestIssued = 0;       // Entries done with
+static uint64_t* s_prefetchManifestHashes = NULL;       // Open addressing set of the manifest's paths
+static unsigned int s_prefetchManifestHashMask = 0;
+static CHAR_TYPE** s_prefetchDirectories = NULL;        // Stack of directories to list
+static unsigned int s_prefetchDirectoryCount = 0;
+static unsigned int s_prefetchDirectoryCapacity = 0;
+static unsigned int s_prefetchListing = 0;              // Threads listing a directory, which may push more
+static unsigned int s_prefetchActive = 0;               // Threads that have not finished
+static uint64_t s_prefetchBeginNs = 0;
+static uint64_t s_prefetchDeadlineNs = 0;               // 0 without a time budget
+static GfnPrefetchStatus s_prefetchStatus;
+static char* s_prefetchRequestBuildPath = NULL;         // Pending request from the InstallCallback, or NULL
+static char* s_prefetchRequestMetadataPath = NULL;
+static bool s_prefetchCoordinatorStop = false;
+static bool s_prefetchRequestBusy = false;               // A request is pending or being started by the coordinator
+
+static bool gfnUtf8ToPath(const char* in, CHAR_TYPE* out)
+{
+#ifdef _WIN32
+    return GfnUtf8ToWide(in, out, PLATFORM_MAX_PATH);
+#elif __linux__
+    size_t length = strlen(in);
+
+    if (length >= PLATFORM_MAX_PATH)
+    {
+        return false;
+    }
+    memcpy(out, in, length + 1);
+    return true;
+#endif
+}
+
+// Joins a directory and a name into out, which holds PLATFORM_MAX_PATH characters
+static bool gfnJoinPrefetchPath(CHAR_TYPE const* directory, CHAR_TYPE const* name, CHAR_TYPE* out)
+{
+#ifdef _WIN32
+    size_t directoryLength = wcslen(directory);
+    size_t nameLength = wcslen(name);
+    const CHAR_TYPE separator = L'\\';
+#elif __linux__
+    size_t directoryLength = strlen(directory);
+    size_t nameLength = strlen(name);
+    const CHAR_TYPE separator = '/';
+#endif
+
+    if (directoryLength + 1 + nameLength >= PLATFORM_MAX_PATH)
+    {
+        return false;
+    }
+    memcpy(out, directory, directoryLength * sizeof(CHAR_TYPE));
+    out[directoryLength] = separator;
+    memcpy(out + directoryLength + 1, name, (nameLength + 1) * sizeof(CHAR_TYPE));
+    return true;
+}
+
+static CHAR_TYPE* gfnCopyPrefetchPath(CHAR_TYPE const* path)
+{
+#ifdef _WIN32
+    size_t size = (wcslen(path) + 1) * sizeof(CHAR_TYPE);
+#elif __linux__
+    size_t size = (strlen(path) + 1) * sizeof(CHAR_TYPE);
+#endif
+    CHAR_TYPE* copy = (CHAR_TYPE*)malloc(size);
+
+    if (copy != NULL)
+    {
+        memcpy(copy, path, size);
+    }
+    return copy;
+}
+
+static uint64_t gfnHashPrefetchPath(CHAR_TYPE const* path)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (; *path != 0; path++)
+    {
+        hash = (hash ^ (uint64_t)*path) * 1099511628211ULL;
+    }
+    // 0 marks a free slot
+    return (hash != 0) ? hash : 1;
+}
+
+// Returns true if the manifest lists the file. Must be called with s_prefetchLock held.
+static bool gfnIsInPrefetchManifest(uint64_t hash)
+{
+    unsigned int i;
+
+    if (s_prefetchManifestHashes == NULL)
+    {
+        return false;
+    }
+    for (i = (unsigned int)hash & s_prefetchManifestHashMask; s_prefetchManifestHashes[i] != 0; i = (i + 1) & s_prefetchManifestHashMask)
+    {
+        if (s_prefetchManifestHashes[i] == hash)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Takes up to wanted bytes from the byte budget. Must be called with s_prefetchLock held.
+static uint64_t gfnReservePrefetchBytes(uint64_t wanted)
+{
+    uint64_t remaining = s_prefetchConfig.budgetBytes - s_prefetchStatus.bytesRequested;
+
+    if (s_prefetchConfig.budgetBytes != 0 && wanted >= remaining)
+    {
+        s_prefetchStatus.budgetExhausted = true;
+        wanted = remaining;
+    }
+    // Counted now, so concurrent files cannot overrun the budget together
+    s_prefetchStatus.bytesRequested += wanted;
+    return wanted;
+}
+
+// Asks the system to read a range of a file into its cache. Returns false if the file cannot be opened.
+static bool gfnWarmPrefetchFile(CHAR_TYPE const* path, uint64_t offset, uint64_t length, uint8_t* buffer)
+{
+    uint64_t size;
+    uint64_t granted;
+#ifdef _WIN32
+    HANDLE file;
+    LARGE_INTEGER fileSize;
+    LARGE_INTEGER position;
+    DWORD chunk;
+    DWORD bytesRead;
+
+    file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    size = (uint64_t)fileSize.QuadPart;
+#elif __linux__
+    int fd;
+    struct stat info;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    size = (uint64_t)info.st_size;
+#endif
+
+    if (offset > size)
+    {
+        offset = size;
+    }
+    if (length == 0 || length > size - offset)
+    {
+        length = size - offset;
+    }
+    gfnMutexLock(&s_prefetchLock);
+    granted = gfnReservePrefetchBytes(length);
+    s_prefetchStatus.filesWarmed++;
+    gfnMutexUnlock(&s_prefetchLock);
+
+#ifdef _WIN32
+    // Windows has no read-ahead hint for a range, so the file is read through the cache and discarded
+    position.QuadPart = (LONGLONG)offset;
+    if (granted != 0 && SetFilePointerEx(file, position, NULL, FILE_BEGIN))
+    {
+        while (granted > 0 && !gfnAtomicLoadAcquire32(&s_prefetchCancelled))
+        {
+            chunk = (granted < kGfnPrefetchReadSize) ? (DWORD)granted : kGfnPrefetchReadSize;
+            if (!ReadFile(file, buffer, chunk, &bytesRead, NULL) || bytesRead == 0)
+            {
+                break;
+            }
+            granted -= bytesRead;
+        }
+    }
+    CloseHandle(file);
+#elif __linux__
+    // Only a hint: the kernel reads ahead in the background and may drop it, so the bytes are reported
+    // as requested rather than read
+    (void)buffer;
+    if (granted != 0)
+    {
+        posix_fadvise(fd, (off_t)offset, (off_t)granted, POSIX_FADV_WILLNEED);
+    }
+    close(fd);
+#endif
+    return true;
+}
+
+static void gfnPushPrefetchDirectory(CHAR_TYPE const* path)
+{
+    CHAR_TYPE** grown;
+    CHAR_TYPE* copy = gfnCopyPrefetchPath(path);
+
+    if (copy == NULL)
+    {
+        return;
+    }
+    gfnMutexLock(&s_prefetchLock);
+    if (s_prefetchDirectoryCount == s_prefetchDirectoryCapacity)
+    {
+        grown = (CHAR_TYPE**)realloc(s_prefetchDirectories, sizeof(CHAR_TYPE*) * (s_prefetchDirectoryCapacity * 2 + 16));
+        if (grown == NULL)
+        {
+            gfnMutexUnlock(&s_prefetchLock);
+            free(copy);
+            return;
+        }
+        s_prefetchDirectories = grown;
+        s_prefetchDirectoryCapacity = s_prefetchDirectoryCapacity * 2 + 16;
+    }
+    s_prefetchDirectories[s_prefetchDirectoryCount++] = copy;
+    gfnCondVarSignal(&s_prefetchWake);
+    gfnMutexUnlock(&s_prefetchLock);
+}
+
+// Warms a file found by the walk unless the manifest already listed it
+static void gfnWarmWalkedFile(CHAR_TYPE const* path, uint8_t* buffer)
+{
+    uint64_t hash = gfnHashPrefetchPath(path);
+    bool listed;
+
+    gfnMutexLock(&s_prefetchLock);
+    listed = gfnIsInPrefetchManifest(hash);
+    gfnMutexUnlock(&s_prefetchLock);
+    if (!listed && !gfnWarmPrefetchFile(path, 0, 0, buffer))
+    {
+        gfnMutexLock(&s_prefetchLock);
+        s_prefetchStatus.filesFailed++;
+        gfnMutexUnlock(&s_prefetchLock);
+    }
+}
+
+// Pushes the subdirectories of a directory and warms its files. Returns false if it cannot be listed.
+static bool gfnWalkPrefetchDirectory(CHAR_TYPE const* directory, uint8_t* buffer)
+{
+    CHAR_TYPE path[PLATFORM_MAX_PATH];
+#ifdef _WIN32
+    WIN32_FIND_DATAW entry;
+    HANDLE find;
+
+    if (!gfnJoinPrefetchPath(directory, L"*", path))
+    {
+        return false;
+    }
+    find = FindFirstFileExW(path, FindExInfoBasic, &entry, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    do
+    {
+        if (wcscmp(entry.cFileName, L".") == 0 || wcscmp(entry.cFileName, L"..") == 0 ||
+            (entry.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) || !gfnJoinPrefetchPath(directory, entry.cFileName, path))
+        {
+            continue;
+        }
+        if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            gfnPushPrefetchDirectory(path);
+        }
+        else
+        {
+            gfnWarmWalkedFile(path, buffer);
+        }
+    } while (!gfnAtomicLoadAcquire32(&s_prefetchCancelled) && FindNextFileW(find, &entry));
+    FindClose(find);
+#elif __linux__
+    DIR* listing;
+    struct dirent* entry;
+    struct stat info;
+    unsigned char type;
+
+    listing = opendir(directory);
+    if (listing == NULL)
+    {
+        return false;
+    }
+    while (!gfnAtomicLoadAcquire32(&s_prefetchCancelled) && (entry = readdir(listing)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0 || !gfnJoinPrefetchPath(directory, entry->d_name, path))
+        {
+            continue;
+        }
+        type = entry->d_type;
+        if (type == DT_UNKNOWN && lstat(path, &info) == 0)
+        {
+            type = S_ISDIR(info.st_mode) ? DT_DIR : S_ISREG(info.st_mode) ? DT_REG : DT_UNKNOWN;
+        }
+        if (type == DT_DIR)
+        {
+            gfnPushPrefetchDirectory(path);
+        }
+        else if (type == DT_REG)
+        {
+            gfnWarmWalkedFile(path, buffer);
+        }
+    }
+    closedir(listing);
+#endif
+    return true;
+}
+
+// Stops the prefetch once a budget is used up. Must be called with s_prefetchLock held.
+static bool gfnIsPrefetchBudgetLeft(void)
+{
+    if (s_prefetchDeadlineNs != 0 && gfnGetMonotonicNs() >= s_prefetchDeadlineNs)
+    {
+        s_prefetchStatus.budgetExhausted = true;
+    }
+    return !s_prefetchStatus.budgetExhausted;
+}
+
+static GFN_THREAD_PROC gfnPrefetchThread(void* arg)
+{
+    gfnPrefetchEntry entry;
+    CHAR_TYPE* directory;
+    uint8_t* buffer = NULL;
+    bool warmed;
+
+    (void)arg;
+#ifdef _WIN32
+    buffer = (uint8_t*)malloc(kGfnPrefetchReadSize);
+    if (buffer == NULL)
+    {
+        gfnMutexLock(&s_prefetchLock);
+        goto finished;
+    }
+#endif
+    gfnMutexLock(&s_prefetchLock);
+    while (!gfnAtomicLoadAcquire32(&s_prefetchCancelled) && gfnIsPrefetchBudgetLeft())
+    {
+        if (s_prefetchManifestNext < s_prefetchStatus.manifestEntries)
+        {
+            entry = s_prefetchManifest[s_prefetchManifestNext++];
+            gfnMutexUnlock(&s_prefetchLock);
+            warmed = gfnWarmPrefetchFile(entry.path, entry.offset, entry.length, buffer);
+            gfnMutexLock(&s_prefetchLock);
+            s_prefetchStatus.filesFailed += warmed ? 0 : 1;
+            if (++s_prefetchManifestIssued == s_prefetchStatus.manifestEntries)
+            {
+                s_prefetchStatus.manifestMs = (unsigned int)((gfnGetMonotonicNs() - s_prefetchBeginNs) / 1000000);
+            }
+        }
+        else if (s_prefetchDirectoryCount > 0)
+        {
+            directory = s_prefetchDirectories[--s_prefetchDirectoryCount];
+            s_prefetchListing++;
+            gfnMutexUnlock(&s_prefetchLock);
+            warmed = gfnWalkPrefetchDirectory(directory, buffer);
+            free(directory);
+            gfnMutexLock(&s_prefetchLock);
+            s_prefetchListing--;
+            s_prefetchStatus.directoriesWalked += warmed ? 1 : 0;
+            s_prefetchStatus.filesFailed += warmed ? 0 : 1;
+            gfnCondVarBroadcast(&s_prefetchWake);
+        }
+        else if (s_prefetchListing > 0)
+        {
+            // A directory being listed may still push subdirectories
+            gfnCondVarWait(&s_prefetchWake, &s_prefetchLock, 100);
+        }
+        else
+        {
+            break;
+        }
+    }
+#ifdef _WIN32
+finished:
+#endif
+    if (--s_prefetchActive == 0)
+    {
+        s_prefetchStatus.running = false;
+        s_prefetchStatus.completed = !gfnAtomicLoadAcquire32(&s_prefetchCancelled);
+        s_prefetchStatus.elapsedMs = (unsigned int)((gfnGetMonotonicNs() - s_prefetchBeginNs) / 1000000);
+        GFN_SDK_LOG("Prefetch requested %llu bytes in %llu files in %u ms, manifest in %u ms%s",
+            (unsigned long long)s_prefetchStatus.bytesRequested, (unsigned long long)s_prefetchStatus.filesWarmed,
+            s_prefetchStatus.elapsedMs, s_prefetchStatus.manifestMs, s_prefetchStatus.budgetExhausted ? ", budget used up" : "");
+    }
+    // Wakes the other threads as well, which stop once the budget is used up
+    gfnCondVarBroadcast(&s_prefetchWake);
+    gfnMutexUnlock(&s_prefetchLock);
+    free(buffer);
+    return GFN_THREAD_RETURN;
+}
+
+// Stops the prefetch in progress and frees its state. Must be called with s_prefetchLifecycleLock held.
+static void gfnStopPrefetch(void)
+{
+    unsigned int i;
+
+    gfnAtomicExchange32(&s_prefetchCancelled, 1);
+    gfnMutexLock(&s_prefetchLock);
+    gfnCondVarBroadcast(&s_prefetchWake);
+    gfnMutexUnlock(&s_prefetchLock);
+    for (i = 0; i < s_prefetchThreadCount; i++)
+    {
+        gfnThreadJoin(s_prefetchThreads[i]);
+    }
+    s_prefetchThreadCount = 0;
+
+    gfnMutexLock(&s_prefetchLock);
+    for (i = 0; s_prefetchManifest != NULL && i < s_prefetchStatus.manifestEntries; i++)
+    {
+        free(s_prefetchManifest[i].path);
+    }
+    for (i = 0; i < s_prefetchDirectoryCount; i++)
+    {
+        free(s_prefetchDirectories[i]);
+    }
+    free(s_prefetchManifest);
+    free(s_prefetchManifestHashes);
+    free(s_prefetchDirectories);
+    s_prefetchManifest = NULL;
+    s_prefetchManifestHashes = NULL;
+    s_prefetchDirectories = NULL;
+    s_prefetchDirectoryCount = 0;
+    s_prefetchDirectoryCapacity = 0;
+    gfnMutexUnlock(&s_prefetchLock);
+}
+
+// Parses the manifest into entries relative to the build path. Must be called with
+// s_prefetchLifecycleLock held, and before the threads start.
+static GfnRuntimeError gfnLoadPrefetchManifest(CHAR_TYPE const* buildPath)
+{
+    CHAR_TYPE relative[PLATFORM_MAX_PATH];
+    CHAR_TYPE path[PLATFORM_MAX_PATH];
+    CHAR_TYPE* resolved;
+    gfnPrefetchEntry* entries;
+    uint8_t* file = NULL;
+    size_t fileSize = 0;
+    char* line;
+    char* end;
+    char* field;
+    unsigned int capacity = 0;
+    unsigned int count = 0;
+    unsigned int hashCapacity;
+    unsigned int slot;
+    size_t i;
+    GfnRuntimeError status;
+
+    status = gfnReadSnapshotFile(s_prefetchManifestPath, &file, &fileSize);
+    if (GFNSDK_FAILED(status))
+    {
+        free(file);
+        GFN_SDK_LOG_WARNING("Could not read the prefetch manifest, walking the build tree only: %d", (int)status);
+        return (status == gfnUnableToAllocateMemory) ? status : gfnSuccess;
+    }
+    file[fileSize] = 0;
+    for (i = 0; i < fileSize; i++)
+    {
+        capacity += (file[i] == '\n') ? 1 : 0;
+    }
+    entries = (gfnPrefetchEntry*)malloc(sizeof(gfnPrefetchEntry) * (capacity + 1));
+    if (entries == NULL)
+    {
+        free(file);
+        return gfnUnableToAllocateMemory;
+    }
+
+    for (line = (char*)file; line < (char*)file + fileSize; line = end + 1)
+    {
+        end = strchr(line, '\n');
+        end = (end != NULL) ? end : (char*)file + fileSize;
+        *end = 0;
+        if (end > line && end[-1] == '\r')
+        {
+            end[-1] = 0;
+        }
+        if (line[0] == 0 || line[0] == '#')
+        {
+            continue;
+        }
+        field = strchr(line, '\t');
+        if (field != NULL)
+        {
+            *field++ = 0;
+        }
+        entries[count].offset = (field != NULL) ? strtoull(field, &field, 10) : 0;
+        entries[count].length = (field != NULL && *field == '\t') ? strtoull(field + 1, NULL, 10) : 0;
+        if (!gfnUtf8ToPath(line, relative))
+        {
+            continue;
+        }
+#ifdef _WIN32
+        resolved = (relative[0] == L'\\' || relative[0] == L'/' || (relative[0] != 0 && relative[1] == L':')) ? relative : path;
+#elif __linux__
+        resolved = (relative[0] == '/') ? relative : path;
+#endif
+        if (resolved == path && !gfnJoinPrefetchPath(buildPath, relative, path))
+        {
+            continue;
+        }
+        entries[count].path = gfnCopyPrefetchPath(resolved);
+        count += (entries[count].path != NULL) ? 1 : 0;
+    }
+    free(file);
+
+    // Sized to stay at most half full
+    for (hashCapacity = 16; hashCapacity < count * 2; hashCapacity *= 2)
+    {
+    }
+    s_prefetchManifestHashes = (uint64_t*)calloc(hashCapacity, sizeof(uint64_t));
+    if (s_prefetchManifestHashes == NULL)
+    {
+        for (i = 0; i < count; i++)
+        {
+            free(entries[i].path);
+        }
+        free(entries);
+        return gfnUnableToAllocateMemory;
+    }
+    s_prefetchManifestHashMask = hashCapacity - 1;
+    for (i = 0; i < count; i++)
+    {
+        uint64_t hash = gfnHashPrefetchPath(entries[i].path);
+        for (slot = (unsigned int)hash & s_prefetchManifestHashMask; s_prefetchManifestHashes[slot] != 0 && s_prefetchManifestHashes[slot] != hash;
+            slot = (slot + 1) & s_prefetchManifestHashMask)
+        {
+        }
+        s_prefetchManifestHashes[slot] = hash;
+    }
+    s_prefetchManifest = entries;
+    s_prefetchStatus.manifestEntries = count;
+    return gfnSuccess;
+}
+
+// Must be called with s_prefetchLifecycleLock held
+static GfnRuntimeError gfnStartPrefetch(const char* buildPath, const char* metadataPath)
+{
+    CHAR_TYPE root[PLATFORM_MAX_PATH];
+    CHAR_TYPE metadataRoot[PLATFORM_MAX_PATH];
+    GfnRuntimeError status = gfnSuccess;
+    unsigned int count;
+
+    if (!gfnUtf8ToPath(buildPath, root) || (metadataPath != NULL && !gfnUtf8ToPath(metadataPath, metadataRoot)))
+    {
+        return gfnInvalidParameter;
+    }
+    gfnStopPrefetch();
+
+    gfnMutexLock(&s_prefetchLock);
+    memset(&s_prefetchStatus, 0, sizeof(s_prefetchStatus));
+    s_prefetchManifestNext = 0;
+    s_prefetchManifestIssued = 0;
+    s_prefetchManifestHashMask = 0;
+    s_prefetchListing = 0;
+    gfnMutexUnlock(&s_prefetchLock);
+    if (s_prefetchManifestPath[0] != 0)
+    {
+        status = gfnLoadPrefetchManifest(root);
+        if (GFNSDK_FAILED(status))
+        {
+            return status;
+        }
+    }
+    gfnPushPrefetchDirectory(root);
+    if (metadataPath != NULL && metadataPath[0] != 0)
+    {
+        gfnPushPrefetchDirectory(metadataRoot);
+    }
+
+    gfnMutexLock(&s_prefetchLock);
+    s_prefetchBeginNs = gfnGetMonotonicNs();
+    s_prefetchDeadlineNs = (s_prefetchConfig.budgetMs != 0) ? s_prefetchBeginNs + (uint64_t)s_prefetchConfig.budgetMs * 1000000 : 0;
+    s_prefetchStatus.running = true;
+    s_prefetchActive = s_prefetchConfig.threads;
+    gfnMutexUnlock(&s_prefetchLock);
+    gfnAtomicExchange32(&s_prefetchCancelled, 0);
+    GFN_SDK_LOG("Prefetching %s with %u manifest entries", buildPath, s_prefetchStatus.manifestEntries);
+
+    for (count = 0; count < s_prefetchConfig.threads; count++)
+    {
+        if (!gfnThreadCreate(&s_prefetchThreads[count], gfnPrefetchThread, NULL))
+        {
+            break;
+        }
+    }
+    s_prefetchThreadCount = count;
+    if (count < s_prefetchConfig.threads)
+    {
+        // The threads that started finish the prefetch
+        gfnMutexLock(&s_prefetchLock);
+        s_prefetchActive -= s_prefetchConfig.threads - count;
+        if (s_prefetchActive == 0)
+        {
+            s_prefetchStatus.running = false;
+        }
+        gfnMutexUnlock(&s_prefetchLock);
+        if (count == 0)
+        {
+            return gfnInternalError;
+        }
+    }
+    return gfnSuccess;
+}
+
+static char* gfnCopyPrefetchRequestPath(const char* path)
+{
+    size_t size = strlen(path) + 1;
+    char* copy = (char*)malloc(size);
+
+    if (copy != NULL)
+    {
+        memcpy(copy, path, size);
+    }
+    return copy;
+}
+
+// Replaces the pending request. Must be called with s_prefetchLock held.
+static void gfnSetPrefetchRequest(char* buildPath, char* metadataPath)
+{
+    free(s_prefetchRequestBuildPath);
+    free(s_prefetchRequestMetadataPath);
+    s_prefetchRequestBuildPath = buildPath;
+    s_prefetchRequestMetadataPath = metadataPath;
+    s_prefetchRequestBusy = (buildPath != NULL);
+    if (!s_prefetchRequestBusy)
+    {
+        gfnCondVarBroadcast(&s_prefetchWake);
+    }
+}
+
+static GFN_THREAD_PROC gfnPrefetchCoordinatorThread(void* arg)
+{
+    GfnRuntimeError status;
+    char* buildPath;
+    char* metadataPath;
+
+    (void)arg;
+    gfnMutexLock(&s_prefetchLock);
+    for (;;)
+    {
+        while (s_prefetchRequestBuildPath == NULL && !s_prefetchCoordinatorStop)
+        {
+            gfnCondVarWaitForever(&s_prefetchRequestWake, &s_prefetchLock);
+        }
+        if (s_prefetchCoordinatorStop)
+        {
+            break;
+        }
+        buildPath = s_prefetchRequestBuildPath;
+        metadataPath = s_prefetchRequestMetadataPath;
+        s_prefetchRequestBuildPath = NULL;
+        s_prefetchRequestMetadataPath = NULL;
+        gfnMutexUnlock(&s_prefetchLock);
+
+        status = gfnSuccess;
+        gfnMutexLock(&s_prefetchLifecycleLock);
+        if (gfnAtomicLoadAcquire32(&s_prefetcherStarted))
+        {
+            status = gfnStartPrefetch(buildPath, metadataPath);
+        }
+        gfnMutexUnlock(&s_prefetchLifecycleLock);
+        if (GFNSDK_FAILED(status))
+        {
+            GFN_SDK_LOG_WARNING("Could not start the prefetch for the InstallCallback: %d", (int)status);
+        }
+        free(buildPath);
+        free(metadataPath);
+        gfnMutexLock(&s_prefetchLock);
+        if (s_prefetchRequestBuildPath == NULL)
+        {
+            s_prefetchRequestBusy = false;
+            gfnCondVarBroadcast(&s_prefetchWake);
+        }
+    }
+    gfnMutexUnlock(&s_prefetchLock);
+    return GFN_THREAD_RETURN;
+}
+
+// Must be called with s_prefetchCoordinatorLock held
+static bool gfnStartPrefetchCoordinator(void)
+{
+    if (s_prefetchCoordinatorRunning)
+    {
+        return true;
+    }
+    gfnMutexLock(&s_prefetchLock);
+    s_prefetchCoordinatorStop = false;
+    gfnMutexUnlock(&s_prefetchLock);
+    if (!gfnThreadCreate(&s_prefetchCoordinator, gfnPrefetchCoordinatorThread, NULL))
+    {
+        return false;
+    }
+    s_prefetchCoordinatorRunning = true;
+    return true;
+}
+
+// Drops a request the coordinator has not picked up. Must be called with s_prefetchCoordinatorLock held.
+static void gfnStopPrefetchCoordinator(void)
+{
+    if (!s_prefetchCoordinatorRunning)
+    {
+        return;
+    }
+    gfnMutexLock(&s_prefetchLock);
+    s_prefetchCoordinatorStop = true;
+    gfnCondVarSignal(&s_prefetchRequestWake);
+    gfnMutexUnlock(&s_prefetchLock);
+    gfnThreadJoin(s_prefetchCoordinator);
+    s_prefetchCoordinatorRunning = false;
+    gfnMutexLock(&s_prefetchLock);
+    gfnSetPrefetchRequest(NULL, NULL);
+    gfnMutexUnlock(&s_prefetchLock);
+}
+
+// Called from the Install trampoline on the GeForce NOW callback thread
+static void gfnPrefetchOnInstall(TitleInstallationInformation const* installation)
+{
+    char* buildPath;
+    char* metadataPath = NULL;
+
+    if (!gfnAtomicLoadAcquire32(&s_prefetcherStarted) || installation == NULL || installation->pchBuildPath == NULL)
+    {
+        return;
+    }
+    buildPath = gfnCopyPrefetchRequestPath(installation->pchBuildPath);
+    if (installation->pchMetadataPath != NULL)
+    {
+        metadataPath = gfnCopyPrefetchRequestPath(installation->pchMetadataPath);
+    }
+    if (buildPath == NULL || (installation->pchMetadataPath != NULL && metadataPath == NULL))
+    {
+        free(buildPath);
+        free(metadataPath);
+        GFN_SDK_LOG_WARNING("Could not start the prefetch for the InstallCallback: %d", (int)gfnUnableToAllocateMemory);
+        return;
+    }
+    gfnMutexLock(&s_prefetchLock);
+    gfnSetPrefetchRequest(buildPath, metadataPath);
+    gfnCondVarSignal(&s_prefetchRequestWake);
+    gfnMutexUnlock(&s_prefetchLock);
+}
+
+// Registers the Install trampoline with the cloud library unless a callback registration already did.
+// Like the NetworkStatus trampoline, the registration lasts until the SDK is shut down. Must be called
+// with g_callbackLock held.
+static GfnRuntimeError gfnRegisterInstallTrampoline(void)
+{
+    GfnRuntimeError status = gfnSuccess;
+    gfnCallbackSlot* registration = &g_callbackSlots[gfnCallbackInstall];
+
+    if (registration->registered)
+    {
+        return gfnSuccess;
+    }
+    GFN_SDK_LOG("Registering for Install Callback updates for the prefetcher");
+    CALL_CLOUD_LIBRARY(status, RegisterInstallCallback, &_gfnInstallCallbackWrapper, registration);
+    if (GFNSDK_SUCCEEDED(status))
+    {
+        registration->registered = true;
+        registration->param = 0;
+    }
+    return status;
+}
+
+GfnRuntimeError GfnStartPrefetcher(const CHAR_TYPE* manifestPath, const GfnPrefetchConfig* config)
+{
+    GfnPrefetchConfig next = { 0, 0, kGfnDefaultPrefetchThreads };
+    GfnRuntimeError status;
+    size_t pathLength = 0;
+
+    if (config != NULL)
+    {
+        next = *config;
+    }
+    if (manifestPath != NULL)
+    {
+#ifdef _WIN32
+        pathLength = wcslen(manifestPath);
+#elif __linux__
+        pathLength = strlen(manifestPath);
+#endif
+    }
+    if (pathLength >= PLATFORM_MAX_PATH || next.threads == 0 || next.threads > GFN_PREFETCH_THREAD_CAPACITY)
+    {
+        return gfnInvalidParameter;
+    }
+    CHECK_CLOUD_ENVIRONMENT();
+
+    gfnMutexLock(&g_callbackLock);
+    status = gfnRegisterInstallTrampoline();
+    gfnMutexUnlock(&g_callbackLock);
+    if (GFNSDK_FAILED(status))
+    {
+        return status;
+    }
+
+    gfnMutexLock(&s_prefetchCoordinatorLock);
+    if (!gfnStartPrefetchCoordinator())
+    {
+        gfnMutexUnlock(&s_prefetchCoordinatorLock);
+        return gfnInternalError;
+    }
+    gfnMutexLock(&s_prefetchLifecycleLock);
+    memset(s_prefetchManifestPath, 0, sizeof(s_prefetchManifestPath));
+    if (pathLength != 0)
+    {
+        memcpy(s_prefetchManifestPath, manifestPath, pathLength * sizeof(CHAR_TYPE));
+    }
+    // The running prefetch keeps the thread count it started with
+    gfnMutexLock(&s_prefetchLock);
+    s_prefetchConfig.budgetBytes = next.budgetBytes;
+    s_prefetchConfig.budgetMs = next.budgetMs;
+    gfnMutexUnlock(&s_prefetchLock);
+    if (s_prefetchThreadCount == 0)
+    {
+        s_prefetchConfig.threads = next.threads;
+    }
+    gfnAtomicExchange32(&s_prefetcherStarted, 1);
+    gfnMutexUnlock(&s_prefetchLifecycleLock);
+    gfnMutexUnlock(&s_prefetchCoordinatorLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnStopPrefetcher(void)
+{
+    gfnAtomicExchange32(&s_prefetcherStarted, 0);
+    gfnMutexLock(&s_prefetchCoordinatorLock);
+    gfnStopPrefetchCoordinator();
+    gfnMutexLock(&s_prefetchLifecycleLock);
+    gfnStopPrefetch();
+    gfnMutexUnlock(&s_prefetchLifecycleLock);
+    gfnMutexUnlock(&s_prefetchCoordinatorLock);
+    return gfnSuccess;
+}
+
+GfnRuntimeError GfnPrefetchTitle(const char* buildPath, const char* metadataPath)
+{
+    GfnRuntimeError status;
+
+    CHECK_NULL_PARAM(buildPath);
+    gfnMutexLock(&s_prefetchLifecycleLock);
+    status = gfnStartPrefetch(buildPath, metadataPath);
+    gfnMutexUnlock(&s_prefetchLifecycleLock);
+    return status;
+}
+
+GfnRuntimeError GfnWaitForPrefetch(unsigned int timeoutMs)
+{
+    uint64_t deadlineNs = gfnGetMonotonicNs() + (uint64_t)timeoutMs * 1000000;
+    uint64_t nowNs;
+    GfnRuntimeError status = gfnSuccess;
+
+    gfnMutexLock(&s_prefetchLock);
+    while (s_prefetchStatus.running || s_prefetchRequestBusy)
+    {
+        nowNs = gfnGetMonotonicNs();
+        if (nowNs >= deadlineNs)
+        {
+            status = gfnTimedOut;
+            break;
+        }
+        gfnCondVarWait(&s_prefetchWake, &s_prefetchLock, (unsigned int)((deadlineNs - nowNs + 999999) / 1000000));
+    }
+    gfnMutexUnlock(&s_prefetchLock);
+    return status;
+}
+
+GfnRuntimeError GfnGetPrefetchStatus(GfnPrefetchStatus* status)
+{
+    CHECK_NULL_PARAM(status);
+    gfnMutexLock(&s_prefetchLock);
+    *status = s_prefetchStatus;
+    if (status->running)
+    {
+        status->elapsedMs = (unsigned int)((gfnGetMonotonicNs() - s_prefetchBeginNs) / 1000000);
+    }
+    gfnMutexUnlock(&s_prefetchLock);
+    return gfnSuccess;
+}
+
+// Stops the prefetch in progress and drops the manifest and configuration
+static void gfnResetPrefetcher(void)
+{
+    GfnStopPrefetcher();
+    gfnMutexLock(&s_prefetchLifecycleLock);
+    memset(s_prefetchManifestPath, 0, sizeof(s_prefetchManifestPath));
+    gfnMutexLock(&s_prefetchLock);
+    s_prefetchConfig.budgetBytes = 0;
+    s_prefetchConfig.budgetMs = 0;
+    s_prefetchConfig.threads = kGfnDefaultPrefetchThreads;
+    memset(&s_prefetchStatus, 0, sizeof(s_prefetchStatus));
+    gfnMutexUnlock(&s_prefetchLock);
+    gfnMutexUnlock(&s_prefetchLifecycleLock);
+}
+
+static void GFN_CALLBACK _gfnSessionInitCallbackWrapper(int status, void* pCString, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pContext;
+    (void)status;
+    gfnInvalidateTitleIndex();
+    for (cursor = 0; gfnNextCallback(gfnCallbackSessionInit, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((SessionInitCallbackSig)invocation.fnCallback)((const char *)pCString, invocation.pUserContext);
+    }
+}
+
+GfnRuntimeError GfnRegisterSessionInitCallback(SessionInitCallbackSig sessionInitCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+
+    CHECK_NULL_PARAM(sessionInitCallback);
+    CHECK_CLOUD_ENVIRONMENT();
+
+    GFN_SDK_LOG("Registering for SessionInit Callback updates");
+
+    if (gfnBeginCallbackRegistration(gfnCallbackSessionInit, (void*)sessionInitCallback, pUserContext, 0))
+    {
+        CALL_CLOUD_LIBRARY(status, RegisterSessionInitCallback, &_gfnSessionInitCallbackWrapper, &g_callbackSlots[gfnCallbackSessionInit]);
+    }
+    return gfnEndCallbackRegistration(gfnCallbackSessionInit, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterSessionInitCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackSessionInit);
+}
+
+static void GFN_CALLBACK _gfnMessageCallbackWrapper(int status, void* pMessage, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+
+    (void)pContext;
+    (void)status;
+    if (gfnIsCallbackDeliveryQueued())
+    {
+        gfnQueueMessage((GfnString*)pMessage);
+        return;
+    }
+    for (cursor = 0; gfnNextCallback(gfnCallbackMessage, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        ((MessageCallbackSig)invocation.fnCallback)((GfnString*)pMessage, invocation.pUserContext);
+    }
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK _gfnClientMessageCallbackWrapper(const GfnString* pMessage, void* pContext)
+{
+    gfnCallbackInvocation invocation;
+    unsigned int cursor;
+    GfnApplicationCallbackResult result;
+
+    (void)pContext;
+    if (gfnIsCallbackDeliveryQueued())
+    {
+        gfnQueueMessage(pMessage);
+        return crCallbackSuccess;
+    }
+    // Each context answers; the event fails if any of them fails it
+    result = crCallbackSuccess;
+    for (cursor = 0; gfnNextCallback(gfnCallbackMessage, &cursor, &invocation); gfnLeaveCallbackSlot(&invocation))
+    {
+        if (((MessageCallbackSig)invocation.fnCallback)(pMessage, invocation.pUserContext) != crCallbackSuccess)
+        {
+            result = crCallbackFailure;
+        }
+    }
+    return result;
+}
+
+GfnRuntimeError GfnRegisterMessageCallback(MessageCallbackSig messageCallback, void* pUserContext)
+{
+    GfnRuntimeError status = gfnSuccess;
+    bool cloudHasApi = false;
+
+    CHECK_NULL_PARAM(messageCallback);
+
+    if (gfnEnterLibraryCall(GFN_STATE_CLOUD_LIVE))
+    {
+        cloudHasApi = (g_pCloudLibrary->RegisterMessageCallback != NULL);
+        gfnLeaveLibraryCall();
+    }
+
+    if (gfnBeginCallbackRegistration(gfnCallbackMessage, (void*)messageCallback, pUserContext, 0))
+    {
+        if (cloudHasApi)
+        {
+            CALL_CLOUD_LIBRARY(status, RegisterMessageCallback, &_gfnMessageCallbackWrapper, &g_callbackSlots[gfnCallbackMessage]);
+        }
+        else
+        {
+            CALL_CLIENT_LIBRARY(status, RegisterMessageCallback, &_gfnClientMessageCallbackWrapper, &g_callbackSlots[gfnCallbackMessage]);
+        }
+    }
+    return gfnEndCallbackRegistration(gfnCallbackMessage, 0, status);
+}
+
+GfnRuntimeError GfnUnregisterMessageCallback(void)
+{
+    return gfnUnregisterCallback(gfnCallbackMessage);
+}
+
+
+// Starts the background log writer. Must be called with s_logLifecycleLock held.
+static void gfnStartLogWriter(void)
+{
+    unsigned int i;
+
+    if (gfnAtomicLoadAcquire32(&s_logWriterRunning))
+    {
+        return;
+    }
+    if (!s_logRingInitialized)
+    {
+        for (i = 0; i < kGfnLogRingSize; i++)
+        {
+            gfnAtomicStoreRelease32(&s_logRing.records[i].sequence, (int32_t)i);
+        }
+        s_logRingInitialized = true;
+    }
+    gfnAtomicStoreRelease32(&s_logWriterStop, 0);
+    if (gfnThreadCreate(&s_logWriter, gfnLogWriterThread, NULL))
+    {
+        gfnAtomicExchange32(&s_logWriterRunning, 1);
+    }
+}
+
+// Stops the background log writer and writes out every queued record. Must be called with
+// s_logLifecycleLock held.
+static void gfnStopLogWriter(void)
+{
+    if (!gfnAtomicLoadAcquire32(&s_logWriterRunning))
+    {
+        return;
+    }
+    // New lines go to the synchronous path from here on; wait for producers already queueing
+    gfnAtomicExchange32(&s_logWriterRunning, 0);
+    while (gfnAtomicLoad32(&s_logProducers) != 0)
+    {
+        gfnThreadYield();
+    }
+
+    gfnAtomicExchange32(&s_logWriterStop, 1);
+    gfnWakeLogWriter();
+    gfnThreadJoin(s_logWriter);
+    gfnDrainLogRing();
+}
+
+// Reads a logging setting from the environment. Returns false if the variable is not set, or is too
+// long to be a valid setting.
+static bool gfnGetLogEnvironmentValue(char const* name, char* value, unsigned int size)
+{
+#ifdef _WIN32
+    DWORD length = GetEnvironmentVariableA(name, value, size);
+    return length != 0 && length < size;
+#elif __linux__
+    char const* env = getenv(name);
+    if (env == NULL || strlen(env) >= size)
+    {
+        return false;
+    }
+    strcpy(value, env);
+    return true;
+#endif
+}
+
+// Matches a logging setting against a list of names, or their indexes as numbers. Returns the index,
+// or -1 if nothing matched.
+static int gfnMatchLogEnvironmentValue(char const* value, char const* const* names, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if ((value[0] == (char)('0' + i) && value[1] == '\0') ||
+#ifdef _WIN32
+            _stricmp(value, names[i]) == 0)
+#elif __linux__
+            strcasecmp(value, names[i]) == 0)
+#endif
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Applies GFN_SDK_LOG_LEVEL from the environment, unless the level was set through GfnSetLogLevel
+static void gfnReadLogLevelFromEnvironment(void)
+{
+    static char const* const levelNames[] = { "trace", "debug", "info", "warning", "error", "none" };
+    char value[16] = { 0 };
+    int level;
+
+    if (s_logLevelSetByApi || !gfnGetLogEnvironmentValue("GFN_SDK_LOG_LEVEL", value, sizeof(value)))
+    {
+        return;
+    }
+    level = gfnMatchLogEnvironmentValue(value, levelNames, gfnLogLevelNone + 1);
+    if (level >= 0)
+    {
+        gfnAtomicExchange32(&s_logLevel, level);
+    }
+}
+
+// Applies GFN_SDK_LOG_MODE from the environment, unless the mode was set through GfnSetLogMode
+static void gfnReadLogModeFromEnvironment(void)
+{
+    static char const* const modeNames[] = { "synchronous", "asynchronous", "persistent" };
+    char value[16] = { 0 };
+    int mode;
+
+    if (s_logModeSetByApi || !gfnGetLogEnvironmentValue("GFN_SDK_LOG_MODE", value, sizeof(value)))
+    {
+        return;
+    }
+    mode = gfnMatchLogEnvironmentValue(value, modeNames, gfnLogModePersistent + 1);
+    if (mode >= 0)
+    {
+        gfnAtomicExchange32(&s_logMode, mode);
+    }
+}
+
+void gfnInitLogging(void)
+{
+    gfnMutexLock(&s_logLifecycleLock);
+    gfnReadLogLevelFromEnvironment();
+    gfnReadLogModeFromEnvironment();
+    gfnOpenLogFile();
+    if (gfnAtomicLoadAcquire32(&s_logMode) == gfnLogModeAsynchronous)
+    {
+        gfnStartLogWriter();
+    }
+    else if (gfnAtomicLoadAcquire32(&s_logMode) == gfnLogModePersistent)
+    {
+        gfnOpenPersistentLog();
+    }
+    gfnMutexUnlock(&s_logLifecycleLock);
+}
+
+// Gets the directory the wrapper writes its logs to, creating it if needed
+static bool gfnGetLogDirectory(CHAR_TYPE* path, size_t size)
+{
+#ifdef _WIN32
+    int createDirResult = ERROR_SUCCESS;
+
+    if (SHGetSpecialFolderPathW(NULL, path, CSIDL_COMMON_APPDATA, false) == FALSE)
+    {
+        GFN_SDK_LOG_ERROR("Could not get path to LOCALAPPDATA: %d", GetLastError());
+        return false;
+    }
+    wcscat_s(path, size, L"\\NVIDIA Corporation\\GfnRuntimeSdk");
+    createDirResult = SHCreateDirectoryExW(NULL, path, NULL);
+    return createDirResult == ERROR_SUCCESS || createDirResult == ERROR_FILE_EXISTS || createDirResult == ERROR_ALREADY_EXISTS;
+#elif __linux__
+    // ~/.nvidia/GfnRuntimeSdk, expanded here since fopen does not expand the tilde
+    char const* home = getenv("HOME");
+    int written;
+
+    if (home == NULL || home[0] == '\0')
+    {
+        return false;
+    }
+    written = snprintf(path, size, "%s/.nvidia", home);
+    if (written <= 0 || (size_t)written >= size || (mkdir(path, 0755) != 0 && errno != EEXIST))
+    {
+        return false;
+    }
+    written = snprintf(path, size, "%s/.nvidia/GfnRuntimeSdk", home);
+    return written > 0 && (size_t)written < size && (mkdir(path, 0755) == 0 || errno == EEXIST);
+#endif
+}
+
+// Appends a file name to a path from gfnGetLogDirectory. Returns false if the result does not fit.
+static bool gfnAppendLogFileName(CHAR_TYPE* path, size_t size, CHAR_TYPE const* fileName)
+{
+#ifdef _WIN32
+    return wcslen(path) + 1 + wcslen(fileName) < size &&
+        wcscat_s(path, size, L"\\") == 0 && wcscat_s(path, size, fileName) == 0;
+#elif __linux__
+    if (strlen(path) + 1 + strlen(fileName) >= size)
+    {
+        return false;
+    }
+    strcat(path, "/");
+    strcat(path, fileName);
+    return true;
+#endif
+}
+
+void gfnOpenLogFile(void)
+{
+    CHAR_TYPE logPath[PLATFORM_MAX_PATH] = { 0 };
+    FILE* logfile = NULL;
+
+    if (gfnGetLogDirectory(logPath, PLATFORM_MAX_PATH))
+    {
+#ifdef _WIN32
+        if (gfnAppendLogFileName(logPath, PLATFORM_MAX_PATH, L"GfnRuntimeSdkWrapper.log"))
+        {
+            _wfopen_s(&logfile, logPath, L"w+");
+        }
+#elif __linux__
+        if (gfnAppendLogFileName(logPath, PLATFORM_MAX_PATH, "GfnRuntimeSdkWrapper.log"))
+        {
+            logfile = fopen(logPath, "w");
+        }
+#endif
+    }
+
+    gfnMutexLock(&s_logLock);
+    s_logfile = logfile;
+    gfnMutexUnlock(&s_logLock);
+}
+
+// Maps a new persistent log file and starts writing log lines to it. The file of the previous run,
+// which holds the end of its log if it crashed, is kept with a .prev suffix. Must be called with
+// s_logLifecycleLock held.
+void gfnOpenPersistentLog(void)
+{
+    CHAR_TYPE path[PLATFORM_MAX_PATH] = { 0 };
+    CHAR_TYPE previousPath[PLATFORM_MAX_PATH] = { 0 };
+    gfnPersistentLogHeader* header = NULL;
+    uint32_t recordCount;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping = NULL;
+#elif __linux__
+    int fd;
+#endif
+
+    if (gfnAtomicLoadAcquirePtr(&s_persistentLog) != NULL)
+    {
+        return;
+    }
+    if (s_persistentLogPath[0] != 0)
+    {
+        memcpy(path, s_persistentLogPath, sizeof(path));
+    }
+#ifdef _WIN32
+    else if (!gfnGetLogDirectory(path, PLATFORM_MAX_PATH) || !gfnAppendLogFileName(path, PLATFORM_MAX_PATH, L"GfnRuntimeSdkWrapper.logring"))
+#elif __linux__
+    else if (!gfnGetLogDirectory(path, PLATFORM_MAX_PATH) || !gfnAppendLogFileName(path, PLATFORM_MAX_PATH, "GfnRuntimeSdkWrapper.logring"))
+#endif
+    {
+        GFN_SDK_LOG_WARNING("Could not get the persistent log path, writing the text log instead");
+        return;
+    }
+
+    recordCount = (uint32_t)1 << gfnHighestBit64((uint64_t)s_persistentLogSizeKb * 1024 / kGfnPersistentLogRecordSize);
+    size = kGfnPersistentLogHeaderSize + (size_t)kGfnPersistentLogSiteCapacity * kGfnPersistentLogSiteSize +
+        (size_t)recordCount * kGfnPersistentLogRecordSize;
+
+#ifdef _WIN32
+    if (wcslen(path) + sizeof(".prev") <= PLATFORM_MAX_PATH)
+    {
+        wcscpy_s(previousPath, PLATFORM_MAX_PATH, path);
+        wcscat_s(previousPath, PLATFORM_MAX_PATH, L".prev");
+        MoveFileExW(path, previousPath, MOVEFILE_REPLACE_EXISTING);
+    }
+    file = CreateFileW(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        mapping = CreateFileMappingW(file, NULL, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32), (DWORD)size, NULL);
+        if (mapping != NULL)
+        {
+            header = (gfnPersistentLogHeader*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+        }
+        if (header == NULL)
+        {
+            if (mapping != NULL)
+            {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+        }
+        else
+        {
+            s_persistentLogFile = file;
+            s_persistentLogMapping = mapping;
+        }
+    }
+#elif __linux__
+    if (strlen(path) + sizeof(".prev") <= PLATFORM_MAX_PATH)
+    {
+        strcpy(previousPath, path);
+        strcat(previousPath, ".prev");
+        rename(path, previousPath);
+    }
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd >= 0)
+    {
+        // Allocate the blocks up front: a store to a mapped page the file system cannot back raises SIGBUS
+        if (posix_fallocate(fd, 0, (off_t)size) == 0)
+        {
+            header = (gfnPersistentLogHeader*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (header == (gfnPersistentLogHeader*)MAP_FAILED)
+            {
+                header = NULL;
+            }
+        }
+        close(fd);
+    }
+#endif
+    if (header == NULL)
+    {
+        GFN_SDK_LOG_WARNING("Could not map the persistent log, writing the text log instead");
+        return;
+    }
+
+    // The new file reads as zeros, so only the fields with other values need to be set
+    header->version = kGfnPersistentLogVersion;
+    header->headerSize = kGfnPersistentLogHeaderSize;
+    header->siteSize = kGfnPersistentLogSiteSize;
+    header->siteCapacity = kGfnPersistentLogSiteCapacity;
+    header->recordSize = kGfnPersistentLogRecordSize;
+    header->recordCount = recordCount;
+    header->baseMonotonicNs = gfnGetMonotonicNs();
+    header->baseWallClockMs = gfnGetWallClockMs();
+    header->processId = gfnGetCurrentProcessId();
+    gfnAtomicFence();
+    memcpy(header->magic, GFN_PERSISTENT_LOG_MAGIC, sizeof(header->magic));
+
+    s_persistentLogMappedSize = size;
+    gfnAtomicAdd32(&s_persistentLogGeneration, 1);
+    gfnAtomicStoreReleasePtr(&s_persistentLog, header);
+    GFN_SDK_LOG("Persistent log started with %u records", recordCount);
+}
+
+// Stops persistent logging and unmaps the log once threads writing a record are done with it. Must be
+// called with s_logLifecycleLock held.
+void gfnClosePersistentLog(void)
+{
+    void* header = gfnAtomicLoadAcquirePtr(&s_persistentLog);
+
+    if (header == NULL)
+    {
+        return;
+    }
+    // New lines go to the text log from here on; wait for writers already holding the mapping
+    gfnAtomicCompareExchangePtr(&s_persistentLog, header, NULL);
+    while (gfnAtomicLoad32(&s_persistentLogWriters) != 0)
+    {
+        gfnThreadYield();
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(header);
+    CloseHandle(s_persistentLogMapping);
+    CloseHandle(s_persistentLogFile);
+    s_persistentLogMapping = NULL;
+    s_persistentLogFile = INVALID_HANDLE_VALUE;
+#elif __linux__
+    munmap(header, s_persistentLogMappedSize);
+#endif
+    s_persistentLogMappedSize = 0;
+}
+
+void gfnDeinitLogging(void)
+{
+    gfnMutexLock(&s_logLifecycleLock);
+    gfnStopLogWriter();
+    gfnClosePersistentLog();
+
+    gfnMutexLock(&s_logLock);
+    if (s_logfile)
+    {
+        fclose(s_logfile);
+        s_logfile = NULL;
+    }
+    gfnMutexUnlock(&s_logLock);
+    g_LoggingInitialized = false;
+    gfnMutexUnlock(&s_logLifecycleLock);
+}
+
+// Formats the local time of a timestamp as yyyy-mm-ddThh:mm:ss.mmm
+static void gfnFormatLogTimestamp(uint64_t timestampMs, char* buffer)
+{
+#ifdef _WIN32
+    ULARGE_INTEGER ticks;
+    FILETIME fileTime;
+    FILETIME localFileTime;
+    SYSTEMTIME timeBuffer;
+
+    ticks.QuadPart = timestampMs * 10000ULL + 116444736000000000ULL;
+    fileTime.dwLowDateTime = ticks.LowPart;
+    fileTime.dwHighDateTime = ticks.HighPart;
+    FileTimeToLocalFileTime(&fileTime, &localFileTime);
+    FileTimeToSystemTime(&localFileTime, &timeBuffer);
+    sprintf_s(buffer, kGfnLogTimestampLen, "%04d-%02d-%02dT%02d:%02d:%02d.%03d", timeBuffer.wYear, timeBuffer.wMonth, timeBuffer.wDay,
+        timeBuffer.wHour, timeBuffer.wMinute, timeBuffer.wSecond, (int)(timestampMs % 1000));
+#elif __linux__
+    time_t t = (time_t)(timestampMs / 1000);
+    struct tm timeBuffer;
+    char formatted[64];
+
+    localtime_r(&t, &timeBuffer);
+    snprintf(formatted, sizeof(formatted), "%04d-%02d-%02dT%02d:%02d:%02d.%03d",
+                    timeBuffer.tm_year + 1900,
+                    timeBuffer.tm_mon + 1,
+                    timeBuffer.tm_mday,
+                    timeBuffer.tm_hour,
+                    timeBuffer.tm_min,
+                    timeBuffer.tm_sec,
+                    (int)(timestampMs % 1000));
+    memcpy(buffer, formatted, kGfnLogTimestampLen - 1);
+    buffer[kGfnLogTimestampLen - 1] = '\0';
+#endif
+}
+
+// Writes one formatted line without flushing. Must be called with s_logLock held.
+static void gfnWriteLogLineLocked(uint64_t timestampMs, char const* text, unsigned int length)
+{
+    FILE* out = s_logfile ? s_logfile : stderr;
+
+    // Converting to local time is comparatively expensive, so only do it once per second
+    if (timestampMs / 1000 != s_logTimestampSecond)
+    {
+        s_logTimestampSecond = timestampMs / 1000;
+        gfnFormatLogTimestamp(timestampMs, s_logTimestamp);
+    }
+    s_logTimestamp[20] = (char)('0' + (timestampMs / 100) % 10);
+    s_logTimestamp[21] = (char)('0' + (timestampMs / 10) % 10);
+    s_logTimestamp[22] = (char)('0' + timestampMs % 10);
+
+    fwrite(s_logTimestamp, 1, kGfnLogTimestampLen - 1, out);
+    fwrite(text, 1, length, out);
+}
+
+// Writes every record currently in the ring, returning the number written. Only called by the log
+// writer thread, or after it has been joined.
+static unsigned int gfnDrainLogRing(void)
+{
+    unsigned int count = 0;
+    int32_t position;
+    gfnLogRecord* record;
+
+    gfnMutexLock(&s_logLock);
+    for (;;)
+    {
+        position = gfnAtomicLoadRelaxed32(&s_logRing.dequeuePos);
+        record = &s_logRing.records[position & (kGfnLogRingSize - 1)];
+        if (gfnAtomicLoadAcquire32(&record->sequence) != position + 1)
+        {
+            break;
+        }
+        gfnWriteLogLineLocked(record->timestampMs, record->text, record->length);
+        gfnAtomicStoreRelease32(&record->sequence, position + kGfnLogRingSize);
+        gfnAtomicStoreRelease32(&s_logRing.dequeuePos, position + 1);
+        count++;
+    }
+    if (count > 0)
+    {
+        fflush(s_logfile ? s_logfile : stderr);
+    }
+    gfnMutexUnlock(&s_logLock);
+
+    if (count > 0)
+    {
+        gfnAtomicAdd64(&s_logLinesWritten, count);
+    }
+    return count;
+}
+
+static void gfnWakeLogWriter(void)
+{
+    gfnMutexLock(&s_logWakeLock);
+    gfnCondVarSignal(&s_logWake);
+    gfnMutexUnlock(&s_logWakeLock);
+}
+
+static GFN_THREAD_PROC gfnLogWriterThread(void* arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        if (gfnDrainLogRing() > 0)
+        {
+            continue;
+        }
+        if (gfnAtomicLoadAcquire32(&s_logWriterStop))
+        {
+            break;
+        }
+        // Producers only wake the writer once the ring starts filling up, so lines are normally
+        // written in batches on a short timer
+        gfnMutexLock(&s_logWakeLock);
+        gfnAtomicExchange32(&s_logWriterSleeping, 1);
+        if (!gfnAtomicLoadAcquire32(&s_logWriterStop))
+        {
+            gfnCondVarWait(&s_logWake, &s_logWakeLock, kGfnLogWriterIntervalMs);
+        }
+        gfnAtomicExchange32(&s_logWriterSleeping, 0);
+        gfnMutexUnlock(&s_logWakeLock);
+    }
+    return GFN_THREAD_RETURN;
+}
+
+// Attempts to queue a formatted line for the log writer. Returns false if the ring is full.
+static bool gfnTryEnqueueLogLine(uint64_t timestampMs, char const* text, unsigned int length)
+{
+    int32_t position = gfnAtomicLoadRelaxed32(&s_logRing.enqueuePos);
+    int32_t sequence;
+    int32_t observed;
+    gfnLogRecord* record;
+
+    for (;;)
+    {
+        record = &s_logRing.records[position & (kGfnLogRingSize - 1)];
+        sequence = gfnAtomicLoadAcquire32(&record->sequence);
+        if (sequence == position)
+        {
+            observed = gfnAtomicCompareExchange32(&s_logRing.enqueuePos, position, position + 1);
+            if (observed == position)
+            {
+                break;
+            }
+            position = observed;
+        }
+        else if (sequence - position < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = gfnAtomicLoadRelaxed32(&s_logRing.enqueuePos);
+        }
+    }
+
+    if (length > kGfnLogRecordLen)
+    {
+        // Keep the line break of truncated lines
+        memcpy(record->text, text, kGfnLogRecordLen - 1);
+        record->text[kGfnLogRecordLen - 1] = '\n';
+        length = kGfnLogRecordLen;
+    }
+    else
+    {
+        memcpy(record->text, text, length);
+    }
+    record->length = length;
+    record->timestampMs = timestampMs;
+    gfnAtomicStoreRelease32(&record->sequence, position + 1);
+
+    if ((position + 1 - gfnAtomicLoadRelaxed32(&s_logRing.dequeuePos)) >= kGfnLogWakeThreshold &&
+        gfnAtomicLoadRelaxed32(&s_logWriterSleeping))
+    {
+        gfnWakeLogWriter();
+    }
+    return true;
+}
+
+// Hands a formatted line to the log writer thread. Returns false if async logging is not running,
+// in which case the caller writes the line itself.
+static bool gfnEnqueueLogLine(uint64_t timestampMs, char const* text, unsigned int length)
+{
+    bool handled = false;
+
+    gfnAtomicAdd32(&s_logProducers, 1);
+    while (gfnAtomicLoad32(&s_logWriterRunning))
+    {
+        if (gfnTryEnqueueLogLine(timestampMs, text, length))
+        {
+            handled = true;
+            break;
+        }
+        if (gfnAtomicLoadRelaxed32(&s_logOverflowPolicy) == gfnLogOverflowDrop)
+        {
+            gfnAtomicAdd64(&s_logLinesDropped, 1);
+            handled = true;
+            break;
+        }
+        gfnWakeLogWriter();
+        gfnThreadYield();
+    }
+    gfnAtomicAdd32(&s_logProducers, -1);
+    return handled;
+}
+
+// Equivalent to snprintf(buffer, size, " %24.24s:%-5d", func, line) without the cost of parsing the format
+static unsigned int gfnFormatLogLocation(char* buffer, char const* func, int line)
+{
+    char digits[12];
+    size_t funcLen = strlen(func);
+    unsigned int n = 0;
+    unsigned int digitCount = 0;
+    unsigned int value = (line < 0) ? 0 : (unsigned int)line;
+
+    buffer[n++] = ' ';
+    if (funcLen > 24)
+    {
+        funcLen = 24;
+    }
+    memset(buffer + n, ' ', 24 - funcLen);
+    n += (unsigned int)(24 - funcLen);
+    memcpy(buffer + n, func, funcLen);
+    n += (unsigned int)funcLen;
+    buffer[n++] = ':';
+
+    do
+    {
+        digits[digitCount++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (digitCount > 0)
+    {
+        buffer[n++] = digits[--digitCount];
+    }
+    while (n < 1 + 24 + 1 + 5)
+    {
+        buffer[n++] = ' ';
+    }
+    return n;
+}
+
+bool gfnLogRateLimitAcquire(gfnLogRateLimit* limit, unsigned int* suppressed)
+{
+    uint32_t now = (uint32_t)(gfnGetMonotonicNs() / 1000000ULL);
+    int32_t last = gfnAtomicLoadRelaxed32(&limit->refillMs);
+    uint32_t elapsed = now - (uint32_t)last;
+    int32_t refill;
+    int32_t tokens;
+    int32_t observed;
+
+    // One thread claims the refill for the elapsed intervals, carrying over any partial interval
+    if (elapsed >= kGfnLogRateRefillMs)
+    {
+        refill = (elapsed >= kGfnLogRateBurst * kGfnLogRateRefillMs) ? kGfnLogRateBurst : (int32_t)(elapsed / kGfnLogRateRefillMs);
+        observed = gfnAtomicCompareExchange32(&limit->refillMs, last,
+            (refill == kGfnLogRateBurst) ? (int32_t)now : last + refill * kGfnLogRateRefillMs);
+        if (observed == last)
+        {
+            tokens = gfnAtomicLoadRelaxed32(&limit->tokens);
+            for (;;)
+            {
+                observed = gfnAtomicCompareExchange32(&limit->tokens, tokens,
+                    (tokens + refill > kGfnLogRateBurst) ? kGfnLogRateBurst : tokens + refill);
+                if (observed == tokens)
+                {
+                    break;
+                }
+                tokens = observed;
+            }
+        }
+    }
+
+    if (gfnAtomicAdd32(&limit->tokens, -1) < 0)
+    {
+        gfnAtomicAdd32(&limit->tokens, 1);
+        gfnAtomicAdd32(&limit->suppressed, 1);
+        return false;
+    }
+    *suppressed = (gfnAtomicLoadRelaxed32(&limit->suppressed) != 0) ? (unsigned int)gfnAtomicExchange32(&limit->suppressed, 0) : 0;
+    return true;
+}
+
+// Copies at most size - 1 characters of a string and terminates the copy
+static void gfnCopyPersistentLogString(char* destination, size_t size, char const* source)
+{
+    size_t length = strlen(source);
+
+    if (length >= size)
+    {
+        length = size - 1;
+    }
+    memcpy(destination, source, length);
+    destination[length] = '\0';
+}
+
+// Returns the index of a call site in the persistent log's site table, adding the call site the first
+// time it logs to this log
+static uint16_t gfnGetPersistentLogSite(gfnPersistentLogHeader* header, gfnLogSite* site, char const* func, int line, char const* format)
+{
+    int32_t generation = gfnAtomicLoadRelaxed32(&s_persistentLogGeneration);
+    int32_t count;
+    gfnPersistentLogSite* entry;
+
+    if (gfnAtomicLoadAcquire32(&site->persistentGeneration) != generation)
+    {
+        gfnMutexLock(&s_persistentLogSiteLock);
+        if (gfnAtomicLoadRelaxed32(&site->persistentGeneration) != generation)
+        {
+            count = gfnAtomicLoadRelaxed32(&header->siteCount);
+            site->persistentSite = kGfnPersistentLogUnknownSite;
+            if ((uint32_t)count < header->siteCapacity)
+            {
+                entry = gfnPersistentLogSiteAt(header, (unsigned int)count);
+                entry->line = (line < 0) ? 0 : (uint32_t)line;
+                gfnCopyPersistentLogString(entry->function, sizeof(entry->function), func);
+                gfnCopyPersistentLogString(entry->format, sizeof(entry->format), format);
+                gfnAtomicStoreRelease32(&header->siteCount, count + 1);
+                site->persistentSite = count;
+            }
+            gfnAtomicStoreRelease32(&site->persistentGeneration, generation);
+        }
+        gfnMutexUnlock(&s_persistentLogSiteLock);
+    }
+    return (uint16_t)site->persistentSite;
+}
+
+// Character of a narrow or wide log argument, with wide characters outside ASCII replaced
+static uint8_t gfnPersistentLogChar(char const* text, wchar_t const* wideText, unsigned int index)
+{
+    if (text != NULL)
+    {
+        return (uint8_t)text[index];
+    }
+    return ((unsigned int)wideText[index] < 0x80) ? (uint8_t)wideText[index] : (uint8_t)'?';
+}
+
+// Copies the arguments of a log line into a record's payload, in the encoding described in
+// GfnSdk_PersistentLog.h
+static void gfnEncodePersistentLogArgs(gfnPersistentLogRecord* record, char const* format, va_list args)
+{
+    gfnPersistentLogConversion conversion;
+    unsigned int used = 0;
+    unsigned int count = 0;
+    unsigned int length;
+    uint64_t value;
+    double number;
+    char const* text;
+    wchar_t const* wideText;
+
+    record->flags = 0;
+    while (gfnPersistentLogNextConversion(format, &conversion))
+    {
+        format = conversion.end;
+        if (conversion.arg == gfnPersistentLogArgString || conversion.arg == gfnPersistentLogArgWideString)
+        {
+            if (used + 1 >= kGfnPersistentLogPayloadLen)
+            {
+                record->flags |= kGfnPersistentLogTruncated;
+                break;
+            }
+            text = NULL;
+            wideText = NULL;
+            if (conversion.arg == gfnPersistentLogArgString)
+            {
+                text = va_arg(args, char const*);
+                text = (text != NULL) ? text : "(null)";
+            }
+            else
+            {
+                wideText = va_arg(args, wchar_t const*);
+                wideText = (wideText != NULL) ? wideText : L"(null)";
+            }
+            for (length = 0; length < 255 && used + 1 + length < kGfnPersistentLogPayloadLen; length++)
+            {
+                record->payload[used + 1 + length] = gfnPersistentLogChar(text, wideText, length);
+                if (record->payload[used + 1 + length] == 0)
+                {
+                    break;
+                }
+            }
+            if (gfnPersistentLogChar(text, wideText, length) != 0)
+            {
+                record->flags |= kGfnPersistentLogTruncated;
+            }
+            record->payload[used] = (uint8_t)length;
+            used += 1 + length;
+            count++;
+            continue;
+        }
+
+        if (conversion.arg == gfnPersistentLogArgNone || used + sizeof(value) > kGfnPersistentLogPayloadLen)
+        {
+            record->flags |= kGfnPersistentLogTruncated;
+            break;
+        }
+        switch (conversion.arg)
+        {
+        case gfnPersistentLogArgInt:
+            value = (uint64_t)(int64_t)va_arg(args, int);
+            break;
+        case gfnPersistentLogArgUnsignedInt:
+            value = va_arg(args, unsigned int);
+            break;
+        case gfnPersistentLogArgLong:
+            value = (uint64_t)(int64_t)va_arg(args, long);
+            break;
+        case gfnPersistentLogArgUnsignedLong:
+            value = va_arg(args, unsigned long);
+            break;
+        case gfnPersistentLogArgLongLong:
+            value = (uint64_t)va_arg(args, long long);
+            break;
+        case gfnPersistentLogArgUnsignedLongLong:
+            value = va_arg(args, unsigned long long);
+            break;
+        case gfnPersistentLogArgSize:
+            value = va_arg(args, size_t);
+            break;
+        case gfnPersistentLogArgPtrDiff:
+            value = (uint64_t)(int64_t)va_arg(args, ptrdiff_t);
+            break;
+        case gfnPersistentLogArgDouble:
+            number = va_arg(args, double);
+            memcpy(&value, &number, sizeof(value));
+            break;
+        case gfnPersistentLogArgPointer:
+            value = (uint64_t)(uintptr_t)va_arg(args, void*);
+            break;
+        default:
+            value = 0;
+            break;
+        }
+        memcpy(record->payload + used, &value, sizeof(value));
+        used += sizeof(value);
+        count++;
+    }
+    record->argCount = (uint8_t)count;
 }
 
-GfnRuntimeError GfnInitializeSdkFromPathW(GfnDisplayLanguage language, const wchar_t* wSdkLibraryPath)
+// Writes a log line as a binary record to the persistent log, without formatting it or making a
+// system call. Returns false if no persistent log is mapped, in which case the caller writes text.
+static bool gfnWritePersistentLogRecord(gfnLogSite* site, int level, char const* func, int line, unsigned int suppressed,
+    char const* format, va_list args)
 {
-    if (wSdkLibraryPath == NULL)
+    gfnPersistentLogHeader* header;
+    gfnPersistentLogRecord* record;
+    int64_t sequence;
+    int64_t replaced;
+    bool recorded = false;
+    bool dropped = false;
+
+    gfnAtomicAdd32(&s_persistentLogWriters, 1);
+    header = (gfnPersistentLogHeader*)gfnAtomicLoadAcquirePtr(&s_persistentLog);
+    if (header != NULL)
     {
-        GFN_SDK_LOG("Invalid SDK library path");
-        return gfnInvalidParameter;
+        if (t_logThreadId == 0)
+        {
+            t_logThreadId = (uint32_t)gfnGetCurrentThreadId();
+        }
+        sequence = gfnAtomicAdd64(&header->nextSequence, 1);
+        record = gfnPersistentLogRecordAt(header, (uint64_t)sequence);
+        // Two writers a whole ring apart can reach the same slot. The slot is claimed by swapping the
+        // record it holds for the negated sequence number, which readers skip, so only one of them fills
+        // it; a writer that finds it claimed, or holding a later record, drops its line.
+        replaced = gfnAtomicLoadRelaxed64(&record->sequence);
+        if (replaced >= 0 && replaced < sequence && gfnAtomicCompareExchange64(&record->sequence, replaced, -sequence) == replaced)
+        {
+            record->timestampNs = gfnGetMonotonicNs();
+            record->threadId = t_logThreadId;
+            record->suppressed = suppressed;
+            record->site = gfnGetPersistentLogSite(header, site, func, line, format);
+            record->level = (uint8_t)level;
+            gfnEncodePersistentLogArgs(record, format, args);
+            gfnAtomicFence();
+            gfnAtomicStoreRelaxed64(&record->sequence, sequence);
+            recorded = true;
+        }
+        else
+        {
+            dropped = true;
+        }
     }
+    gfnAtomicAdd32(&s_persistentLogWriters, -1);
 
-#ifdef _WIN32
-    // On windows, this is the default encoding. Directly call the implementation.
-    return GfnInitializeSdkFromPathDefault(language, wSdkLibraryPath);
-#elif __linux__
-    (void)language;
-    GFN_SDK_LOG("GfnInitializeSdkFromPathW is unsupported on linux");
-    return gfnInvalidParameter;
-#endif
-}
-
-GfnRuntimeError GfnShutdownSdk(void)
-{
-    gfnShutdownRuntimeSdkFn fnGfnShutdownRuntimeSdk = NULL;
-
-    gfnShutDownCloudSdk();
-
-    if (g_gfnSdkModule == NULL)
+    if (recorded)
     {
-        // Not initialized, no need to shutdown
-        return gfnSuccess;
+        gfnAtomicAdd64(&s_logLinesWritten, 1);
     }
-
-    fnGfnShutdownRuntimeSdk = (gfnShutdownRuntimeSdkFn)gfnGetSymbol(g_gfnSdkModule, "gfnShutdownRuntimeSdk");
-    if (fnGfnShutdownRuntimeSdk == NULL)
+    if (dropped)
     {
-        return gfnAPINotFound;
+        gfnAtomicAdd64(&s_logLinesDropped, 1);
     }
-
-    fnGfnShutdownRuntimeSdk();
-
-    gfnFreeLibrary(g_gfnSdkModule);
-    g_gfnSdkModule = NULL;
-
-    GFN_SDK_DEINIT_LOGGING();
-    return gfnSuccess;
+    return recorded || dropped;
 }
 
-GfnRuntimeError GfnIsRunningInCloud(bool* runningInCloud)
+void gfnLog(gfnLogSite* site, int level, char const* func, int line, unsigned int suppressed, char const* format, ...)
 {
-    CHECK_NULL_PARAM(runningInCloud);
-    *runningInCloud = false;
+    char* buffer = t_logScratch;
+    uint64_t timestampMs;
+    int written;
+    unsigned int n = 0;
+    bool recorded;
+    va_list args;
 
-    if (g_pCloudLibrary == NULL && g_gfnSdkModule == NULL)
+    if (gfnAtomicLoadRelaxed32(&s_logMode) == gfnLogModePersistent)
     {
-        return gfnAPINotInit;
+        va_start(args, format);
+        recorded = gfnWritePersistentLogRecord(site, level, func, line, suppressed, format, args);
+        va_end(args);
+        if (recorded)
+        {
+            return;
+        }
     }
+    timestampMs = gfnGetWallClockMs();
+
+    // Format function, line number
+    n = gfnFormatLogLocation(buffer, func, line);
 
-    if (g_pCloudLibrary == NULL)
+    // Format the actual message/format
+    va_start(args, format);
+    written = vsnprintf(buffer + n, kGfnLogBufLen - n - 1, format, args); // -1 leave room for linebreak
+    va_end(args);
+    if (written > 0)
     {
-        GFN_SDK_LOG("No cloud library present, call succeeds");
-        return gfnSuccess;
+        n += (unsigned int)written;
+    }
+    if (kGfnLogBufLen - 2 < n)  // returns amount it WOULD have written if buffer were big enough
+    {
+        n = kGfnLogBufLen - 2;
     }
 
-    if (g_pCloudLibrary->IsRunningInCloud == NULL)
+    // Report lines this call site dropped through rate limiting since it last logged
+    if (suppressed > 0 && n < kGfnLogBufLen - 2)
     {
-        GFN_SDK_LOG("API Not Found");
-        return gfnAPINotFound;
+        written = snprintf(buffer + n, kGfnLogBufLen - n - 1, " (%u similar lines suppressed)", suppressed);
+        n = (written > 0 && n + (unsigned int)written < kGfnLogBufLen - 2) ? n + (unsigned int)written : kGfnLogBufLen - 2;
     }
 
-    *runningInCloud = (bool)g_pCloudLibrary->IsRunningInCloud();
+    // Add linebreak at end
+    buffer[n++] = '\n';
+    buffer[n] = '\0';
+
+    if (gfnEnqueueLogLine(timestampMs, buffer, n))
+    {
+        return;
+    }
 
-    GFN_SDK_LOG("Success: %d", *runningInCloud);
-    return gfnSuccess;
+    gfnMutexLock(&s_logLock);
+    gfnWriteLogLineLocked(timestampMs, buffer, n);
+    fflush(s_logfile ? s_logfile : stderr);
+    gfnMutexUnlock(&s_logLock);
+    gfnAtomicAdd64(&s_logLinesWritten, 1);
 }
 
-GfnRuntimeError GfnIsRunningInCloudSecure(GfnIsRunningInCloudAssurance* assurance)
+GfnRuntimeError GfnSetLogMode(GfnLogMode mode, GfnLogOverflowPolicy overflowPolicy)
 {
-    GfnRuntimeError status = gfnSuccess;
-
-    CHECK_NULL_PARAM(assurance);
-    *assurance = gfnNotCloud;
-
-    if (g_pCloudLibrary == NULL && g_gfnSdkModule == NULL)
+    if ((mode != gfnLogModeSynchronous && mode != gfnLogModeAsynchronous && mode != gfnLogModePersistent) ||
+        (overflowPolicy != gfnLogOverflowDrop && overflowPolicy != gfnLogOverflowBlock))
     {
-        return gfnAPINotInit;
+        return gfnInvalidParameter;
     }
 
-#ifdef _WIN32
-    if (wcslen(g_cloudLibraryPath) == 0)
-#elif __linux__
-    if (strlen(g_cloudLibraryPath) == 0)
-#endif
+    gfnMutexLock(&s_logLifecycleLock);
+    s_logModeSetByApi = true;
+    gfnAtomicExchange32(&s_logOverflowPolicy, overflowPolicy);
+    gfnAtomicExchange32(&s_logMode, mode);
+    if (mode != gfnLogModeAsynchronous)
     {
-        GFN_SDK_LOG("Cloud library path not defined, which denotes an API call without Initialize succeeding, treating as not in cloud");
-        return gfnSuccess;
+        gfnStopLogWriter();
     }
-
-#ifdef _WIN32
-    if (gfnCheckLibraryGfnSignatureW(g_cloudLibraryPath) == FALSE)
+    if (mode != gfnLogModePersistent)
     {
-        GFN_SDK_LOG("Cloud library path does not have valid GFN signing, treating as not in cloud");
-        return gfnSuccess;
+        gfnClosePersistentLog();
     }
-#endif
-
-    if (g_pCloudLibrary == NULL)
+    if (g_LoggingInitialized && mode == gfnLogModeAsynchronous)
     {
-        GFN_SDK_LOG("No cloud library present, call succeeds");
-        return gfnSuccess;
+        gfnStartLogWriter();
     }
-
-    if (g_pCloudLibrary->IsRunningInCloudSecure == NULL)
+    else if (g_LoggingInitialized && mode == gfnLogModePersistent)
     {
-        GFN_SDK_LOG("API Not Found");
-        return gfnAPINotFound;
+        gfnOpenPersistentLog();
     }
+    gfnMutexUnlock(&s_logLifecycleLock);
 
-    status = gfnTranslateCloudStatus(g_pCloudLibrary->IsRunningInCloudSecure(assurance));
-    GFN_SDK_LOG("status=%d assurance=%d", status, *assurance);
-
-    return status;
+    return gfnSuccess;
 }
 
-GfnRuntimeError GfnCloudCheck(const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment)
+GfnRuntimeError GfnSetPersistentLogConfig(const CHAR_TYPE* path, unsigned int sizeKb)
 {
-    GfnRuntimeError status = gfnSuccess;
+    size_t pathLength = 0;
 
-    *isCloudEnvironment = false;
-
-    if (g_pCloudLibrary == NULL && g_gfnSdkModule == NULL)
+    if (path != NULL)
     {
-        return gfnAPINotInit;
-    }
-
 #ifdef _WIN32
-    if (wcslen(g_cloudLibraryPath) == 0)
+        pathLength = wcslen(path);
 #elif __linux__
-    if (strlen(g_cloudLibraryPath) == 0)
+        pathLength = strlen(path);
 #endif
+    }
+    if (pathLength >= PLATFORM_MAX_PATH ||
+        (sizeKb != 0 && (sizeKb < kGfnPersistentLogMinSizeKb || sizeKb > kGfnPersistentLogMaxSizeKb)))
     {
-        GFN_SDK_LOG("Cloud library path not defined, which denotes an API call without Initialize succeeding, treating as not in cloud");
-        return gfnSuccess;
+        return gfnInvalidParameter;
     }
 
-    if (g_pCloudLibrary == NULL)
+    gfnMutexLock(&s_logLifecycleLock);
+    memset(s_persistentLogPath, 0, sizeof(s_persistentLogPath));
+    if (pathLength > 0)
     {
-        GFN_SDK_LOG("No cloud library present, call succeeds");
-        return gfnSuccess;
+        memcpy(s_persistentLogPath, path, pathLength * sizeof(CHAR_TYPE));
+    }
+    s_persistentLogSizeKb = (sizeKb != 0) ? sizeKb : kGfnPersistentLogDefaultSizeKb;
+    // A log that is already being written is restarted with the new configuration
+    if (gfnAtomicLoadAcquirePtr(&s_persistentLog) != NULL)
+    {
+        gfnClosePersistentLog();
+        gfnOpenPersistentLog();
     }
+    gfnMutexUnlock(&s_logLifecycleLock);
+
+    return gfnSuccess;
+}
 
-    if (g_pCloudLibrary->CloudCheck == NULL)
+GfnRuntimeError GfnSetLogLevel(GfnLogLevel level)
+{
+    if (level < gfnLogLevelTrace || level > gfnLogLevelNone)
     {
-        GFN_SDK_LOG("API Not Found");
-        return gfnAPINotFound;
+        return gfnInvalidParameter;
     }
 
-    status = gfnTranslateCloudStatus(g_pCloudLibrary->CloudCheck(challenge, response, isCloudEnvironment));
-    GFN_SDK_LOG("status=%d isCloudEnvironment=%d", status, *isCloudEnvironment);
+    gfnMutexLock(&s_logLifecycleLock);
+    s_logLevelSetByApi = true;
+    gfnAtomicExchange32(&s_logLevel, level);
+    gfnMutexUnlock(&s_logLifecycleLock);
 
-    return status;
+    return gfnSuccess;
 }
 
-#define TESTME(lib, fn) lib->fn()
-
-GfnRuntimeError GfnFree(const char** data)
+GfnRuntimeError GfnGetLogLevel(GfnLogLevel* level)
 {
-    CHECK_NULL_PARAM(data);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(Free, data);
+    CHECK_NULL_PARAM(level);
+
+    *level = (GfnLogLevel)gfnAtomicLoadRelaxed32(&s_logLevel);
+    return gfnSuccess;
 }
 
-GfnRuntimeError GfnGetClientIpV4(const char ** clientIp)
+GfnRuntimeError GfnGetLogStats(GfnLogStats* stats)
 {
-    CHECK_NULL_PARAM(clientIp);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetClientIp, clientIp);
+    CHECK_NULL_PARAM(stats);
+
+    stats->linesWritten = (uint64_t)gfnAtomicLoadRelaxed64(&s_logLinesWritten);
+    stats->linesDropped = (uint64_t)gfnAtomicLoadRelaxed64(&s_logLinesDropped);
+    return gfnSuccess;
 }
 
-GfnRuntimeError GfnGetClientLanguageCode(const char** languageCode)
+// Nanoseconds per gfnReadTicks unit, measured against the monotonic clock
+static double gfnStatsNsPerTick(void)
 {
-    CHECK_NULL_PARAM(languageCode);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetClientLanguageCode, languageCode);
+#ifdef GFN_TICKS_ARE_NS
+    return 1.0;
+#else
+    uint64_t elapsedNs;
+    uint64_t elapsedTicks;
+
+    gfnStartStatsClock();
+    while (gfnAtomicLoadAcquire32(&s_statsClockState) != 2)
+    {
+        gfnThreadYield();
+    }
+    // A short interval gives a poor estimate of the tick rate, so measure over at least 10 ms
+    for (;;)
+    {
+        elapsedNs = gfnGetMonotonicNs() - s_statsClockBaseNs;
+        elapsedTicks = gfnReadTicks() - s_statsClockBaseTicks;
+        if (elapsedNs >= 10000000ULL)
+        {
+            break;
+        }
+        gfnSleepMs(1);
+    }
+    return elapsedTicks != 0 ? (double)elapsedNs / (double)elapsedTicks : 1.0;
+#endif
 }
 
-GfnRuntimeError GfnGetClientCountryCode(char* countryCode, unsigned int length)
+// Statistics of the current context: the default context is sharded, created contexts have one shard
+static unsigned int gfnContextStatsShardCount(void)
 {
-    CHECK_NULL_PARAM(countryCode);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetClientCountryCode, countryCode, length);
+    return t_context != NULL ? 1 : GFN_STATS_SHARDS;
 }
 
-GfnRuntimeError GfnGetPartnerData(const char** partnerData)
+static gfnApiStatsShard* gfnContextStatsShardAt(unsigned int shard, unsigned int api)
 {
-    CHECK_NULL_PARAM(partnerData);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetPartnerData, partnerData);
+    return t_context != NULL ? &t_context->stats[api] : &s_apiStats[shard][api];
 }
 
-GfnRuntimeError GfnGetPartnerSecureData(const char** partnerSecureData)
+// Merges the shards of one API into stats and the latency histogram
+static void gfnMergeApiStats(gfnApiId api, GfnApiStats* stats, uint64_t* latency)
 {
-    CHECK_NULL_PARAM(partnerSecureData);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetPartnerSecureData, partnerSecureData);
+    uint64_t* errors = stats->errorsByCode;
+    unsigned int shard;
+    unsigned int i;
+
+    stats->calls = 0;
+    stats->timedCalls = 0;
+    memset(latency, 0, GFN_STATS_LATENCY_BUCKETS * sizeof(uint64_t));
+    memset(errors, 0, GFN_WRAPPER_STATS_ERROR_CODES * sizeof(uint64_t));
+    for (shard = 0; shard < gfnContextStatsShardCount(); shard++)
+    {
+        gfnApiStatsShard* pShard = gfnContextStatsShardAt(shard, api);
+        stats->calls += (uint64_t)gfnAtomicLoadRelaxed64(&pShard->calls);
+        for (i = 0; i < GFN_STATS_LATENCY_BUCKETS; i++)
+        {
+            uint64_t count = (uint64_t)gfnAtomicLoadRelaxed64(&pShard->latency[i]);
+            latency[i] += count;
+            stats->timedCalls += count;
+        }
+        for (i = 0; i < GFN_WRAPPER_STATS_ERROR_CODES; i++)
+        {
+            errors[i] += (uint64_t)gfnAtomicLoadRelaxed64(&pShard->errors[i]);
+        }
+    }
 }
 
-GfnRuntimeError GfnIsTitleAvailable(const char* platformAppId, bool* isAvailable)
+// Upper bound of the bucket holding the given fraction, in per mille, of the timed calls
+static uint64_t gfnLatencyPercentileNs(const uint64_t* latency, uint64_t calls, unsigned int permille, double nsPerTick)
 {
-    CHECK_NULL_PARAM(isAvailable);
-    *isAvailable = false;
-
-    CHECK_NULL_PARAM(platformAppId);
-    CHECK_CLOUD_ENVIRONMENT();
-    CHECK_CLOUD_API_AVAILABLE(IsTitleAvailable);
-    *isAvailable = (bool)g_pCloudLibrary->IsTitleAvailable(platformAppId);
+    uint64_t rank = (calls * permille + 999) / 1000;
+    uint64_t seen = 0;
+    unsigned int i;
 
-    return gfnSuccess;
+    for (i = 0; i < GFN_STATS_LATENCY_BUCKETS && calls != 0; i++)
+    {
+        seen += latency[i];
+        if (seen >= rank)
+        {
+            return (uint64_t)((double)gfnLatencyBucketLimit(i) * nsPerTick);
+        }
+    }
+    return 0;
 }
 
-GfnRuntimeError GfnGetTitlesAvailable(const char** platformAppIds)
+static void gfnCollectApiStats(gfnApiId api, double nsPerTick, GfnApiStats* stats, uint64_t* latency)
 {
-    CHECK_NULL_PARAM(platformAppIds);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetTitlesAvailable, platformAppIds);
-}
+    unsigned int i;
 
-
-GfnRuntimeError GfnGetClientInfo(GfnClientInfo* clientInfo)
-{
-    GFN_SDK_LOG("Calling GfnGetClientInfo");
-    CHECK_NULL_PARAM(clientInfo);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetClientInfo, clientInfo);
+    stats->name = kGfnApiNames[api];
+    stats->cloudLibrary = kGfnApiInCloudLibrary[api];
+    gfnMergeApiStats(api, stats, latency);
+    stats->errors = 0;
+    for (i = 0; i < GFN_WRAPPER_STATS_ERROR_CODES; i++)
+    {
+        stats->errors += stats->errorsByCode[i];
+    }
+    stats->throttled = stats->errorsByCode[-gfnThrottled];
+    stats->latencyP50Ns = gfnLatencyPercentileNs(latency, stats->timedCalls, 500, nsPerTick);
+    stats->latencyP90Ns = gfnLatencyPercentileNs(latency, stats->timedCalls, 900, nsPerTick);
+    stats->latencyP99Ns = gfnLatencyPercentileNs(latency, stats->timedCalls, 990, nsPerTick);
+    stats->latencyMaxNs = gfnLatencyPercentileNs(latency, stats->timedCalls, 1000, nsPerTick);
 }
 
-static void GFN_CALLBACK _gfnClientInfoCallbackWrapper(int status, void* updateData, void* pData)
+// Appends formatted text to a file or to a caller buffer, counting the full length even once the buffer is full
+typedef struct gfnTextWriter
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    ClientInfoCallbackSig cb = NULL;
+    FILE* file;
+    char* buffer;
+    size_t size;
+    size_t length;
+} gfnTextWriter;
 
-    (void)status;
-    GFN_SDK_LOG("ClientInfo update received");
+static void gfnTextAppend(gfnTextWriter* writer, const char* format, ...)
+{
+    va_list args;
+    int written;
+    bool hasRoom = writer->buffer != NULL && writer->length < writer->size;
 
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pData);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
+    va_start(args, format);
+    if (writer->file != NULL)
     {
-        GFN_SDK_LOG("Wrapped context was null or had no callback. Ignoring");
-        return;
+        written = vfprintf(writer->file, format, args);
     }
-    cb = (ClientInfoCallbackSig)(pWrappedContext->fnCallback);
-    if (cb == NULL)
+    else
     {
-        GFN_SDK_LOG("Callback was NULL, ignoring");
-        return;
+        written = vsnprintf(hasRoom ? writer->buffer + writer->length : NULL, hasRoom ? writer->size - writer->length : 0, format, args);
+    }
+    va_end(args);
+    if (written > 0)
+    {
+        writer->length += (size_t)written;
     }
-    cb((GfnClientInfoUpdateData *)updateData, pWrappedContext->pOrigUserContext);
 }
 
-GfnRuntimeError GfnRegisterClientInfoCallback(ClientInfoCallbackSig clientInfoCallback, void* pUserContext)
+GfnRuntimeError GfnGetWrapperStats(GfnWrapperStats* stats)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
+    uint64_t latency[GFN_STATS_LATENCY_BUCKETS];
+    double nsPerTick;
+    unsigned int api;
 
-    CHECK_NULL_PARAM(clientInfoCallback);
-    CHECK_CLOUD_ENVIRONMENT();
-    GFN_SDK_LOG("Registering for ClientInfo updates");
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)clientInfoCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
+    CHECK_NULL_PARAM(stats);
 
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-    DELEGATE_TO_CLOUD_LIBRARY(RegisterClientInfoCallback, &_gfnClientInfoCallbackWrapper, (void*)(pWrappedContext));
+    nsPerTick = gfnStatsNsPerTick();
+    stats->apiCount = gfnApiCount;
+    for (api = 0; api < gfnApiCount; api++)
+    {
+        gfnCollectApiStats((gfnApiId)api, nsPerTick, &stats->apis[api], latency);
+    }
+    return gfnSuccess;
 }
 
-GfnRuntimeError GfnGetSessionInfo(GfnSessionInfo* sessionInfo)
+GfnRuntimeError GfnDumpWrapperStatsJson(char* buffer, size_t bufferSize, size_t* length)
 {
-    GFN_SDK_LOG("Calling GfnGetSessionInfo");
-    CHECK_NULL_PARAM(sessionInfo);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(GetSessionInfo, sessionInfo);
-}
+    GfnApiStats stats;
+    uint64_t latency[GFN_STATS_LATENCY_BUCKETS];
+    gfnTextWriter writer;
+    double nsPerTick;
+    const char* separator = "";
+    unsigned int api;
+    unsigned int i;
+
+    CHECK_NULL_PARAM(length);
+    if (buffer == NULL && bufferSize != 0)
+    {
+        return gfnInvalidParameter;
+    }
+
+    writer.file = NULL;
+    writer.buffer = buffer;
+    writer.size = bufferSize;
+    writer.length = 0;
+    nsPerTick = gfnStatsNsPerTick();
+    gfnTextAppend(&writer, "{\"apis\":[");
+    for (api = 0; api < gfnApiCount; api++)
+    {
+        const char* bucketSeparator = "";
+        gfnCollectApiStats((gfnApiId)api, nsPerTick, &stats, latency);
+        if (stats.calls == 0)
+        {
+            continue;
+        }
+        gfnTextAppend(&writer, "%s{\"name\":\"%s\",\"library\":\"%s\",\"calls\":%llu,\"timedCalls\":%llu,\"errors\":%llu,\"throttled\":%llu,\"errorsByCode\":{",
+            separator, stats.name, stats.cloudLibrary ? "cloud" : "client", (unsigned long long)stats.calls, (unsigned long long)stats.timedCalls,
+            (unsigned long long)stats.errors, (unsigned long long)stats.throttled);
+        separator = "";
+        for (i = 0; i < GFN_WRAPPER_STATS_ERROR_CODES; i++)
+        {
+            if (stats.errorsByCode[i] != 0)
+            {
+                if (i == 0)
+                {
+                    gfnTextAppend(&writer, "%s\"other\":%llu", separator, (unsigned long long)stats.errorsByCode[i]);
+                }
+                else
+                {
+                    gfnTextAppend(&writer, "%s\"%d\":%llu", separator, -(int)i, (unsigned long long)stats.errorsByCode[i]);
+                }
+                separator = ",";
+            }
+        }
+        gfnTextAppend(&writer, "},\"latencyNs\":{\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"max\":%llu},\"histogram\":[",
+            (unsigned long long)stats.latencyP50Ns, (unsigned long long)stats.latencyP90Ns,
+            (unsigned long long)stats.latencyP99Ns, (unsigned long long)stats.latencyMaxNs);
+        for (i = 0; i < GFN_STATS_LATENCY_BUCKETS; i++)
+        {
+            if (latency[i] != 0)
+            {
+                gfnTextAppend(&writer, "%s[%llu,%llu]", bucketSeparator,
+                    (unsigned long long)((double)gfnLatencyBucketLimit(i) * nsPerTick), (unsigned long long)latency[i]);
+                bucketSeparator = ",";
+            }
+        }
+        gfnTextAppend(&writer, "]}");
+        separator = ",";
+    }
+    gfnTextAppend(&writer, "]}");
 
+    *length = writer.length;
+    return writer.length < bufferSize ? gfnSuccess : gfnInvalidParameter;
+}
 
-static void GFN_CALLBACK _gfnNetworkStatusCallbackWrapper(int status, void* updateData, void* pData)
+void GfnResetWrapperStats(void)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    NetworkStatusCallbackSig cb = NULL;
-
-    (void)status;
-    GFN_SDK_LOG("Network performance update received");
+    unsigned int shard;
+    unsigned int api;
+    unsigned int i;
 
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pData);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        GFN_SDK_LOG("Wrapped context was null or had no callback. Ignoring");
-        return;
-    }
-    cb = (NetworkStatusCallbackSig)(pWrappedContext->fnCallback);
-    if (cb == NULL)
+    for (shard = 0; shard < gfnContextStatsShardCount(); shard++)
     {
-        GFN_SDK_LOG("Callback was NULL, ignoring");
-        return;
+        for (api = 0; api < gfnApiCount; api++)
+        {
+            gfnApiStatsShard* pShard = gfnContextStatsShardAt(shard, api);
+            gfnAtomicExchange64(&pShard->calls, 0);
+            for (i = 0; i < GFN_STATS_LATENCY_BUCKETS; i++)
+            {
+                gfnAtomicExchange64(&pShard->latency[i], 0);
+            }
+            for (i = 0; i < GFN_WRAPPER_STATS_ERROR_CODES; i++)
+            {
+                gfnAtomicExchange64(&pShard->errors[i], 0);
+            }
+        }
     }
-    cb((GfnNetworkStatusUpdateData *)updateData, pWrappedContext->pOrigUserContext);
 }
 
-GfnRuntimeError GfnRegisterNetworkStatusCallback(NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* pUserContext)
+GfnRuntimeError GfnSetTracingEnabled(bool enabled)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    
-    CHECK_NULL_PARAM(networkStatusCallback);
-    CHECK_CLOUD_ENVIRONMENT();
-    GFN_SDK_LOG("Registering for NetworkStatus updates");
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)networkStatusCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
-
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-    DELEGATE_TO_CLOUD_LIBRARY(RegisterNetworkStatusCallback, &_gfnNetworkStatusCallbackWrapper, updateRateMs, (void*)(pWrappedContext));
+    gfnAtomicExchange32(&s_traceEnabled, enabled ? 1 : 0);
+    return gfnSuccess;
 }
 
-GfnRuntimeError GfnRegisterStreamStatusCallback(StreamStatusCallbackSig streamStatusCallback, void* userContext)
+// Copies the spans of one thread that were not overwritten while being copied. Returns their number.
+static unsigned int gfnCopyTraceEvents(gfnTraceBuffer* buffer, gfnTraceEvent* events)
 {
-    gfnRegisterStreamStatusCallbackFn fnRegisterStreamStatusCallback = NULL;
+    uint32_t written = (uint32_t)gfnAtomicLoadAcquire32(&buffer->written);
+    uint32_t count = gfnAtomicLoadAcquire32(&buffer->full) ? kGfnTraceEventsPerThread : written;
+    uint32_t first = written - count;
+    uint32_t position;
+    uint32_t valid = 0;
 
-    if (g_gfnSdkModule == NULL)
+    for (position = first; position != written; position++)
+    {
+        events[position - first] = buffer->events[position & (kGfnTraceEventsPerThread - 1)];
+    }
+    // The span at position p is overwritten when the span at p + kGfnTraceEventsPerThread is recorded
+    written = (uint32_t)gfnAtomicLoadAcquire32(&buffer->written);
+    for (position = first; position != first + count; position++)
+    {
+        if (written - position < kGfnTraceEventsPerThread)
+        {
+            events[valid++] = events[position - first];
+        }
+    }
+    return valid;
+}
+
+GfnRuntimeError GfnTraceDump(const CHAR_TYPE* path)
+{
+    gfnTraceEvent* events;
+    gfnTraceBuffer* buffer;
+    gfnTextWriter writer;
+    double nsPerTick;
+    uint64_t processId = gfnGetCurrentProcessId();
+    const char* separator = "";
+    unsigned int count;
+    unsigned int i;
+
+    CHECK_NULL_PARAM(path);
+
+    events = (gfnTraceEvent*)malloc(kGfnTraceEventsPerThread * sizeof(gfnTraceEvent));
+    if (events == NULL)
+    {
+        return gfnUnableToAllocateMemory;
+    }
+    memset(&writer, 0, sizeof(writer));
+#ifdef _WIN32
+    _wfopen_s(&writer.file, path, L"w");
+#elif __linux__
+    writer.file = fopen(path, "w");
+#endif
+    if (writer.file == NULL)
     {
-        return gfnAPINotInit;
+        free(events);
+        GFN_SDK_LOG_WARNING("Could not open trace file");
+        return gfnInvalidParameter;
     }
 
-    fnRegisterStreamStatusCallback = (gfnRegisterStreamStatusCallbackFn)gfnGetSymbol(g_gfnSdkModule, "gfnRegisterStreamStatusCallback");
-
-    if (fnRegisterStreamStatusCallback == NULL)
+    gfnMutexLock(&s_traceDumpLock);
+    nsPerTick = gfnStatsNsPerTick();
+    gfnTextAppend(&writer, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (buffer = (gfnTraceBuffer*)gfnAtomicLoadAcquirePtr(&s_traceBuffers); buffer != NULL; buffer = buffer->next)
     {
-        return gfnAPINotFound;
+        count = gfnCopyTraceEvents(buffer, events);
+        for (i = 0; i < count; i++)
+        {
+            // Timestamps are on the monotonic clock, in microseconds, so they line up with other traces of the process
+            double beginNs = (double)s_statsClockBaseNs + (double)(int64_t)(events[i].beginTicks - s_statsClockBaseTicks) * nsPerTick;
+            double durationNs = (double)(events[i].endTicks - events[i].beginTicks) * nsPerTick;
+            gfnTextAppend(&writer, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%llu,\"tid\":%llu",
+                separator, events[i].name, events[i].category, beginNs / 1000.0, durationNs / 1000.0,
+                (unsigned long long)processId, (unsigned long long)buffer->threadId);
+            if (events[i].hasResult)
+            {
+                gfnTextAppend(&writer, ",\"args\":{\"result\":%d}", (int)events[i].result);
+            }
+            gfnTextAppend(&writer, "}");
+            separator = ",";
+        }
     }
+    gfnTextAppend(&writer, "\n]}\n");
+    gfnMutexUnlock(&s_traceDumpLock);
 
-    return fnRegisterStreamStatusCallback(streamStatusCallback, userContext);
+    fclose(writer.file);
+    free(events);
+    return gfnSuccess;
 }
 
-GfnRuntimeError GfnStartStream(StartStreamInput * startStreamInput, StartStreamResponse* response)
+// Context lifecycle. The first context initializes the SDK unless the application already initialized it
+// through the global API, and in that case the last context to be destroyed shuts it down again.
+static gfnMutex s_contextLifecycleLock = GFN_MUTEX_INITIALIZER;
+static unsigned int s_contextReferences = 0;
+static bool s_contextsOwnSdk = false;
+static GfnRuntimeError s_contextInitStatus = gfnSuccess;
+
+GfnRuntimeError GfnCreateContext(GfnDisplayLanguage language, GfnSdkContext* context)
 {
-    gfnStartStreamFn fnGfnStartStream = NULL;
-    
-    if (g_gfnSdkModule == NULL)
+    GfnSdkContext created;
+    GfnRuntimeError status;
+    unsigned int index;
+
+    CHECK_NULL_PARAM(context);
+    *context = NULL;
+    created = (GfnSdkContext)calloc(1, sizeof(*created));
+    if (created == NULL)
     {
-        return gfnAPINotInit;
+        return gfnUnableToAllocateMemory;
     }
 
-    fnGfnStartStream = (gfnStartStreamFn)gfnGetSymbol(g_gfnSdkModule, "gfnStartStream");
-
-    if (fnGfnStartStream == NULL)
+    gfnMutexLock(&s_contextLifecycleLock);
+    for (index = 0; index < kGfnMaxContexts && gfnAtomicLoadAcquirePtr(&s_contexts[index]) != NULL; index++)
     {
-        return gfnAPINotFound;
     }
-
-    return fnGfnStartStream(startStreamInput, response);
-}
-
-GfnRuntimeError GfnStartStreamAsync(const StartStreamInput* startStreamInput, StartStreamCallbackSig cb, void* context, unsigned int timeoutMs)
-{
-    gfnStartStreamAsyncFn fnGfnStartStreamAsync = NULL;
-    if (g_gfnSdkModule == NULL)
+    if (index == kGfnMaxContexts)
     {
-        return gfnAPINotInit;
+        gfnMutexUnlock(&s_contextLifecycleLock);
+        free(created);
+        GFN_SDK_LOG_WARNING("Too many SDK contexts");
+        return gfnUnableToAllocateMemory;
     }
-
-    fnGfnStartStreamAsync = (gfnStartStreamAsyncFn)gfnGetSymbol(g_gfnSdkModule, "gfnStartStreamAsync");
-
-    if (fnGfnStartStreamAsync == NULL)
+    if (s_contextReferences == 0)
     {
-        return gfnAPINotFound;
+        s_contextsOwnSdk = (gfnAtomicLoadAcquire32(&g_sdkState) & (GFN_STATE_CLIENT_LIVE | GFN_STATE_CLOUD_LIVE)) == 0;
+        s_contextInitStatus = s_contextsOwnSdk ? GfnInitializeSdk(language) : gfnSuccess;
     }
-
-    fnGfnStartStreamAsync(startStreamInput, cb, context, timeoutMs);
-
-    return gfnSuccess;
-}
-
-GfnRuntimeError GfnStopStream(void)
-{
-    gfnStopStreamFn fnGfnStopStream = NULL;
-
-    if (g_gfnSdkModule == NULL)
+    status = s_contextInitStatus;
+    if (GFNSDK_FAILED(status))
     {
-        return gfnAPINotInit;
+        gfnMutexUnlock(&s_contextLifecycleLock);
+        free(created);
+        return status;
     }
+    s_contextReferences++;
 
-    fnGfnStopStream = (gfnStopStreamFn)gfnGetSymbol(g_gfnSdkModule, "gfnStopStream");
-
-    if (fnGfnStopStream == NULL)
+    created->index = index;
+    gfnMutexLock(&s_contextRegistryLock);
+    gfnAtomicStoreReleasePtr(&s_contexts[index], created);
+    if (index >= (unsigned int)gfnAtomicLoad32(&s_contextCount))
     {
-        return gfnAPINotFound;
+        gfnAtomicExchange32(&s_contextCount, (int32_t)index + 1);
     }
+    gfnMutexUnlock(&s_contextRegistryLock);
+    gfnMutexUnlock(&s_contextLifecycleLock);
 
-    return fnGfnStopStream();
+    *context = created;
+    return status;
 }
 
-GfnRuntimeError GfnStopStreamAsync(StopStreamCallbackSig cb, void* context, unsigned int timeoutMs)
+GfnRuntimeError GfnDestroyContext(GfnSdkContext context)
 {
-    gfnStopStreamAsyncFn fnGfnStopStreamAsync = NULL;
+    GfnRuntimeError status = gfnSuccess;
 
-    if (g_gfnSdkModule == NULL)
+    CHECK_NULL_PARAM(context);
+    if (t_callbackDispatchDepth > 0)
     {
-        return gfnAPINotInit;
+        // The callback's context could be the one being freed
+        return gfnCallWrongEnvironment;
     }
 
-    fnGfnStopStreamAsync = (gfnStopStreamAsyncFn)gfnGetSymbol(g_gfnSdkModule, "gfnStopStreamAsync");
+    gfnMutexLock(&s_contextLifecycleLock);
+    gfnMutexLock(&s_contextRegistryLock);
+    gfnAtomicCompareExchangePtr(&s_contexts[context->index], context, NULL);
+    gfnMutexUnlock(&s_contextRegistryLock);
+    // Trampolines that found the context before it was removed still have to leave it
+    gfnDrainCallbackDispatchers();
+    free(context);
 
-    if (fnGfnStopStreamAsync == NULL)
+    if (--s_contextReferences == 0 && s_contextsOwnSdk)
     {
-        return gfnAPINotFound;
+        s_contextsOwnSdk = false;
+        status = GfnShutdownSdk();
     }
-
-    fnGfnStopStreamAsync(cb, context, timeoutMs);
-
-    return gfnSuccess;
+    gfnMutexUnlock(&s_contextLifecycleLock);
+    return status;
 }
 
-GfnRuntimeError GfnSetupTitle(const char* platformAppId)
+// Body of a GfnContext* function: runs the global API function with the context current on this thread
+#define CALL_IN_CONTEXT(context, call)                  \
+    GfnSdkContext previousContext = t_context;          \
+    GfnRuntimeError contextStatus;                      \
+    CHECK_NULL_PARAM(context);                          \
+    t_context = context;                                \
+    contextStatus = call;                               \
+    t_context = previousContext;                        \
+    return contextStatus
+
+GfnRuntimeError GfnContextIsRunningInCloud(GfnSdkContext context, bool* runningInCloud)
 {
-    CHECK_NULL_PARAM(platformAppId);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(SetupTitle, platformAppId);
+    CALL_IN_CONTEXT(context, GfnIsRunningInCloud(runningInCloud));
 }
 
-GfnRuntimeError GfnTitleExited(const char* platformId, const char* platformAppId)
+GfnRuntimeError GfnContextIsRunningInCloudSecure(GfnSdkContext context, GfnIsRunningInCloudAssurance* assurance)
 {
-    CHECK_NULL_PARAM(platformId);
-    CHECK_NULL_PARAM(platformAppId);
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(TitleExited, platformId, platformAppId);
+    CALL_IN_CONTEXT(context, GfnIsRunningInCloudSecure(assurance));
 }
 
-GfnRuntimeError GfnAppReady(bool success, const char* status)
+GfnRuntimeError GfnContextCloudCheck(GfnSdkContext context, const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment)
 {
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(AppReady, success, status);
+    CALL_IN_CONTEXT(context, GfnCloudCheck(challenge, response, isCloudEnvironment));
 }
 
-GfnRuntimeError GfnSetActionZone(GfnActionType type, unsigned int id, GfnRect* zone)
+GfnRuntimeError GfnContextGetClientIpV4(GfnSdkContext context, const char** clientIp)
 {
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(SetActionZone, type, id, zone);
+    CALL_IN_CONTEXT(context, GfnGetClientIpV4(clientIp));
 }
 
-GfnRuntimeError GfnSendMessage(const char* pchMessage, unsigned int length) {
-    gfnSendMessageFn fnSendMessage = NULL;
-
-    if (g_pCloudLibrary != NULL && g_pCloudLibrary->SendMessage != NULL)                                        \
-    {                                                                       \
-        DELEGATE_TO_CLOUD_LIBRARY(SendMessage, pchMessage, length);              \
-    }
-    else
-    {
-        if (g_gfnSdkModule == NULL)
-        {
-            return gfnAPINotInit;
-        }
-
-        fnSendMessage = (gfnSendMessageFn)gfnGetSymbol(g_gfnSdkModule, "gfnSendMessage");
-
-        if (fnSendMessage == NULL)
-        {
-            return gfnAPINotFound;
-        }
-
-        return fnSendMessage(pchMessage, length);
-    }
+GfnRuntimeError GfnContextGetClientLanguageCode(GfnSdkContext context, const char** languageCode)
+{
+    CALL_IN_CONTEXT(context, GfnGetClientLanguageCode(languageCode));
 }
 
-GfnRuntimeError GfnOpenURLOnClient(const char* pchUrl) {
-    CHECK_CLOUD_ENVIRONMENT();
-    DELEGATE_TO_CLOUD_LIBRARY(OpenURLOnClient, pchUrl);
+GfnRuntimeError GfnContextGetClientCountryCode(GfnSdkContext context, char* countryCode, unsigned int length)
+{
+    CALL_IN_CONTEXT(context, GfnGetClientCountryCode(countryCode, length));
 }
 
-static void GFN_CALLBACK _gfnExitCallbackWrapper(int status, void* pUnused, void* pContext)
+GfnRuntimeError GfnContextGetClientInfo(GfnSdkContext context, GfnClientInfo* clientInfo)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    ExitCallbackSig cb = NULL;
-
-    (void)status;
-    (void)pUnused;
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pContext);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        return;
-    }
-    cb = (ExitCallbackSig)(pWrappedContext->fnCallback);
-    cb(pWrappedContext->pOrigUserContext);
+    CALL_IN_CONTEXT(context, GfnGetClientInfo(clientInfo));
 }
 
-GfnRuntimeError GfnRegisterExitCallback(ExitCallbackSig exitCallback, void* pUserContext)
+GfnRuntimeError GfnContextGetSessionInfo(GfnSdkContext context, GfnSessionInfo* sessionInfo)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-
-    CHECK_NULL_PARAM(exitCallback);
-    CHECK_CLOUD_ENVIRONMENT();
-    
-    GFN_SDK_LOG("Registering for Exit Callback updates");
-
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)exitCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
-
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-    DELEGATE_TO_CLOUD_LIBRARY(RegisterExitCallback, &_gfnExitCallbackWrapper, pWrappedContext);
+    CALL_IN_CONTEXT(context, GfnGetSessionInfo(sessionInfo));
 }
 
-static void GFN_CALLBACK _gfnPauseCallbackWrapper(int status, void* pUnused, void* pContext)
+GfnRuntimeError GfnContextGetPartnerData(GfnSdkContext context, const char** partnerData)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    PauseCallbackSig cb = NULL;
-
-    (void)status;
-    (void)pUnused;
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pContext);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        return;
-    }
-    cb = (PauseCallbackSig)(pWrappedContext->fnCallback);
-    cb(pWrappedContext->pOrigUserContext);
+    CALL_IN_CONTEXT(context, GfnGetPartnerData(partnerData));
 }
 
-GfnRuntimeError GfnRegisterPauseCallback(PauseCallbackSig pauseCallback, void* pUserContext)
+GfnRuntimeError GfnContextGetPartnerSecureData(GfnSdkContext context, const char** partnerSecureData)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    
-    CHECK_NULL_PARAM(pauseCallback);
-    CHECK_CLOUD_ENVIRONMENT();
-    
-    GFN_SDK_LOG("Registering for Pause Callback updates");
-
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)pauseCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
-
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-    DELEGATE_TO_CLOUD_LIBRARY(RegisterPauseCallback, &_gfnPauseCallbackWrapper, pWrappedContext);
+    CALL_IN_CONTEXT(context, GfnGetPartnerSecureData(partnerSecureData));
 }
 
-static void GFN_CALLBACK _gfnInstallCallbackWrapper(int status, void* pTitleInstallationInformation, void* pContext)
+GfnRuntimeError GfnContextIsTitleAvailable(GfnSdkContext context, const char* platformAppId, bool* isAvailable)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    InstallCallbackSig cb = NULL;
-
-    (void)status;
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pContext);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        return;
-    }
-    cb = (InstallCallbackSig)(pWrappedContext->fnCallback);
-    cb((TitleInstallationInformation*)pTitleInstallationInformation, pWrappedContext->pOrigUserContext);
+    CALL_IN_CONTEXT(context, GfnIsTitleAvailable(platformAppId, isAvailable));
 }
 
-GfnRuntimeError GfnRegisterInstallCallback(InstallCallbackSig installCallback, void* pUserContext)
+GfnRuntimeError GfnContextAreTitlesAvailable(GfnSdkContext context, const char** platformAppIds, unsigned int count, bool* isAvailable)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
+    CALL_IN_CONTEXT(context, GfnAreTitlesAvailable(platformAppIds, count, isAvailable));
+}
 
-    CHECK_NULL_PARAM(installCallback);
-    CHECK_CLOUD_ENVIRONMENT();
+GfnRuntimeError GfnContextGetTitlesAvailable(GfnSdkContext context, const char** platformAppIds)
+{
+    CALL_IN_CONTEXT(context, GfnGetTitlesAvailable(platformAppIds));
+}
 
-    GFN_SDK_LOG("Registering for Install Callback updates");
+GfnRuntimeError GfnContextFree(GfnSdkContext context, const char** data)
+{
+    CALL_IN_CONTEXT(context, GfnFree(data));
+}
 
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)installCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
+GfnRuntimeError GfnContextRegisterStreamStatusCallback(GfnSdkContext context, StreamStatusCallbackSig streamStatusCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterStreamStatusCallback(streamStatusCallback, userContext));
+}
 
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-    DELEGATE_TO_CLOUD_LIBRARY(RegisterInstallCallback, &_gfnInstallCallbackWrapper, pWrappedContext);
+GfnRuntimeError GfnContextUnregisterStreamStatusCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterStreamStatusCallback());
 }
 
-static void GFN_CALLBACK _gfnSaveCallbackWrapper(int status, void* pUnused, void* pContext)
+GfnRuntimeError GfnContextStartStream(GfnSdkContext context, StartStreamInput* startStreamInput, StartStreamResponse* response)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    SaveCallbackSig cb = NULL;
+    CALL_IN_CONTEXT(context, GfnStartStream(startStreamInput, response));
+}
 
-    (void)status;
-    (void)pUnused;
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pContext);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        return;
-    }
-    cb = (SaveCallbackSig)(pWrappedContext->fnCallback);
-    cb(pWrappedContext->pOrigUserContext);
+GfnRuntimeError GfnContextStartStreamAsync(GfnSdkContext context, const StartStreamInput* startStreamInput, StartStreamCallbackSig cb, void* userContext, unsigned int timeoutMs)
+{
+    CALL_IN_CONTEXT(context, GfnStartStreamAsync(startStreamInput, cb, userContext, timeoutMs));
 }
 
-GfnRuntimeError GfnRegisterSaveCallback(SaveCallbackSig saveCallback, void* pUserContext)
+GfnRuntimeError GfnContextStopStream(GfnSdkContext context)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
+    CALL_IN_CONTEXT(context, GfnStopStream());
+}
 
-    CHECK_NULL_PARAM(saveCallback);
-    CHECK_CLOUD_ENVIRONMENT();
+GfnRuntimeError GfnContextStopStreamAsync(GfnSdkContext context, StopStreamCallbackSig cb, void* userContext, unsigned int timeoutMs)
+{
+    CALL_IN_CONTEXT(context, GfnStopStreamAsync(cb, userContext, timeoutMs));
+}
 
-    GFN_SDK_LOG("Registering for Save Callback updates");
+GfnRuntimeError GfnContextSetupTitle(GfnSdkContext context, const char* platformAppId)
+{
+    CALL_IN_CONTEXT(context, GfnSetupTitle(platformAppId));
+}
 
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)saveCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
+GfnRuntimeError GfnContextTitleExited(GfnSdkContext context, const char* platformId, const char* platformAppId)
+{
+    CALL_IN_CONTEXT(context, GfnTitleExited(platformId, platformAppId));
+}
 
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-    DELEGATE_TO_CLOUD_LIBRARY(RegisterSaveCallback, &_gfnSaveCallbackWrapper, pWrappedContext);
+GfnRuntimeError GfnContextRegisterExitCallback(GfnSdkContext context, ExitCallbackSig exitCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterExitCallback(exitCallback, userContext));
 }
 
-static void GFN_CALLBACK _gfnSessionInitCallbackWrapper(int status, void* pCString, void* pContext)
+GfnRuntimeError GfnContextUnregisterExitCallback(GfnSdkContext context)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    SessionInitCallbackSig cb = NULL;
+    CALL_IN_CONTEXT(context, GfnUnregisterExitCallback());
+}
 
-    (void)status;
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pContext);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        return;
-    }
-    cb = (SessionInitCallbackSig)(pWrappedContext->fnCallback);
-    cb((const char *)pCString, pWrappedContext->pOrigUserContext);
+GfnRuntimeError GfnContextRegisterPauseCallback(GfnSdkContext context, PauseCallbackSig pauseCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterPauseCallback(pauseCallback, userContext));
 }
 
-GfnRuntimeError GfnRegisterSessionInitCallback(SessionInitCallbackSig sessionInitCallback, void* pUserContext)
+GfnRuntimeError GfnContextUnregisterPauseCallback(GfnSdkContext context)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
+    CALL_IN_CONTEXT(context, GfnUnregisterPauseCallback());
+}
 
-    CHECK_NULL_PARAM(sessionInitCallback);
-    CHECK_CLOUD_ENVIRONMENT();
+GfnRuntimeError GfnContextRegisterInstallCallback(GfnSdkContext context, InstallCallbackSig installCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterInstallCallback(installCallback, userContext));
+}
 
-    GFN_SDK_LOG("Registering for SessionInit Callback updates");
+GfnRuntimeError GfnContextUnregisterInstallCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterInstallCallback());
+}
 
-	pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-    pWrappedContext->fnCallback = (void*)sessionInitCallback;
-    pWrappedContext->pOrigUserContext = pUserContext;
+GfnRuntimeError GfnContextRegisterSaveCallback(GfnSdkContext context, SaveCallbackSig saveCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterSaveCallback(saveCallback, userContext));
+}
 
-    // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-    // cppcheck-suppress memleak
-	DELEGATE_TO_CLOUD_LIBRARY(RegisterSessionInitCallback, &_gfnSessionInitCallbackWrapper, pWrappedContext)
+GfnRuntimeError GfnContextUnregisterSaveCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterSaveCallback());
 }
 
-static void GFN_CALLBACK _gfnMessageCallbackWrapper(int status, void* pMessage, void* pContext)
+GfnRuntimeError GfnContextRegisterSessionInitCallback(GfnSdkContext context, SessionInitCallbackSig sessionInitCallback, void* userContext)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    MessageCallbackSig cb = NULL;
+    CALL_IN_CONTEXT(context, GfnRegisterSessionInitCallback(sessionInitCallback, userContext));
+}
 
-    (void)status;
-    pWrappedContext = (_gfnUserContextCallbackWrapper*)(pContext);
-    if (pWrappedContext == NULL || pWrappedContext->fnCallback == NULL)
-    {
-        return;
-    }
-    cb = (MessageCallbackSig)(pWrappedContext->fnCallback);
-    cb((GfnString*)pMessage, pWrappedContext->pOrigUserContext);
+GfnRuntimeError GfnContextUnregisterSessionInitCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterSessionInitCallback());
 }
 
-GfnRuntimeError GfnRegisterMessageCallback(MessageCallbackSig messageCallback, void* pUserContext)
+GfnRuntimeError GfnContextRegisterMessageCallback(GfnSdkContext context, MessageCallbackSig messageCallback, void* userContext)
 {
-    _gfnUserContextCallbackWrapper* pWrappedContext = NULL;
-    gfnRegisterMessageCallbackFn fnRegisterMessageCallback = NULL;
+    CALL_IN_CONTEXT(context, GfnRegisterMessageCallback(messageCallback, userContext));
+}
 
-    CHECK_NULL_PARAM(messageCallback);
+GfnRuntimeError GfnContextUnregisterMessageCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterMessageCallback());
+}
 
-    if (g_pCloudLibrary != NULL && g_pCloudLibrary->RegisterMessageCallback != NULL)
-    {
-        pWrappedContext = (_gfnUserContextCallbackWrapper*)malloc(sizeof(_gfnUserContextCallbackWrapper));
-        pWrappedContext->fnCallback = (void*)messageCallback;
-        pWrappedContext->pOrigUserContext = pUserContext;
+GfnRuntimeError GfnContextRegisterClientInfoCallback(GfnSdkContext context, ClientInfoCallbackSig clientInfoCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterClientInfoCallback(clientInfoCallback, userContext));
+}
 
-        // Suppress CppCheck warning about memory leak. The cloud DLL takes ownership of the memory and will free on call to gfnShutdownSdk
-        // cppcheck-suppress memleak
-        DELEGATE_TO_CLOUD_LIBRARY(RegisterMessageCallback, &_gfnMessageCallbackWrapper, pWrappedContext);
-    }
-    else
-    {
-        if (g_gfnSdkModule == NULL)
-        {
-            return gfnAPINotInit;
-        }
+GfnRuntimeError GfnContextUnregisterClientInfoCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterClientInfoCallback());
+}
 
-        fnRegisterMessageCallback = (gfnRegisterMessageCallbackFn)gfnGetSymbol(g_gfnSdkModule, "gfnRegisterMessageCallback");
-        if (fnRegisterMessageCallback == NULL)
-        {
-            return gfnAPINotFound;
-        }
+GfnRuntimeError GfnContextRegisterNetworkStatusCallback(GfnSdkContext context, NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterNetworkStatusCallback(networkStatusCallback, updateRateMs, userContext));
+}
 
-        return fnRegisterMessageCallback(messageCallback, pUserContext);
-    }
+GfnRuntimeError GfnContextUnregisterNetworkStatusCallback(GfnSdkContext context)
+{
+    CALL_IN_CONTEXT(context, GfnUnregisterNetworkStatusCallback());
 }
 
+GfnRuntimeError GfnContextRegisterQualityAdviceCallback(GfnSdkContext context, QualityAdviceCallbackSig adviceCallback, void* userContext)
+{
+    CALL_IN_CONTEXT(context, GfnRegisterQualityAdviceCallback(adviceCallback, userContext));
+}
 
-void gfnInitLogging(void)
+GfnRuntimeError GfnContextUnregisterQualityAdviceCallback(GfnSdkContext context)
 {
-#ifdef _WIN32
-    int createDirResult = ERROR_SUCCESS;
+    CALL_IN_CONTEXT(context, GfnUnregisterQualityAdviceCallback());
+}
 
-    wchar_t localAppDataPath[1024] = { L"" };
-    if (SHGetSpecialFolderPathW(NULL, localAppDataPath, CSIDL_COMMON_APPDATA, false) == FALSE)
-    {
-        GFN_SDK_LOG("Could not get path to LOCALAPPDATA: %d", GetLastError());
-        return;
-    }
-    wcscat_s(localAppDataPath, 1024, L"\\NVIDIA Corporation\\GfnRuntimeSdk");
-    createDirResult = SHCreateDirectoryExW(NULL, localAppDataPath, NULL);
-    if (createDirResult != ERROR_SUCCESS && createDirResult != ERROR_FILE_EXISTS && createDirResult != ERROR_ALREADY_EXISTS)
-    {
-        return;
-    }
-    wcscat_s(localAppDataPath, 1024, L"\\GfnRuntimeSdkWrapper.log");
-    _wfopen_s(&s_logfile, localAppDataPath, L"w+");
-#elif __linux__
-    const char* logPath = "~/.nvidia/GfnRuntimeSdk/GfnRuntimeSdkWrapper.log";
-    s_logfile = fopen(logPath, "r");
-#endif
+GfnRuntimeError GfnContextAppReady(GfnSdkContext context, bool success, const char* status)
+{
+    CALL_IN_CONTEXT(context, GfnAppReady(success, status));
 }
 
-void gfnDeinitLogging(void)
+GfnRuntimeError GfnContextSetActionZone(GfnSdkContext context, GfnActionType type, unsigned int id, GfnRect* zone)
 {
-    if (s_logfile)
-    {
-        fclose(s_logfile);
-        s_logfile = NULL;
-    }
+    CALL_IN_CONTEXT(context, GfnSetActionZone(type, id, zone));
 }
 
-void gfnLog(char const* func, int line, char const* format, ...)
+GfnRuntimeError GfnContextSetActionZones(GfnSdkContext context, const GfnActionZone* zones, unsigned int count)
 {
-    time_t t;
-    size_t n = 0;
-    va_list args;
-    va_start(args, format);
+    CALL_IN_CONTEXT(context, GfnSetActionZones(zones, count));
+}
 
-#ifdef _WIN32
-    (void)t;
-    // Format date and time
-    GetLocalTime(&s_logData.timeBuffer);
-    n = sprintf_s(s_logData.buffer, 24, "%04d-%02d-%02dT%02d:%02d:%02d.%03d", s_logData.timeBuffer.wYear, s_logData.timeBuffer.wMonth, s_logData.timeBuffer.wDay,
-        s_logData.timeBuffer.wHour, s_logData.timeBuffer.wMinute, s_logData.timeBuffer.wSecond, s_logData.timeBuffer.wMilliseconds);
+GfnRuntimeError GfnContextSendMessage(GfnSdkContext context, const char* pchMessage, unsigned int length)
+{
+    CALL_IN_CONTEXT(context, GfnSendMessage(pchMessage, length));
+}
 
-    // Format function, line number
-    n += _snprintf_s(s_logData.buffer + n, kGfnLogBufLen - n, kGfnLogBufLen - n, " %24.24s:%-5d", func, line);
+GfnRuntimeError GfnContextOpenURLOnClient(GfnSdkContext context, const char* pchUrl)
+{
+    CALL_IN_CONTEXT(context, GfnOpenURLOnClient(pchUrl));
+}
 
-    // Format the actual message/format
-    n += vsnprintf(s_logData.buffer + n, kGfnLogBufLen - n - 2, format, args); // -1 leave room for linebreak and terminator
-    if (kGfnLogBufLen - 2 < n)  // returns amount it WOULD have written if buffer were big enough
-    {
-        n = kGfnLogBufLen - 2;
-    }
-    _snprintf_s(s_logData.buffer + n, kGfnLogBufLen - n, kGfnLogBufLen - n, "\n"); // Add linebreak at end
-#elif __linux__
-    // Format date and time
-    t = time(NULL);
-    localtime_r(&t, &s_logData.timeBuffer);
-
-    n = snprintf(s_logData.buffer, 24, "%04d-%02d-%02dT%02d:%02d:%02d.%03d",
-                    s_logData.timeBuffer.tm_year + 1900,
-                    s_logData.timeBuffer.tm_mon + 1,
-                    s_logData.timeBuffer.tm_mday,
-                    s_logData.timeBuffer.tm_hour,
-                    s_logData.timeBuffer.tm_min,
-                    s_logData.timeBuffer.tm_sec,
-                    0);
+GfnRuntimeError GfnContextGetSessionSnapshot(GfnSdkContext context, GfnSessionSnapshot* snapshot)
+{
+    CALL_IN_CONTEXT(context, GfnGetSessionSnapshot(snapshot));
+}
 
-    // Format function, line number
-    n += snprintf(s_logData.buffer + n, kGfnLogBufLen - n, " %24.24s:%-5d", func, line);
+GfnRuntimeError GfnContextGetWrapperStats(GfnSdkContext context, GfnWrapperStats* stats)
+{
+    CALL_IN_CONTEXT(context, GfnGetWrapperStats(stats));
+}
 
-    // Format the actual message/format
-    n += vsnprintf(s_logData.buffer + n, kGfnLogBufLen - n - 2, format, args);
-    if (kGfnLogBufLen - 2 < n)  // returns amount it WOULD have written if buffer were big enough
-    {
-        n = kGfnLogBufLen - 2;
-    }
+GfnRuntimeError GfnContextDumpWrapperStatsJson(GfnSdkContext context, char* buffer, size_t bufferSize, size_t* length)
+{
+    CALL_IN_CONTEXT(context, GfnDumpWrapperStatsJson(buffer, bufferSize, length));
+}
 
-    // Add linebreak at end
-    snprintf(s_logData.buffer + n, kGfnLogBufLen - n, "\n");
-#endif
+GfnRuntimeError GfnContextResetWrapperStats(GfnSdkContext context)
+{
+    GfnSdkContext previousContext = t_context;
 
-    if (s_logfile)
-    {
-        fputs(s_logData.buffer, s_logfile);
-        fflush(s_logfile);
-    }
-    else
-    {
-        fputs(s_logData.buffer, stderr);
-        fflush(stderr);
-    }
-    va_end(args);
+    CHECK_NULL_PARAM(context);
+    t_context = context;
+    GfnResetWrapperStats();
+    t_context = previousContext;
+    return gfnSuccess;
 }
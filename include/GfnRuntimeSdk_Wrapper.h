@@ -118,6 +118,12 @@
 ///
 /// Language | API
 /// -------- | -------------------------------------
+/// C        | @ref GfnAreTitlesAvailable
+///
+/// @copydoc GfnAreTitlesAvailable
+///
+/// Language | API
+/// -------- | -------------------------------------
 /// C        | @ref GfnGetTitlesAvailable
 ///
 /// @copydoc GfnGetTitlesAvailable
@@ -236,992 +242,3545 @@
 /// C        | @ref GfnOpenURLOnClient
 ///
 /// @copydoc GfnOpenURLOnClient
-
-#include "GfnRuntimeSdk_CAPI.h"
-
-#include <stddef.h>
-
-#ifdef _WIN32
-    #define CHAR_TYPE wchar_t
-    #ifndef WIN32_LEAN_AND_MEAN
-        #define WIN32_LEAN_AND_MEAN
-    #endif
-    #include <windows.h>
-    /// @brief Global handle to loaded GFN SDK Library module
-    extern HMODULE g_gfnSdkModule;
-#elif __linux__
-    #define CHAR_TYPE char
-#endif
-
-#ifdef __cplusplus
-extern "C"
-{
-#endif
-    /// @defgroup wrapper API Wrapper Methods
-    /// @{
-
-    /// @par Description
-    /// Loads the GFN SDK dynamic library and calls @ref gfnInitializeRuntimeSdk. By default, the function
-    /// expects the library to be in the same folder as the loading process's executable. For
-    /// security reasons, the dynamic library is loaded by fully-quanitified path. If the GFN SDK
-    /// library is packaged in another folder, you will need to locally modify the function to
-    /// reference that location.
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// Call as soon as possible during application startup.
-    ///
-    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
-    ///                                     Defaults to system language if not defined.
-    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available.
-    /// @retval gfnInitSuccessClientOnly  - If the SDK was initialized, but only client-side functionality is available, such as
-    ///                                     calls to gfnStartStream. By definition, gfnIsRunningInCloud is expected to return false
-    ///                                     in this scenario.
-    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
-    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnInitializeSdk(GfnDisplayLanguage language);
-
-    /// @brief Backward compatibility alias for GfnInitializeSdkFromPathA
-    #define GfnInitializeSdkFromPath GfnInitializeSdkFromPathA
-
-    /// @par Description
-    /// Loads the GFN SDK dynamic library from the given path and calls @ref gfnInitializeRuntimeSdk. (UTF-8 / ASCII version)
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// Call as soon as possible during application startup.
-    ///
-    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
-    ///                                     Defaults to system language if not defined.
-    /// @param sdkLibraryPath             - Fully-quantified path to GFN SDK library file including the library filename,
-    ///                                     note that for security reasons, library cannot be renamed to any other string.
-    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available.
-    /// @retval gfnInitSuccessClientOnly  - If the SDK was initialized, but only client-side functionality is available, such as
-    ///                                     calls to gfnStartStream. By definition, gfnIsRunningInCloud is expected to return false
-    ///                                     in this scenario.
-    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
-    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnInitializeSdkFromPathA(GfnDisplayLanguage language, const char* sdkLibraryPath);
-
-    /// @par Description
-    /// Loads the GFN SDK dynamic library from the given path and calls @ref gfnInitializeRuntimeSdk. (Wide char version)
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// Call as soon as possible during application startup.
-    ///
-    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
-    ///                                     Defaults to system language if not defined.
-    /// @param wSdkLibraryPath            - Wide Char string with fully-quantified path to GFN SDK library file including the library
-    ///                                     filename, note that for security reasons, library cannot be renamed to any other string.
-    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available.
-    /// @retval gfnInitSuccessClientOnly  - If the SDK was initialized, but only client-side functionality is available, such as
-    ///                                     calls to gfnStartStream. By definition, gfnIsRunningInCloud is expected to return false
-    ///                                     in this scenario.
-    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
-    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnInitializeSdkFromPathW(GfnDisplayLanguage language, const wchar_t* wSdkLibraryPath);
-
-    ///
-    /// @par Description
-    /// Calls @ref gfnShutdownRuntimeSdk to releases the SDK and resources and disconnects from GFN
-    /// backend and then unloads unloads the GFN SDK Library.
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// Call during application shutdown or when GFN Runtime API methods are no longer needed.
-    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available
-    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnShutdownSdk(void);
-
-    ///
-    /// @par Description
-    /// Calls @ref gfnIsRunningInCloud to determine if calling application is running in GFN environment,
-    /// and without requiring process registration.
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// Use to quickly determine whether to enable / disable any low-value GFN cloud environment
-    /// specific application logic, for example, to block any calls to @ref GfnStartStream() to
-    /// avoid an error, or to know if @ref GfnGetTitlesAvailable can be called without an error.
-    ///
-    /// @warning
-    /// This API is meant to fill the need to quickly determine if the call looks to be in the
-    /// GFN cloud environment. It purposefully trades off resource-intensive checks for fast response.
-    /// Do not tie any logic or features of value to this API as the call stack could be tampered with.
-    /// For that purpose, use @ref GfnIsRunningInCloudSecure.
-    ///
-    /// @param runningInCloud             - Pointer to a boolean that receives true if running in GeForce NOW
-    ///                                     cloud or false if not in the GeForce NOW cloud
-    /// @retval gfnSuccess                - If the query was successful
-    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
-    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
-    ///
-    /// @note
-    /// This function's definition differs from the export that it wraps, as it returns a
-    /// GfnRuntimeError instead of bool.
-    GfnRuntimeError GfnIsRunningInCloud(bool* runningInCloud);
-
-    ///
-    /// @par Description
-    /// Calls @ref gfnIsRunningInCloudSecure to determine if calling application is running in GFN environment,
-    /// and what level of security assurance that the result is valid.
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows
-    ///
-    /// @par Usage
-    /// Call from an NVIDIA-approved process to securely determine whether running in GFN cloud, and use the
-    /// GfnIsRunningInCloudAssurance value to decide the risk to enable any application specific logic
-    /// for that environment.
-    ///
-    /// @warning
-    /// This API must be called from a process that has been registered with NVIDIA, or it will return an error.
-    /// Refer to the Cloud Check API Guide on how to get your application registered. To prevent
-    /// man-in-the-middle (MiM) attacks, you must also securely load the SDK library, checking the integrity
-    /// of the digital signature on the binary. Make sure to use the value returned from GfnIsRunningInCloudAssurance
-    /// to decide if the check was certain enough without tampering to enable the logic or feature associated
-    /// with the API call.
-    ///
-    /// @param assurance                  - Likelihood and level of security assurance defined via @ref GfnIsRunningInCloudAssurance that API is running in GFN cloud environment
-    ///
-    /// @retval gfnSuccess                - If the query was successful.
-    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
-    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnIsRunningInCloudSecure(GfnIsRunningInCloudAssurance* assurance);
-
-    ///
-    /// @par Description
-    /// Determines if calling application is running in GFN environment or not. It also provides a 
-    /// cryptographically signed response if requested, which can be verified either locally or via 3rd party backend.
-    /// Refer to the Cloud Check API Guide on how to validate attestation data in response.
-    ///
-    /// @par Environment
-    /// Cloud and Client
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// This API can be used from any execution context - privileged or not. 
-    ///
-    /// @param challenge                 - Optional input parameter, that can be used to pass in nonce data.
-    ///                                    If a non-null challenge is passed in, then the response parameter is mandatory.
-    /// 
-    /// @param response                  - Optional output parameter, that receives the signed attestation response from the API.
-    /// 
-    /// @param isCloudEnvironment        - Optional output parameter, that receives true value if the caller is in the GFN environment.
-    ///
-    /// @retval gfnSuccess               - On success indicates cloud check was performed successfully.
-    /// @retval gfnInvalidParameter      - NULL pointer passed in response parameter when challenge parameter is nonzero.
-    /// @retval gfnNotAuthorized         - Indicates the application is either not properly onboarded (missing allow - list),
-    ///                                    or the application attempted to perform cloud check in an unsafe environment (patched game seat).
-    /// @retval gfnBackendError          - Indicates the API could not communicate with the GFN backend services to confirm it is running in GFN environment.
-    /// @retval gfnThrottled             - API call was throttled for exceeding limit
-    GfnRuntimeError GfnCloudCheck(const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment);
-
-    ///
-    /// @par Description
-    /// Calls @ref gfnGetClientIp to get user client's IP address.
-    ///
-    /// @par Environment
-    /// Cloud
-    /// 
-    /// @par Platform
-    /// Windows, Linux
-    ///
-    /// @par Usage
-    /// Call this during application start or from the platform client in
-    /// order to get the user's external client IP address.
-    ///
-    /// @param clientIp - Output IPv4 in string format. Example: "192.168.0.1". Call @ref GfnFree to free the memory.
-    ///
-    /// @retval gfnSuccess               - Successfully retrieved client IP
-    /// @retval gfnNoData                - No IP data found
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    /// @note
-    /// To avoid leaking memory, call @ref GfnFree once done with the data.
-    GfnRuntimeError GfnGetClientIpV4(const char** clientIp);
-
-    ///
-    /// @par Description
-    /// Calls @ref gfnGetClientLanguageCode to gets user's client language code in the form
-    /// "<lang>-<country>" using a standard ISO 639-1 language code and ISO 3166-1 Alpha-2 country code.
-    ///
-    /// @par Environment
-    /// Cloud
-    /// 
-    /// @par Platform
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterStreamStatusCallback
+///
+/// @copydoc GfnUnregisterStreamStatusCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterExitCallback
+///
+/// @copydoc GfnUnregisterExitCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterPauseCallback
+///
+/// @copydoc GfnUnregisterPauseCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterInstallCallback
+///
+/// @copydoc GfnUnregisterInstallCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterSaveCallback
+///
+/// @copydoc GfnUnregisterSaveCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterSessionInitCallback
+///
+/// @copydoc GfnUnregisterSessionInitCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterMessageCallback
+///
+/// @copydoc GfnUnregisterMessageCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterClientInfoCallback
+///
+/// @copydoc GfnUnregisterClientInfoCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterNetworkStatusCallback
+///
+/// @copydoc GfnUnregisterNetworkStatusCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetLogMode
+///
+/// @copydoc GfnSetLogMode
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetPersistentLogConfig
+///
+/// @copydoc GfnSetPersistentLogConfig
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetLogStats
+///
+/// @copydoc GfnGetLogStats
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetLogLevel
+///
+/// @copydoc GfnSetLogLevel
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetLogLevel
+///
+/// @copydoc GfnGetLogLevel
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetCallbackDeliveryMode
+///
+/// @copydoc GfnSetCallbackDeliveryMode
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnPumpEvents
+///
+/// @copydoc GfnPumpEvents
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetEventHandle
+///
+/// @copydoc GfnGetEventHandle
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetSessionSnapshot
+///
+/// @copydoc GfnGetSessionSnapshot
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetSessionSnapshotTtl
+///
+/// @copydoc GfnSetSessionSnapshotTtl
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetTitleIndexRefreshInterval
+///
+/// @copydoc GfnSetTitleIndexRefreshInterval
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetRequestSchedulerConfig
+///
+/// @copydoc GfnSetRequestSchedulerConfig
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetRequestSchedulerStats
+///
+/// @copydoc GfnGetRequestSchedulerStats
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnInitializeSdkAsync
+///
+/// @copydoc GfnInitializeSdkAsync
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnWaitForInitialization
+///
+/// @copydoc GfnWaitForInitialization
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnPollInitialization
+///
+/// @copydoc GfnPollInitialization
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnReleaseInitHandle
+///
+/// @copydoc GfnReleaseInitHandle
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetInitTimings
+///
+/// @copydoc GfnGetInitTimings
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetWrapperStats
+///
+/// @copydoc GfnGetWrapperStats
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnDumpWrapperStatsJson
+///
+/// @copydoc GfnDumpWrapperStatsJson
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnResetWrapperStats
+///
+/// @copydoc GfnResetWrapperStats
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetTracingEnabled
+///
+/// @copydoc GfnSetTracingEnabled
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnTraceDump
+///
+/// @copydoc GfnTraceDump
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetActionZones
+///
+/// @copydoc GfnSetActionZones
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnFlushActionZones
+///
+/// @copydoc GfnFlushActionZones
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetActionZoneConfig
+///
+/// @copydoc GfnSetActionZoneConfig
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetActionZoneStats
+///
+/// @copydoc GfnGetActionZoneStats
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetNetworkStats
+///
+/// @copydoc GfnGetNetworkStats
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetNetworkStatsConfig
+///
+/// @copydoc GfnSetNetworkStatsConfig
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnRegisterQualityAdviceCallback
+///
+/// @copydoc GfnRegisterQualityAdviceCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnUnregisterQualityAdviceCallback
+///
+/// @copydoc GfnUnregisterQualityAdviceCallback
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetQualityAdvice
+///
+/// @copydoc GfnGetQualityAdvice
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetQualityAdvisorConfig
+///
+/// @copydoc GfnSetQualityAdvisorConfig
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStartSaveScheduler
+///
+/// @copydoc GfnStartSaveScheduler
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStopSaveScheduler
+///
+/// @copydoc GfnStopSaveScheduler
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetSaveSchedulerStatus
+///
+/// @copydoc GfnGetSaveSchedulerStatus
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetSaveSnapshotConfig
+///
+/// @copydoc GfnSetSaveSnapshotConfig
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnAddSaveRegion
+///
+/// @copydoc GfnAddSaveRegion
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnRemoveSaveRegion
+///
+/// @copydoc GfnRemoveSaveRegion
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnCaptureSaveSnapshot
+///
+/// @copydoc GfnCaptureSaveSnapshot
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnWaitForSaveSnapshot
+///
+/// @copydoc GfnWaitForSaveSnapshot
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetSaveSnapshotStatus
+///
+/// @copydoc GfnGetSaveSnapshotStatus
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnLoadSaveSnapshot
+///
+/// @copydoc GfnLoadSaveSnapshot
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStartPauseController
+///
+/// @copydoc GfnStartPauseController
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStopPauseController
+///
+/// @copydoc GfnStopPauseController
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnSetPaused
+///
+/// @copydoc GfnSetPaused
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnAddPauseResourcePool
+///
+/// @copydoc GfnAddPauseResourcePool
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnRemovePauseResourcePool
+///
+/// @copydoc GfnRemovePauseResourcePool
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnThrottlePausedFrame
+///
+/// @copydoc GfnThrottlePausedFrame
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnParkPausedWorker
+///
+/// @copydoc GfnParkPausedWorker
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetPauseControllerStatus
+///
+/// @copydoc GfnGetPauseControllerStatus
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStartExitOrchestrator
+///
+/// @copydoc GfnStartExitOrchestrator
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStopExitOrchestrator
+///
+/// @copydoc GfnStopExitOrchestrator
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnAddExitTask
+///
+/// @copydoc GfnAddExitTask
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnRemoveExitTask
+///
+/// @copydoc GfnRemoveExitTask
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnRunExitTasks
+///
+/// @copydoc GfnRunExitTasks
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetExitReport
+///
+/// @copydoc GfnGetExitReport
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStartPrefetcher
+///
+/// @copydoc GfnStartPrefetcher
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnStopPrefetcher
+///
+/// @copydoc GfnStopPrefetcher
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnPrefetchTitle
+///
+/// @copydoc GfnPrefetchTitle
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnWaitForPrefetch
+///
+/// @copydoc GfnWaitForPrefetch
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnGetPrefetchStatus
+///
+/// @copydoc GfnGetPrefetchStatus
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnCreateContext
+///
+/// @copydoc GfnCreateContext
+///
+/// Language | API
+/// -------- | -------------------------------------
+/// C        | @ref GfnDestroyContext
+///
+/// @copydoc GfnDestroyContext
+
+#include "GfnRuntimeSdk_CAPI.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+    #define CHAR_TYPE wchar_t
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    /// @brief Global handle to loaded GFN SDK Library module
+    extern HMODULE g_gfnSdkModule;
+#elif __linux__
+    #define CHAR_TYPE char
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    /// @defgroup wrapper API Wrapper Methods
+    /// @{
+
+    /// @par Description
+    /// Loads the GFN SDK dynamic library and calls @ref gfnInitializeRuntimeSdk. By default, the function
+    /// expects the library to be in the same folder as the loading process's executable. For
+    /// security reasons, the dynamic library is loaded by fully-quanitified path. If the GFN SDK
+    /// library is packaged in another folder, you will need to locally modify the function to
+    /// reference that location.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call as soon as possible during application startup.
+    ///
+    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
+    ///                                     Defaults to system language if not defined.
+    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available.
+    /// @retval gfnInitSuccessClientOnly  - If the SDK was initialized, but only client-side functionality is available, such as
+    ///                                     calls to gfnStartStream. By definition, gfnIsRunningInCloud is expected to return false
+    ///                                     in this scenario.
+    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
+    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnInitializeSdk(GfnDisplayLanguage language);
+
+    /// @brief Backward compatibility alias for GfnInitializeSdkFromPathA
+    #define GfnInitializeSdkFromPath GfnInitializeSdkFromPathA
+
+    /// @par Description
+    /// Loads the GFN SDK dynamic library from the given path and calls @ref gfnInitializeRuntimeSdk. (UTF-8 / ASCII version)
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call as soon as possible during application startup.
+    ///
+    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
+    ///                                     Defaults to system language if not defined.
+    /// @param sdkLibraryPath             - Fully-quantified path to GFN SDK library file including the library filename,
+    ///                                     note that for security reasons, library cannot be renamed to any other string.
+    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available.
+    /// @retval gfnInitSuccessClientOnly  - If the SDK was initialized, but only client-side functionality is available, such as
+    ///                                     calls to gfnStartStream. By definition, gfnIsRunningInCloud is expected to return false
+    ///                                     in this scenario.
+    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
+    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnInitializeSdkFromPathA(GfnDisplayLanguage language, const char* sdkLibraryPath);
+
+    /// @par Description
+    /// Loads the GFN SDK dynamic library from the given path and calls @ref gfnInitializeRuntimeSdk. (Wide char version)
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call as soon as possible during application startup.
+    ///
+    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
+    ///                                     Defaults to system language if not defined.
+    /// @param wSdkLibraryPath            - Wide Char string with fully-quantified path to GFN SDK library file including the library
+    ///                                     filename, note that for security reasons, library cannot be renamed to any other string.
+    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available.
+    /// @retval gfnInitSuccessClientOnly  - If the SDK was initialized, but only client-side functionality is available, such as
+    ///                                     calls to gfnStartStream. By definition, gfnIsRunningInCloud is expected to return false
+    ///                                     in this scenario.
+    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
+    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnInitializeSdkFromPathW(GfnDisplayLanguage language, const wchar_t* wSdkLibraryPath);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnShutdownRuntimeSdk to releases the SDK and resources and disconnects from GFN
+    /// backend and then unloads unloads the GFN SDK Library.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call during application shutdown or when GFN Runtime API methods are no longer needed.
+    /// @retval gfnSuccess                - If the SDK was initialized and all SDK features are available
+    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnShutdownSdk(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnIsRunningInCloud to determine if calling application is running in GFN environment,
+    /// and without requiring process registration.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to quickly determine whether to enable / disable any low-value GFN cloud environment
+    /// specific application logic, for example, to block any calls to @ref GfnStartStream() to
+    /// avoid an error, or to know if @ref GfnGetTitlesAvailable can be called without an error.
+    ///
+    /// @warning
+    /// This API is meant to fill the need to quickly determine if the call looks to be in the
+    /// GFN cloud environment. It purposefully trades off resource-intensive checks for fast response.
+    /// Do not tie any logic or features of value to this API as the call stack could be tampered with.
+    /// For that purpose, use @ref GfnIsRunningInCloudSecure.
+    ///
+    /// @param runningInCloud             - Pointer to a boolean that receives true if running in GeForce NOW
+    ///                                     cloud or false if not in the GeForce NOW cloud
+    /// @retval gfnSuccess                - If the query was successful
+    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
+    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
+    ///
+    /// @note
+    /// This function's definition differs from the export that it wraps, as it returns a
+    /// GfnRuntimeError instead of bool.
+    GfnRuntimeError GfnIsRunningInCloud(bool* runningInCloud);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnIsRunningInCloudSecure to determine if calling application is running in GFN environment,
+    /// and what level of security assurance that the result is valid.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows
+    ///
+    /// @par Usage
+    /// Call from an NVIDIA-approved process to securely determine whether running in GFN cloud, and use the
+    /// GfnIsRunningInCloudAssurance value to decide the risk to enable any application specific logic
+    /// for that environment.
+    ///
+    /// @warning
+    /// This API must be called from a process that has been registered with NVIDIA, or it will return an error.
+    /// Refer to the Cloud Check API Guide on how to get your application registered. To prevent
+    /// man-in-the-middle (MiM) attacks, you must also securely load the SDK library, checking the integrity
+    /// of the digital signature on the binary. Make sure to use the value returned from GfnIsRunningInCloudAssurance
+    /// to decide if the check was certain enough without tampering to enable the logic or feature associated
+    /// with the API call.
+    ///
+    /// @param assurance                  - Likelihood and level of security assurance defined via @ref GfnIsRunningInCloudAssurance that API is running in GFN cloud environment
+    ///
+    /// @retval gfnSuccess                - If the query was successful.
+    /// @retval gfnClientLibraryNotFound  - GFN SDK client-side library could not be found
+    /// @retval gfnCloudLibraryNotFound   - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound            - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnIsRunningInCloudSecure(GfnIsRunningInCloudAssurance* assurance);
+
+    ///
+    /// @par Description
+    /// Determines if calling application is running in GFN environment or not. It also provides a 
+    /// cryptographically signed response if requested, which can be verified either locally or via 3rd party backend.
+    /// Refer to the Cloud Check API Guide on how to validate attestation data in response.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// This API can be used from any execution context - privileged or not. 
+    ///
+    /// @param challenge                 - Optional input parameter, that can be used to pass in nonce data.
+    ///                                    If a non-null challenge is passed in, then the response parameter is mandatory.
+    /// 
+    /// @param response                  - Optional output parameter, that receives the signed attestation response from the API.
+    /// 
+    /// @param isCloudEnvironment        - Optional output parameter, that receives true value if the caller is in the GFN environment.
+    ///
+    /// @retval gfnSuccess               - On success indicates cloud check was performed successfully.
+    /// @retval gfnInvalidParameter      - NULL pointer passed in response parameter when challenge parameter is nonzero.
+    /// @retval gfnNotAuthorized         - Indicates the application is either not properly onboarded (missing allow - list),
+    ///                                    or the application attempted to perform cloud check in an unsafe environment (patched game seat).
+    /// @retval gfnBackendError          - Indicates the API could not communicate with the GFN backend services to confirm it is running in GFN environment.
+    /// @retval gfnThrottled             - API call was throttled for exceeding limit
+    GfnRuntimeError GfnCloudCheck(const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnGetClientIp to get user client's IP address.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call this during application start or from the platform client in
+    /// order to get the user's external client IP address.
+    ///
+    /// @param clientIp - Output IPv4 in string format. Example: "192.168.0.1". Call @ref GfnFree to free the memory.
+    ///
+    /// @retval gfnSuccess               - Successfully retrieved client IP
+    /// @retval gfnNoData                - No IP data found
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @note
+    /// To avoid leaking memory, call @ref GfnFree once done with the data.
+    GfnRuntimeError GfnGetClientIpV4(const char** clientIp);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnGetClientLanguageCode to gets user's client language code in the form
+    /// "<lang>-<country>" using a standard ISO 639-1 language code and ISO 3166-1 Alpha-2 country code.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call this during application start or from the platform client in
+    /// order to get the user's language and country settings.
+    ///
+    /// @param languageCode - Language code as a string. Example: "en-US". Call @ref GfnFree to free the memory.
+    ///
+    /// @retval gfnSuccess               - Successfully retrieved language code
+    /// @retval gfnNoData                - No language code found
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @note
+    /// To avoid leaking memory, call @ref GfnFree once done with the data.
+    GfnRuntimeError GfnGetClientLanguageCode(const char** languageCode);
+
+    ///
+    /// @par Description
+    /// Gets user's client country code using ISO 3166-1 Alpha-2 country code.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call this during application start or from the platform client in order to get
+    /// the user's country code.
+    ///
+    /// @param[out] countryCode          - Country code as a 2 character string. Example: “US”
+    /// @param length                    - Length of pchCountryCode character array
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnGetClientCountryCode(char* countryCode, unsigned int length);
+
+    ///
+    /// @par Description
+    /// Gets user's client data.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call this during application start or from the platform client in order to get
+    /// the data on the user's client.
+    ///
+    /// @param[out] clientInfo           - A structure to hold clientInfo data
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @note
+    /// The client data returned by this function is best effort, as not all client devices will report
+    /// all information. For example, certain browser and TV clients will not report client resolution or
+    /// will incorrect resolution in certain situations. In the cases the data is not reported, the data
+    /// returned will be zeroes. Likewise for safezone information, as most clients, such as Windows PC,
+    /// do not have screen areas unsafe for rendering or input. For more information about safe zones,
+    /// see the  the Mobile Integration Guide in the /doc folder.
+    GfnRuntimeError GfnGetClientInfo(GfnClientInfo* clientInfo);
+
+        ///
+        /// @par Description
+        /// Gets various information about the current streaming session
+        ///
+        /// @par Environment
+        /// Cloud
+        /// 
+        /// @par Platform
+        /// Windows, Linux
+        ///
+        /// @par Usage
+        /// Call this from a streaming session to find out more information about the session, such
+        /// as session time remaining, or if RTX is enabled for the current session.
+        ///
+        /// @param sessionInfo               - Pointer to a GfnSessionInfo struct.
+
+        ///
+        /// @retval gfnSuccess               - On success
+        /// @retval gfnInvalidParameter      - NULL pointer passed in or buffer length is too small
+        /// @retval gfnCallWrongEnvironment  - If called in a client environment
+        /// @return Otherwise, appropriate error code
+        /// @note
+        /// If the application has called @ref gfnRegisterSessionInitCallback to be notified when a
+        /// user connects, then this API should be called after that callback is triggered.
+        /// Certain data, such as session time limit or RTX support, can only be defined when a user
+        /// connects as the values depend on the user type. Calling before that point can result in
+        /// obtaining incorrect data.
+        GfnRuntimeError GfnGetSessionInfo(GfnSessionInfo* sessionInfo);
+
+    ///
+    /// @par Description
+    /// Calls @ref GfnGetPartnerData to retrieves non-secure partner data that is either a) passed by the client in the gfnStartStream call
+    /// or b) sent using Deep Link parameter.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use during cloud session to retrieve partner data
+    ///
+    /// @param partnerData              - Populated with the partner data in string form if found
+    ///                                   Call @ref GfnFree to free the memory
+    ///
+    /// @retval gfnSuccess              - Partner data successfully retrieved from session data
+    /// @retval gfnNoData               - No partner data found in session data
+    /// @retval gfnInvalidParameter     - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
+    /// @note
+    /// To avoid leaking memory, call @ref GfnFree once done with the data.
+    GfnRuntimeError GfnGetPartnerData(const char** partnerData);
+
+    ///
+    /// @par Description
+    /// Calls @ref GfnGetPartnerSecureData to retrieves secure partner data that is either a) passed by the client in the gfnStartStream call
+    /// or b) sent in response to Deep Link nonce validation.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use during cloud session to retrieve secure partner data
+    ///
+    /// @param partnerSecureData         - Populated with the secure partner data in string for if found
+    ///                                    Call @ref GfnFree to free the memory
+    ///
+    /// @retval gfnSuccess               - Secure partner data successfully retrieved from session data
+    /// @retval gfnNoData                - No secure partner data found in session data
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @note
+    /// To avoid leaking memory, call @ref GfnFree once done with the data.
+    GfnRuntimeError GfnGetPartnerSecureData(const char** partnerSecureData);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnIsTitleAvailable to determines if a specific title is available to launch
+    /// in current streaming session.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to determine if a title is available to be launched from the active GFN cloud instance,
+    /// for example, to show a "Play" button in a platform launcher's UI.
+    ///
+    /// The wrapper answers from an index of the list returned by @ref GfnGetTitlesAvailable, without
+    /// calling into the SDK library, once the list has been fetched. See
+    /// @ref GfnSetTitleIndexRefreshInterval for how often the list is fetched again.
+    ///
+    /// @param platformAppId             - Identifier of the requested title to check
+    /// @param isAvailable               - Pointer to a boolean that receives true if the title is
+    ///                                    available, or or false if not available.
+    ///
+    /// @retval gfnSuccess               - If the query was successful.
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    ///
+    /// @note
+    /// This function's definition differs from the export that it wraps, as it returns a
+    /// GfnRuntimeError instead of bool.
+    GfnRuntimeError GfnIsTitleAvailable(const char* platformAppId, bool* isAvailable);
+
+    ///
+    /// @par Description
+    /// Determines for each of a set of titles whether it is available to launch in the current
+    /// streaming session.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to check a page of catalog entries at once, for example when a platform launcher renders
+    /// its store. Like @ref GfnIsTitleAvailable, it answers from the wrapper's title index.
+    ///
+    /// @param platformAppIds            - Array of title identifiers to check. NULL entries are
+    ///                                    reported as not available.
+    /// @param count                     - Number of entries in platformAppIds and isAvailable
+    /// @param isAvailable               - Array that receives true for each available title, and
+    ///                                    false otherwise
+    ///
+    /// @retval gfnSuccess               - If the query was successful.
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnAreTitlesAvailable(const char** platformAppIds, unsigned int count, bool* isAvailable);
+
+    ///
+    /// @par Description
+    /// Calls @ref GfnGetTitlesAvailable to retrieves all titles that can be launched in the
+    /// current game streaming session.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to retrieve a list of all titles available to launch in the current streaming session,
+    /// for example, to add "Play" buttons to all titles instead of calling gfnIsTitleAvailable on
+    /// each title.
+    ///
+    /// The list is served from the wrapper's title index when it has one, so the SDK library is not
+    /// called each time.
+    ///
+    /// @param platformAppIds            - Comma-delimited list of platform identifiers. Memory is
+    ///                                    allocated for the list. Call @ref GfnFree to free the memory.
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @retval gfnInternalError         - The copy of the list could not be allocated
+    ///
+    /// @note
+    /// To avoid leaking memory, call @ref GfnFree once done with the title list.
+    GfnRuntimeError GfnGetTitlesAvailable(const char** platformAppIds);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnFree to free memory allocated by @ref GfnGetTitlesAvailable
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to release memory after a call to a memory-allocated function and you are finished with the data.
+    /// Should only be called if the memory is populated with valid data. Calling @ref GfnFree with invalid
+    /// pointer or data will result in an memory exception being thrown.
+    ///
+    /// Strings from @ref GfnGetTitlesAvailable, @ref GfnGetPartnerData and @ref GfnGetPartnerSecureData
+    /// are allocated by the wrapper and must be released with @ref GfnFree, never with free or the SDK
+    /// library's own gfnFree. Each string must be released exactly once. The wrapper tracks a limited
+    /// number of its strings at a time, so a call that returns one fails with @ref gfnInternalError
+    /// while too many earlier ones have not been released.
+    ///
+    /// @param data                      - Pointer to allocated string memory
+    ///
+    /// @retval gfnSuccess               - Memory successfully released
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    GfnRuntimeError GfnFree(const char** data);
+
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterStreamStatusCallback to register a callback that gets called on the
+    /// user's PC when the streaming session state changes.
+    ///
+    /// @par Environment
+    /// Client
+    /// 
+    /// @par Platform
+    /// Windows
+    ///
+    /// @par Usage
+    /// Register a function to call when stream status changes on the user's client PC
+    ///
+    /// @param streamStatusCallback      - Function pointer to application code to call after
+    ///                                    the GeForce NOW streamer changes state
+    /// @param userContext               - Pointer to user context, which will be passed unmodified to the
+    ///                                    registered callback. Can be NULL
+    ///
+    /// @retval gfnSuccess               - On success, when running on the client PC
+    /// @retval gfnCallWrongEnvironment  - If callback could not be registered since this function
+    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnRegisterStreamStatusCallback(StreamStatusCallbackSig streamStatusCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the stream status callback registered with @ref GfnRegisterStreamStatusCallback.
+    ///
+    /// @par Environment
+    /// Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterStreamStatusCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnStartStream to request GFN client to start a streaming session of an application
+    /// in a synchronous (blocking) fashion.
+    ///
+    /// @par Environment
+    /// Client
+    /// 
+    /// @par Platform
+    /// Windows
+    ///
+    /// @par Usage
+    /// Use to start a streaming session.
+    ///
+    /// @param startStreamInput         - Pointer to a StartStreamInput structure.
+    /// @param response                 - Start streaming response.
+    ///
+    /// @retval gfnSuccess              - On success
+    /// @retval gfnInvalidParameter     - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment - If called in a cloud environment
+    /// @retval gfnStreamFailure        - Network failure or other error prevented the stream from starting
+    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found.
+    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnStartStream(StartStreamInput* startStreamInput, StartStreamResponse* response);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnStartStreamAsync to request GFN client to start a streaming session of an
+    /// application in an asynchronous fashion.
+    ///
+    /// @par Environment
+    /// Client
+    /// 
+    /// @par Platform
+    /// Windows
+    ///
+    /// @par Usage
+    /// Use to start a streaming session.
+    ///
+    /// @param startStreamInput          - Pointer to a StartStreamInput structure.
+    /// @param cb                        - A StartStreamCallbackSig callback to be called with streaming events.
+    /// @param context                   - User context
+    /// @param timeoutMs                 - Time after which attempt to start streaming will be aborted.
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a cloud environment
+    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    ///
+    /// @note
+    /// This function's definition differs from the export that it wraps, as it returns a
+    /// GfnRuntimeError instead of being void for consistent error reporting.
+    GfnRuntimeError GfnStartStreamAsync(const StartStreamInput* startStreamInput, StartStreamCallbackSig cb, void* context, unsigned int timeoutMs);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnStopStream to request GFN client to stop a streaming session of an application
+    /// in a synchronous (blocking) fashion.
+    ///
+    /// @par Environment
+    /// Client
+    /// 
+    /// @par Platform
+    /// Windows
+    ///
+    /// @par Usage
+    /// Use to stop a streaming session started by the same process
+    ///
+    /// @retval gfnSuccess              - On success
+    /// @retval gfnCallWrongEnvironment - If called in a cloud environment
+    /// @retval gfnStreamStopFailure    - Failure to stop the streaming session
+    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found
+    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnStopStream(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnStopStreamAsync to request GFN client to stop a streaming session of an
+    /// application in an asynchronous fashion.
+    ///
+    /// @par Environment
+    /// Client
+    /// 
+    /// @par Platform
+    /// Windows
+    ///
+    /// @par Usage
+    /// Use to start a streaming session.
+    ///
+    /// @param cb                        - A StartStreamCallbackSig callback to be called with streaming events.
+    /// @param context                   - User context
+    /// @param timeoutMs                 - Time after which attempt to start streaming will be aborted.
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnStreamStopFailure     - Failure to stop the streaming session
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a cloud environment
+    /// @retval gfnClientLibraryNotFound - GFN SDK client-side Library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    ///
+    /// @note
+    /// This function's definition differs from the export that it wraps, as it returns a
+    /// GfnRuntimeError instead of being void for consistent error reporting.
+    GfnRuntimeError GfnStopStreamAsync(StopStreamCallbackSig cb, void* context, unsigned int timeoutMs);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnSetupTitle to notify GeForce NOW that an application should be readied for launch.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to prepare an application for launch on GeForce NOW, and block on the result.
+    ///
+    /// @param platformAppId             - Identifier of the requested application to setup
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnSetupTitleFailure     - The GeForce NOW SDK failed to set up the title
+    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnSetupTitle(const char* platformAppId);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnTitleExited to notify GFN that an application has exited.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to notify GFN that your application has exited.
+    ///
+    /// @param platformId                - Identifier of the launcher service, e.g. "Steam"
+    /// @param platformAppId             - Identifier of the application that has exited.
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnInvalidParameter      - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnCloudLibraryNotFound  - GeForce NOW SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound           - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnTitleExited(const char* platformId, const char* platformAppId);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterExitCallback to register an application function that is called when
+    /// the user has requested to end the GeForce NOW session.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Register an application function that is called when GeForce NOW will end the current session.
+    /// Note: This callback function allows an application to respond to a user's request to end a session,
+    /// for example, to perform a clean exit of the application. The application is given 5 seconds to 
+    /// perform activities and return from the callback function before session shutdown activities continue.
+    ///
+    /// @param exitCallback             - Function pointer to application code to call when GeForce NOW
+    ///                                   will begin to shut down the current session.
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   registered callback. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success, when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - If exitCallback function pointer is NULL
+    /// @retval gfnCallWrongEnvironment - If callback could not be registered since this function
+    ///                                   was called outside of a cloud execution environment
+    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnRegisterExitCallback(ExitCallbackSig exitCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the exit callback registered with @ref GfnRegisterExitCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterExitCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterPauseCallback to register an application callback with GeForce NOW
+    /// to be called when GeForce NOW needs to pause the game on the user's behalf.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Register an application function to call when GeForce NOW needs to pause the game.
+    /// Note: Callback should return as soon as the game process is paused. 
+    /// Resuming should occur when the user interacts with the game UI.
+    ///
+    /// @param pauseCallback            - Function pointer to application code to call when
+    ///                                   GeForce NOW needs to pause the game
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   registered callback. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success, when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - If pauseCallback function pointer is NULL
+    /// @retval gfnCallWrongEnvironment - If callback could not be registered since this function
+    ///                                   was called outside of a cloud execution environment
+    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnRegisterPauseCallback(PauseCallbackSig pauseCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the pause callback registered with @ref GfnRegisterPauseCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterPauseCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterInstallCallback to register an application callback with GeForce NOW
+    /// to be called after a successful call to @ref gfnSetupTitle.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Register a function to call after a successful call to gfnSetupTitle.
+    ///
+    /// @param installCallback          - Function pointer to application code to call after
+    ///                                   GeForce NOW successfully performs its own title setup.
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   registered callback. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success, when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - If installCallback function pointer is NULL
+    /// @retval gfnCallWrongEnvironment - If callback could not be registered since this function
+    ///                                   was called outside of a cloud execution environment
+    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
+    GfnRuntimeError GfnRegisterInstallCallback(InstallCallbackSig installCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the install callback registered with @ref GfnRegisterInstallCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterInstallCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterSaveCallback to register an application callback with GeForce NOW to be
+    /// called when GeForce NOW needs the application to save user progress.
+    ///
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Register an application function to call when GeForce NOW needs the application to save game or user data.
+    /// The callback function should trigger the save of game state and return when completed.
+    ///
+    /// @param saveCallback             - Function pointer to application code to call when GFN needs the application to save
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   callback specified. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
+    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnRegisterSaveCallback(SaveCallbackSig saveCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the save callback registered with @ref GfnRegisterSaveCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterSaveCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterSessionInitCallback to register an application callback with GeForce NOW to be called when
+    /// a GeForce NOW user has connected to the game seat to start a streaming session. This callback is used as part of
+    /// the Pre-warm feature. 
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Register an application function to call when a GeForce NOW user has connected to the game seat to allow the game to load
+    /// user-specific data and start game play for the user. Callback should return once loading is complete and user
+    /// can interact with the game.
+    /// Note: The callback function is given 30 second to complete and call @ref GfnAppReady. If this time elapses, before the 
+    /// function is called, the session will begin streaming frames to the user even if the game is still loading user data.
+    ///
+    /// @param sessionInitCallback      - Function pointer to application code to call when the user has connected
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   callback specified. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - Callback was NULL
+    /// @retval gfnAPINotInit           - SDK was not initialized
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    /// @retval gfnCallWrongEnvironment - The on-seat dll detected that it was not on a game seat
+    GfnRuntimeError GfnRegisterSessionInitCallback(SessionInitCallbackSig sessionInitCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the session init callback registered with @ref GfnRegisterSessionInitCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterSessionInitCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref gfnRegisterMessageCallback to register an application callback with GeForce NOW to be called when a message
+    /// is sent to the application via the SendMessage feature as part of GeForce NOW's support for two-way communication 
+    /// between client application and the game application running in the game seat.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Provide a callback function that will be called when a message is sent to the application from the SendMessage feature.
+    ///
+    /// @param messageCallback          - Function pointer to application code to call when a message has been sent.
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   callback specified. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - Callback was NULL
+    /// @retval gfnAPINotInit           - SDK was not initialized
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    /// @retval gfnCallWrongEnvironment - The on-seat dll detected that it was not on a game seat
+    GfnRuntimeError GfnRegisterMessageCallback(MessageCallbackSig messageCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the message callback registered with @ref GfnRegisterMessageCallback.
+    ///
+    /// @par Environment
+    /// Cloud or Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterMessageCallback(void);
+
+
+    ///
+    /// @par Description
+    /// Registers an application callback with GeForce NOW to be called when client info changes
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param clientInfoCallback       - Function pointer to application code to call when GeForce NOW client data changes
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   callback specified. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - Callback was NULL
+    /// @retval gfnAPINotInit           - SDK was not initialized
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnRegisterClientInfoCallback(ClientInfoCallbackSig clientInfoCallback, void* userContext);
+
+    /// @par Description
+    /// Removes the client info callback registered with @ref GfnRegisterClientInfoCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterClientInfoCallback(void);
+
+    ///
+    /// @par Description
+    /// Registers an application callback with GeForce NOW to be called when network latency changes
+    ///
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param networkStatusCallback    - Function pointer to application code to call when network latency changes
+    /// @param updateRateMs             - Time interval for updates
+    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
+    ///                                   callback specified. Can be NULL.
+    ///
+    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
+    /// @retval gfnInvalidParameter     - Callback was NULL
+    /// @retval gfnAPINotInit           - SDK was not initialized
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnRegisterNetworkStatusCallback(NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* userContext);
+
+    /// @par Description
+    /// Removes the network status callback registered with @ref GfnRegisterNetworkStatusCallback.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Once this returns, the callback is not running on another thread and will not be called again,
+    /// so its user context can be released. Registering a callback again afterwards does not allocate.
+    ///
+    /// @retval gfnSuccess              - On success, including when no callback was registered
+    GfnRuntimeError GfnUnregisterNetworkStatusCallback(void);
+
+    ///
+    /// @par Description
+    /// Calls @ref GfnAppReady to notify GeForce NOW that an application is ready to be displayed to the GeForce NOW user.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to notify GFN that your application is ready to be streamed.
+    ///
+    /// @param success                - True if startup was successful
+    /// @param status                 - Optional startup status
+    ///
+    /// @retval gfnSuccess               - On success
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnAPINotInit            - SDK was not initialized
+    /// @retval gfnAPINotFound           - The API was not found in the GeForce NOW SDK Library
+    GfnRuntimeError GfnAppReady(bool success, const char * status);
+
+    ///
+    /// @par Description
+    /// Sends Active zone coordinates to GFN Client
+    ///
+    /// TO BE DEPRECATED SOON
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to invoke special events on the client from the GFN cloud environment
+    /// Note : Marked for deprecation
+    ///
+    /// @param type                 - Populated with relevant GfnActionType
+    /// @param id                   - unique unsigned int type identifier for this event
+    /// @param zone                 - Optional zone coordinates relevant to type specified
+    ///
+    /// @retval gfnSuccess              - Call was successful
+    /// @retval gfnInputExpected        - Expected zone to have a value
+    /// @retval gfnComError             - There was SDK internal communication error
+    /// @retval gfnCallWrongEnvironment  - If called in a client environment
+    /// @retval gfnAPINotInit            - SDK was not initialized
+    /// @retval gfnAPINotFound           - The API was not found in the GeForce NOW SDK Library
+    /// @retval gfnInvalidParameter     - Invalid parameters provided
+    /// @retval gfnThrottled            - API call was throttled for exceeding limit
+    /// @retval gfnUnhandledException   - API ran into an unhandled error and caught an exception before it returned to client code
+    /// @return Otherwise, appropriate error code
+    ///
+    /// @note
+    /// Every call reaches the SDK library. The wrapper records the zone, so a later
+    /// @ref GfnSetActionZones only calls the SDK library for the zones that differ from it.
+    GfnRuntimeError GfnSetActionZone(GfnActionType type, unsigned int id, GfnRect* zone);
+
+
+    ///
+    /// @par Description
+    /// Sends a custom message communication from the app to the client. This message
+    /// is "fire-and-forget", and does not wait for the message to be delivered to return status.
+    /// Latency is best effort and not guaranteed.
+    ///
+    /// @par Environment
+    /// Cloud or Client
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to communicate between cloud applications and streaming clients.
+    ///
+    /// @param pchMessage - Character string
+    /// @param length     - Length of pchMessage in characters, which cannot exceed 8K in length
+    ///
+    /// @retval gfnSuccess              - Call was successful
+    /// @retval gfnComError             - There was SDK internal communication error
+    /// @retval gfnAPINotInit           - SDK was not initialized
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    /// @retval gfnInvalidParameter     - Invalid parameters provided, or message exceeded allowed length
+    /// @retval gfnThrottled            - API call was throttled for exceeding limit of 30 messages per second
+    /// @retval gfnUnhandledException   - API ran into an unhandled error and caught an exception before it returned to client code
+    /// @retval gfnCloudLibraryNotFound - GFN SDK cloud-side library could not be found
+    /// @return Otherwise, appropriate error code
+    GfnRuntimeError GfnSendMessage(const char* pchMessage, unsigned int length);
+    ///
+    /// @par Description
+    /// Requests the client application to open a URL in their local web browser.
+    /// 
+    /// These requests are fire-and-forget. Typically, the client will see a popup during their streaming session with a link that
+    /// they can click to open the local web browser.
+    /// 
+    /// Usage of this API is limited to  5 URL requests every second, with no more than 25 URL requests per minute.
+    ///
+    /// @par Environment
+    /// Cloud
+    /// 
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Use to request that the client application open a URL link in their local web browser.
+    ///
+    /// @param pchUrl - A URL which should be opened on the client's local browser.
+    ///
+    /// @retval gfnSuccess              - Call was successful
+    /// @retval gfnAPINotInit           - SDK was not initialized
+    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
+    /// @retval gfnCallWrongEnvironment - API was called outside of a cloud execution environment
+    /// @retval gfnInvalidParameter     - Invalid pointer provided, or message exceeded allowed length
+    /// @retval gfnThrottled            - API call was throttled for exceeding limit of 5 messages per second or 25 total per session
+    /// @retval gfnInternalError        - API ran into an internal error
+    /// @return Otherwise, appropriate error code
+    GfnRuntimeError GfnOpenURLOnClient(const char* pchUrl);
+
+    /// @brief How the wrapper writes its log lines
+    typedef enum GfnLogMode
+    {
+        gfnLogModeSynchronous = 0,  ///< Each line is written and flushed by the calling thread
+        gfnLogModeAsynchronous = 1, ///< Lines are queued and written in batches by a background thread
+        gfnLogModePersistent = 2    ///< Lines are stored as binary records in a memory-mapped file that survives a crash
+    } GfnLogMode;
+
+    /// @brief What an asynchronous log call does when the log queue is full
+    typedef enum GfnLogOverflowPolicy
+    {
+        gfnLogOverflowDrop = 0,     ///< Drop the line and count it in @ref GfnLogStats::linesDropped
+        gfnLogOverflowBlock = 1     ///< Wait for the background thread to make room
+    } GfnLogOverflowPolicy;
+
+    /// @brief Wrapper logging counters
+    typedef struct GfnLogStats
+    {
+        uint64_t linesWritten;      ///< Lines written to the log
+        uint64_t linesDropped;      ///< Lines dropped because the log queue was full
+    } GfnLogStats;
+
+    /// @par Description
+    /// Selects how the wrapper writes its log. In asynchronous mode, the calling thread only formats
+    /// the line and queues it; a background thread writes queued lines to disk in batches. Lines
+    /// longer than 512 characters are truncated in asynchronous mode. Queued lines are always written
+    /// out before @ref GfnShutdownSdk returns, or when switching back to synchronous mode.
+    ///
+    /// In persistent mode, the calling thread stores the arguments of each line as a fixed-size binary
+    /// record in a ring mapped from a file, without formatting the line or making a system call. The
+    /// records reach the file even if the process crashes; the tools/LogDecoder tool renders them as
+    /// text. Each initialization starts a new file and keeps the previous one with a .prev suffix. See
+    /// @ref GfnSetPersistentLogConfig for the file location and size. If the file cannot be mapped,
+    /// lines are written to the text log as in synchronous mode.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call before @ref GfnInitializeSdk to have initialization logged asynchronously, or at any
+    /// time afterwards. Defaults to synchronous mode. The mode can also be set with the GFN_SDK_LOG_MODE
+    /// environment variable, which takes a mode name (synchronous, asynchronous, persistent) or its
+    /// numeric value and is read during @ref GfnInitializeSdk. A mode set with this API takes precedence
+    /// over the environment variable.
+    ///
+    /// @param mode                       - Synchronous, asynchronous or persistent logging
+    /// @param overflowPolicy             - Behavior of asynchronous logging when the log queue is full
+    /// @retval gfnSuccess                - The log mode was applied
+    /// @retval gfnInvalidParameter       - Unknown mode or overflow policy
+    GfnRuntimeError GfnSetLogMode(GfnLogMode mode, GfnLogOverflowPolicy overflowPolicy);
+
+    /// @par Description
+    /// Sets the file and size of the log written in @ref gfnLogModePersistent. By default, the file is
+    /// GfnRuntimeSdkWrapper.logring next to the wrapper's text log, in
+    /// %ProgramData%\\NVIDIA Corporation\\GfnRuntimeSdk on Windows and ~/.nvidia/GfnRuntimeSdk on Linux,
+    /// and holds 4096 KB of records, the most recent 32768 lines.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call before selecting persistent mode with @ref GfnSetLogMode. A persistent log that is already
+    /// being written is restarted with the new configuration.
+    ///
+    /// @param path                       - Path of the log file, or NULL for the default path
+    /// @param sizeKb                     - Size of the record ring in KB, from 64 to 1048576, rounded down
+    ///                                     to a power of two. 0 selects the default size.
+    /// @retval gfnSuccess                - The configuration was applied
+    /// @retval gfnInvalidParameter       - Path too long, or size out of range
+    GfnRuntimeError GfnSetPersistentLogConfig(const CHAR_TYPE* path, unsigned int sizeKb);
+
+    /// @par Description
+    /// Retrieves the number of lines the wrapper has written to and dropped from its log.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param stats                      - Pointer to a structure that receives the counters
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetLogStats(GfnLogStats* stats);
+
+    /// @brief Severity of a wrapper log line. The numeric values are also used by the
+    /// GFN_SDK_LOG_MIN_LEVEL compile definition, which removes less severe lines from the build.
+    typedef enum GfnLogLevel
+    {
+        gfnLogLevelTrace = 0,       ///< Per-call and per-callback detail
+        gfnLogLevelDebug = 1,       ///< Results of individual API calls
+        gfnLogLevelInfo = 2,        ///< Lifecycle events such as initialization and callback registration
+        gfnLogLevelWarning = 3,     ///< Calls that failed because of how or where they were made
+        gfnLogLevelError = 4,       ///< Failures to load or initialize the SDK libraries
+        gfnLogLevelNone = 5         ///< Logging disabled
+    } GfnLogLevel;
+
+    /// @par Description
+    /// Sets the least severe level of line the wrapper writes to its log. Each logging call site is
+    /// additionally rate limited; when lines are dropped by the rate limit, the next line written
+    /// from that call site reports how many were suppressed.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Defaults to @ref gfnLogLevelInfo. The level can also be set with the GFN_SDK_LOG_LEVEL
+    /// environment variable, which takes a level name (trace, debug, info, warning, error, none) or its
+    /// numeric value and is read during @ref GfnInitializeSdk. A level set with this API takes precedence
+    /// over the environment variable.
+    ///
+    /// @param level                      - Least severe level to log
+    /// @retval gfnSuccess                - The level was applied
+    /// @retval gfnInvalidParameter       - Unknown level
+    GfnRuntimeError GfnSetLogLevel(GfnLogLevel level);
+
+    /// @par Description
+    /// Retrieves the least severe level of line the wrapper currently writes to its log.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param level                      - Pointer that receives the current level
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetLogLevel(GfnLogLevel* level);
+
+    /// @brief Thread on which ClientInfo, NetworkStatus, StreamStatus and Message callbacks run
+    typedef enum GfnCallbackDeliveryMode
+    {
+        gfnCallbackDeliveryImmediate = 0,   ///< Callbacks run on the SDK library's thread as soon as the event arrives
+        gfnCallbackDeliveryQueued = 1       ///< Events are queued and callbacks run from @ref GfnPumpEvents
+    } GfnCallbackDeliveryMode;
+
+    /// @brief Waitable handle that is signaled while queued events are waiting for @ref GfnPumpEvents
+#ifdef _WIN32
+    typedef HANDLE GfnEventHandle;
+#else
+    typedef int GfnEventHandle;
+#endif
+
+    /// @par Description
+    /// Selects whether ClientInfo, NetworkStatus, StreamStatus, Message and quality advice callbacks run
+    /// immediately on the SDK library's thread, or are queued for the application to deliver on its own
+    /// thread with @ref GfnPumpEvents.
+    ///
+    /// In queued mode, ClientInfo and NetworkStatus updates are coalesced per update type, as is quality
+    /// advice: if several updates of the same type arrive between two pumps, only the newest is
+    /// delivered. StreamStatus
+    /// transitions and messages are each delivered, in the order they arrived. Up to 256 of them can be
+    /// waiting; further ones are dropped and logged. The SDK library's StreamStatus and Message callbacks
+    /// are answered with @ref crCallbackSuccess when the event is queued.
+    ///
+    /// Exit, Pause, Install, Save and SessionInit callbacks are always delivered immediately, since the
+    /// SDK waits for them to complete.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call before registering callbacks. Defaults to @ref gfnCallbackDeliveryImmediate. Events already
+    /// queued when switching back to immediate mode are still delivered by the next @ref GfnPumpEvents.
+    ///
+    /// @param mode                       - Immediate or queued delivery
+    /// @retval gfnSuccess                - The mode was applied
+    /// @retval gfnInvalidParameter       - Unknown mode
+    GfnRuntimeError GfnSetCallbackDeliveryMode(GfnCallbackDeliveryMode mode);
+
+    /// @par Description
+    /// Runs the registered callbacks for queued events on the calling thread. Coalesced ClientInfo and
+    /// NetworkStatus updates are delivered first, followed by StreamStatus transitions and messages in
+    /// arrival order.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Call once per frame, or whenever the handle from @ref GfnGetEventHandle is signaled, while in
+    /// @ref gfnCallbackDeliveryQueued mode. Must not be called from inside a callback.
+    ///
+    /// @param maxEvents                  - Most events to deliver in this call, or 0 for no limit
+    /// @param budgetUs                   - Stop once this many microseconds have been spent delivering
+    ///                                     events, or 0 for no limit. The event being delivered when the
+    ///                                     budget runs out is always completed.
+    /// @param eventsDelivered            - Optional pointer that receives the number of events delivered
+    /// @retval gfnSuccess                - On success, including when no events were queued
+    /// @retval gfnCallWrongEnvironment   - Called from inside a callback
+    GfnRuntimeError GfnPumpEvents(unsigned int maxEvents, unsigned int budgetUs, unsigned int* eventsDelivered);
+
+    /// @par Description
+    /// Retrieves a handle that is signaled while queued events are waiting for @ref GfnPumpEvents, so an
+    /// event loop can wait on it instead of polling. On Windows it is a manual-reset event object for
+    /// WaitForMultipleObjects; on Linux it is a non-blocking eventfd that becomes readable, for use with
+    /// poll or epoll. @ref GfnPumpEvents resets it.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// The handle is owned by the wrapper and stays valid for the life of the process, across
+    /// @ref GfnShutdownSdk and a new initialization, so it can stay in the application's wait set; do
+    /// not close it or read from it. Shutting down discards the queued events and leaves it unsignaled.
+    ///
+    /// @param eventHandle                - Pointer that receives the handle
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnInternalError          - The handle could not be created
+    GfnRuntimeError GfnGetEventHandle(GfnEventHandle* eventHandle);
+
+    #define GFN_SESSION_SNAPSHOT_LANGUAGE_CODE_SIZE (16)    ///< Buffer size for @ref GfnSessionSnapshot::languageCode
+    #define GFN_SESSION_SNAPSHOT_PARTNER_DATA_SIZE  (4096)  ///< Buffer size for @ref GfnSessionSnapshot::partnerData
+
+    /// @brief Client and session data gathered in one call by @ref GfnGetSessionSnapshot. Each part carries
+    /// the status the corresponding API returned; the part's data is only meaningful when that status is
+    /// successful.
+    typedef struct GfnSessionSnapshot
+    {
+        GfnRuntimeError clientInfoStatus;       ///< Result of @ref GfnGetClientInfo
+        GfnClientInfo clientInfo;               ///< Client data
+        GfnRuntimeError sessionInfoStatus;      ///< Result of @ref GfnGetSessionInfo
+        GfnSessionInfo sessionInfo;             ///< Session data
+        GfnRuntimeError languageCodeStatus;     ///< Result of @ref GfnGetClientLanguageCode
+        char languageCode[GFN_SESSION_SNAPSHOT_LANGUAGE_CODE_SIZE]; ///< Client language code, example - "en-US"
+        GfnRuntimeError countryCodeStatus;      ///< Result of @ref GfnGetClientCountryCode
+        char countryCode[CC_SIZE];              ///< Client country code, example - "US"
+        GfnRuntimeError partnerDataStatus;      ///< Result of @ref GfnGetPartnerData
+        unsigned int partnerDataLength;         ///< Full length of the partner data. If it is not less than
+                                                ///< GFN_SESSION_SNAPSHOT_PARTNER_DATA_SIZE, partnerData was
+                                                ///< truncated; call @ref GfnGetPartnerData for all of it.
+        char partnerData[GFN_SESSION_SNAPSHOT_PARTNER_DATA_SIZE]; ///< Non-secure partner data, NULL terminated
+        unsigned int ageMs;                     ///< Time since the snapshot was fetched from the SDK library
+    } GfnSessionSnapshot;
+
+    /// @par Description
+    /// Retrieves client info, session info, the client's language and country codes and the partner data
+    /// in a single call. The wrapper caches the result and serves copies of it until its time to live
+    /// expires or a ClientInfo or NetworkStatus update arrives, so repeated calls within that window do not
+    /// call into the SDK library. If a part of the refresh is throttled, that part keeps its previous value.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Can be called every frame, from any thread. Reads never wait: while one thread is refreshing the
+    /// snapshot, other threads receive the previous one. Only the first call of a session waits for the
+    /// data to be fetched.
+    ///
+    /// @param[out] snapshot              - Structure that receives the snapshot
+    /// @retval gfnSuccess                - At least one part of the snapshot was retrieved. Check the
+    ///                                     status of each part.
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @return Otherwise, the error from @ref GfnGetClientInfo when no part could be retrieved
+    GfnRuntimeError GfnGetSessionSnapshot(GfnSessionSnapshot* snapshot);
+
+    /// @par Description
+    /// Sets how long @ref GfnGetSessionSnapshot serves the cached snapshot before fetching it again, and
+    /// discards the current one.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Defaults to 1000 milliseconds. A time to live of 0 fetches the snapshot on every call.
+    ///
+    /// @param ttlMs                      - Time to live of the cached snapshot, in milliseconds
+    /// @retval gfnSuccess                - Always
+    GfnRuntimeError GfnSetSessionSnapshotTtl(unsigned int ttlMs);
+
+    /// @par Description
+    /// Sets how often the wrapper fetches the list of available titles again for the index that
+    /// answers @ref GfnIsTitleAvailable, @ref GfnAreTitlesAvailable and @ref GfnGetTitlesAvailable,
+    /// and discards the current list.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Defaults to 60000 milliseconds. The list is also fetched again when a SessionInit or Install
+    /// callback arrives; Install callbacks are only received while an Install callback is registered.
+    /// A fetch that returns the same list keeps the current index. While one thread fetches the list,
+    /// other threads keep using the previous index. An interval of 0 disables the index, so every call
+    /// goes to the SDK library.
+    ///
+    /// @param intervalMs                 - Time between fetches of the title list, in milliseconds
+    /// @retval gfnSuccess                - Always
+    GfnRuntimeError GfnSetTitleIndexRefreshInterval(unsigned int intervalMs);
+
+    /// @brief Requests that the wrapper schedules to stay within the SDK's throttling limits
+    typedef enum GfnScheduledRequest
+    {
+        gfnScheduledCloudCheck = 0,         ///< @ref GfnCloudCheck
+        gfnScheduledPartnerData = 1,        ///< @ref GfnGetPartnerData, also used by @ref GfnGetSessionSnapshot
+        gfnScheduledPartnerSecureData = 2,  ///< @ref GfnGetPartnerSecureData
+        gfnScheduledRequestCount            ///< Sentinel value, do not use
+    } GfnScheduledRequest;
+
+    /// @brief Rate limit and retry policy of a scheduled request
+    typedef struct GfnRequestSchedulerConfig
+    {
+        unsigned int burst;                 ///< Calls allowed at once before the rate limit applies, or 0 for no rate limit
+        unsigned int refillMs;              ///< Interval at which another call is allowed once the burst is used
+        unsigned int initialBackoffMs;      ///< Delay before retrying the first throttled call. Each retry doubles it,
+                                            ///< and a random reduction of up to half is applied to every delay.
+        unsigned int maxBackoffMs;          ///< Longest delay between retries
+        unsigned int deadlineMs;            ///< Time after which a call that is still rate limited or throttled
+                                            ///< returns @ref gfnThrottled. 0 makes a single attempt.
+    } GfnRequestSchedulerConfig;
+
+    /// @brief Counters of a scheduled request
+    typedef struct GfnRequestSchedulerStats
+    {
+        uint64_t requests;                  ///< Calls made by the application
+        uint64_t libraryCalls;              ///< Calls made into the SDK library, including retries
+        uint64_t deduplicated;              ///< Application calls answered by sharing another call's result
+        uint64_t throttled;                 ///< SDK library calls that returned @ref gfnThrottled
+        uint64_t retries;                   ///< Throttled calls that were retried
+        uint64_t rateLimited;               ///< Application calls that failed because the rate limit did not allow
+                                            ///< a call before the deadline
+    } GfnRequestSchedulerStats;
+
+    /// @par Description
+    /// Sets the rate limit and retry policy the wrapper applies to a request that the SDK throttles.
+    ///
+    /// The wrapper schedules @ref GfnCloudCheck, @ref GfnGetPartnerData and @ref GfnGetPartnerSecureData.
+    /// Calls made while an identical call is in progress wait for it and receive the same result, so
+    /// many callers asking at once cause a single SDK call; for @ref GfnCloudCheck, calls are identical
+    /// when their challenge nonces are. Calls beyond the rate limit wait for their turn, and calls the
+    /// SDK throttles are retried with exponential backoff, both until the deadline passes.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Defaults to no rate limit and a deadline of 0, so a call is never delayed or retried and a
+    /// throttled call returns @ref gfnThrottled straight away; identical calls in progress are still
+    /// shared. Calls only wait on the calling thread once a policy with a burst or a deadline is set,
+    /// so avoid setting one for calls made from a game or render thread. Strings returned by scheduled
+    /// requests must still be released with @ref GfnFree.
+    ///
+    /// @param request                    - Request to configure
+    /// @param config                     - Policy to apply
+    /// @retval gfnSuccess                - The policy was applied
+    /// @retval gfnInvalidParameter       - NULL pointer, unknown request, or maxBackoffMs less than initialBackoffMs
+    GfnRuntimeError GfnSetRequestSchedulerConfig(GfnScheduledRequest request, const GfnRequestSchedulerConfig* config);
+
+    /// @par Description
+    /// Retrieves the counters of a scheduled request.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param request                    - Request to query
+    /// @param stats                      - Pointer to a structure that receives the counters
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer or unknown request
+    GfnRuntimeError GfnGetRequestSchedulerStats(GfnScheduledRequest request, GfnRequestSchedulerStats* stats);
+
+    /// @brief Handle to an initialization started with @ref GfnInitializeSdkAsync
+    typedef struct GfnInitOperation* GfnInitHandle;
+
+    /// @brief Callback function for notification when an asynchronous initialization completes.
+    /// Receives the result @ref GfnInitializeSdk would have returned.
+    typedef void(GFN_CALLBACK* InitCompleteCallbackSig)(GfnRuntimeError result, void* pUserContext);
+
+    /// @brief Timeout value for @ref GfnWaitForInitialization that waits until initialization completes
+    #define GFN_INIT_WAIT_INFINITE (0xFFFFFFFFu)
+
+    /// @brief Time spent in each phase of the last initialization, in microseconds
+    typedef struct GfnInitTimings
+    {
+        uint64_t pathResolutionUs;          ///< Locating and checking the client library path
+        uint64_t clientLoadUs;              ///< Loading the client library
+        uint64_t clientInitUs;              ///< Initializing the client library
+        uint64_t cloudLoadUs;               ///< Locating and loading the cloud library
+        uint64_t symbolBindingUs;           ///< Resolving the exports of both libraries
+        uint64_t cloudInitUs;               ///< Initializing the cloud library
+        uint64_t totalUs;                   ///< Whole initialization call, including the phases above
+    } GfnInitTimings;
+
+    /// @brief Number of error codes counted individually in @ref GfnApiStats
+    #define GFN_WRAPPER_STATS_ERROR_CODES 32
+
+    /// @brief Capacity of the per-API array in @ref GfnWrapperStats
+    #define GFN_WRAPPER_STATS_MAX_APIS 48
+
+    /// @brief Counters for one function exported by the GFN SDK libraries, since the process started
+    /// or @ref GfnResetWrapperStats was last called. Latencies are measured on a sample of the calls
+    /// and reported as the upper bound of the histogram bucket they fall in, so they overstate the
+    /// measured time by up to 25%.
+    typedef struct GfnApiStats
+    {
+        const char* name;                   ///< Name of the library export, such as "gfnGetClientInfo"
+        bool cloudLibrary;                  ///< True for a cloud library export, false for a client library export
+        uint64_t calls;                     ///< Calls made into the library
+        uint64_t timedCalls;                ///< Calls whose latency was measured for the percentiles below
+        uint64_t errors;                    ///< Calls that returned an error code
+        uint64_t throttled;                 ///< Calls that returned gfnThrottled
+        uint64_t errorsByCode[GFN_WRAPPER_STATS_ERROR_CODES]; ///< Element n counts calls that returned error code -n.
+                                                              ///< Element 0 counts error codes outside that range.
+        uint64_t latencyP50Ns;              ///< Median call latency
+        uint64_t latencyP90Ns;              ///< 90th percentile call latency
+        uint64_t latencyP99Ns;              ///< 99th percentile call latency
+        uint64_t latencyMaxNs;              ///< Longest call latency
+    } GfnApiStats;
+
+    /// @brief Per-API counters returned by @ref GfnGetWrapperStats
+    typedef struct GfnWrapperStats
+    {
+        unsigned int apiCount;              ///< Number of valid entries in apis
+        GfnApiStats apis[GFN_WRAPPER_STATS_MAX_APIS]; ///< One entry per library export, including ones never called
+    } GfnWrapperStats;
+
+    /// @par Description
+    /// Starts @ref GfnInitializeSdk on a background thread and returns immediately, so SDK startup can
+    /// overlap with other work. Completion can be waited for with @ref GfnWaitForInitialization, checked
+    /// with @ref GfnPollInitialization, or notified through a callback.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Call this during application start or from the platform client in
-    /// order to get the user's language and country settings.
+    /// Other SDK APIs return @ref gfnAPINotInit until initialization completes. @ref GfnInitializeSdk
+    /// and @ref GfnShutdownSdk wait for a pending asynchronous initialization before they run. Release
+    /// the handle with @ref GfnReleaseInitHandle once done with it.
+    ///
+    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs
+    /// @param callback                   - Optional function called on the background thread once initialization
+    ///                                     completes, possibly after @ref GfnWaitForInitialization has returned
+    /// @param pUserContext               - Pointer to user context, which will be passed unmodified to the callback
+    /// @param[out] handle                - Receives the handle of the initialization
+    /// @retval gfnSuccess                - Initialization was started
+    /// @retval gfnInvalidParameter       - NULL handle pointer passed in
+    /// @retval gfnUnableToAllocateMemory - The handle could not be allocated
+    /// @retval gfnInternalError          - The background thread could not be started
+    GfnRuntimeError GfnInitializeSdkAsync(GfnDisplayLanguage language, InitCompleteCallbackSig callback, void* pUserContext, GfnInitHandle* handle);
+
+    /// @par Description
+    /// Waits for an initialization started with @ref GfnInitializeSdkAsync to complete.
     ///
-    /// @param languageCode - Language code as a string. Example: "en-US". Call @ref GfnFree to free the memory.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - Successfully retrieved language code
-    /// @retval gfnNoData                - No language code found
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    /// @note
-    /// To avoid leaking memory, call @ref GfnFree once done with the data.
-    GfnRuntimeError GfnGetClientLanguageCode(const char** languageCode);
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param handle                     - Handle returned by @ref GfnInitializeSdkAsync
+    /// @param timeoutMs                  - Longest time to wait, or @ref GFN_INIT_WAIT_INFINITE
+    /// @param[out] result                - Optional pointer that receives the result of the initialization
+    /// @retval gfnSuccess                - Initialization completed
+    /// @retval gfnTimedOut               - Initialization did not complete within the timeout
+    /// @retval gfnInvalidParameter       - NULL handle passed in
+    GfnRuntimeError GfnWaitForInitialization(GfnInitHandle handle, unsigned int timeoutMs, GfnRuntimeError* result);
+
+    /// @par Description
+    /// Checks whether an initialization started with @ref GfnInitializeSdkAsync has completed, without waiting.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param handle                     - Handle returned by @ref GfnInitializeSdkAsync
+    /// @param[out] complete              - Receives true if initialization has completed
+    /// @param[out] result                - Optional pointer that receives the result of the initialization, if complete
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnPollInitialization(GfnInitHandle handle, bool* complete, GfnRuntimeError* result);
+
+    /// @par Description
+    /// Releases a handle returned by @ref GfnInitializeSdkAsync, waiting for the initialization and its
+    /// completion callback to finish first. Does not shut down the SDK.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param handle                     - Handle returned by @ref GfnInitializeSdkAsync
+    /// @retval gfnSuccess                - The handle was released
+    /// @retval gfnInvalidParameter       - NULL handle passed in
+    /// @retval gfnCallWrongEnvironment   - Called from the completion callback
+    GfnRuntimeError GfnReleaseInitHandle(GfnInitHandle handle);
 
+    /// @par Description
+    /// Retrieves how long each phase of the most recent initialization took, whether it was started with
+    /// @ref GfnInitializeSdk, @ref GfnInitializeSdkAsync or one of the GfnInitializeSdkFromPath variants.
+    /// Phases that did not run, such as loading the cloud library on a user's client, report their
+    /// time until they were skipped.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param[out] timings               - Structure that receives the timings
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnNoData                 - No initialization has completed yet
+    GfnRuntimeError GfnGetInitTimings(GfnInitTimings* timings);
+
     /// @par Description
-    /// Gets user's client country code using ISO 3166-1 Alpha-2 country code.
+    /// Retrieves per-API call counts, error counts and latency percentiles for every call the wrapper
+    /// has made into the GFN SDK libraries.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Call this during application start or from the platform client in order to get
-    /// the user's country code.
+    /// Counting is lock-free and costs a few nanoseconds per call, so it can be left on in production.
+    /// The latency of one call in sixteen per thread is measured; define GFN_SDK_WRAPPER_STATS_SAMPLE_INTERVAL
+    /// when building the wrapper to change the interval, or GFN_SDK_WRAPPER_STATS to 0 to remove the
+    /// counting; tracing has its own switch, see @ref GfnSetTracingEnabled. Reading the counters merges
+    /// per-thread shards and can be done at any time.
+    ///
+    /// @param[out] stats                 - Structure that receives the counters
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetWrapperStats(GfnWrapperStats* stats);
+
+    /// @par Description
+    /// Writes the counters returned by @ref GfnGetWrapperStats as a JSON document, together with the
+    /// non-empty latency histogram buckets of each API. APIs that were never called are left out.
     ///
-    /// @param[out] countryCode          - Country code as a 2 character string. Example: “US”
-    /// @param length                    - Length of pchCountryCode character array
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnGetClientCountryCode(char* countryCode, unsigned int length);
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Pass a NULL buffer and a size of 0 to query the required size. Histogram buckets are written as
+    /// [upper bound in nanoseconds, calls] pairs.
+    ///
+    /// @param buffer                     - Buffer that receives the NUL-terminated document, or NULL
+    /// @param bufferSize                 - Size of buffer in bytes
+    /// @param[out] length                - Receives the length of the document, not counting the terminator
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL length pointer passed in, or the buffer is too small.
+    ///                                     In the latter case length still receives the required length.
+    GfnRuntimeError GfnDumpWrapperStatsJson(char* buffer, size_t bufferSize, size_t* length);
 
+    /// @par Description
+    /// Clears the counters reported by @ref GfnGetWrapperStats. Calls that complete while the counters
+    /// are being cleared may or may not be counted.
+    ///
+    /// @par Environment
+    /// Cloud and Client
     ///
+    /// @par Platform
+    /// Windows, Linux
+    void GfnResetWrapperStats(void);
+
     /// @par Description
-    /// Gets user's client data.
+    /// Turns tracing of SDK activity on or off. While tracing is on, every call the wrapper makes into
+    /// the GFN SDK libraries, every callback delivered to the application and every SDK initialization
+    /// is recorded with its start time, duration, thread and result code. Write the recorded spans out
+    /// with @ref GfnTraceDump.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Call this during application start or from the platform client in order to get
-    /// the data on the user's client.
+    /// Tracing can also be turned on by setting the GFN_SDK_TRACE_FILE environment variable to the path
+    /// of a file, in which case the trace is written to that file by @ref GfnShutdownSdk. Each thread keeps
+    /// its most recent 4096 spans in a ring of about 160 KB. The ring of a thread that exits is kept
+    /// for dumps until another thread reuses it, and at most 64 rings exist, so threads beyond that
+    /// record nothing until a ring is released. Define GFN_SDK_WRAPPER_TRACE to 0 when building the wrapper to remove
+    /// the recording; GFN_SDK_WRAPPER_STATS does not affect it.
+    ///
+    /// @param enabled                    - True to record spans, false to stop recording
+    /// @retval gfnSuccess                - On success
+    GfnRuntimeError GfnSetTracingEnabled(bool enabled);
+
+    /// @par Description
+    /// Writes the spans recorded while tracing was on to a file in the Chrome trace-event JSON format,
+    /// which can be opened in chrome://tracing or the Perfetto UI.
     ///
-    /// @param[out] clientInfo           - A structure to hold clientInfo data
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    /// @note
-    /// The client data returned by this function is best effort, as not all client devices will report
-    /// all information. For example, certain browser and TV clients will not report client resolution or
-    /// will incorrect resolution in certain situations. In the cases the data is not reported, the data
-    /// returned will be zeroes. Likewise for safezone information, as most clients, such as Windows PC,
-    /// do not have screen areas unsafe for rendering or input. For more information about safe zones,
-    /// see the  the Mobile Integration Guide in the /doc folder.
-    GfnRuntimeError GfnGetClientInfo(GfnClientInfo* clientInfo);
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Timestamps are microseconds of the monotonic clock (QueryPerformanceCounter on Windows,
+    /// CLOCK_MONOTONIC on Linux) and thread ids are those of the operating system, so the spans can be
+    /// lined up with a trace of the application recorded on the same clock. The recorded spans are kept
+    /// and can be dumped again.
+    ///
+    /// @param path                       - Path of the file to write. On Windows, a wide char string; on
+    ///                                     other platforms, a UTF-8 string.
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL path passed in, or the file could not be created
+    /// @retval gfnUnableToAllocateMemory - Memory for the dump could not be allocated
+    GfnRuntimeError GfnTraceDump(const CHAR_TYPE* path);
 
-        ///
-        /// @par Description
-        /// Gets various information about the current streaming session
-        ///
-        /// @par Environment
-        /// Cloud
-        /// 
-        /// @par Platform
-        /// Windows, Linux
-        ///
-        /// @par Usage
-        /// Call this from a streaming session to find out more information about the session, such
-        /// as session time remaining, or if RTX is enabled for the current session.
-        ///
-        /// @param sessionInfo               - Pointer to a GfnSessionInfo struct.
+    /// @brief An action zone in the set passed to @ref GfnSetActionZones
+    typedef struct GfnActionZone
+    {
+        GfnActionType type;                 ///< Action of the zone
+        unsigned int id;                    ///< Identifier of the zone, unique for its type
+        GfnRect zone;                       ///< Zone coordinates
+    } GfnActionZone;
 
-        ///
-        /// @retval gfnSuccess               - On success
-        /// @retval gfnInvalidParameter      - NULL pointer passed in or buffer length is too small
-        /// @retval gfnCallWrongEnvironment  - If called in a client environment
-        /// @return Otherwise, appropriate error code
-        /// @note
-        /// If the application has called @ref gfnRegisterSessionInitCallback to be notified when a
-        /// user connects, then this API should be called after that callback is triggered.
-        /// Certain data, such as session time limit or RTX support, can only be defined when a user
-        /// connects as the values depend on the user type. Calling before that point can result in
-        /// obtaining incorrect data.
-        GfnRuntimeError GfnGetSessionInfo(GfnSessionInfo* sessionInfo);
+    /// @brief How the wrapper compares and batches action zone updates
+    typedef struct GfnActionZoneConfig
+    {
+        float epsilon;                      ///< Largest difference in each coordinate for which a zone is
+                                            ///< considered unchanged
+        unsigned int coalesceMs;            ///< Minimum time between updates sent to the SDK library, or 0 to
+                                            ///< send every set as soon as it is submitted
+    } GfnActionZoneConfig;
+
+    /// @brief Counters of action zone updates, since the process started
+    typedef struct GfnActionZoneStats
+    {
+        uint64_t submitted;                 ///< Zones passed to @ref GfnSetActionZone and @ref GfnSetActionZones
+        uint64_t forwarded;                 ///< Zones added or changed in the SDK library
+        uint64_t removed;                   ///< Zones removed from the SDK library
+        uint64_t unchanged;                 ///< Submitted zones that did not need an SDK library call
+        uint64_t coalesced;                 ///< Submitted zones replaced by a later set before being sent
+        uint64_t flushes;                   ///< Zone sets compared against the SDK library's zones
+        uint64_t errors;                    ///< SDK library calls that failed
+    } GfnActionZoneStats;
 
+    /// @par Description
+    /// Replaces the action zones set in the SDK library with the given set. The wrapper keeps the zones
+    /// it has set, keyed by type and id, and only calls the SDK library for zones that were added, moved
+    /// by more than the configured epsilon, or left out of the set, which are removed. Zones set with
+    /// @ref GfnSetActionZone are part of the same set.
+    ///
+    /// @par Environment
+    /// Cloud
     ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Pass every zone of the current layout each time it changes, for example every frame of a UI
+    /// animation. If a type and id appear more than once, the last one is used. With coalescing
+    /// configured through @ref GfnSetActionZoneConfig, a set submitted less than coalesceMs after the
+    /// last update is held, replacing any set already held, until the next call to
+    /// @ref GfnSetActionZones, @ref GfnSetActionZone or @ref GfnFlushActionZones after the interval.
+    /// Zones that failed to update are retried with the next set.
+    ///
+    /// @param zones                      - Array of zones, can be NULL when count is 0
+    /// @param count                      - Number of zones; 0 removes every zone
+    /// @retval gfnSuccess                - The set was applied, or held for the next update
+    /// @retval gfnInvalidParameter       - NULL zones with a non-zero count
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @retval gfnUnableToAllocateMemory - The set could not be stored
+    /// @return Otherwise, the first error returned by the SDK library
+    GfnRuntimeError GfnSetActionZones(const GfnActionZone* zones, unsigned int count);
+
     /// @par Description
-    /// Calls @ref GfnGetPartnerData to retrieves non-secure partner data that is either a) passed by the client in the gfnStartStream call
-    /// or b) sent using Deep Link parameter.
+    /// Sends an action zone set held by coalescing to the SDK library.
     ///
     /// @par Environment
     /// Cloud
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use during cloud session to retrieve partner data
+    /// Call when the layout stops changing, such as at the end of a UI animation, so the last set does
+    /// not wait for another update.
     ///
-    /// @param partnerData              - Populated with the partner data in string form if found
-    ///                                   Call @ref GfnFree to free the memory
+    /// @retval gfnSuccess                - No set was held, or it was applied
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @return Otherwise, the first error returned by the SDK library
+    GfnRuntimeError GfnFlushActionZones(void);
+
+    /// @par Description
+    /// Sets how @ref GfnSetActionZones and @ref GfnSetActionZone compare and batch zone updates.
     ///
-    /// @retval gfnSuccess              - Partner data successfully retrieved from session data
-    /// @retval gfnNoData               - No partner data found in session data
-    /// @retval gfnInvalidParameter     - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
-    /// @note
-    /// To avoid leaking memory, call @ref GfnFree once done with the data.
-    GfnRuntimeError GfnGetPartnerData(const char** partnerData);
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @par Usage
+    /// Defaults to an epsilon of 0.0001 and no coalescing.
+    ///
+    /// @param config                     - The configuration to apply
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in, or a negative epsilon
+    GfnRuntimeError GfnSetActionZoneConfig(const GfnActionZoneConfig* config);
 
+    /// @par Description
+    /// Retrieves the counters of submitted and forwarded action zones.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param stats                      - Pointer to a structure that receives the counters
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetActionZoneStats(GfnActionZoneStats* stats);
+
+    /// @brief Number of sliding windows in @ref GfnNetworkStats
+    #define GFN_NETWORK_STATS_WINDOW_COUNT 3
+
+    /// @brief Round trip delay statistics of the network status updates received within a sliding window.
+    /// The windows move forward when an update arrives, so they describe the updates received within
+    /// their length before the last one, see lastUpdateAgeMs in @ref GfnNetworkStats.
+    typedef struct GfnNetworkWindowStats
+    {
+        unsigned int windowMs;              ///< Length of the window
+        unsigned int sampleCount;           ///< Updates received within the window
+        unsigned int coveredMs;             ///< Time from the oldest to the newest update in the window. Less than
+                                            ///< windowMs until the window has filled, or when updates arrive faster
+                                            ///< than the window can hold.
+        unsigned int minMs;                 ///< Lowest latency within the window
+        unsigned int maxMs;                 ///< Highest latency within the window
+        unsigned int p50Ms;                 ///< Median latency. Percentiles above 255 ms are accurate to 8 ms.
+        unsigned int p95Ms;                 ///< 95th percentile latency
+        unsigned int p99Ms;                 ///< 99th percentile latency
+        float meanMs;                       ///< Mean latency
+        float jitterMs;                     ///< Mean absolute change in latency between consecutive updates
+    } GfnNetworkWindowStats;
+
+    /// @brief Network quality of the session, computed from the RTDAverageLatencyMs values of network
+    /// status updates
+    typedef struct GfnNetworkStats
+    {
+        uint64_t updateCount;               ///< Updates received since the SDK was initialized
+        unsigned int lastUpdateAgeMs;       ///< Time since the last update, 0 if none was received
+        unsigned int latestMs;              ///< Latency of the last update
+        float ewmaMs;                       ///< Exponentially weighted moving average of the latency, with a
+                                            ///< weight of 1/8 for each update
+        float jitterMs;                     ///< Smoothed absolute change in latency between updates, with a
+                                            ///< weight of 1/16 for each update, as in RFC 3550
+        GfnNetworkWindowStats windows[GFN_NETWORK_STATS_WINDOW_COUNT];  ///< Sliding windows, shortest first
+    } GfnNetworkStats;
+
+    /// @brief Configuration of the network quality statistics
+    typedef struct GfnNetworkStatsConfig
+    {
+        unsigned int updateRateMs;          ///< Update rate the wrapper asks for when it subscribes to network
+                                            ///< status updates itself
+        unsigned int windowMs[GFN_NETWORK_STATS_WINDOW_COUNT];  ///< Lengths of the sliding windows, shortest first
+    } GfnNetworkStatsConfig;
+
     /// @par Description
-    /// Calls @ref GfnGetPartnerSecureData to retrieves secure partner data that is either a) passed by the client in the gfnStartStream call
-    /// or b) sent in response to Deep Link nonce validation.
+    /// Retrieves rolling statistics of the session's round trip delay. The wrapper records every
+    /// network status update it receives and keeps a moving average, a smoothed jitter, and the
+    /// minimum, maximum, mean, jitter and percentiles of the updates within each sliding window.
     ///
     /// @par Environment
     /// Cloud
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use during cloud session to retrieve secure partner data
+    /// Call as often as needed, for example every frame from several threads: reading the statistics
+    /// is wait-free and does not call the SDK library. The first call after @ref GfnInitializeSdk
+    /// subscribes the wrapper to network status updates, unless a callback registered with
+    /// @ref GfnRegisterNetworkStatusCallback already did, so components that only need the statistics
+    /// do not register callbacks of their own. Windows hold at most the last 2048 updates, so when a
+    /// callback registered at a faster rate than the configured one makes updates arrive more often,
+    /// a long window covers less time than its length; coveredMs reports the time it covers.
+    ///
+    /// @param stats                      - Pointer to a structure that receives the statistics
+    /// @retval gfnSuccess                - On success, including before the first update arrives
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @return Otherwise, the error returned by the SDK library when subscribing to updates
+    GfnRuntimeError GfnGetNetworkStats(GfnNetworkStats* stats);
+
+    /// @par Description
+    /// Sets the sliding windows of @ref GfnGetNetworkStats, and the update rate the wrapper asks for
+    /// when it subscribes to network status updates itself.
     ///
-    /// @param partnerSecureData         - Populated with the secure partner data in string for if found
-    ///                                    Call @ref GfnFree to free the memory
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - Secure partner data successfully retrieved from session data
-    /// @retval gfnNoData                - No secure partner data found in session data
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    /// @note
-    /// To avoid leaking memory, call @ref GfnFree once done with the data.
-    GfnRuntimeError GfnGetPartnerSecureData(const char** partnerSecureData);
-
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @par Usage
+    /// Defaults to an update rate of 1000 ms and windows of 10, 60 and 300 seconds. Changing the windows
+    /// restarts the statistics. The update rate applies when the wrapper subscribes, and a new rate
+    /// registers the wrapper's subscription again; it does not replace the rate of a callback registered
+    /// with @ref GfnRegisterNetworkStatusCallback. Windows hold at most 2048 updates, so the longest
+    /// window may span at most 2047 updates at the update rate.
+    ///
+    /// @param config                     - The configuration to apply
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in, a zero update rate, windows that are
+    ///                                     zero or not in increasing order, or a window longer than
+    ///                                     2047 updates at the update rate
+    /// @return Otherwise, the error returned by the SDK library when subscribing again at the new rate;
+    ///         the configuration is applied regardless
+    GfnRuntimeError GfnSetNetworkStatsConfig(const GfnNetworkStatsConfig* config);
+
+    /// @brief How much the application should compensate for the round trip delay of the stream, for
+    /// example through input prediction or wider timing windows
+    typedef enum GfnLatencyCompensationTier
+    {
+        gfnLatencyCompensationNone = 0,     ///< Round trip delay below the first threshold
+        gfnLatencyCompensationLow = 1,      ///< Round trip delay from the first threshold
+        gfnLatencyCompensationMedium = 2,   ///< Round trip delay from the second threshold
+        gfnLatencyCompensationHigh = 3      ///< Round trip delay from the third threshold
+    } GfnLatencyCompensationTier;
+
+    /// @brief Number of @ref GfnLatencyCompensationTier values
+    #define GFN_LATENCY_COMPENSATION_TIER_COUNT 4
+
+    /// @brief Rendering recommendation of the quality advisor, see @ref GfnRegisterQualityAdviceCallback
+    typedef struct GfnQualityAdvice
+    {
+        uint64_t revision;                  ///< Incremented each time the advice changes, 0 before the
+                                            ///< advisor has started
+        unsigned int renderWidth;           ///< Recommended render width, 0 if the client did not report
+                                            ///< its resolution
+        unsigned int renderHeight;          ///< Recommended render height, 0 if the client did not report
+                                            ///< its resolution
+        unsigned int frameRateCap;          ///< Recommended frame rate cap, in frames per second
+        GfnLatencyCompensationTier latencyCompensation; ///< Recommended latency compensation
+        unsigned int rtdMs;                 ///< Smoothed round trip delay the tier was chosen from
+        unsigned int clientWidth;           ///< Physical width of the client display, 0 if not reported
+        unsigned int clientHeight;          ///< Physical height of the client display, 0 if not reported
+        GfnRect safeZone;                   ///< Title-safe area of the client, all zero if the whole
+                                            ///< screen is title-safe
+        bool rtxEnabled;                    ///< RTX is enabled for the session
+    } GfnQualityAdvice;
+
+    /// @brief Policy of the quality advisor
+    typedef struct GfnQualityAdvisorConfig
+    {
+        unsigned int maxRenderHeight;       ///< Largest render height, measured on the shorter side of the
+                                            ///< client display, in sessions with RTX enabled
+        unsigned int maxRenderHeightNonRtx; ///< Largest render height in sessions without RTX
+        unsigned int tierThresholdMs[GFN_LATENCY_COMPENSATION_TIER_COUNT - 1]; ///< Round trip delays at
+                                            ///< which the Low, Medium and High tiers start, increasing
+        unsigned int hysteresisMs;          ///< How far the round trip delay must fall below a threshold
+                                            ///< before the tier below is recommended again
+        unsigned int holdMs;                ///< Minimum time between two changes of latency tier
+        unsigned int frameRateCap[GFN_LATENCY_COMPENSATION_TIER_COUNT]; ///< Frame rate cap for each
+                                            ///< latency tier
+    } GfnQualityAdvisorConfig;
+
+    /// @brief Callback function receiving the new advice each time it changes. Register via
+    /// @ref GfnRegisterQualityAdviceCallback.
+    typedef void(GFN_CALLBACK* QualityAdviceCallbackSig)(const GfnQualityAdvice* advice, void* userContext);
+
     /// @par Description
-    /// Calls @ref gfnIsTitleAvailable to determines if a specific title is available to launch
-    /// in current streaming session.
+    /// Registers a callback to be called whenever the quality advisor changes its rendering
+    /// recommendation. The advisor follows the client resolution and safe zone from ClientInfo
+    /// updates, whether RTX is enabled for the session, and the round trip delay from network status
+    /// updates, smoothed as in @ref GfnNetworkStats::ewmaMs, and recommends:
+    /// - a render resolution: the client's physical resolution, scaled down to fit the configured
+    ///   height, so a game does not render more pixels than the client displays;
+    /// - a latency compensation tier, chosen from the smoothed round trip delay with hysteresis, and
+    ///   changed at most once per hold time so the recommendation does not flap;
+    /// - a frame rate cap, configured per latency tier.
     ///
     /// @par Environment
     /// Cloud
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to determine if a title is available to be launched from the active GFN cloud instance,
-    /// for example, to show a "Play" button in a platform launcher's UI.
+    /// The first registration, or the first call to @ref GfnGetQualityAdvice, starts the advisor: it
+    /// reads the client and session info and subscribes to ClientInfo and network status updates,
+    /// without affecting callbacks registered for them. The callback is not called for the initial
+    /// advice; read it with @ref GfnGetQualityAdvice. Later changes are delivered on the thread of the
+    /// update that caused them, or from @ref GfnPumpEvents in @ref gfnCallbackDeliveryQueued mode, where
+    /// only the newest advice is delivered. Updates arriving on different threads can deliver advice
+    /// out of order; an advice with a lower revision than one already received can be ignored.
+    ///
+    /// @param adviceCallback             - Function to call when the advice changes
+    /// @param userContext                - Pointer passed back to the callback
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL callback passed in
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @return Otherwise, the error returned by the SDK library when starting the advisor
+    GfnRuntimeError GfnRegisterQualityAdviceCallback(QualityAdviceCallbackSig adviceCallback, void* userContext);
+
+    /// @par Description
+    /// Unregisters the callback registered with @ref GfnRegisterQualityAdviceCallback. The advisor keeps
+    /// running for @ref GfnGetQualityAdvice until the SDK is shut down.
     ///
-    /// @param platformAppId             - Identifier of the requested title to check
-    /// @param isAvailable               - Pointer to a boolean that receives true if the title is
-    ///                                    available, or or false if not available.
+    /// @par Environment
+    /// Cloud
     ///
-    /// @retval gfnSuccess               - If the query was successful.
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @retval gfnSuccess                - On success
+    GfnRuntimeError GfnUnregisterQualityAdviceCallback(void);
+
+    /// @par Description
+    /// Retrieves the current advice of the quality advisor, starting the advisor if needed.
+    ///
+    /// @par Environment
+    /// Cloud
+    ///
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param advice                     - Pointer to a structure that receives the advice
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @return Otherwise, the error returned by the SDK library when starting the advisor
+    GfnRuntimeError GfnGetQualityAdvice(GfnQualityAdvice* advice);
+
+    /// @par Description
+    /// Sets the policy of the quality advisor. A running advisor applies it to the next update.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
     ///
-    /// @note
-    /// This function's definition differs from the export that it wraps, as it returns a
-    /// GfnRuntimeError instead of bool.
-    GfnRuntimeError GfnIsTitleAvailable(const char* platformAppId, bool* isAvailable);
+    /// @par Usage
+    /// Defaults to render heights of 2160 with RTX and 1080 without, tier thresholds of 40, 80 and
+    /// 150 ms with 10 ms of hysteresis and a hold time of 5000 ms, and frame rate caps of 60, 60, 60
+    /// and 30.
+    ///
+    /// @param config                     - The configuration to apply
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in, a zero render height or frame rate
+    ///                                     cap, or thresholds that are not increasing
+    GfnRuntimeError GfnSetQualityAdvisorConfig(const GfnQualityAdvisorConfig* config);
+
+    /// @brief Why the save scheduler runs the application's save job
+    typedef enum GfnSaveReason
+    {
+        gfnSaveReasonScheduled = 0,         ///< The session is about to reach its time limit
+        gfnSaveReasonRequested = 1          ///< GeForce NOW asked the application to save through the
+                                            ///< SaveCallback, and no recent save could answer it
+    } GfnSaveReason;
+
+    /// @brief Save job run by the save scheduler. Return @ref crCallbackSuccess once the state is
+    /// saved, or @ref crCallbackFailure to have the save retried.
+    typedef GfnApplicationCallbackResult(GFN_CALLBACK* SaveJobCallbackSig)(GfnSaveReason reason, unsigned int sessionTimeRemainingSec, void* userContext);
+
+    /// @brief When the save scheduler saves
+    typedef struct GfnSaveSchedulerConfig
+    {
+        unsigned int leadTimeSec;           ///< Time before the end of the session at which scheduled
+                                            ///< saves start
+        unsigned int intervalSec;           ///< Time between the start of two scheduled saves, and
+                                            ///< before retrying a save that failed
+        unsigned int pollIntervalSec;       ///< Time between two reads of the session info
+        unsigned int freshnessSec;          ///< Age up to which a completed save answers a SaveCallback
+                                            ///< without running the job again, 0 to always run it
+    } GfnSaveSchedulerConfig;
+
+    /// @brief State of the save scheduler, and its counters since it was started
+    typedef struct GfnSaveSchedulerStatus
+    {
+        bool running;                       ///< The scheduler is started
+        bool sessionLimited;                ///< The session has a time limit
+        bool saveScheduled;                 ///< A save is scheduled before the end of the session
+        unsigned int sessionTimeRemainingSec; ///< Time left in the session, extrapolated from the last read
+                                            ///< of the session info, 0 if the session has no limit
+        unsigned int nextSaveInMs;          ///< Time until the next scheduled save, if saveScheduled
+        unsigned int lastSaveAgeMs;         ///< Time since the last completed save, 0 if none completed
+        uint64_t scheduledSaves;            ///< Jobs run ahead of the end of the session
+        uint64_t requestedSaves;            ///< Jobs run for a SaveCallback
+        uint64_t recentSaveAnswers;         ///< SaveCallbacks answered by a recent save without a job
+        uint64_t failedSaves;               ///< Jobs that returned @ref crCallbackFailure
+        uint64_t sessionInfoPolls;          ///< Reads of the session info
+    } GfnSaveSchedulerStatus;
 
-    ///
     /// @par Description
-    /// Calls @ref GfnGetTitlesAvailable to retrieves all titles that can be launched in the
-    /// current game streaming session.
+    /// Starts saving the application's state ahead of the end of the session, instead of only when
+    /// GeForce NOW sends the SaveCallback. A background thread reads the session info every
+    /// pollIntervalSec and tracks the time remaining with a monotonic clock in between. Once the
+    /// session is within leadTimeSec of its limit, the job runs every intervalSec, so the saves are
+    /// spread over the lead time rather than landing in the final seconds.
+    ///
+    /// The scheduler also answers the SaveCallback: if a save completed within freshnessSec, the
+    /// callback returns at once; if a save is running, the callback waits for it; otherwise the job runs
+    /// with @ref gfnSaveReasonRequested. Callbacks registered with @ref GfnRegisterSaveCallback are still
+    /// called afterwards.
     ///
     /// @par Environment
     /// Cloud
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to retrieve a list of all titles available to launch in the current streaming session,
-    /// for example, to add "Play" buttons to all titles instead of calling gfnIsTitleAvailable on
-    /// each title.
+    /// Make the job incremental where possible, so a scheduled save only writes what changed since the
+    /// last one. Jobs never overlap; they run on the scheduler thread, or on the SDK library's thread for
+    /// a SaveCallback. Calling this again while the scheduler runs replaces the job and configuration.
+    /// Defaults to a lead time of 300 seconds, an interval of 60 seconds, a poll interval of 60 seconds
+    /// and a freshness of 30 seconds. The scheduler stops with @ref GfnStopSaveScheduler or
+    /// @ref GfnShutdownSdk, once the running job has returned.
+    ///
+    /// @param saveJob                    - Function that saves the application's state
+    /// @param userContext                - Pointer passed back to the job
+    /// @param config                     - Configuration, or NULL for the defaults
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL job passed in, or a zero lead time, interval or poll interval
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @retval gfnInternalError          - The scheduler thread could not be started
+    /// @return Otherwise, the error returned by the SDK library when registering for the SaveCallback
+    GfnRuntimeError GfnStartSaveScheduler(SaveJobCallbackSig saveJob, void* userContext, const GfnSaveSchedulerConfig* config);
+
+    /// @par Description
+    /// Stops the save scheduler, waiting for a running job to return. SaveCallbacks are then only
+    /// delivered to the callbacks registered with @ref GfnRegisterSaveCallback.
     ///
-    /// @param platformAppIds            - Comma-delimited list of platform identifiers. Memory is
-    ///                                    allocated for the list. Call @ref GfnFree to free the memory.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @par Platform
+    /// Windows, Linux
     ///
-    /// @note
-    /// To avoid leaking memory, call @ref GfnFree once done with the title list.
-    GfnRuntimeError GfnGetTitlesAvailable(const char** platformAppIds);
+    /// @retval gfnSuccess                - The scheduler is stopped, or was not running
+    /// @retval gfnCallWrongEnvironment   - Called from the save job
+    GfnRuntimeError GfnStopSaveScheduler(void);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnFree to free memory allocated by @ref GfnGetTitlesAvailable
+    /// Retrieves the state and counters of the save scheduler.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @par Usage
-    /// Use to release memory after a call to a memory-allocated function and you are finished with the data.
-    /// Should only be called if the memory is populated with valid data. Calling @ref GfnFree with invalid
-    /// pointer or data will result in an memory exception being thrown.
-    ///
-    /// @param data                      - Pointer to allocated string memory
-    ///
-    /// @retval gfnSuccess               - Memory successfully released
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    GfnRuntimeError GfnFree(const char** data);
+    /// @param status                     - Pointer to a structure that receives the status
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetSaveSchedulerStatus(GfnSaveSchedulerStatus* status);
 
+    /// @brief Most memory regions that can be added with @ref GfnAddSaveRegion
+    #define GFN_SAVE_REGION_CAPACITY 64
+
+    /// @brief State of the save snapshot pipeline
+    typedef struct GfnSaveSnapshotStatus
+    {
+        uint64_t lastCapturedId;            ///< Snapshot most recently captured, 0 if none
+        uint64_t lastWrittenId;             ///< Snapshot most recently written to disk, 0 if none
+        GfnRuntimeError lastWriteResult;    ///< Result of the most recent write
+        bool pending;                       ///< A captured snapshot is waiting for the writer
+        bool writing;                       ///< A snapshot is being written
+        unsigned int lastCaptureUs;         ///< Time the most recent capture took
+        unsigned int lastWriteMs;           ///< Time the most recent write took, compression included
+        uint64_t lastRawBytes;              ///< Size of the regions in the most recent write
+        uint64_t lastStoredBytes;           ///< Size of the data in the most recent write, after compression
+        uint64_t captures;                  ///< Snapshots captured
+        uint64_t writes;                    ///< Snapshots written to disk
+        uint64_t superseded;                ///< Snapshots replaced by a later capture before being written
+        uint64_t failures;                  ///< Writes that failed
+    } GfnSaveSnapshotStatus;
 
-    ///
     /// @par Description
-    /// Calls @ref gfnRegisterStreamStatusCallback to register a callback that gets called on the
-    /// user's PC when the streaming session state changes.
+    /// Sets the file that @ref GfnCaptureSaveSnapshot writes snapshots to, and whether they are
+    /// compressed. Each write goes to the path with a .tmp suffix, is flushed to the disk and then
+    /// renamed over the path, so the file always holds a complete snapshot.
     ///
     /// @par Environment
-    /// Client
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
-    /// Windows
+    /// Windows, Linux
     ///
     /// @par Usage
-    /// Register a function to call when stream status changes on the user's client PC
-    ///
-    /// @param streamStatusCallback      - Function pointer to application code to call after
-    ///                                    the GeForce NOW streamer changes state
-    /// @param userContext               - Pointer to user context, which will be passed unmodified to the
-    ///                                    registered callback. Can be NULL
-    ///
-    /// @retval gfnSuccess               - On success, when running on the client PC
-    /// @retval gfnCallWrongEnvironment  - If callback could not be registered since this function
-    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnRegisterStreamStatusCallback(StreamStatusCallbackSig streamStatusCallback, void* userContext);
+    /// Call before the first capture. Applies from the next write. The configuration is kept when the
+    /// SDK is shut down and initialized again.
+    ///
+    /// @param path                       - Path of the snapshot file
+    /// @param compress                   - Compress the snapshot with a fast LZ77 compressor
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL or empty path, or a path too long to add the .tmp suffix to
+    GfnRuntimeError GfnSetSaveSnapshotConfig(const CHAR_TYPE* path, bool compress);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnStartStream to request GFN client to start a streaming session of an application
-    /// in a synchronous (blocking) fashion.
+    /// Adds a memory region holding game state to the save snapshots. The two snapshot buffers are
+    /// grown to hold every region here, so captures never allocate memory.
     ///
     /// @par Environment
-    /// Client
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
-    /// Windows
+    /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to start a streaming session.
+    /// Add the regions once, in the same order in every run, since @ref GfnLoadSaveSnapshot restores
+    /// them by position. The region must stay valid until it is removed: regions are kept when the SDK
+    /// is shut down and initialized again. Waits for a write in progress, since its buffer may need to
+    /// grow.
+    ///
+    /// @param data                       - Start of the region
+    /// @param size                       - Size of the region in bytes
+    /// @param regionId                   - Pointer that receives the identifier of the region
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer or zero size passed in
+    /// @retval gfnUnableToAllocateMemory - The snapshot buffers could not be grown, or all
+    ///                                     GFN_SAVE_REGION_CAPACITY regions are in use
+    /// @retval gfnInternalError          - The writer thread could not be started
+    GfnRuntimeError GfnAddSaveRegion(const void* data, size_t size, unsigned int* regionId);
+
+    /// @par Description
+    /// Removes a region added with @ref GfnAddSaveRegion from later snapshots.
     ///
-    /// @param startStreamInput         - Pointer to a StartStreamInput structure.
-    /// @param response                 - Start streaming response.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess              - On success
-    /// @retval gfnInvalidParameter     - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment - If called in a cloud environment
-    /// @retval gfnStreamFailure        - Network failure or other error prevented the stream from starting
-    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found.
-    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnStartStream(StartStreamInput* startStreamInput, StartStreamResponse* response);
-
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param regionId                   - Identifier returned by @ref GfnAddSaveRegion
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - Unknown region
+    GfnRuntimeError GfnRemoveSaveRegion(unsigned int regionId);
+
     /// @par Description
-    /// Calls @ref gfnStartStreamAsync to request GFN client to start a streaming session of an
-    /// application in an asynchronous fashion.
+    /// Copies every region into a free snapshot buffer and hands it to a writer thread, which
+    /// compresses it and writes it to the configured file. The capture only copies memory, so it takes
+    /// microseconds whatever the time needed to write the snapshot. Of the two buffers, one can be
+    /// written while the other holds the newest capture: a capture taken while another one is still
+    /// waiting for the writer replaces it.
     ///
     /// @par Environment
-    /// Client
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
-    /// Windows
+    /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to start a streaming session.
+    /// Call from the SaveCallback, or from the save job of @ref GfnStartSaveScheduler, and return
+    /// @ref crCallbackSuccess right away. Use @ref GfnWaitForSaveSnapshot or
+    /// @ref GfnGetSaveSnapshotStatus to learn when the snapshot is on disk. Other threads must not
+    /// modify the regions during the call.
+    ///
+    /// @param snapshotId                 - Optional pointer that receives the identifier of the snapshot
+    /// @retval gfnSuccess                - The snapshot was captured
+    /// @retval gfnAPINotInit             - No path was set with @ref GfnSetSaveSnapshotConfig
+    /// @retval gfnNoData                 - No region was added
+    /// @retval gfnInternalError          - The writer thread, stopped by @ref GfnShutdownSdk, could not be
+    ///                                     started again
+    GfnRuntimeError GfnCaptureSaveSnapshot(uint64_t* snapshotId);
+
+    /// @par Description
+    /// Waits until a snapshot, or a later one that replaced it, has been written.
     ///
-    /// @param startStreamInput          - Pointer to a StartStreamInput structure.
-    /// @param cb                        - A StartStreamCallbackSig callback to be called with streaming events.
-    /// @param context                   - User context
-    /// @param timeoutMs                 - Time after which attempt to start streaming will be aborted.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a cloud environment
-    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @par Platform
+    /// Windows, Linux
     ///
-    /// @note
-    /// This function's definition differs from the export that it wraps, as it returns a
-    /// GfnRuntimeError instead of being void for consistent error reporting.
-    GfnRuntimeError GfnStartStreamAsync(const StartStreamInput* startStreamInput, StartStreamCallbackSig cb, void* context, unsigned int timeoutMs);
+    /// @param snapshotId                 - Identifier from @ref GfnCaptureSaveSnapshot, or 0 for the most
+    ///                                     recent capture
+    /// @param timeoutMs                  - Longest time to wait
+    /// @retval gfnSuccess                - The snapshot is on disk
+    /// @retval gfnTimedOut               - The snapshot was not written within the timeout
+    /// @retval gfnInvalidParameter       - The snapshot was not captured
+    /// @return Otherwise, the error of the write that failed
+    GfnRuntimeError GfnWaitForSaveSnapshot(uint64_t snapshotId, unsigned int timeoutMs);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnStopStream to request GFN client to stop a streaming session of an application
-    /// in a synchronous (blocking) fashion.
+    /// Retrieves the state and counters of the save snapshot pipeline, without waiting for a write.
     ///
     /// @par Environment
-    /// Client
-    /// 
-    /// @par Platform
-    /// Windows
+    /// Cloud and Client
     ///
-    /// @par Usage
-    /// Use to stop a streaming session started by the same process
+    /// @par Platform
+    /// Windows, Linux
     ///
-    /// @retval gfnSuccess              - On success
-    /// @retval gfnCallWrongEnvironment - If called in a cloud environment
-    /// @retval gfnStreamStopFailure    - Failure to stop the streaming session
-    /// @retval gfnClientLibraryNotFound - GFN SDK client-side library could not be found
-    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnStopStream(void);
+    /// @param status                     - Pointer to a structure that receives the status
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetSaveSnapshotStatus(GfnSaveSnapshotStatus* status);
 
+    /// @par Description
+    /// Reads a snapshot file written by @ref GfnCaptureSaveSnapshot back into the regions added with
+    /// @ref GfnAddSaveRegion. The regions are only modified once the whole file has been read and its
+    /// checksum verified.
+    ///
+    /// @par Environment
+    /// Cloud and Client
+    ///
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param path                       - Path of the snapshot file, or NULL for the configured path
+    /// @retval gfnSuccess                - The regions were restored
+    /// @retval gfnNoData                 - The file does not exist
+    /// @retval gfnInvalidParameter       - No path is configured, or the regions of the file do not
+    ///                                     match the regions added
+    /// @retval gfnInternalError          - The file is not a valid snapshot
+    /// @retval gfnUnableToAllocateMemory - Memory for the file could not be allocated
+    GfnRuntimeError GfnLoadSaveSnapshot(const CHAR_TYPE* path);
+
+    /// @brief Most resource pools that can be added with @ref GfnAddPauseResourcePool
+    #define GFN_PAUSE_RESOURCE_POOL_CAPACITY 32
+
+    /// @brief Why the seat is paused
+    typedef enum GfnPauseReason
+    {
+        gfnPauseReasonNone = 0,             ///< The seat is not paused
+        gfnPauseReasonPauseCallback = 1,    ///< GeForce NOW sent the PauseCallback
+        gfnPauseReasonLostInputFocus = 2,   ///< The stream lost input focus
+        gfnPauseReasonApplication = 3       ///< The application called @ref GfnSetPaused
+    } GfnPauseReason;
+
+    /// @brief Releases or rebuilds a resource pool of the application for the pause controller
+    typedef void(GFN_CALLBACK* PauseResourceCallbackSig)(void* userContext);
+
+    /// @brief Resource pool that the pause controller trims while the seat is paused
+    typedef struct GfnPauseResourcePool
+    {
+        PauseResourceCallbackSig release;   ///< Frees the pool when the seat pauses, or NULL
+        PauseResourceCallbackSig restore;   ///< Rebuilds the pool when the seat resumes, or NULL
+        void* userContext;                  ///< Pointer passed back to release and restore
+        void* reclaimable;                  ///< Cache memory whose pages the system may reclaim while
+                                            ///< paused, or NULL. Only used with discardReclaimable.
+        size_t reclaimableSize;             ///< Size of reclaimable in bytes
+        bool discardReclaimable;            ///< Set to let the pause controller discard the pages of
+                                            ///< reclaimable after release, losing their contents. When
+                                            ///< not set, the wrapper never touches the pool's memory.
+        unsigned int priority;              ///< Pools are restored in increasing priority and released
+                                            ///< in decreasing priority
+    } GfnPauseResourcePool;
+
+    /// @brief Events the pause controller follows
+    typedef struct GfnPauseControllerConfig
+    {
+        unsigned int pausedFrameIntervalMs; ///< Frame interval @ref GfnThrottlePausedFrame keeps while paused
+        bool pauseOnFocusLoss;              ///< Pause when the stream loses input focus, and resume when
+                                            ///< it gets it back
+    } GfnPauseControllerConfig;
+
+    /// @brief State of the pause controller, and the timings of the last pause and resume
+    typedef struct GfnPauseControllerStatus
+    {
+        bool started;                       ///< The controller follows pause and focus events
+        bool paused;                        ///< The seat is paused
+        GfnPauseReason reason;              ///< Why the seat is paused
+        unsigned int pools;                 ///< Resource pools added
+        unsigned int parkedWorkers;         ///< Threads waiting in @ref GfnParkPausedWorker
+        unsigned int pausedForMs;           ///< Time since the seat paused, 0 when not paused
+        unsigned int lastReleaseUs;         ///< Time the last pause took to release the pools
+        unsigned int lastResumeUs;          ///< Time the last resume took to restore the pools
+        unsigned int slowestRestorePoolId;  ///< Pool that took longest to restore on the last resume
+        unsigned int slowestRestoreUs;      ///< Time that pool took to restore
+        uint64_t reclaimedBytes;            ///< Memory handed back to the system on the last pause
+        uint64_t pauses;                    ///< Pauses since the SDK was initialized
+        uint64_t resumes;                   ///< Resumes since the SDK was initialized
+    } GfnPauseControllerStatus;
+
     /// @par Description
-    /// Calls @ref gfnStopStreamAsync to request GFN client to stop a streaming session of an
-    /// application in an asynchronous fashion.
+    /// Starts pausing the seat when GeForce NOW sends the PauseCallback, and, if pauseOnFocusLoss is
+    /// set, when the stream reports @ref GfnStreamStatusLostInputFocus. A pause releases the resource
+    /// pools added with @ref GfnAddPauseResourcePool, throttles the frame loop through
+    /// @ref GfnThrottlePausedFrame and parks the threads that call @ref GfnParkPausedWorker, so a
+    /// paused seat draws less power and holds less memory.
     ///
     /// @par Environment
-    /// Client
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
-    /// Windows
+    /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to start a streaming session.
+    /// The PauseCallback has no matching resume event, so call @ref GfnSetPaused with false once the
+    /// user resumes the game. A pause for focus loss ends when the stream reports
+    /// @ref GfnStreamStatusGotInputFocus. Pauses and resumes that follow these events release and
+    /// restore the pools on a thread of the wrapper, never on the GeForce NOW callback thread. Calling
+    /// this again replaces the configuration. Defaults to a paused frame interval of 100 ms, with
+    /// pauseOnFocusLoss set. @ref GfnShutdownSdk stops the controller; call this again after the SDK is
+    /// initialized again.
+    ///
+    /// @param config                     - Configuration, or NULL for the defaults
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - A zero paused frame interval
+    /// @retval gfnInternalError          - The pause thread could not be started
+    /// @return Otherwise, the error returned by the SDK library when registering for the events
+    GfnRuntimeError GfnStartPauseController(const GfnPauseControllerConfig* config);
+
+    /// @par Description
+    /// Stops following pause and focus events, resuming the seat first if it is paused.
     ///
-    /// @param cb                        - A StartStreamCallbackSig callback to be called with streaming events.
-    /// @param context                   - User context
-    /// @param timeoutMs                 - Time after which attempt to start streaming will be aborted.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnStreamStopFailure     - Failure to stop the streaming session
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a cloud environment
-    /// @retval gfnClientLibraryNotFound - GFN SDK client-side Library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
+    /// @par Platform
+    /// Windows, Linux
     ///
-    /// @note
-    /// This function's definition differs from the export that it wraps, as it returns a
-    /// GfnRuntimeError instead of being void for consistent error reporting.
-    GfnRuntimeError GfnStopStreamAsync(StopStreamCallbackSig cb, void* context, unsigned int timeoutMs);
+    /// @retval gfnSuccess                - The controller is stopped, or was not started
+    /// @retval gfnCallWrongEnvironment   - Called from the release or restore function of a pool
+    GfnRuntimeError GfnStopPauseController(void);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnSetupTitle to notify GeForce NOW that an application should be readied for launch.
+    /// Pauses or resumes the seat. A pause releases the pools in decreasing priority and hands the
+    /// reclaimable memory of each pool that set discardReclaimable back to the system; a resume restores them in increasing
+    /// priority, timing each restore, and only then wakes the throttled frame loop and the parked
+    /// threads.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to prepare an application for launch on GeForce NOW, and block on the result.
+    /// Works whether or not the controller is started. The pools are released and restored on the
+    /// calling thread before the call returns.
     ///
-    /// @param platformAppId             - Identifier of the requested application to setup
-    ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnSetupTitleFailure     - The GeForce NOW SDK failed to set up the title
-    /// @retval gfnCloudLibraryNotFound  - GFN SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnSetupTitle(const char* platformAppId);
+    /// @param paused                     - true to pause, false to resume
+    /// @retval gfnSuccess                - On success, or if the seat already was in that state
+    /// @retval gfnCallWrongEnvironment   - Called from the release or restore function of a pool
+    GfnRuntimeError GfnSetPaused(bool paused);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnTitleExited to notify GFN that an application has exited.
+    /// Adds a resource pool for the pause controller to trim while the seat is paused.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to notify GFN that your application has exited.
+    /// The structure is copied. Only the whole pages within reclaimable are handed back to the system,
+    /// and only if discardReclaimable is set; on Windows, the memory must come from VirtualAlloc. A
+    /// pool added while the seat is paused is only released on the next pause. The release and restore
+    /// functions must not call the pause controller. Pools are kept when the SDK is shut down and
+    /// initialized again.
+    ///
+    /// @param pool                       - The pool to add
+    /// @param poolId                     - Pointer that receives the identifier of the pool
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in, or a pool with nothing to trim
+    /// @retval gfnUnableToAllocateMemory - All GFN_PAUSE_RESOURCE_POOL_CAPACITY pools are in use
+    /// @retval gfnCallWrongEnvironment   - Called from the release or restore function of a pool
+    GfnRuntimeError GfnAddPauseResourcePool(const GfnPauseResourcePool* pool, unsigned int* poolId);
+
+    /// @par Description
+    /// Removes a pool added with @ref GfnAddPauseResourcePool. A pool removed while the seat is paused
+    /// is not restored.
     ///
-    /// @param platformId                - Identifier of the launcher service, e.g. "Steam"
-    /// @param platformAppId             - Identifier of the application that has exited.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnInvalidParameter      - NULL pointer passed in
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnCloudLibraryNotFound  - GeForce NOW SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound           - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnTitleExited(const char* platformId, const char* platformAppId);
-
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param poolId                     - Identifier returned by @ref GfnAddPauseResourcePool
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - Unknown pool
+    /// @retval gfnCallWrongEnvironment   - Called from the release or restore function of a pool
+    GfnRuntimeError GfnRemovePauseResourcePool(unsigned int poolId);
+
     /// @par Description
-    /// Calls @ref gfnRegisterExitCallback to register an application function that is called when
-    /// the user has requested to end the GeForce NOW session.
+    /// Throttles the frame loop while the seat is paused: waits until pausedFrameIntervalMs has passed
+    /// since the previous throttled frame, or until the seat resumes. Returns at once when the seat is
+    /// not paused.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Register an application function that is called when GeForce NOW will end the current session.
-    /// Note: This callback function allows an application to respond to a user's request to end a session,
-    /// for example, to perform a clean exit of the application. The application is given 5 seconds to 
-    /// perform activities and return from the callback function before session shutdown activities continue.
-    ///
-    /// @param exitCallback             - Function pointer to application code to call when GeForce NOW
-    ///                                   will begin to shut down the current session.
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   registered callback. Can be NULL.
+    /// Call once per frame from the frame loop, before rendering.
     ///
-    /// @retval gfnSuccess              - On success, when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - If exitCallback function pointer is NULL
-    /// @retval gfnCallWrongEnvironment - If callback could not be registered since this function
-    ///                                   was called outside of a cloud execution environment
-    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnRegisterExitCallback(ExitCallbackSig exitCallback, void* userContext);
+    /// @return true if the seat is paused, false otherwise
+    bool GfnThrottlePausedFrame(void);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnRegisterPauseCallback to register an application callback with GeForce NOW
-    /// to be called when GeForce NOW needs to pause the game on the user's behalf.
+    /// Parks the calling thread while the seat is paused, until it resumes or the timeout expires.
+    /// Returns at once when the seat is not paused.
+    ///
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @par Environment
-    /// Cloud
-    /// 
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Register an application function to call when GeForce NOW needs to pause the game.
-    /// Note: Callback should return as soon as the game process is paused. 
-    /// Resuming should occur when the user interacts with the game UI.
-    ///
-    /// @param pauseCallback            - Function pointer to application code to call when
-    ///                                   GeForce NOW needs to pause the game
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   registered callback. Can be NULL.
+    /// Call from worker threads between jobs. The timeout lets a worker check its own exit conditions.
     ///
-    /// @retval gfnSuccess              - On success, when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - If pauseCallback function pointer is NULL
-    /// @retval gfnCallWrongEnvironment - If callback could not be registered since this function
-    ///                                   was called outside of a cloud execution environment
-    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnRegisterPauseCallback(PauseCallbackSig pauseCallback, void* userContext);
+    /// @param timeoutMs                  - Longest time to park
+    /// @return true if the seat is still paused, false otherwise
+    bool GfnParkPausedWorker(unsigned int timeoutMs);
 
-    ///
     /// @par Description
-    /// Calls @ref gfnRegisterInstallCallback to register an application callback with GeForce NOW
-    /// to be called after a successful call to @ref gfnSetupTitle.
+    /// Retrieves the state of the pause controller and the timings of the last pause and resume.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @par Usage
-    /// Register a function to call after a successful call to gfnSetupTitle.
-    ///
-    /// @param installCallback          - Function pointer to application code to call after
-    ///                                   GeForce NOW successfully performs its own title setup.
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   registered callback. Can be NULL.
-    ///
-    /// @retval gfnSuccess              - On success, when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - If installCallback function pointer is NULL
-    /// @retval gfnCallWrongEnvironment - If callback could not be registered since this function
-    ///                                   was called outside of a cloud execution environment
-    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound          - The API was not found in the GFN SDK Library
-    GfnRuntimeError GfnRegisterInstallCallback(InstallCallbackSig installCallback, void* userContext);
+    /// @param status                     - Pointer to a structure that receives the status
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetPauseControllerStatus(GfnPauseControllerStatus* status);
+
+    /// @brief Most tasks that can be added with @ref GfnAddExitTask
+    #define GFN_EXIT_TASK_CAPACITY 64
+    /// @brief Most tasks an exit task can depend on
+    #define GFN_EXIT_TASK_MAX_DEPENDENCIES 8
+    /// @brief Most worker threads of the exit orchestrator
+    #define GFN_EXIT_WORKER_CAPACITY 16
+
+    /// @brief Teardown step run by the exit orchestrator. Return @ref crCallbackFailure to report
+    /// that it failed; the tasks depending on it run regardless.
+    typedef GfnApplicationCallbackResult(GFN_CALLBACK* ExitTaskCallbackSig)(void* userContext);
+
+    /// @brief Teardown task added with @ref GfnAddExitTask
+    typedef struct GfnExitTask
+    {
+        const char* name;                   ///< Name for the log and the report, or NULL
+        ExitTaskCallbackSig run;            ///< Function that performs the task
+        void* userContext;                  ///< Pointer passed back to run
+        unsigned int priority;              ///< Of the tasks ready to start, the highest priority starts first
+        bool critical;                      ///< Run even after the deadline has passed
+        unsigned int dependencies[GFN_EXIT_TASK_MAX_DEPENDENCIES]; ///< Tasks that must finish first, 0 for none
+    } GfnExitTask;
+
+    /// @brief Outcome of an exit task
+    typedef enum GfnExitTaskState
+    {
+        gfnExitTaskNotRun = 0,              ///< The exit tasks have not run
+        gfnExitTaskSucceeded = 1,           ///< The task returned @ref crCallbackSuccess
+        gfnExitTaskFailed = 2,              ///< The task returned @ref crCallbackFailure
+        gfnExitTaskSkipped = 3              ///< The task was not critical and was ready after the deadline
+    } GfnExitTaskState;
+
+    /// @brief Timing of an exit task
+    typedef struct GfnExitTaskReport
+    {
+        char name[32];                      ///< Name of the task, truncated
+        unsigned int taskId;                ///< Identifier returned by @ref GfnAddExitTask
+        GfnExitTaskState state;             ///< Outcome of the task
+        bool critical;                      ///< The task is critical
+        unsigned int worker;                ///< Thread that ran the task, 0 for the thread that ran the exit
+        unsigned int startUs;               ///< Time from the start of the exit to the start of the task
+        unsigned int durationUs;            ///< Time the task took
+    } GfnExitTaskReport;
+
+    /// @brief Report of the last run of the exit tasks
+    typedef struct GfnExitReport
+    {
+        bool ran;                           ///< The exit tasks have run
+        bool deadlineExceeded;              ///< The tasks took longer than the deadline
+        unsigned int deadlineMs;            ///< Deadline the tasks ran under
+        unsigned int totalUs;               ///< Time from the start of the exit to the end of the last task
+        unsigned int succeeded;             ///< Tasks that succeeded
+        unsigned int failed;                ///< Tasks that failed
+        unsigned int skipped;               ///< Tasks skipped after the deadline
+        unsigned int taskCount;             ///< Entries used in tasks, in the order the tasks started
+        GfnExitTaskReport tasks[GFN_EXIT_TASK_CAPACITY]; ///< Timing of each task
+    } GfnExitReport;
+
+    /// @brief How the exit orchestrator runs the exit tasks
+    typedef struct GfnExitOrchestratorConfig
+    {
+        unsigned int deadlineMs;            ///< Time from the start of the exit after which tasks that are
+                                            ///< not critical are skipped
+        unsigned int workerThreads;         ///< Threads that run tasks alongside the thread running the
+                                            ///< exit, 0 to run them all on that thread
+        bool shutDownSdk;                   ///< Shut the SDK down with @ref GfnShutdownSdk once the tasks
+                                            ///< have run for the ExitCallback
+    } GfnExitOrchestratorConfig;
 
-    ///
     /// @par Description
-    /// Calls @ref gfnRegisterSaveCallback to register an application callback with GeForce NOW to be
-    /// called when GeForce NOW needs the application to save user progress.
-    ///
+    /// Starts running the exit tasks on the ExitCallback, replacing a serial teardown with one bounded
+    /// by a deadline. The tasks run as a dependency graph: every task whose dependencies have finished
+    /// is ready, and the thread running the exit and a pool of worker threads start the ready tasks in
+    /// decreasing priority. Once the deadline has passed, tasks that are not critical are skipped
+    /// instead of started. When every task has finished or been skipped, the timing of each task is
+    /// logged and kept for @ref GfnGetExitReport. If shutDownSdk is set, the SDK is then shut down with
+    /// @ref GfnShutdownSdk on a thread of the wrapper, never on the GeForce NOW callback thread, which
+    /// the shutdown would unload the library under.
     ///
     /// @par Environment
     /// Cloud
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Register an application function to call when GeForce NOW needs the application to save game or user data.
-    /// The callback function should trigger the save of game state and return when completed.
+    /// The worker threads are started here, so none are created during the exit. Callbacks registered
+    /// with @ref GfnRegisterExitCallback are called before the tasks run. A task that already started
+    /// cannot be interrupted, so the exit takes as long as the slowest task started before the
+    /// deadline, plus the critical tasks. Calling this again replaces the configuration. Defaults to a
+    /// deadline of 2000 ms and 3 worker threads, without shutting the SDK down.
+    ///
+    /// @param config                     - Configuration, or NULL for the defaults
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - More than GFN_EXIT_WORKER_CAPACITY worker threads
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment, or from an exit task
+    /// @retval gfnInternalError          - The worker threads could not be started
+    /// @return Otherwise, the error returned by the SDK library when registering for the ExitCallback
+    GfnRuntimeError GfnStartExitOrchestrator(const GfnExitOrchestratorConfig* config);
+
+    /// @par Description
+    /// Stops running the exit tasks on the ExitCallback and stops the worker threads, waiting for a
+    /// run of the exit tasks in progress. The tasks are kept.
     ///
-    /// @param saveCallback             - Function pointer to application code to call when GFN needs the application to save
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   callback specified. Can be NULL.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
-    /// @retval gfnCloudLibraryNotFound - GeForce NOW SDK cloud-side library could not be found
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnRegisterSaveCallback(SaveCallbackSig saveCallback, void* userContext);
-
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @retval gfnSuccess                - The orchestrator is stopped, or was not started
+    /// @retval gfnCallWrongEnvironment   - Called from an exit task
+    GfnRuntimeError GfnStopExitOrchestrator(void);
+
     /// @par Description
-    /// Calls @ref gfnRegisterSessionInitCallback to register an application callback with GeForce NOW to be called when
-    /// a GeForce NOW user has connected to the game seat to start a streaming session. This callback is used as part of
-    /// the Pre-warm feature. 
+    /// Adds a teardown task to run on exit. Dependencies must name tasks already added, so the tasks
+    /// always form a graph without cycles.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @par Usage
-    /// Register an application function to call when a GeForce NOW user has connected to the game seat to allow the game to load
-    /// user-specific data and start game play for the user. Callback should return once loading is complete and user
-    /// can interact with the game.
-    /// Note: The callback function is given 30 second to complete and call @ref GfnAppReady. If this time elapses, before the 
-    /// function is called, the session will begin streaming frames to the user even if the game is still loading user data.
+    /// @param task                       - The task to add. The structure and the name are copied.
+    /// @param taskId                     - Pointer that receives the identifier of the task
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer or function passed in, or an unknown dependency
+    /// @retval gfnUnableToAllocateMemory - All GFN_EXIT_TASK_CAPACITY tasks are in use
+    /// @retval gfnCallWrongEnvironment   - Called from an exit task
+    GfnRuntimeError GfnAddExitTask(const GfnExitTask* task, unsigned int* taskId);
+
+    /// @par Description
+    /// Removes a task added with @ref GfnAddExitTask. Waits for a run of the exit tasks in progress.
     ///
-    /// @param sessionInitCallback      - Function pointer to application code to call when the user has connected
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   callback specified. Can be NULL.
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - Callback was NULL
-    /// @retval gfnAPINotInit           - SDK was not initialized
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    /// @retval gfnCallWrongEnvironment - The on-seat dll detected that it was not on a game seat
-    GfnRuntimeError GfnRegisterSessionInitCallback(SessionInitCallbackSig sessionInitCallback, void* userContext);
-
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param taskId                     - Identifier returned by @ref GfnAddExitTask
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - Unknown task, or another task depends on it
+    /// @retval gfnCallWrongEnvironment   - Called from an exit task
+    GfnRuntimeError GfnRemoveExitTask(unsigned int taskId);
+
     /// @par Description
-    /// Calls @ref gfnRegisterMessageCallback to register an application callback with GeForce NOW to be called when a message
-    /// is sent to the application via the SendMessage feature as part of GeForce NOW's support for two-way communication 
-    /// between client application and the game application running in the game seat.
+    /// Runs the exit tasks now, as the ExitCallback would. Lets an application that exits on its own
+    /// use the same teardown. The SDK is not shut down, whatever shutDownSdk is set to.
     ///
     /// @par Environment
     /// Cloud and Client
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Provide a callback function that will be called when a message is sent to the application from the SendMessage feature.
-    ///
-    /// @param messageCallback          - Function pointer to application code to call when a message has been sent.
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   callback specified. Can be NULL.
+    /// Without @ref GfnStartExitOrchestrator, the tasks run on the calling thread under the default
+    /// deadline. Call @ref GfnShutdownSdk afterwards to shut the SDK down; that drops the tasks.
     ///
-    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - Callback was NULL
-    /// @retval gfnAPINotInit           - SDK was not initialized
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    /// @retval gfnCallWrongEnvironment - The on-seat dll detected that it was not on a game seat
-    GfnRuntimeError GfnRegisterMessageCallback(MessageCallbackSig messageCallback, void* userContext);
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnCallWrongEnvironment   - Called from an exit task
+    GfnRuntimeError GfnRunExitTasks(void);
 
-
-    ///
     /// @par Description
-    /// Registers an application callback with GeForce NOW to be called when client info changes
+    /// Retrieves the report of the last run of the exit tasks. The report is kept after the SDK shuts
+    /// down.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @param clientInfoCallback       - Function pointer to application code to call when GeForce NOW client data changes
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   callback specified. Can be NULL.
-    ///
-    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - Callback was NULL
-    /// @retval gfnAPINotInit           - SDK was not initialized
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnRegisterClientInfoCallback(ClientInfoCallbackSig clientInfoCallback, void* userContext);
+    /// @param report                     - Pointer to a structure that receives the report
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnNoData                 - The exit tasks have not run
+    GfnRuntimeError GfnGetExitReport(GfnExitReport* report);
+
+    /// @brief Most threads the prefetcher can use
+    #define GFN_PREFETCH_THREAD_CAPACITY 16
+
+    /// @brief Budget and parallelism of the prefetcher
+    typedef struct GfnPrefetchConfig
+    {
+        uint64_t budgetBytes;               ///< Most bytes to request, 0 for no limit
+        unsigned int budgetMs;              ///< Longest time to keep issuing reads, 0 for no limit
+        unsigned int threads;               ///< Threads walking the build tree and issuing reads
+    } GfnPrefetchConfig;
+
+    /// @brief Progress of the last prefetch
+    typedef struct GfnPrefetchStatus
+    {
+        bool running;                       ///< A prefetch is in progress
+        bool completed;                     ///< The last prefetch went through the manifest and the
+                                            ///< build tree, or used up its budget, without being stopped
+        bool budgetExhausted;               ///< The last prefetch stopped at the byte or time budget
+        unsigned int manifestEntries;       ///< Entries read from the manifest
+        unsigned int manifestMs;            ///< Time until every manifest entry was issued
+        unsigned int elapsedMs;             ///< Time the prefetch has taken so far, or took
+        uint64_t directoriesWalked;         ///< Directories of the build tree listed
+        uint64_t filesWarmed;               ///< Files, or ranges of files from the manifest, warmed
+        uint64_t filesFailed;               ///< Files and directories that could not be opened
+        uint64_t bytesRequested;            ///< Bytes the system was asked to read into its file cache. On
+                                            ///< Windows they were read; on Linux they were passed to
+                                            ///< posix_fadvise, a hint the system may not act on in full
+    } GfnPrefetchStatus;
 
-    ///
     /// @par Description
-    /// Registers an application callback with GeForce NOW to be called when network latency changes
+    /// Starts warming the file cache with the game's files when GeForce NOW sends the InstallCallback,
+    /// so the first launch does not wait on cold reads. Each InstallCallback starts a prefetch of its
+    /// build path and metadata path, as @ref GfnPrefetchTitle does, on a thread of the wrapper: the
+    /// GeForce NOW callback thread only hands the paths over.
     ///
+    /// A prefetch first issues the entries of the access-order manifest, in order, then walks the
+    /// build tree on several threads and warms every file the manifest did not list. It stops once
+    /// the byte or time budget is used up. On Linux, reads are issued with posix_fadvise and
+    /// POSIX_FADV_WILLNEED, which reads ahead in the background; on Windows, the files are read with
+    /// FILE_FLAG_SEQUENTIAL_SCAN.
     ///
     /// @par Environment
     /// Cloud
-    /// 
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @param networkStatusCallback    - Function pointer to application code to call when network latency changes
-    /// @param updateRateMs             - Time interval for updates
-    /// @param userContext              - Pointer to user context, which will be passed unmodified to the
-    ///                                   callback specified. Can be NULL.
-    ///
-    /// @retval gfnSuccess              - On success when running in a GeForce NOW environment
-    /// @retval gfnInvalidParameter     - Callback was NULL
-    /// @retval gfnAPINotInit           - SDK was not initialized
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnRegisterNetworkStatusCallback(NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* userContext);
+    /// @par Usage
+    /// The manifest is a text file recorded by a previous run, for example by the game's file layer.
+    /// Each line names a file the game read, in the order it first read them, relative to the build
+    /// path unless absolute. A line can add a byte offset and a length, separated by tabs, to warm
+    /// only part of the file. Empty lines and lines starting with # are ignored. Calling this again
+    /// replaces the manifest and the configuration for the next prefetch. Defaults to no budget and 4
+    /// threads.
+    ///
+    /// @param manifestPath               - Path of the manifest, or NULL to only walk the build tree
+    /// @param config                     - Configuration, or NULL for the defaults
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - A manifest path that is too long, or zero threads or more
+    ///                                     than GFN_PREFETCH_THREAD_CAPACITY
+    /// @retval gfnCallWrongEnvironment   - If called in a client environment
+    /// @retval gfnInternalError          - The thread starting the prefetches could not be started
+    /// @return Otherwise, the error returned by the SDK library when registering for the InstallCallback
+    GfnRuntimeError GfnStartPrefetcher(const CHAR_TYPE* manifestPath, const GfnPrefetchConfig* config);
 
-    ///
     /// @par Description
-    /// Calls @ref GfnAppReady to notify GeForce NOW that an application is ready to be displayed to the GeForce NOW user.
+    /// Stops prefetching on the InstallCallback, and stops a prefetch in progress. The manifest and
+    /// configuration are kept for @ref GfnPrefetchTitle.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @par Usage
-    /// Use to notify GFN that your application is ready to be streamed.
+    /// @retval gfnSuccess                - On success
+    GfnRuntimeError GfnStopPrefetcher(void);
+
+    /// @par Description
+    /// Starts a prefetch of a build path and metadata path now, with the manifest and configuration
+    /// of @ref GfnStartPrefetcher, or the defaults without a manifest. Returns once the threads are
+    /// started; a prefetch in progress is stopped first.
     ///
-    /// @param success                - True if startup was successful
-    /// @param status                 - Optional startup status
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess               - On success
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnAPINotInit            - SDK was not initialized
-    /// @retval gfnAPINotFound           - The API was not found in the GeForce NOW SDK Library
-    GfnRuntimeError GfnAppReady(bool success, const char * status);
-
+    /// @par Platform
+    /// Windows, Linux
     ///
+    /// @param buildPath                  - Root of the build tree, in UTF-8
+    /// @param metadataPath               - Root of the metadata tree, in UTF-8, or NULL
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL build path, or a path too long
+    /// @retval gfnUnableToAllocateMemory - Memory for the manifest could not be allocated
+    /// @retval gfnInternalError          - The threads could not be started
+    GfnRuntimeError GfnPrefetchTitle(const char* buildPath, const char* metadataPath);
+
     /// @par Description
-    /// Sends Active zone coordinates to GFN Client
-    ///
-    /// TO BE DEPRECATED SOON
+    /// Waits for the prefetch in progress to finish, including one an InstallCallback asked for that
+    /// has not started yet.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
-    /// @par Usage
-    /// Use to invoke special events on the client from the GFN cloud environment
-    /// Note : Marked for deprecation
+    /// @param timeoutMs                  - Longest time to wait
+    /// @retval gfnSuccess                - No prefetch is in progress
+    /// @retval gfnTimedOut               - The prefetch did not finish within the timeout
+    GfnRuntimeError GfnWaitForPrefetch(unsigned int timeoutMs);
+
+    /// @par Description
+    /// Retrieves the progress of the prefetch in progress, or of the last one.
     ///
-    /// @param type                 - Populated with relevant GfnActionType
-    /// @param id                   - unique unsigned int type identifier for this event
-    /// @param zone                 - Optional zone coordinates relevant to type specified
+    /// @par Environment
+    /// Cloud and Client
     ///
-    /// @retval gfnSuccess              - Call was successful
-    /// @retval gfnInputExpected        - Expected zone to have a value
-    /// @retval gfnComError             - There was SDK internal communication error
-    /// @retval gfnCallWrongEnvironment  - If called in a client environment
-    /// @retval gfnAPINotInit            - SDK was not initialized
-    /// @retval gfnAPINotFound           - The API was not found in the GeForce NOW SDK Library
-    /// @retval gfnInvalidParameter     - Invalid parameters provided
-    /// @retval gfnThrottled            - API call was throttled for exceeding limit
-    /// @retval gfnUnhandledException   - API ran into an unhandled error and caught an exception before it returned to client code
-    /// @return Otherwise, appropriate error code
-    GfnRuntimeError GfnSetActionZone(GfnActionType type, unsigned int id, GfnRect* zone);
+    /// @par Platform
+    /// Windows, Linux
+    ///
+    /// @param status                     - Pointer to a structure that receives the status
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    GfnRuntimeError GfnGetPrefetchStatus(GfnPrefetchStatus* status);
 
+    /// @brief Handle to an SDK context created with @ref GfnCreateContext
+    typedef struct GfnSdkContext_t* GfnSdkContext;
 
-    ///
     /// @par Description
-    /// Sends a custom message communication from the app to the client. This message
-    /// is "fire-and-forget", and does not wait for the message to be delivered to return status.
-    /// Latency is best effort and not guaranteed.
+    /// Creates an SDK context. A context has its own callback registrations and its own call statistics,
+    /// so independent components or simulated sessions in one process can use the SDK without seeing
+    /// each other's callbacks or counters. Every API function that a context applies to has a
+    /// GfnContext* variant that takes the context as its first parameter.
     ///
     /// @par Environment
-    /// Cloud or Client
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to communicate between cloud applications and streaming clients.
-    ///
-    /// @param pchMessage - Character string
-    /// @param length     - Length of pchMessage in characters, which cannot exceed 8K in length
-    ///
-    /// @retval gfnSuccess              - Call was successful
-    /// @retval gfnComError             - There was SDK internal communication error
-    /// @retval gfnAPINotInit           - SDK was not initialized
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    /// @retval gfnInvalidParameter     - Invalid parameters provided, or message exceeded allowed length
-    /// @retval gfnThrottled            - API call was throttled for exceeding limit of 30 messages per second
-    /// @retval gfnUnhandledException   - API ran into an unhandled error and caught an exception before it returned to client code
-    /// @retval gfnCloudLibraryNotFound - GFN SDK cloud-side library could not be found
-    /// @return Otherwise, appropriate error code
-    GfnRuntimeError GfnSendMessage(const char* pchMessage, unsigned int length);
+    /// The first context initializes the SDK as @ref GfnInitializeSdk does, unless it is already
+    /// initialized, and the last context to be destroyed then shuts it down. The GFN SDK libraries are
+    /// loaded once per process, so the library bindings, the environment check, the session snapshot
+    /// and the request schedulers are shared by all contexts, as is the log. Events are delivered to
+    /// the callback registered in every context, and to the one registered through the global API,
+    /// which acts as the default context. Contexts can be used from any thread, and up to 1024 can
+    /// exist at a time.
     ///
+    /// @param language                   - Language to use for any UI, such as GFN download and install progress dialogs.
+    ///                                     Used only if the SDK is not initialized yet.
+    /// @param[out] context               - Receives the new context
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInitSuccessClientOnly  - On success, when only client-side functionality is available
+    /// @retval gfnInvalidParameter       - NULL pointer passed in
+    /// @retval gfnUnableToAllocateMemory - Memory for the context could not be allocated, or too many contexts exist
+    /// @return Otherwise, the error @ref GfnInitializeSdk returned
+    GfnRuntimeError GfnCreateContext(GfnDisplayLanguage language, GfnSdkContext* context);
+
     /// @par Description
-    /// Requests the client application to open a URL in their local web browser.
-    /// 
-    /// These requests are fire-and-forget. Typically, the client will see a popup during their streaming session with a link that
-    /// they can click to open the local web browser.
-    /// 
-    /// Usage of this API is limited to  5 URL requests every second, with no more than 25 URL requests per minute.
+    /// Destroys a context created with @ref GfnCreateContext. Its callbacks are no longer called once
+    /// this returns.
     ///
     /// @par Environment
-    /// Cloud
-    /// 
+    /// Cloud and Client
+    ///
     /// @par Platform
     /// Windows, Linux
     ///
     /// @par Usage
-    /// Use to request that the client application open a URL link in their local web browser.
-    ///
-    /// @param pchUrl - A URL which should be opened on the client's local browser.
-    ///
-    /// @retval gfnSuccess              - Call was successful
-    /// @retval gfnAPINotInit           - SDK was not initialized
-    /// @retval gfnAPINotFound          - The API was not found in the GeForce NOW SDK Library
-    /// @retval gfnCallWrongEnvironment - API was called outside of a cloud execution environment
-    /// @retval gfnInvalidParameter     - Invalid pointer provided, or message exceeded allowed length
-    /// @retval gfnThrottled            - API call was throttled for exceeding limit of 5 messages per second or 25 total per session
-    /// @retval gfnInternalError        - API ran into an internal error
-    /// @return Otherwise, appropriate error code
-    GfnRuntimeError GfnOpenURLOnClient(const char* pchUrl);
+    /// Do not use the context after destroying it, including from other threads. Calling
+    /// @ref GfnShutdownSdk shuts the SDK down for every context; the contexts still have to be destroyed.
+    ///
+    /// @param context                    - Context to destroy
+    /// @retval gfnSuccess                - On success
+    /// @retval gfnInvalidParameter       - NULL context passed in
+    /// @retval gfnCallWrongEnvironment   - Called from an SDK callback
+    /// @return Otherwise, the error @ref GfnShutdownSdk returned when the last context shut the SDK down
+    GfnRuntimeError GfnDestroyContext(GfnSdkContext context);
+
+    /// @name Context variants
+    /// Each of these behaves as the function of the same name without "Context", with callbacks
+    /// registered in and calls counted against the given context. They return gfnInvalidParameter
+    /// if the context is NULL.
+    /// @{
+
+    /// @brief Context variant of @ref GfnIsRunningInCloud
+    GfnRuntimeError GfnContextIsRunningInCloud(GfnSdkContext context, bool* runningInCloud);
+    /// @brief Context variant of @ref GfnIsRunningInCloudSecure
+    GfnRuntimeError GfnContextIsRunningInCloudSecure(GfnSdkContext context, GfnIsRunningInCloudAssurance* assurance);
+    /// @brief Context variant of @ref GfnCloudCheck
+    GfnRuntimeError GfnContextCloudCheck(GfnSdkContext context, const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment);
+    /// @brief Context variant of @ref GfnGetClientIpV4
+    GfnRuntimeError GfnContextGetClientIpV4(GfnSdkContext context, const char** clientIp);
+    /// @brief Context variant of @ref GfnGetClientLanguageCode
+    GfnRuntimeError GfnContextGetClientLanguageCode(GfnSdkContext context, const char** languageCode);
+    /// @brief Context variant of @ref GfnGetClientCountryCode
+    GfnRuntimeError GfnContextGetClientCountryCode(GfnSdkContext context, char* countryCode, unsigned int length);
+    /// @brief Context variant of @ref GfnGetClientInfo
+    GfnRuntimeError GfnContextGetClientInfo(GfnSdkContext context, GfnClientInfo* clientInfo);
+    /// @brief Context variant of @ref GfnGetSessionInfo
+    GfnRuntimeError GfnContextGetSessionInfo(GfnSdkContext context, GfnSessionInfo* sessionInfo);
+    /// @brief Context variant of @ref GfnGetPartnerData
+    GfnRuntimeError GfnContextGetPartnerData(GfnSdkContext context, const char** partnerData);
+    /// @brief Context variant of @ref GfnGetPartnerSecureData
+    GfnRuntimeError GfnContextGetPartnerSecureData(GfnSdkContext context, const char** partnerSecureData);
+    /// @brief Context variant of @ref GfnIsTitleAvailable
+    GfnRuntimeError GfnContextIsTitleAvailable(GfnSdkContext context, const char* platformAppId, bool* isAvailable);
+    /// @brief Context variant of @ref GfnAreTitlesAvailable
+    GfnRuntimeError GfnContextAreTitlesAvailable(GfnSdkContext context, const char** platformAppIds, unsigned int count, bool* isAvailable);
+    /// @brief Context variant of @ref GfnGetTitlesAvailable
+    GfnRuntimeError GfnContextGetTitlesAvailable(GfnSdkContext context, const char** platformAppIds);
+    /// @brief Context variant of @ref GfnFree
+    GfnRuntimeError GfnContextFree(GfnSdkContext context, const char** data);
+    /// @brief Context variant of @ref GfnRegisterStreamStatusCallback
+    GfnRuntimeError GfnContextRegisterStreamStatusCallback(GfnSdkContext context, StreamStatusCallbackSig streamStatusCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterStreamStatusCallback
+    GfnRuntimeError GfnContextUnregisterStreamStatusCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnStartStream
+    GfnRuntimeError GfnContextStartStream(GfnSdkContext context, StartStreamInput* startStreamInput, StartStreamResponse* response);
+    /// @brief Context variant of @ref GfnStartStreamAsync
+    GfnRuntimeError GfnContextStartStreamAsync(GfnSdkContext context, const StartStreamInput* startStreamInput, StartStreamCallbackSig cb, void* userContext, unsigned int timeoutMs);
+    /// @brief Context variant of @ref GfnStopStream
+    GfnRuntimeError GfnContextStopStream(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnStopStreamAsync
+    GfnRuntimeError GfnContextStopStreamAsync(GfnSdkContext context, StopStreamCallbackSig cb, void* userContext, unsigned int timeoutMs);
+    /// @brief Context variant of @ref GfnSetupTitle
+    GfnRuntimeError GfnContextSetupTitle(GfnSdkContext context, const char* platformAppId);
+    /// @brief Context variant of @ref GfnTitleExited
+    GfnRuntimeError GfnContextTitleExited(GfnSdkContext context, const char* platformId, const char* platformAppId);
+    /// @brief Context variant of @ref GfnRegisterExitCallback
+    GfnRuntimeError GfnContextRegisterExitCallback(GfnSdkContext context, ExitCallbackSig exitCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterExitCallback
+    GfnRuntimeError GfnContextUnregisterExitCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterPauseCallback
+    GfnRuntimeError GfnContextRegisterPauseCallback(GfnSdkContext context, PauseCallbackSig pauseCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterPauseCallback
+    GfnRuntimeError GfnContextUnregisterPauseCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterInstallCallback
+    GfnRuntimeError GfnContextRegisterInstallCallback(GfnSdkContext context, InstallCallbackSig installCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterInstallCallback
+    GfnRuntimeError GfnContextUnregisterInstallCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterSaveCallback
+    GfnRuntimeError GfnContextRegisterSaveCallback(GfnSdkContext context, SaveCallbackSig saveCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterSaveCallback
+    GfnRuntimeError GfnContextUnregisterSaveCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterSessionInitCallback
+    GfnRuntimeError GfnContextRegisterSessionInitCallback(GfnSdkContext context, SessionInitCallbackSig sessionInitCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterSessionInitCallback
+    GfnRuntimeError GfnContextUnregisterSessionInitCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterMessageCallback
+    GfnRuntimeError GfnContextRegisterMessageCallback(GfnSdkContext context, MessageCallbackSig messageCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterMessageCallback
+    GfnRuntimeError GfnContextUnregisterMessageCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterClientInfoCallback
+    GfnRuntimeError GfnContextRegisterClientInfoCallback(GfnSdkContext context, ClientInfoCallbackSig clientInfoCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterClientInfoCallback
+    GfnRuntimeError GfnContextUnregisterClientInfoCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterNetworkStatusCallback
+    GfnRuntimeError GfnContextRegisterNetworkStatusCallback(GfnSdkContext context, NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterNetworkStatusCallback
+    GfnRuntimeError GfnContextUnregisterNetworkStatusCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnRegisterQualityAdviceCallback
+    GfnRuntimeError GfnContextRegisterQualityAdviceCallback(GfnSdkContext context, QualityAdviceCallbackSig adviceCallback, void* userContext);
+    /// @brief Context variant of @ref GfnUnregisterQualityAdviceCallback
+    GfnRuntimeError GfnContextUnregisterQualityAdviceCallback(GfnSdkContext context);
+    /// @brief Context variant of @ref GfnAppReady
+    GfnRuntimeError GfnContextAppReady(GfnSdkContext context, bool success, const char* status);
+    /// @brief Context variant of @ref GfnSetActionZone
+    GfnRuntimeError GfnContextSetActionZone(GfnSdkContext context, GfnActionType type, unsigned int id, GfnRect* zone);
+    /// @brief Context variant of @ref GfnSetActionZones
+    GfnRuntimeError GfnContextSetActionZones(GfnSdkContext context, const GfnActionZone* zones, unsigned int count);
+    /// @brief Context variant of @ref GfnSendMessage
+    GfnRuntimeError GfnContextSendMessage(GfnSdkContext context, const char* pchMessage, unsigned int length);
+    /// @brief Context variant of @ref GfnOpenURLOnClient
+    GfnRuntimeError GfnContextOpenURLOnClient(GfnSdkContext context, const char* pchUrl);
+    /// @brief Context variant of @ref GfnGetSessionSnapshot
+    GfnRuntimeError GfnContextGetSessionSnapshot(GfnSdkContext context, GfnSessionSnapshot* snapshot);
+    /// @brief Context variant of @ref GfnGetWrapperStats, covering the calls made through the context
+    GfnRuntimeError GfnContextGetWrapperStats(GfnSdkContext context, GfnWrapperStats* stats);
+    /// @brief Context variant of @ref GfnDumpWrapperStatsJson, covering the calls made through the context
+    GfnRuntimeError GfnContextDumpWrapperStatsJson(GfnSdkContext context, char* buffer, size_t bufferSize, size_t* length);
+    /// @brief Context variant of @ref GfnResetWrapperStats
+    GfnRuntimeError GfnContextResetWrapperStats(GfnSdkContext context);
+    /// @}
     /// @}
 #ifdef __cplusplus
     } // extern "C"
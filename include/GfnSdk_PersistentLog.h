@@ -0,0 +1,272 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Layout of the wrapper's persistent log file, shared by the wrapper and the gfn_log_decode tool.
+// Not part of the public API.
+//
+// The file is memory mapped by the wrapper and holds a header, a table of logging call sites and a
+// ring of fixed-size binary records. A record holds the raw arguments of one log line; the text is
+// only produced by the decoder, from the call site's format string. Records are written with plain
+// stores into the mapping, so they reach the file even if the process crashes.
+//
+// ===============================================================================================
+
+#ifndef __NV_GFNSDK_PERSISTENT_LOG_H__
+#define __NV_GFNSDK_PERSISTENT_LOG_H__
+
+#include "GfnSdk_Platform.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define GFN_PERSISTENT_LOG_MAGIC "GFNPLOG1"
+#define kGfnPersistentLogVersion 1
+#define kGfnPersistentLogHeaderSize 128
+#define kGfnPersistentLogSiteSize 256
+#define kGfnPersistentLogSiteCapacity 512
+#define kGfnPersistentLogFunctionLen 48
+#define kGfnPersistentLogFormatLen (kGfnPersistentLogSiteSize - kGfnPersistentLogFunctionLen - 8)
+#define kGfnPersistentLogRecordSize 128
+#define kGfnPersistentLogPayloadLen (kGfnPersistentLogRecordSize - 32)
+#define kGfnPersistentLogUnknownSite 0xFFFF     // Record of a call site that did not fit in the site table
+#define kGfnPersistentLogTruncated 0x01         // Record flag: not every argument fit in the payload
+
+// Start of the file. The magic is written last, so a file with a valid magic has a complete header.
+typedef struct gfnPersistentLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t siteSize;
+    uint32_t siteCapacity;
+    uint32_t recordSize;
+    uint32_t recordCount;           // Power of two
+    uint64_t baseWallClockMs;       // Wall clock time at baseMonotonicNs, to convert record timestamps
+    uint64_t baseMonotonicNs;
+    uint64_t processId;
+    gfnAtomic32 siteCount;          // Entries used in the site table
+    uint32_t reserved0;
+    gfnAtomic64 nextSequence;       // Sequence number of the last record reserved, starting from 1
+    char padding[kGfnPersistentLogHeaderSize - 72];
+} gfnPersistentLogHeader;
+
+// One logging call site, referred to by index from records
+typedef struct gfnPersistentLogSite
+{
+    uint32_t line;
+    uint32_t reserved0;
+    char function[kGfnPersistentLogFunctionLen];    // Truncated to fit, always terminated
+    char format[kGfnPersistentLogFormatLen];        // Truncated to fit, always terminated
+} gfnPersistentLogSite;
+
+// One log line. A writer claims the slot by swapping the sequence number of the record it replaces for
+// its own, negated, fills in the record and then stores its sequence number. A writer that finds the
+// slot claimed by another writer, or already holding a later record, drops its line instead. A record
+// whose sequence number is not positive or does not map back to its slot was torn by a crash or has
+// not been written yet. The payload holds the arguments in format order: 8 bytes for numbers and
+// pointers, and a length byte followed by the characters for strings.
+typedef struct gfnPersistentLogRecord
+{
+    gfnAtomic64 sequence;
+    uint64_t timestampNs;           // Monotonic clock
+    uint32_t threadId;
+    uint32_t suppressed;            // Lines this call site dropped through rate limiting before this one
+    uint16_t site;
+    uint8_t level;
+    uint8_t flags;
+    uint8_t argCount;
+    uint8_t reserved0[3];
+    uint8_t payload[kGfnPersistentLogPayloadLen];
+} gfnPersistentLogRecord;
+
+// Type of the argument a printf conversion consumes
+typedef enum gfnPersistentLogArg
+{
+    gfnPersistentLogArgNone = 0,    // A conversion that cannot be recorded, such as '*' widths or %n
+    gfnPersistentLogArgInt,
+    gfnPersistentLogArgUnsignedInt,
+    gfnPersistentLogArgLong,
+    gfnPersistentLogArgUnsignedLong,
+    gfnPersistentLogArgLongLong,
+    gfnPersistentLogArgUnsignedLongLong,
+    gfnPersistentLogArgSize,
+    gfnPersistentLogArgPtrDiff,
+    gfnPersistentLogArgDouble,
+    gfnPersistentLogArgString,
+    gfnPersistentLogArgWideString,
+    gfnPersistentLogArgPointer
+} gfnPersistentLogArg;
+
+typedef struct gfnPersistentLogConversion
+{
+    char const* start;              // The '%' that starts the conversion
+    char const* end;                // One past the conversion character
+    char conversion;                // Conversion character, such as 'd' or 's'
+    gfnPersistentLogArg arg;
+} gfnPersistentLogConversion;
+
+GFN_FORCE_INLINE gfnPersistentLogSite* gfnPersistentLogSiteAt(gfnPersistentLogHeader* header, unsigned int index)
+{
+    return (gfnPersistentLogSite*)((char*)header + header->headerSize + (size_t)index * header->siteSize);
+}
+
+GFN_FORCE_INLINE gfnPersistentLogRecord* gfnPersistentLogRecordAt(gfnPersistentLogHeader* header, uint64_t sequence)
+{
+    return (gfnPersistentLogRecord*)((char*)header + header->headerSize + (size_t)header->siteCapacity * header->siteSize +
+        (size_t)((sequence - 1) & (header->recordCount - 1)) * header->recordSize);
+}
+
+// Finds the next conversion in a printf format string, skipping literal text and "%%". Returns false
+// at the end of the format. Writers stop recording arguments at a conversion of gfnPersistentLogArgNone.
+static GFN_MAYBE_UNUSED bool gfnPersistentLogNextConversion(char const* format, gfnPersistentLogConversion* conversion)
+{
+    char const* p = format;
+    int longCount = 0;
+    char size = '\0';
+    bool isSigned;
+
+    for (;;)
+    {
+        while (*p != '\0' && *p != '%')
+        {
+            p++;
+        }
+        if (*p == '\0')
+        {
+            return false;
+        }
+        if (p[1] == '%')
+        {
+            p += 2;
+            continue;
+        }
+        break;
+    }
+
+    conversion->start = p++;
+    conversion->arg = gfnPersistentLogArgNone;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+    {
+        p++;
+    }
+    while ((*p >= '0' && *p <= '9') || *p == '.' || *p == '*')
+    {
+        if (*p == '*')
+        {
+            size = '*';
+        }
+        p++;
+    }
+    for (;; p++)
+    {
+        if (*p == 'l')
+        {
+            longCount++;
+        }
+        else if (*p == 'h' || *p == 'z' || *p == 'j' || *p == 't' || *p == 'L')
+        {
+            size = (size == '*') ? size : *p;
+        }
+        else
+        {
+            break;
+        }
+    }
+    conversion->conversion = *p;
+    conversion->end = (*p != '\0') ? p + 1 : p;
+    if (size == '*' || size == 'L')
+    {
+        return true;
+    }
+
+    isSigned = (*p == 'd' || *p == 'i');
+    switch (*p)
+    {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        if (size == 'z' || size == 't')
+        {
+            conversion->arg = (isSigned || size == 't') ? gfnPersistentLogArgPtrDiff : gfnPersistentLogArgSize;
+        }
+        else if (longCount >= 2 || size == 'j')
+        {
+            conversion->arg = isSigned ? gfnPersistentLogArgLongLong : gfnPersistentLogArgUnsignedLongLong;
+        }
+        else if (longCount == 1)
+        {
+            conversion->arg = isSigned ? gfnPersistentLogArgLong : gfnPersistentLogArgUnsignedLong;
+        }
+        else
+        {
+            conversion->arg = isSigned ? gfnPersistentLogArgInt : gfnPersistentLogArgUnsignedInt;
+        }
+        break;
+    case 'c':
+        conversion->arg = gfnPersistentLogArgInt;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        conversion->arg = gfnPersistentLogArgDouble;
+        break;
+    case 's':
+        conversion->arg = (longCount > 0) ? gfnPersistentLogArgWideString : gfnPersistentLogArgString;
+        break;
+    case 'S':
+        // Wide string in MSVC's printf, used by the Windows log lines, and a synonym of %ls in glibc
+        conversion->arg = gfnPersistentLogArgWideString;
+        break;
+    case 'p':
+        conversion->arg = gfnPersistentLogArgPointer;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // __NV_GFNSDK_PERSISTENT_LOG_H__
@@ -0,0 +1,641 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Internal platform abstractions used by the GFN SDK wrapper. Not part of the public API.
+//
+// ===============================================================================================
+
+#ifndef __NV_GFNSDK_PLATFORM_H__
+#define __NV_GFNSDK_PLATFORM_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#   include <intrin.h>
+#   define GFN_THREAD_LOCAL __declspec(thread)
+#   define GFN_FORCE_INLINE static __forceinline
+#   define GFN_MAYBE_UNUSED
+#elif __linux__
+#   include <pthread.h>
+#   include <sched.h>
+#   include <sys/syscall.h>
+#   include <time.h>
+#   include <unistd.h>
+#   define GFN_THREAD_LOCAL __thread
+#   define GFN_FORCE_INLINE static inline __attribute__((always_inline))
+#   define GFN_MAYBE_UNUSED __attribute__((unused))
+#else
+#   error "Unsupported platform"
+#endif
+
+/// @brief Size used to pad shared counters onto their own cache line
+#define GFN_CACHE_LINE_SIZE 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================================
+// Atomics
+//
+// All read-modify-write operations are sequentially consistent. Loads and stores carry the
+// ordering named in the function.
+// ============================================================================================
+#ifdef _WIN32
+typedef volatile LONG gfnAtomic32;
+typedef volatile LONG64 gfnAtomic64;
+typedef void* volatile gfnAtomicPtr;
+
+GFN_FORCE_INLINE int32_t gfnAtomicLoadAcquire32(gfnAtomic32 const* p)
+{
+#   if defined(_M_ARM64)
+    return (int32_t)__ldar32((unsigned __int32 volatile*)p);
+#   else
+    LONG value = *p;
+    _ReadWriteBarrier();
+    return (int32_t)value;
+#   endif
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicLoadRelaxed32(gfnAtomic32 const* p)
+{
+    return (int32_t)*p;
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicLoad32(gfnAtomic32 const* p)
+{
+#   if defined(_M_ARM64)
+    return (int32_t)__ldar32((unsigned __int32 volatile*)p);
+#   else
+    LONG value = *p;
+    _ReadWriteBarrier();
+    return (int32_t)value;
+#   endif
+}
+
+GFN_FORCE_INLINE void gfnAtomicStoreRelease32(gfnAtomic32* p, int32_t value)
+{
+#   if defined(_M_ARM64)
+    __stlr32((unsigned __int32 volatile*)p, (unsigned __int32)value);
+#   else
+    _ReadWriteBarrier();
+    *p = (LONG)value;
+#   endif
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicAdd32(gfnAtomic32* p, int32_t value)
+{
+    return (int32_t)InterlockedExchangeAdd(p, (LONG)value) + value;
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicExchange32(gfnAtomic32* p, int32_t value)
+{
+    return (int32_t)InterlockedExchange(p, (LONG)value);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicAnd32(gfnAtomic32* p, int32_t value)
+{
+    return (int32_t)InterlockedAnd(p, (LONG)value);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicOr32(gfnAtomic32* p, int32_t value)
+{
+    return (int32_t)InterlockedOr(p, (LONG)value);
+}
+
+// Returns the value observed before the operation; the exchange happened if it equals 'expected'
+GFN_FORCE_INLINE int32_t gfnAtomicCompareExchange32(gfnAtomic32* p, int32_t expected, int32_t desired)
+{
+    return (int32_t)InterlockedCompareExchange(p, (LONG)desired, (LONG)expected);
+}
+
+GFN_FORCE_INLINE int64_t gfnAtomicLoadRelaxed64(gfnAtomic64 const* p)
+{
+#   if defined(_WIN64)
+    return (int64_t)*p;
+#   else
+    return (int64_t)InterlockedCompareExchange64((gfnAtomic64*)p, 0, 0);
+#   endif
+}
+
+GFN_FORCE_INLINE void gfnAtomicStoreRelaxed64(gfnAtomic64* p, int64_t value)
+{
+#   if defined(_WIN64)
+    *p = (LONG64)value;
+#   else
+    InterlockedExchange64(p, (LONG64)value);
+#   endif
+}
+
+GFN_FORCE_INLINE int64_t gfnAtomicAdd64(gfnAtomic64* p, int64_t value)
+{
+    return (int64_t)InterlockedExchangeAdd64(p, (LONG64)value) + value;
+}
+
+GFN_FORCE_INLINE int64_t gfnAtomicExchange64(gfnAtomic64* p, int64_t value)
+{
+    return (int64_t)InterlockedExchange64(p, (LONG64)value);
+}
+
+// Returns the value observed before the operation; the exchange happened if it equals 'expected'
+GFN_FORCE_INLINE int64_t gfnAtomicCompareExchange64(gfnAtomic64* p, int64_t expected, int64_t desired)
+{
+    return (int64_t)InterlockedCompareExchange64(p, (LONG64)desired, (LONG64)expected);
+}
+
+GFN_FORCE_INLINE void* gfnAtomicLoadAcquirePtr(gfnAtomicPtr const* p)
+{
+#   if defined(_M_ARM64)
+    return (void*)__ldar64((unsigned __int64 volatile*)p);
+#   else
+    void* value = *p;
+    _ReadWriteBarrier();
+    return value;
+#   endif
+}
+
+GFN_FORCE_INLINE void gfnAtomicStoreReleasePtr(gfnAtomicPtr* p, void* value)
+{
+    _ReadWriteBarrier();
+    InterlockedExchangePointer((PVOID volatile*)p, value);
+}
+
+GFN_FORCE_INLINE void* gfnAtomicCompareExchangePtr(gfnAtomicPtr* p, void* expected, void* desired)
+{
+    return InterlockedCompareExchangePointer((PVOID volatile*)p, desired, expected);
+}
+
+GFN_FORCE_INLINE void gfnAtomicFence(void)
+{
+    MemoryBarrier();
+}
+
+GFN_FORCE_INLINE void gfnCpuRelax(void)
+{
+    YieldProcessor();
+}
+
+GFN_FORCE_INLINE void gfnThreadYield(void)
+{
+    SwitchToThread();
+}
+#elif __linux__
+typedef volatile int32_t gfnAtomic32;
+typedef volatile int64_t gfnAtomic64;
+typedef void* volatile gfnAtomicPtr;
+
+GFN_FORCE_INLINE int32_t gfnAtomicLoadAcquire32(gfnAtomic32 const* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicLoadRelaxed32(gfnAtomic32 const* p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicLoad32(gfnAtomic32 const* p)
+{
+    return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+}
+
+GFN_FORCE_INLINE void gfnAtomicStoreRelease32(gfnAtomic32* p, int32_t value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicAdd32(gfnAtomic32* p, int32_t value)
+{
+    return __atomic_add_fetch(p, value, __ATOMIC_SEQ_CST);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicExchange32(gfnAtomic32* p, int32_t value)
+{
+    return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicAnd32(gfnAtomic32* p, int32_t value)
+{
+    return __atomic_fetch_and(p, value, __ATOMIC_SEQ_CST);
+}
+
+GFN_FORCE_INLINE int32_t gfnAtomicOr32(gfnAtomic32* p, int32_t value)
+{
+    return __atomic_fetch_or(p, value, __ATOMIC_SEQ_CST);
+}
+
+// Returns the value observed before the operation; the exchange happened if it equals 'expected'
+GFN_FORCE_INLINE int32_t gfnAtomicCompareExchange32(gfnAtomic32* p, int32_t expected, int32_t desired)
+{
+    __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;
+}
+
+GFN_FORCE_INLINE int64_t gfnAtomicLoadRelaxed64(gfnAtomic64 const* p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+GFN_FORCE_INLINE void gfnAtomicStoreRelaxed64(gfnAtomic64* p, int64_t value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELAXED);
+}
+
+GFN_FORCE_INLINE int64_t gfnAtomicAdd64(gfnAtomic64* p, int64_t value)
+{
+    return __atomic_add_fetch(p, value, __ATOMIC_SEQ_CST);
+}
+
+GFN_FORCE_INLINE int64_t gfnAtomicExchange64(gfnAtomic64* p, int64_t value)
+{
+    return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+}
+
+// Returns the value observed before the operation; the exchange happened if it equals 'expected'
+GFN_FORCE_INLINE int64_t gfnAtomicCompareExchange64(gfnAtomic64* p, int64_t expected, int64_t desired)
+{
+    __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;
+}
+
+GFN_FORCE_INLINE void* gfnAtomicLoadAcquirePtr(gfnAtomicPtr const* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+GFN_FORCE_INLINE void gfnAtomicStoreReleasePtr(gfnAtomicPtr* p, void* value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+GFN_FORCE_INLINE void* gfnAtomicCompareExchangePtr(gfnAtomicPtr* p, void* expected, void* desired)
+{
+    __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;
+}
+
+GFN_FORCE_INLINE void gfnAtomicFence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+GFN_FORCE_INLINE void gfnCpuRelax(void)
+{
+#   if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#   elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#   endif
+}
+
+GFN_FORCE_INLINE void gfnThreadYield(void)
+{
+    sched_yield();
+}
+#endif
+
+// ============================================================================================
+// Threads, locks and clocks
+// ============================================================================================
+#ifdef _WIN32
+typedef HANDLE gfnThread;
+typedef SRWLOCK gfnMutex;
+typedef CONDITION_VARIABLE gfnCondVar;
+#   define GFN_THREAD_PROC DWORD WINAPI
+#   define GFN_THREAD_RETURN 0
+#   define GFN_MUTEX_INITIALIZER SRWLOCK_INIT
+#   define GFN_CONDVAR_INITIALIZER CONDITION_VARIABLE_INIT
+typedef DWORD (WINAPI *gfnThreadProc)(void* arg);
+typedef DWORD gfnThreadKey;
+#   define GFN_THREAD_KEY_DESTRUCTOR VOID NTAPI
+typedef PFLS_CALLBACK_FUNCTION gfnThreadKeyDestructor;
+
+GFN_FORCE_INLINE bool gfnThreadCreate(gfnThread* thread, gfnThreadProc proc, void* arg)
+{
+    *thread = CreateThread(NULL, 0, proc, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+GFN_FORCE_INLINE void gfnThreadJoin(gfnThread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+// The thread keeps running and is never joined
+GFN_FORCE_INLINE void gfnThreadDetach(gfnThread thread)
+{
+    CloseHandle(thread);
+}
+
+// The destructor runs on a thread that exits with a non-NULL value set for the key
+GFN_FORCE_INLINE bool gfnThreadKeyCreate(gfnThreadKey* key, gfnThreadKeyDestructor destructor)
+{
+    *key = FlsAlloc(destructor);
+    return *key != FLS_OUT_OF_INDEXES;
+}
+
+GFN_FORCE_INLINE void gfnThreadKeySet(gfnThreadKey key, void* value)
+{
+    FlsSetValue(key, value);
+}
+
+GFN_FORCE_INLINE uint64_t gfnGetCurrentThreadId(void)
+{
+    return (uint64_t)GetCurrentThreadId();
+}
+
+GFN_FORCE_INLINE uint64_t gfnGetCurrentProcessId(void)
+{
+    return (uint64_t)GetCurrentProcessId();
+}
+
+GFN_FORCE_INLINE void gfnMutexInit(gfnMutex* mutex)
+{
+    InitializeSRWLock(mutex);
+}
+
+GFN_FORCE_INLINE void gfnMutexLock(gfnMutex* mutex)
+{
+    AcquireSRWLockExclusive(mutex);
+}
+
+GFN_FORCE_INLINE bool gfnMutexTryLock(gfnMutex* mutex)
+{
+    return TryAcquireSRWLockExclusive(mutex) != 0;
+}
+
+GFN_FORCE_INLINE void gfnMutexUnlock(gfnMutex* mutex)
+{
+    ReleaseSRWLockExclusive(mutex);
+}
+
+GFN_FORCE_INLINE void gfnCondVarInit(gfnCondVar* condVar)
+{
+    InitializeConditionVariable(condVar);
+}
+
+// Returns false if the wait timed out
+GFN_FORCE_INLINE bool gfnCondVarWait(gfnCondVar* condVar, gfnMutex* mutex, unsigned int timeoutMs)
+{
+    return SleepConditionVariableSRW(condVar, mutex, timeoutMs, 0) != 0;
+}
+
+GFN_FORCE_INLINE void gfnCondVarWaitForever(gfnCondVar* condVar, gfnMutex* mutex)
+{
+    SleepConditionVariableSRW(condVar, mutex, INFINITE, 0);
+}
+
+GFN_FORCE_INLINE void gfnCondVarSignal(gfnCondVar* condVar)
+{
+    WakeConditionVariable(condVar);
+}
+
+GFN_FORCE_INLINE void gfnCondVarBroadcast(gfnCondVar* condVar)
+{
+    WakeAllConditionVariable(condVar);
+}
+
+GFN_FORCE_INLINE void gfnSleepMs(unsigned int milliseconds)
+{
+    Sleep(milliseconds);
+}
+
+GFN_FORCE_INLINE uint64_t gfnGetMonotonicNs(void)
+{
+    static LARGE_INTEGER s_frequency;
+    LARGE_INTEGER counter;
+    if (s_frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&s_frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((counter.QuadPart / s_frequency.QuadPart) * 1000000000ULL +
+        ((counter.QuadPart % s_frequency.QuadPart) * 1000000000ULL) / s_frequency.QuadPart);
+}
+
+// Milliseconds since the Unix epoch
+GFN_FORCE_INLINE uint64_t gfnGetWallClockMs(void)
+{
+    FILETIME fileTime;
+    ULARGE_INTEGER ticks;
+    GetSystemTimeAsFileTime(&fileTime);
+    ticks.LowPart = fileTime.dwLowDateTime;
+    ticks.HighPart = fileTime.dwHighDateTime;
+    return (ticks.QuadPart - 116444736000000000ULL) / 10000ULL;
+}
+#elif __linux__
+typedef pthread_t gfnThread;
+typedef pthread_mutex_t gfnMutex;
+typedef pthread_cond_t gfnCondVar;
+#   define GFN_THREAD_PROC void*
+#   define GFN_THREAD_RETURN NULL
+#   define GFN_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#   define GFN_CONDVAR_INITIALIZER PTHREAD_COND_INITIALIZER
+typedef void* (*gfnThreadProc)(void* arg);
+typedef pthread_key_t gfnThreadKey;
+#   define GFN_THREAD_KEY_DESTRUCTOR void
+typedef void (*gfnThreadKeyDestructor)(void* value);
+
+GFN_FORCE_INLINE bool gfnThreadCreate(gfnThread* thread, gfnThreadProc proc, void* arg)
+{
+    return pthread_create(thread, NULL, proc, arg) == 0;
+}
+
+GFN_FORCE_INLINE void gfnThreadJoin(gfnThread thread)
+{
+    pthread_join(thread, NULL);
+}
+
+// The thread keeps running and is never joined
+GFN_FORCE_INLINE void gfnThreadDetach(gfnThread thread)
+{
+    pthread_detach(thread);
+}
+
+// The destructor runs on a thread that exits with a non-NULL value set for the key
+GFN_FORCE_INLINE bool gfnThreadKeyCreate(gfnThreadKey* key, gfnThreadKeyDestructor destructor)
+{
+    return pthread_key_create(key, destructor) == 0;
+}
+
+GFN_FORCE_INLINE void gfnThreadKeySet(gfnThreadKey key, void* value)
+{
+    pthread_setspecific(key, value);
+}
+
+// Kernel thread id, as shown by tools such as perf and top
+GFN_FORCE_INLINE uint64_t gfnGetCurrentThreadId(void)
+{
+    return (uint64_t)syscall(SYS_gettid);
+}
+
+GFN_FORCE_INLINE uint64_t gfnGetCurrentProcessId(void)
+{
+    return (uint64_t)getpid();
+}
+
+GFN_FORCE_INLINE void gfnMutexInit(gfnMutex* mutex)
+{
+    pthread_mutex_init(mutex, NULL);
+}
+
+GFN_FORCE_INLINE void gfnMutexLock(gfnMutex* mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+GFN_FORCE_INLINE bool gfnMutexTryLock(gfnMutex* mutex)
+{
+    return pthread_mutex_trylock(mutex) == 0;
+}
+
+GFN_FORCE_INLINE void gfnMutexUnlock(gfnMutex* mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+GFN_FORCE_INLINE void gfnCondVarInit(gfnCondVar* condVar)
+{
+    pthread_cond_init(condVar, NULL);
+}
+
+// Returns false if the wait timed out
+GFN_FORCE_INLINE bool gfnCondVarWait(gfnCondVar* condVar, gfnMutex* mutex, unsigned int timeoutMs)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(condVar, mutex, &deadline) == 0;
+}
+
+GFN_FORCE_INLINE void gfnCondVarWaitForever(gfnCondVar* condVar, gfnMutex* mutex)
+{
+    pthread_cond_wait(condVar, mutex);
+}
+
+GFN_FORCE_INLINE void gfnCondVarSignal(gfnCondVar* condVar)
+{
+    pthread_cond_signal(condVar);
+}
+
+GFN_FORCE_INLINE void gfnCondVarBroadcast(gfnCondVar* condVar)
+{
+    pthread_cond_broadcast(condVar);
+}
+
+GFN_FORCE_INLINE void gfnSleepMs(unsigned int milliseconds)
+{
+    struct timespec duration;
+    duration.tv_sec = milliseconds / 1000;
+    duration.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+    nanosleep(&duration, NULL);
+}
+
+GFN_FORCE_INLINE uint64_t gfnGetMonotonicNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// Milliseconds since the Unix epoch
+GFN_FORCE_INLINE uint64_t gfnGetWallClockMs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * 1000ULL + (uint64_t)now.tv_nsec / 1000000ULL;
+}
+#endif
+
+// ============================================================================================
+// Cycle counter
+//
+// gfnReadTicks is the cheapest monotonic timestamp the platform offers, meant for timing hot
+// paths. On x86 and x64 it reads the invariant TSC, whose rate is not known up front, so
+// callers convert tick deltas to nanoseconds by comparing against gfnGetMonotonicNs over a
+// longer interval. Elsewhere it falls back to the monotonic clock and GFN_TICKS_ARE_NS is set.
+// ============================================================================================
+#if defined(_M_X64) || defined(_M_IX86)
+GFN_FORCE_INLINE uint64_t gfnReadTicks(void)
+{
+    return (uint64_t)__rdtsc();
+}
+#elif defined(__x86_64__) || defined(__i386__)
+GFN_FORCE_INLINE uint64_t gfnReadTicks(void)
+{
+    return (uint64_t)__builtin_ia32_rdtsc();
+}
+#else
+#   define GFN_TICKS_ARE_NS 1
+GFN_FORCE_INLINE uint64_t gfnReadTicks(void)
+{
+    return gfnGetMonotonicNs();
+}
+#endif
+
+// Index of the highest set bit; value must be non-zero
+GFN_FORCE_INLINE unsigned int gfnHighestBit64(uint64_t value)
+{
+#ifdef _WIN32
+#   if defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (unsigned int)index;
+#   else
+    unsigned long index;
+    if (_BitScanReverse(&index, (unsigned long)(value >> 32)))
+    {
+        return (unsigned int)index + 32;
+    }
+    _BitScanReverse(&index, (unsigned long)value);
+    return (unsigned int)index;
+#   endif
+#else
+    return 63u - (unsigned int)__builtin_clzll(value);
+#endif
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // __NV_GFNSDK_PLATFORM_H__
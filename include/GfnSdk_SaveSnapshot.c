@@ -0,0 +1,397 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+
+#include "GfnRuntimeSdk_Wrapper.h"
+#include "GfnSdk_SaveSnapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <wchar.h>
+#   define PLATFORM_MAX_PATH MAX_PATH
+#elif __linux__
+#   include <limits.h>      // PATH_MAX
+#   include <libgen.h>      // dirname
+#   include <unistd.h>      // write, fsync
+#   include <errno.h>       // errno
+#   include <fcntl.h>       // open
+#   define PLATFORM_MAX_PATH PATH_MAX
+#else
+#   error "Unsupported platform"
+#endif
+
+#define kGfnSaveSnapshotMinMatch 4
+#define kGfnSaveSnapshotMaxOffset 65535
+
+uint64_t gfnSaveSnapshotChecksum(uint8_t const* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint32_t gfnReadSnapshotWord(uint8_t const* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Appends a sequence to the compressed data. matchLength is 0 for the last sequence. Returns false if
+// the sequence does not fit in the output.
+static bool gfnEmitSnapshotSequence(uint8_t* out, size_t capacity, size_t* position, uint8_t const* literals,
+    size_t literalLength, size_t offset, size_t matchLength)
+{
+    size_t extraMatch = (matchLength != 0) ? matchLength - kGfnSaveSnapshotMinMatch : 0;
+    size_t needed = 1 + literalLength / 255 + 1 + literalLength + 2 + extraMatch / 255 + 1;
+    size_t o = *position;
+    size_t n;
+
+    if (o + needed > capacity)
+    {
+        return false;
+    }
+    out[o++] = (uint8_t)(((literalLength < 15) ? literalLength : 15) << 4 | ((extraMatch < 15) ? extraMatch : 15));
+    if (literalLength >= 15)
+    {
+        for (n = literalLength - 15; n >= 255; n -= 255)
+        {
+            out[o++] = 255;
+        }
+        out[o++] = (uint8_t)n;
+    }
+    memcpy(out + o, literals, literalLength);
+    o += literalLength;
+    if (matchLength != 0)
+    {
+        out[o++] = (uint8_t)(offset & 0xFF);
+        out[o++] = (uint8_t)(offset >> 8);
+        if (extraMatch >= 15)
+        {
+            for (n = extraMatch - 15; n >= 255; n -= 255)
+            {
+                out[o++] = 255;
+            }
+            out[o++] = (uint8_t)n;
+        }
+    }
+    *position = o;
+    return true;
+}
+
+// Greedy LZ77 with a single-entry hash table of 4-byte sequences. Returns the compressed size, or 0 if
+// the data does not compress into capacity bytes.
+size_t gfnCompressSnapshot(uint8_t const* in, size_t size, uint8_t* out, size_t capacity, uint32_t* table)
+{
+    size_t anchor = 0;
+    size_t position = 0;
+    size_t o = 0;
+    size_t candidate;
+    size_t length;
+    uint32_t sequence;
+    uint32_t hash;
+
+    memset(table, 0, kGfnSaveSnapshotHashTableSize);
+    while (position + kGfnSaveSnapshotMinMatch <= size)
+    {
+        sequence = gfnReadSnapshotWord(in + position);
+        hash = (sequence * 2654435761u) >> (32 - kGfnSaveSnapshotHashBits);
+        // Entries hold the position plus one, so 0 is empty; buffers are smaller than 4 GB
+        candidate = table[hash];
+        table[hash] = (uint32_t)(position + 1);
+        if (candidate == 0 || position - (candidate - 1) > kGfnSaveSnapshotMaxOffset ||
+            gfnReadSnapshotWord(in + candidate - 1) != sequence)
+        {
+            position++;
+            continue;
+        }
+        candidate--;
+        length = kGfnSaveSnapshotMinMatch;
+        while (position + length < size && in[candidate + length] == in[position + length])
+        {
+            length++;
+        }
+        if (!gfnEmitSnapshotSequence(out, capacity, &o, in + anchor, position - anchor, position - candidate, length))
+        {
+            return 0;
+        }
+        position += length;
+        anchor = position;
+    }
+    if (anchor < size && !gfnEmitSnapshotSequence(out, capacity, &o, in + anchor, size - anchor, 0, 0))
+    {
+        return 0;
+    }
+    return o;
+}
+
+// Reads a length extended with bytes of 255. Returns false if the input ends first.
+static bool gfnReadSnapshotLength(uint8_t const* in, size_t size, size_t* i, size_t* length)
+{
+    uint8_t byte;
+
+    do
+    {
+        if (*i >= size)
+        {
+            return false;
+        }
+        byte = in[(*i)++];
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// Returns false if the data is not a valid compressed snapshot of exactly outSize bytes
+bool gfnDecompressSnapshot(uint8_t const* in, size_t size, uint8_t* out, size_t outSize)
+{
+    size_t i = 0;
+    size_t o = 0;
+    size_t literalLength;
+    size_t matchLength;
+    size_t offset;
+    uint8_t token;
+
+    while (i < size)
+    {
+        token = in[i++];
+        literalLength = token >> 4;
+        if (literalLength == 15 && !gfnReadSnapshotLength(in, size, &i, &literalLength))
+        {
+            return false;
+        }
+        if (literalLength > size - i || literalLength > outSize - o)
+        {
+            return false;
+        }
+        memcpy(out + o, in + i, literalLength);
+        i += literalLength;
+        o += literalLength;
+        if (i == size)
+        {
+            break;
+        }
+        if (size - i < 2)
+        {
+            return false;
+        }
+        offset = (size_t)in[i] | ((size_t)in[i + 1] << 8);
+        i += 2;
+        matchLength = token & 15;
+        if (matchLength == 15 && !gfnReadSnapshotLength(in, size, &i, &matchLength))
+        {
+            return false;
+        }
+        matchLength += kGfnSaveSnapshotMinMatch;
+        if (offset == 0 || offset > o || matchLength > outSize - o)
+        {
+            return false;
+        }
+        // Byte by byte, since a match can overlap its own output
+        for (; matchLength > 0; matchLength--, o++)
+        {
+            out[o] = out[o - offset];
+        }
+    }
+    return o == outSize;
+}
+
+// Writes the snapshot to a temporary file next to path, flushes it to the disk and renames it over path
+GfnRuntimeError gfnWriteSnapshotFile(CHAR_TYPE const* path, gfnSaveSnapshotHeader const* header,
+    uint64_t const* regionSizes, uint8_t const* data)
+{
+    CHAR_TYPE temporaryPath[PLATFORM_MAX_PATH];
+    void const* parts[3];
+    size_t sizes[3];
+    bool written = true;
+    int i;
+#ifdef _WIN32
+    HANDLE file;
+    DWORD chunk;
+    size_t offset;
+#elif __linux__
+    char directory[PLATFORM_MAX_PATH];
+    int fd;
+    ssize_t chunk;
+    size_t offset;
+#endif
+
+    parts[0] = header;
+    sizes[0] = sizeof(*header);
+    parts[1] = regionSizes;
+    sizes[1] = header->regionCount * sizeof(uint64_t);
+    parts[2] = data;
+    sizes[2] = (size_t)header->storedSize;
+
+#ifdef _WIN32
+    wcscpy_s(temporaryPath, PLATFORM_MAX_PATH, path);
+    wcscat_s(temporaryPath, PLATFORM_MAX_PATH, L".tmp");
+    file = CreateFileW(temporaryPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return gfnInternalError;
+    }
+    for (i = 0; i < 3 && written; i++)
+    {
+        for (offset = 0; offset < sizes[i] && written; offset += chunk)
+        {
+            chunk = (sizes[i] - offset > 0x40000000) ? 0x40000000 : (DWORD)(sizes[i] - offset);
+            written = WriteFile(file, (uint8_t const*)parts[i] + offset, chunk, &chunk, NULL) && chunk != 0;
+        }
+    }
+    written = written && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!written || !MoveFileExW(temporaryPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        DeleteFileW(temporaryPath);
+        return gfnInternalError;
+    }
+#elif __linux__
+    strcpy(temporaryPath, path);
+    strcat(temporaryPath, ".tmp");
+    fd = open(temporaryPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return gfnInternalError;
+    }
+    for (i = 0; i < 3 && written; i++)
+    {
+        for (offset = 0; offset < sizes[i] && written; offset += (chunk > 0) ? (size_t)chunk : 0)
+        {
+            chunk = write(fd, (uint8_t const*)parts[i] + offset, sizes[i] - offset);
+            written = chunk > 0 || (chunk < 0 && errno == EINTR);
+        }
+    }
+    written = written && fsync(fd) == 0;
+    close(fd);
+    if (!written || rename(temporaryPath, path) != 0)
+    {
+        unlink(temporaryPath);
+        return gfnInternalError;
+    }
+    // The rename itself is only durable once the directory is flushed
+    strcpy(directory, path);
+    fd = open(dirname(directory), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+#endif
+    return gfnSuccess;
+}
+
+// Reads a whole file into memory. Returns gfnNoData if it does not exist.
+GfnRuntimeError gfnReadSnapshotFile(CHAR_TYPE const* path, uint8_t** data, size_t* size)
+{
+    FILE* file = NULL;
+    long length;
+
+#ifdef _WIN32
+    _wfopen_s(&file, path, L"rb");
+#elif __linux__
+    file = fopen(path, "rb");
+#endif
+    if (file == NULL)
+    {
+        return gfnNoData;
+    }
+    if (fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+    {
+        fclose(file);
+        return gfnInternalError;
+    }
+    *data = (uint8_t*)malloc((size_t)length + 1);
+    if (*data == NULL)
+    {
+        fclose(file);
+        return gfnUnableToAllocateMemory;
+    }
+    *size = fread(*data, 1, (size_t)length, file);
+    fclose(file);
+    return (*size == (size_t)length) ? gfnSuccess : gfnInternalError;
+}
+
+bool gfnParseSnapshotHeader(uint8_t const* file, size_t fileSize, uint32_t maxRegions, gfnSaveSnapshotHeader* header)
+{
+    memset(header, 0, sizeof(*header));
+    if (fileSize >= sizeof(*header))
+    {
+        memcpy(header, file, sizeof(*header));
+    }
+    return memcmp(header->magic, kGfnSaveSnapshotMagic, sizeof(header->magic)) == 0 && header->version == kGfnSaveSnapshotVersion &&
+        header->headerSize == sizeof(*header) && header->regionCount <= maxRegions &&
+        fileSize - sizeof(*header) >= header->regionCount * sizeof(uint64_t) &&
+        fileSize - sizeof(*header) - header->regionCount * sizeof(uint64_t) == header->storedSize &&
+        header->rawSize <= 0xFFFFFFFFu;
+}
+
+uint64_t gfnSnapshotRegionSize(uint8_t const* file, uint32_t region)
+{
+    uint64_t size;
+    memcpy(&size, file + sizeof(gfnSaveSnapshotHeader) + region * sizeof(uint64_t), sizeof(size));
+    return size;
+}
+
+GfnRuntimeError gfnDecodeSnapshotData(uint8_t const* file, gfnSaveSnapshotHeader const* header, uint8_t** raw,
+    uint8_t const** data)
+{
+    uint8_t const* payload = file + sizeof(*header) + header->regionCount * sizeof(uint64_t);
+
+    *raw = NULL;
+    if (header->flags & kGfnSaveSnapshotCompressed)
+    {
+        *raw = (uint8_t*)malloc((size_t)header->rawSize + 1);
+        if (*raw == NULL)
+        {
+            return gfnUnableToAllocateMemory;
+        }
+        if (!gfnDecompressSnapshot(payload, (size_t)header->storedSize, *raw, (size_t)header->rawSize))
+        {
+            return gfnInternalError;
+        }
+        payload = *raw;
+    }
+    else if (header->storedSize != header->rawSize)
+    {
+        return gfnInternalError;
+    }
+    if (gfnSaveSnapshotChecksum(payload, (size_t)header->rawSize) != header->checksum)
+    {
+        return gfnInternalError;
+    }
+    *data = payload;
+    return gfnSuccess;
+}
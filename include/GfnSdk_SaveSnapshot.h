@@ -0,0 +1,111 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+
+//
+// ===============================================================================================
+//
+// Save snapshot file of the wrapper: its layout, the compressor and the durable write. Not part of
+// the public API; the snapshot pipeline in GfnRuntimeSdk_Wrapper.c captures the regions and runs the
+// writer thread.
+//
+// The file starts with a gfnSaveSnapshotHeader, followed by the size of each region as a uint64_t and
+// the data, stored as is or compressed. Values are in the byte order of the machine, little-endian on
+// every supported platform. The compressed data is a series of LZ77 sequences laid out as in LZ4: a
+// token holding the literal length in its high nibble and the match length minus 4 in its low nibble,
+// each extended with bytes of 255 and a final smaller byte when the nibble is 15, the literals, and a
+// 16-bit match offset. The last sequence has no match.
+//
+// ===============================================================================================
+
+#ifndef __NV_GFNSDK_SAVE_SNAPSHOT_H__
+#define __NV_GFNSDK_SAVE_SNAPSHOT_H__
+
+// Uses CHAR_TYPE and GfnRuntimeError: include after GfnRuntimeSdk_Wrapper.h, which has no include guard
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define kGfnSaveSnapshotMagic "GFNSAVE1"
+#define kGfnSaveSnapshotVersion 1
+#define kGfnSaveSnapshotCompressed 0x1          // Header flag
+#define kGfnSaveSnapshotHashBits 14
+#define kGfnSaveSnapshotHashTableSize (sizeof(uint32_t) << kGfnSaveSnapshotHashBits)
+
+typedef struct gfnSaveSnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t regionCount;
+    uint32_t headerSize;            // Size of this header, the region sizes follow it
+    uint64_t snapshotId;
+    uint64_t rawSize;               // Total size of the regions
+    uint64_t storedSize;            // Size of the data following the region sizes
+    uint64_t checksum;              // FNV-1a of the regions
+} gfnSaveSnapshotHeader;
+
+// FNV-1a of the data
+uint64_t gfnSaveSnapshotChecksum(uint8_t const* data, size_t size);
+
+// Greedy LZ77 with a single-entry hash table of 4-byte sequences, of kGfnSaveSnapshotHashTableSize
+// bytes. Returns the compressed size, or 0 if the data does not compress into capacity bytes.
+size_t gfnCompressSnapshot(uint8_t const* in, size_t size, uint8_t* out, size_t capacity, uint32_t* table);
+
+// Returns false if the data is not a valid compressed snapshot of exactly outSize bytes
+bool gfnDecompressSnapshot(uint8_t const* in, size_t size, uint8_t* out, size_t outSize);
+
+// Writes the snapshot to a temporary file next to path, flushes it to the disk and renames it over path
+GfnRuntimeError gfnWriteSnapshotFile(CHAR_TYPE const* path, gfnSaveSnapshotHeader const* header,
+    uint64_t const* regionSizes, uint8_t const* data);
+
+// Reads a whole file into memory, which the caller frees. Returns gfnNoData if it does not exist.
+GfnRuntimeError gfnReadSnapshotFile(CHAR_TYPE const* path, uint8_t** data, size_t* size);
+
+// Checks the header of a snapshot file read with gfnReadSnapshotFile and copies it out. Returns false
+// if the file is not a snapshot of at most maxRegions regions, or its size does not match the header.
+bool gfnParseSnapshotHeader(uint8_t const* file, size_t fileSize, uint32_t maxRegions, gfnSaveSnapshotHeader* header);
+
+// Size of a region, from the table following the header
+uint64_t gfnSnapshotRegionSize(uint8_t const* file, uint32_t region);
+
+// Finds the data of a snapshot file whose header was checked with gfnParseSnapshotHeader, decompressing
+// it into a buffer returned in raw, which the caller frees, and verifies its checksum. Returns
+// gfnInternalError if the data is corrupted.
+GfnRuntimeError gfnDecodeSnapshotData(uint8_t const* file, gfnSaveSnapshotHeader const* header, uint8_t** raw,
+    uint8_t const** data);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // __NV_GFNSDK_SAVE_SNAPSHOT_H__
@@ -0,0 +1,165 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Minimal JSON writer shared by the wrapper development tools. Values are written as they are
+// added, with keys passed as NULL for array elements.
+//
+// ===============================================================================================
+
+#ifndef __NV_GFNSDK_TOOL_JSON_H__
+#define __NV_GFNSDK_TOOL_JSON_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GFN_JSON_MAX_DEPTH 16
+
+typedef struct gfnJsonWriter
+{
+    FILE* file;
+    unsigned int depth;
+    bool first[GFN_JSON_MAX_DEPTH];
+} gfnJsonWriter;
+
+static inline void gfnJsonInit(gfnJsonWriter* json, FILE* file)
+{
+    unsigned int i;
+
+    json->file = file;
+    json->depth = 0;
+    for (i = 0; i < GFN_JSON_MAX_DEPTH; i++)
+    {
+        json->first[i] = true;
+    }
+}
+
+static inline void gfnJsonSeparator(gfnJsonWriter* json, const char* key)
+{
+    unsigned int i;
+
+    if (json->depth == 0)
+    {
+        return;
+    }
+    fputs(json->first[json->depth] ? "\n" : ",\n", json->file);
+    json->first[json->depth] = false;
+    for (i = 0; i < json->depth; i++)
+    {
+        fputs("  ", json->file);
+    }
+    if (key != NULL)
+    {
+        fprintf(json->file, "\"%s\": ", key);
+    }
+}
+
+// Opens an object with '{' or an array with '['
+static inline void gfnJsonOpen(gfnJsonWriter* json, const char* key, char bracket)
+{
+    gfnJsonSeparator(json, key);
+    fputc(bracket, json->file);
+    json->depth++;
+    json->first[json->depth] = true;
+}
+
+static inline void gfnJsonClose(gfnJsonWriter* json, char bracket)
+{
+    unsigned int i;
+
+    json->depth--;
+    fputc('\n', json->file);
+    for (i = 0; i < json->depth; i++)
+    {
+        fputs("  ", json->file);
+    }
+    fputc(bracket, json->file);
+    if (json->depth == 0)
+    {
+        fputc('\n', json->file);
+    }
+}
+
+static inline void gfnJsonNumber(gfnJsonWriter* json, const char* key, double value)
+{
+    gfnJsonSeparator(json, key);
+    fprintf(json->file, "%.2f", value);
+}
+
+static inline void gfnJsonInteger(gfnJsonWriter* json, const char* key, uint64_t value)
+{
+    gfnJsonSeparator(json, key);
+    fprintf(json->file, "%llu", (unsigned long long)value);
+}
+
+static inline void gfnJsonSigned(gfnJsonWriter* json, const char* key, int64_t value)
+{
+    gfnJsonSeparator(json, key);
+    fprintf(json->file, "%lld", (long long)value);
+}
+
+static inline void gfnJsonBool(gfnJsonWriter* json, const char* key, bool value)
+{
+    gfnJsonSeparator(json, key);
+    fputs(value ? "true" : "false", json->file);
+}
+
+// Writes a string, or null. Control characters are dropped, since only names and paths are written.
+static inline void gfnJsonString(gfnJsonWriter* json, const char* key, const char* value)
+{
+    gfnJsonSeparator(json, key);
+    if (value == NULL)
+    {
+        fputs("null", json->file);
+        return;
+    }
+    fputc('"', json->file);
+    for (; *value != '\0'; value++)
+    {
+        if (*value == '"' || *value == '\\')
+        {
+            fputc('\\', json->file);
+        }
+        if ((unsigned char)*value >= 0x20)
+        {
+            fputc(*value, json->file);
+        }
+    }
+    fputc('"', json->file);
+}
+
+// Writes an already formatted JSON value
+static inline void gfnJsonRaw(gfnJsonWriter* json, const char* key, const char* value)
+{
+    gfnJsonSeparator(json, key);
+    fputs(value, json->file);
+}
+
+#endif // __NV_GFNSDK_TOOL_JSON_H__
@@ -0,0 +1,92 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Helpers for the wrapper development tools that run the wrapper against the mock runtime
+// library (tools/MockRuntime). Linux only.
+//
+// ===============================================================================================
+
+#ifndef __NV_GFNSDK_TOOL_MOCK_RUNTIME_H__
+#define __NV_GFNSDK_TOOL_MOCK_RUNTIME_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if !GFN_SDK_ENABLE_LIBRARY_OVERRIDE
+#   error "Tools that load the mock runtime must link GfnSdkWrapperTools, which honors GFN_SDK_CLOUD_LIBRARY_PATH"
+#endif
+
+// Points the wrapper at the mock runtime library next to the executable, unless
+// GFN_SDK_CLOUD_LIBRARY_PATH already names a cloud library, and selects the mock configuration
+// file, or none if config is NULL. Receives the path of the cloud library in mockPath.
+static inline bool gfnSelectMockRuntime(const char* config, char* mockPath, size_t size)
+{
+    const char* overridePath = getenv("GFN_SDK_CLOUD_LIBRARY_PATH");
+    ssize_t length;
+    char* slash;
+
+    if (overridePath != NULL && overridePath[0] != '\0')
+    {
+        if (strlen(overridePath) >= size)
+        {
+            return false;
+        }
+        strcpy(mockPath, overridePath);
+    }
+    else
+    {
+        length = readlink("/proc/self/exe", mockPath, size - 1);
+        if (length <= 0)
+        {
+            return false;
+        }
+        mockPath[length] = '\0';
+        slash = strrchr(mockPath, '/');
+        if (slash == NULL || (size_t)(slash - mockPath) + sizeof("/GfnSdk.so") > size)
+        {
+            return false;
+        }
+        strcpy(slash, "/GfnSdk.so");
+        setenv("GFN_SDK_CLOUD_LIBRARY_PATH", mockPath, 1);
+    }
+    if (config != NULL)
+    {
+        setenv("GFN_MOCK_RUNTIME_CONFIG", config, 1);
+    }
+    else
+    {
+        unsetenv("GFN_MOCK_RUNTIME_CONFIG");
+    }
+    return true;
+}
+
+#endif // __NV_GFNSDK_TOOL_MOCK_RUNTIME_H__
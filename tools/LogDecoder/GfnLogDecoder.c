@@ -0,0 +1,405 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Decoder for the wrapper's persistent log (GfnSetLogMode with gfnLogModePersistent). Reads a
+// .logring file, including one left behind by a process that crashed, and prints its records as
+// text lines in the format of the wrapper's text log, oldest first. Records that were being
+// written when the process died are skipped. The layout is described in GfnSdk_PersistentLog.h.
+//
+// ===============================================================================================
+
+#include "GfnSdk_PersistentLog.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define kDecodeTimestampLen 64
+#define kDecodeMessageLen 2048
+
+typedef struct decodeOptions
+{
+    const char* path;
+    unsigned int last;              // Print only the most recent records, 0 for all
+    bool details;                   // Add the level and thread id of each line
+} decodeOptions;
+
+// Appends text to a message, truncating it to the buffer
+static void decodeAppend(char* message, size_t* length, char const* text, size_t textLength)
+{
+    if (*length + textLength >= kDecodeMessageLen)
+    {
+        textLength = kDecodeMessageLen - 1 - *length;
+    }
+    memcpy(message + *length, text, textLength);
+    *length += textLength;
+    message[*length] = '\0';
+}
+
+// Appends the literal text of a format string between two conversions
+static void decodeAppendLiteral(char* message, size_t* length, char const* begin, char const* end)
+{
+    while (begin < end)
+    {
+        decodeAppend(message, length, begin, 1);
+        begin += (begin[0] == '%' && begin + 1 < end && begin[1] == '%') ? 2 : 1;
+    }
+}
+
+// Builds the printf specification of a conversion without its length modifier, so that it can be
+// applied to the decoded value with a modifier of the decoder's choosing
+static bool decodeBuildSpec(gfnPersistentLogConversion const* conversion, char const* modifier, char* spec, size_t size)
+{
+    char const* p;
+    size_t length = 0;
+
+    for (p = conversion->start; p + 1 < conversion->end; p++)
+    {
+        if (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'z' || *p == 'j' || *p == 't')
+        {
+            continue;
+        }
+        if (length + 1 >= size)
+        {
+            return false;
+        }
+        spec[length++] = *p;
+    }
+    if (length + strlen(modifier) + 2 > size)
+    {
+        return false;
+    }
+    spec[length] = '\0';
+    strcat(spec, modifier);
+    length = strlen(spec);
+    spec[length++] = conversion->conversion;
+    spec[length] = '\0';
+    return true;
+}
+
+// Renders the message of a record from the format string of its call site
+static void decodeRenderMessage(char const* format, gfnPersistentLogRecord const* record, char* message)
+{
+    gfnPersistentLogConversion conversion;
+    char spec[32];
+    char text[256];
+    char piece[512];
+    size_t length = 0;
+    unsigned int offset = 0;
+    unsigned int arg = 0;
+    unsigned int textLength;
+    uint64_t value;
+    double number;
+    bool isSigned;
+
+    message[0] = '\0';
+    while (gfnPersistentLogNextConversion(format, &conversion))
+    {
+        decodeAppendLiteral(message, &length, format, conversion.start);
+        format = conversion.end;
+        piece[0] = '\0';
+        if (arg >= record->argCount)
+        {
+            // Not recorded: the payload was full, or the conversion cannot be recorded
+            snprintf(piece, sizeof(piece), "<?>");
+        }
+        else if (conversion.arg == gfnPersistentLogArgString || conversion.arg == gfnPersistentLogArgWideString)
+        {
+            textLength = record->payload[offset];
+            if (offset + 1 + textLength > kGfnPersistentLogPayloadLen)
+            {
+                break;
+            }
+            memcpy(text, record->payload + offset + 1, textLength);
+            text[textLength] = '\0';
+            offset += 1 + textLength;
+            conversion.conversion = 's';
+            if (decodeBuildSpec(&conversion, "", spec, sizeof(spec)))
+            {
+                snprintf(piece, sizeof(piece), spec, text);
+            }
+        }
+        else
+        {
+            if (offset + sizeof(value) > kGfnPersistentLogPayloadLen)
+            {
+                break;
+            }
+            memcpy(&value, record->payload + offset, sizeof(value));
+            offset += sizeof(value);
+            isSigned = (conversion.arg == gfnPersistentLogArgInt || conversion.arg == gfnPersistentLogArgLong ||
+                conversion.arg == gfnPersistentLogArgLongLong || conversion.arg == gfnPersistentLogArgPtrDiff);
+            if (conversion.arg == gfnPersistentLogArgDouble)
+            {
+                memcpy(&number, &value, sizeof(number));
+                if (decodeBuildSpec(&conversion, "", spec, sizeof(spec)))
+                {
+                    snprintf(piece, sizeof(piece), spec, number);
+                }
+            }
+            else if (conversion.arg == gfnPersistentLogArgPointer)
+            {
+                snprintf(piece, sizeof(piece), "0x%llx", (unsigned long long)value);
+            }
+            else if (conversion.conversion == 'c')
+            {
+                if (decodeBuildSpec(&conversion, "", spec, sizeof(spec)))
+                {
+                    snprintf(piece, sizeof(piece), spec, (int)value);
+                }
+            }
+            else if (decodeBuildSpec(&conversion, "ll", spec, sizeof(spec)))
+            {
+                if (isSigned)
+                {
+                    snprintf(piece, sizeof(piece), spec, (long long)value);
+                }
+                else
+                {
+                    snprintf(piece, sizeof(piece), spec, (unsigned long long)value);
+                }
+            }
+        }
+        decodeAppend(message, &length, piece, strlen(piece));
+        arg++;
+    }
+    decodeAppendLiteral(message, &length, format, format + strlen(format));
+}
+
+// Formats the local time of a timestamp as yyyy-mm-ddThh:mm:ss.mmm, as the wrapper's text log does
+static void decodeFormatTimestamp(uint64_t timestampMs, char* buffer)
+{
+    time_t t = (time_t)(timestampMs / 1000);
+    struct tm timeBuffer;
+
+    localtime_r(&t, &timeBuffer);
+    snprintf(buffer, kDecodeTimestampLen, "%04d-%02d-%02dT%02d:%02d:%02d.%03d",
+        timeBuffer.tm_year + 1900, timeBuffer.tm_mon + 1, timeBuffer.tm_mday,
+        timeBuffer.tm_hour, timeBuffer.tm_min, timeBuffer.tm_sec, (int)(timestampMs % 1000));
+}
+
+// Checks that a file holds a complete header and that the tables it describes fit in the file
+static bool decodeValidateHeader(gfnPersistentLogHeader const* header, size_t size)
+{
+    uint64_t expected;
+
+    if (size < sizeof(gfnPersistentLogHeader) || memcmp(header->magic, GFN_PERSISTENT_LOG_MAGIC, sizeof(header->magic)) != 0)
+    {
+        fprintf(stderr, "gfn_log_decode: not a persistent log file\n");
+        return false;
+    }
+    if (header->version != kGfnPersistentLogVersion || header->headerSize != kGfnPersistentLogHeaderSize ||
+        header->siteSize != sizeof(gfnPersistentLogSite) || header->recordSize != sizeof(gfnPersistentLogRecord))
+    {
+        fprintf(stderr, "gfn_log_decode: unsupported persistent log version %u\n", header->version);
+        return false;
+    }
+    expected = (uint64_t)header->headerSize + (uint64_t)header->siteCapacity * header->siteSize +
+        (uint64_t)header->recordCount * header->recordSize;
+    if (header->recordCount == 0 || (header->recordCount & (header->recordCount - 1)) != 0 || expected > size)
+    {
+        fprintf(stderr, "gfn_log_decode: persistent log file is truncated or damaged\n");
+        return false;
+    }
+    return true;
+}
+
+static int decodeCompareSequence(const void* a, const void* b)
+{
+    int64_t left = gfnAtomicLoadRelaxed64(&(*(gfnPersistentLogRecord* const*)a)->sequence);
+    int64_t right = gfnAtomicLoadRelaxed64(&(*(gfnPersistentLogRecord* const*)b)->sequence);
+
+    return (left > right) - (left < right);
+}
+
+static void decodePrintRecord(gfnPersistentLogHeader* header, gfnPersistentLogRecord const* record, bool details)
+{
+    static char const* const levelNames[] = { "TRACE", "DEBUG", "INFO", "WARNING", "ERROR" };
+    char timestamp[kDecodeTimestampLen];
+    char message[kDecodeMessageLen];
+    gfnPersistentLogSite const* site = NULL;
+    int64_t elapsedNs = (int64_t)(record->timestampNs - header->baseMonotonicNs);
+
+    if (record->site < (uint32_t)gfnAtomicLoadRelaxed32(&header->siteCount) && record->site < header->siteCapacity)
+    {
+        site = gfnPersistentLogSiteAt(header, record->site);
+    }
+    decodeFormatTimestamp(header->baseWallClockMs + elapsedNs / 1000000, timestamp);
+    if (site != NULL)
+    {
+        decodeRenderMessage(site->format, record, message);
+    }
+    else
+    {
+        snprintf(message, sizeof(message), "<call site missing from the site table>");
+    }
+
+    printf("%s", timestamp);
+    if (details)
+    {
+        printf(" %-7s %7u", record->level < 5 ? levelNames[record->level] : "?", record->threadId);
+    }
+    printf(" %24.24s:%-5u%s", site != NULL ? site->function : "?", site != NULL ? site->line : 0, message);
+    if (record->suppressed > 0)
+    {
+        printf(" (%u similar lines suppressed)", record->suppressed);
+    }
+    if (record->flags & kGfnPersistentLogTruncated)
+    {
+        printf(" [truncated]");
+    }
+    printf("\n");
+}
+
+static void decodeUsage(void)
+{
+    fprintf(stderr,
+        "Usage: gfn_log_decode [options] <file.logring>\n"
+        "  --last <n>               Print only the most recent n lines\n"
+        "  --details                Add the level and thread id of each line\n");
+}
+
+static bool decodeParseOptions(int argc, char** argv, decodeOptions* options)
+{
+    int i;
+    char* end;
+    unsigned long parsed;
+
+    memset(options, 0, sizeof(*options));
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--details") == 0)
+        {
+            options->details = true;
+        }
+        else if (strcmp(argv[i], "--last") == 0 && i + 1 < argc)
+        {
+            parsed = strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || parsed == 0 || parsed > UINT_MAX)
+            {
+                return false;
+            }
+            options->last = (unsigned int)parsed;
+        }
+        else if (argv[i][0] != '-' && options->path == NULL)
+        {
+            options->path = argv[i];
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options->path != NULL;
+}
+
+int main(int argc, char** argv)
+{
+    decodeOptions options;
+    FILE* file;
+    char* data;
+    long fileSize;
+    size_t size;
+    gfnPersistentLogHeader* header;
+    gfnPersistentLogRecord** records;
+    gfnPersistentLogRecord* record;
+    unsigned int count = 0;
+    unsigned int first = 0;
+    unsigned int i;
+    uint64_t reserved;
+
+    if (!decodeParseOptions(argc, argv, &options))
+    {
+        decodeUsage();
+        return 2;
+    }
+    file = fopen(options.path, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "gfn_log_decode: could not open %s\n", options.path);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    size = (fileSize > 0) ? (size_t)fileSize : 0;
+    data = (char*)malloc(size > 0 ? size : 1);
+    if (data == NULL || fread(data, 1, size, file) != size)
+    {
+        fprintf(stderr, "gfn_log_decode: could not read %s\n", options.path);
+        fclose(file);
+        free(data);
+        return 1;
+    }
+    fclose(file);
+
+    header = (gfnPersistentLogHeader*)data;
+    if (!decodeValidateHeader(header, size))
+    {
+        free(data);
+        return 1;
+    }
+    records = (gfnPersistentLogRecord**)malloc(header->recordCount * sizeof(gfnPersistentLogRecord*));
+    if (records == NULL)
+    {
+        free(data);
+        return 1;
+    }
+    // A slot holds a complete record only if its sequence number maps back to the slot
+    for (i = 0; i < header->recordCount; i++)
+    {
+        record = gfnPersistentLogRecordAt(header, (uint64_t)i + 1);
+        reserved = (uint64_t)gfnAtomicLoadRelaxed64(&record->sequence);
+        if ((int64_t)reserved > 0 && gfnPersistentLogRecordAt(header, reserved) == record)
+        {
+            records[count++] = record;
+        }
+    }
+    qsort(records, count, sizeof(records[0]), decodeCompareSequence);
+
+    if (options.last != 0 && options.last < count)
+    {
+        first = count - options.last;
+    }
+    for (i = first; i < count; i++)
+    {
+        decodePrintRecord(header, records[i], options.details);
+    }
+    reserved = (uint64_t)gfnAtomicLoadRelaxed64(&header->nextSequence);
+    fprintf(stderr, "gfn_log_decode: process %llu, %u lines printed, %llu lines logged, %llu overwritten or incomplete\n",
+        (unsigned long long)header->processId, count - first, (unsigned long long)reserved,
+        (unsigned long long)(reserved - count));
+
+    free(records);
+    free(data);
+    return 0;
+}
@@ -0,0 +1,1399 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Mock GFN runtime library. Exports every symbol the wrapper resolves from the client and cloud
+// libraries, so wrapper code paths, including the cloud-only ones, can be exercised and measured
+// on machines that are not GFN game seats. Point GFN_SDK_CLOUD_LIBRARY_PATH at this library to
+// use it as the cloud library, or copy it next to the application as GfnRuntimeSdk.so to use it
+// as the client library.
+//
+// Behavior is read from the file named by GFN_MOCK_RUNTIME_CONFIG each time the library is
+// initialized; see mock_runtime.conf for the format. Every call can be given a latency
+// distribution and a probability of being throttled or failing, and callbacks can be scripted
+// to fire at fixed times after initialization. Harnesses that load the library themselves can
+// also resolve gfnMockConfigure and gfnMockFireEvent to change the behavior and deliver callbacks
+// while it runs.
+//
+// ===============================================================================================
+
+#include "GfnRuntimeSdk_CAPI.h"
+#include "GfnSdk_Platform.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Cloud library exports that have no declaration in the public headers
+NVGFNSDK_EXPORT GfnRuntimeError NVGFNSDKApi gfnInitializeRuntimeSdk2(float libVersion);
+NVGFNSDK_EXPORT GfnRuntimeError NVGFNSDKApi gfnInitializeRuntimeSdk3(char* strLibVersion);
+NVGFNSDK_EXPORT void NVGFNSDKApi gfnShutdownRuntimeSdk2(void);
+NVGFNSDK_EXPORT bool NVGFNSDKApi gfnIsInitialized(void);
+NVGFNSDK_EXPORT GfnRuntimeError NVGFNSDKApi gfnSendCustomMessageToClient(const char* pchMessage, unsigned int length);
+NVGFNSDK_EXPORT GfnRuntimeError NVGFNSDKApi gfnRegisterCustomMessageCallback(MessageCallbackSig messageCallback, void* pUserContext);
+
+// Test control exports of the mock
+NVGFNSDK_EXPORT GfnRuntimeError NVGFNSDKApi gfnMockConfigure(const char* line);
+NVGFNSDK_EXPORT GfnRuntimeError NVGFNSDKApi gfnMockFireEvent(const char* event, unsigned int count);
+
+// The cloud library calls back with the status, the event data and the registered context
+typedef void(GFN_CALLBACK* mockCloudCallback)(int status, void* pData, void* pContext);
+
+// Every mocked export, named as in the configuration file
+#define MOCK_APIS(API)                                                  \
+    API(InitializeRuntimeSdk, "gfnInitializeRuntimeSdk")                \
+    API(InitializeRuntimeSdk2, "gfnInitializeRuntimeSdk2")              \
+    API(InitializeRuntimeSdk3, "gfnInitializeRuntimeSdk3")              \
+    API(ShutdownRuntimeSdk, "gfnShutdownRuntimeSdk")                    \
+    API(ShutdownRuntimeSdk2, "gfnShutdownRuntimeSdk2")                  \
+    API(IsInitialized, "gfnIsInitialized")                              \
+    API(IsRunningInCloud, "gfnIsRunningInCloud")                        \
+    API(IsRunningInCloudSecure, "gfnIsRunningInCloudSecure")            \
+    API(CloudCheck, "gfnCloudCheck")                                    \
+    API(RegisterExitCallback, "gfnRegisterExitCallback")                \
+    API(RegisterSaveCallback, "gfnRegisterSaveCallback")                \
+    API(RegisterSessionInitCallback, "gfnRegisterSessionInitCallback")  \
+    API(RegisterPauseCallback, "gfnRegisterPauseCallback")              \
+    API(RegisterInstallCallback, "gfnRegisterInstallCallback")          \
+    API(RegisterClientInfoCallback, "gfnRegisterClientInfoCallback")    \
+    API(RegisterNetworkStatusCallback, "gfnRegisterNetworkStatusCallback") \
+    API(RegisterCustomMessageCallback, "gfnRegisterCustomMessageCallback") \
+    API(RegisterStreamStatusCallback, "gfnRegisterStreamStatusCallback") \
+    API(RegisterMessageCallback, "gfnRegisterMessageCallback")          \
+    API(IsTitleAvailable, "gfnIsTitleAvailable")                        \
+    API(GetTitlesAvailable, "gfnGetTitlesAvailable")                    \
+    API(SetupTitle, "gfnSetupTitle")                                    \
+    API(TitleExited, "gfnTitleExited")                                  \
+    API(GetClientIp, "gfnGetClientIp")                                  \
+    API(GetClientLanguageCode, "gfnGetClientLanguageCode")              \
+    API(GetClientCountryCode, "gfnGetClientCountryCode")                \
+    API(GetClientInfo, "gfnGetClientInfo")                              \
+    API(GetSessionInfo, "gfnGetSessionInfo")                            \
+    API(GetPartnerData, "gfnGetPartnerData")                            \
+    API(GetPartnerSecureData, "gfnGetPartnerSecureData")                \
+    API(Free, "gfnFree")                                                \
+    API(AppReady, "gfnAppReady")                                        \
+    API(SetActionZone, "gfnSetActionZone")                              \
+    API(SendCustomMessageToClient, "gfnSendCustomMessageToClient")      \
+    API(SendMessage, "gfnSendMessage")                                  \
+    API(OpenURLOnClient, "gfnOpenURLOnClient")                          \
+    API(StartStream, "gfnStartStream")                                  \
+    API(StartStreamAsync, "gfnStartStreamAsync")                        \
+    API(StopStream, "gfnStopStream")                                    \
+    API(StopStreamAsync, "gfnStopStreamAsync")
+
+#define MOCK_API_ID(member, symbol) mockApi##member,
+#define MOCK_API_NAME(member, symbol) symbol,
+
+typedef enum mockApiId
+{
+    MOCK_APIS(MOCK_API_ID)
+    mockApiCount
+} mockApiId;
+
+static const char* const kMockApiNames[mockApiCount] = { MOCK_APIS(MOCK_API_NAME) };
+
+typedef enum mockLatencyKind
+{
+    mockLatencyNone,
+    mockLatencyFixed,           // a
+    mockLatencyUniform,         // between a and b
+    mockLatencyExponential,     // mean a
+    mockLatencyNormal,          // mean a, standard deviation b
+    mockLatencyLogNormal        // median a, shape b
+} mockLatencyKind;
+
+// Injected behavior of one export. Latencies are in microseconds.
+typedef struct mockApiBehavior
+{
+    mockLatencyKind latency;
+    double a;
+    double b;
+    double throttleRate;
+    double failRate;
+    GfnRuntimeError failError;
+} mockApiBehavior;
+
+typedef enum mockEventKind
+{
+    mockEventClientInfo,
+    mockEventNetworkStatus,
+    mockEventStreamStatus,
+    mockEventExit,
+    mockEventPause,
+    mockEventInstall,
+    mockEventSave,
+    mockEventSessionInit,
+    mockEventMessage,           // Cloud custom message callback
+    mockEventClientMessage,     // Client message callback
+    mockEventKindCount
+} mockEventKind;
+
+static const char* const kMockEventNames[mockEventKindCount] =
+{
+    "clientinfo", "network", "streamstatus", "exit", "pause", "install", "save", "sessioninit", "message", "clientmessage"
+};
+
+#define kMockTextLength 256
+
+// A scripted callback. Fires atMs after initialization and then every periodMs, if not 0, at most
+// count times, if not 0.
+typedef struct mockEvent
+{
+    mockEventKind kind;
+    uint64_t atMs;
+    uint64_t periodMs;
+    unsigned int count;
+    unsigned int fired;
+    int status;
+    GfnClientInfoUpdateData clientInfo;
+    GfnNetworkStatusUpdateData networkStatus;
+    GfnStreamStatus streamStatus;
+    char text[kMockTextLength];
+    char text2[kMockTextLength];
+} mockEvent;
+
+#define kMockMaxEvents 256
+#define kMockMaxPending 64
+
+// Asynchronous start and stop requests, completed by the event thread
+typedef struct mockPendingCall
+{
+    uint64_t dueNs;
+    bool start;
+    StartStreamCallbackSig startCallback;
+    StopStreamCallbackSig stopCallback;
+    void* context;
+    GfnRuntimeError result;
+} mockPendingCall;
+
+typedef struct mockCallbackRegistration
+{
+    void* callback;
+    void* context;
+} mockCallbackRegistration;
+
+typedef struct mockConfig
+{
+    mockApiBehavior apis[mockApiCount];
+    unsigned int seed;
+    bool runningInCloud;
+    GfnIsRunningInCloudAssurance assurance;
+    GfnRuntimeError initResult;
+    GfnClientInfo clientInfo;
+    GfnSessionInfo sessionInfo;
+    char partnerData[kMockTextLength];
+    char partnerSecureData[kMockTextLength];
+    char titles[4096];
+    mockEvent events[kMockMaxEvents];
+    unsigned int eventCount;
+} mockConfig;
+
+static mockConfig s_config;
+static gfnMutex s_lock = GFN_MUTEX_INITIALIZER;
+static gfnCondVar s_wake = GFN_CONDVAR_INITIALIZER;
+static gfnAtomic32 s_initCount = 0;
+static gfnAtomic32 s_seedSequence = 0;
+static gfnAtomic32 s_seedGeneration = 0;      // Changes each time the configuration is loaded
+static uint64_t s_initNs = 0;
+static mockCallbackRegistration s_callbacks[mockEventKindCount];
+static mockPendingCall s_pending[kMockMaxPending];
+static unsigned int s_pendingCount = 0;
+static bool s_threadRunning = false;
+static bool s_stopThread = false;
+static gfnThread s_eventThread;
+static GFN_THREAD_LOCAL uint64_t t_random = 0;
+static GFN_THREAD_LOCAL int32_t t_randomGeneration = 0;
+
+// xorshift64*, seeded per thread so calls from different threads do not contend
+static double mockRandom(void)
+{
+    int32_t generation = gfnAtomicLoadAcquire32(&s_seedGeneration);
+
+    if (t_random == 0 || t_randomGeneration != generation)
+    {
+        t_randomGeneration = generation;
+        t_random = ((uint64_t)s_config.seed << 32) ^ (0x9E3779B97F4A7C15ULL * (uint64_t)(gfnAtomicAdd32(&s_seedSequence, 1) + 1));
+    }
+    t_random ^= t_random >> 12;
+    t_random ^= t_random << 25;
+    t_random ^= t_random >> 27;
+    return (double)((t_random * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+static double mockGaussian(void)
+{
+    double u = mockRandom();
+    double v = mockRandom();
+    return sqrt(-2.0 * log(u > 0.0 ? u : 1e-300)) * cos(6.283185307179586 * v);
+}
+
+static double mockSampleLatencyUs(const mockApiBehavior* behavior)
+{
+    switch (behavior->latency)
+    {
+    case mockLatencyFixed:
+        return behavior->a;
+    case mockLatencyUniform:
+        return behavior->a + (behavior->b - behavior->a) * mockRandom();
+    case mockLatencyExponential:
+        return -behavior->a * log(1.0 - mockRandom());
+    case mockLatencyNormal:
+        return behavior->a + behavior->b * mockGaussian();
+    case mockLatencyLogNormal:
+        return behavior->a * exp(behavior->b * mockGaussian());
+    default:
+        return 0.0;
+    }
+}
+
+// Sleeps for the bulk of the delay and spins for the rest, so short latencies are reproduced closely
+static void mockDelayUs(double delayUs)
+{
+    uint64_t endNs;
+
+    if (delayUs <= 0.0)
+    {
+        return;
+    }
+    endNs = gfnGetMonotonicNs() + (uint64_t)(delayUs * 1000.0);
+    if (delayUs >= 2000.0)
+    {
+        gfnSleepMs((unsigned int)(delayUs / 1000.0) - 1);
+    }
+    while (gfnGetMonotonicNs() < endNs)
+    {
+        gfnCpuRelax();
+    }
+}
+
+// Applies the configured latency and returns the injected error of the call, or gfnSuccess
+static GfnRuntimeError mockEnter(mockApiId api)
+{
+    const mockApiBehavior* behavior = &s_config.apis[api];
+
+    mockDelayUs(mockSampleLatencyUs(behavior));
+    if (behavior->throttleRate > 0.0 && mockRandom() < behavior->throttleRate)
+    {
+        return gfnThrottled;
+    }
+    if (behavior->failRate > 0.0 && mockRandom() < behavior->failRate)
+    {
+        return behavior->failError;
+    }
+    return gfnSuccess;
+}
+
+static const char* mockCopyString(const char* value)
+{
+    size_t length = strlen(value) + 1;
+    char* copy = (char*)malloc(length);
+    if (copy != NULL)
+    {
+        memcpy(copy, value, length);
+    }
+    return copy;
+}
+
+static void mockCopyText(char* destination, const char* value)
+{
+    strncpy(destination, value, kMockTextLength - 1);
+    destination[kMockTextLength - 1] = '\0';
+}
+
+static void mockResetConfig(void)
+{
+    memset(&s_config, 0, sizeof(s_config));
+    s_config.seed = 1;
+    s_config.runningInCloud = true;
+    s_config.assurance = gfnIsCloudHighAssurance;
+    s_config.initResult = gfnSuccess;
+    s_config.clientInfo.osType = gfnWindows;
+    strcpy(s_config.clientInfo.ipV4, "192.168.0.1");
+    strcpy(s_config.clientInfo.country, "US");
+    strcpy(s_config.clientInfo.locale, "en-US");
+    s_config.clientInfo.RTDAverageLatencyMs = 20;
+    s_config.clientInfo.clientResolution.horizontalPixels = 1920;
+    s_config.clientInfo.clientResolution.verticalPixels = 1080;
+    s_config.sessionInfo.sessionMaxDurationSec = 6 * 3600;
+    s_config.sessionInfo.sessionTimeRemainingSec = 6 * 3600;
+    strcpy(s_config.sessionInfo.sessionId, "00000000-0000-0000-0000-000000000000");
+    s_config.sessionInfo.sessionRTXEnabled = true;
+    strcpy(s_config.partnerData, "mock-partner-data");
+    strcpy(s_config.partnerSecureData, "mock-partner-secure-data");
+}
+
+// Splits the next whitespace-separated token off *line
+static char* mockNextToken(char** line)
+{
+    char* token = *line;
+
+    while (*token != '\0' && isspace((unsigned char)*token))
+    {
+        token++;
+    }
+    if (*token == '\0')
+    {
+        *line = token;
+        return NULL;
+    }
+    *line = token;
+    while (**line != '\0' && !isspace((unsigned char)**line))
+    {
+        (*line)++;
+    }
+    if (**line != '\0')
+    {
+        **line = '\0';
+        (*line)++;
+    }
+    return token;
+}
+
+// Rest of the line with surrounding whitespace removed
+static char* mockRemainder(char* line)
+{
+    char* end;
+
+    while (*line != '\0' && isspace((unsigned char)*line))
+    {
+        line++;
+    }
+    end = line + strlen(line);
+    while (end > line && isspace((unsigned char)end[-1]))
+    {
+        *--end = '\0';
+    }
+    return line;
+}
+
+// Consumes the keyword if it is the next token of *line
+static bool mockSkipKeyword(char** line, const char* keyword)
+{
+    char* token = *line;
+    size_t length = strlen(keyword);
+
+    while (*token != '\0' && isspace((unsigned char)*token))
+    {
+        token++;
+    }
+    if (strncmp(token, keyword, length) != 0 || (token[length] != '\0' && !isspace((unsigned char)token[length])))
+    {
+        return false;
+    }
+    *line = token + length;
+    return true;
+}
+
+static double mockNumber(char** line)
+{
+    char* token = mockNextToken(line);
+    return token != NULL ? atof(token) : 0.0;
+}
+
+// Applies fn to the named export, or to every export for "*". Returns false for an unknown name.
+static bool mockForApis(const char* name, mockApiBehavior* behavior, void (*fn)(mockApiBehavior* target, const mockApiBehavior* source))
+{
+    unsigned int api;
+    bool found = false;
+
+    for (api = 0; api < mockApiCount; api++)
+    {
+        if (strcmp(name, "*") == 0 || strcmp(name, kMockApiNames[api]) == 0)
+        {
+            fn(&s_config.apis[api], behavior);
+            found = true;
+        }
+    }
+    return found;
+}
+
+static void mockApplyLatency(mockApiBehavior* target, const mockApiBehavior* source)
+{
+    target->latency = source->latency;
+    target->a = source->a;
+    target->b = source->b;
+}
+
+static void mockApplyThrottle(mockApiBehavior* target, const mockApiBehavior* source)
+{
+    target->throttleRate = source->throttleRate;
+}
+
+static void mockApplyFailure(mockApiBehavior* target, const mockApiBehavior* source)
+{
+    target->failRate = source->failRate;
+    target->failError = source->failError;
+}
+
+static bool mockParseSetting(const char* key, char* value)
+{
+    GfnClientInfo* clientInfo = &s_config.clientInfo;
+    GfnSessionInfo* sessionInfo = &s_config.sessionInfo;
+
+    if (strcmp(key, "seed") == 0)
+    {
+        s_config.seed = (unsigned int)strtoul(value, NULL, 10);
+    }
+    else if (strcmp(key, "cloud") == 0)
+    {
+        s_config.runningInCloud = strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
+    }
+    else if (strcmp(key, "assurance") == 0)
+    {
+        s_config.assurance = (GfnIsRunningInCloudAssurance)atoi(value);
+    }
+    else if (strcmp(key, "initResult") == 0)
+    {
+        s_config.initResult = (GfnRuntimeError)atoi(value);
+    }
+    else if (strcmp(key, "os") == 0)
+    {
+        clientInfo->osType = (GfnOsType)atoi(value);
+    }
+    else if (strcmp(key, "ip") == 0)
+    {
+        strncpy(clientInfo->ipV4, value, IP_V4_SIZE - 1);
+    }
+    else if (strcmp(key, "country") == 0)
+    {
+        strncpy(clientInfo->country, value, CC_SIZE - 1);
+    }
+    else if (strcmp(key, "locale") == 0)
+    {
+        strncpy(clientInfo->locale, value, LOCALE_SIZE - 1);
+    }
+    else if (strcmp(key, "rtdMs") == 0)
+    {
+        clientInfo->RTDAverageLatencyMs = (unsigned int)atoi(value);
+    }
+    else if (strcmp(key, "resolution") == 0)
+    {
+        sscanf(value, "%ux%u", &clientInfo->clientResolution.horizontalPixels, &clientInfo->clientResolution.verticalPixels);
+    }
+    else if (strcmp(key, "sessionMaxSec") == 0)
+    {
+        sessionInfo->sessionMaxDurationSec = (unsigned int)atoi(value);
+    }
+    else if (strcmp(key, "sessionRemainingSec") == 0)
+    {
+        sessionInfo->sessionTimeRemainingSec = (unsigned int)atoi(value);
+    }
+    else if (strcmp(key, "sessionId") == 0)
+    {
+        strncpy(sessionInfo->sessionId, value, SESSION_ID_SIZE - 1);
+    }
+    else if (strcmp(key, "rtx") == 0)
+    {
+        sessionInfo->sessionRTXEnabled = strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
+    }
+    else if (strcmp(key, "partnerData") == 0)
+    {
+        mockCopyText(s_config.partnerData, value);
+    }
+    else if (strcmp(key, "partnerSecureData") == 0)
+    {
+        mockCopyText(s_config.partnerSecureData, value);
+    }
+    else if (strcmp(key, "titles") == 0)
+    {
+        strncpy(s_config.titles, value, sizeof(s_config.titles) - 1);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// Parses "<kind> [arguments]" into event
+static bool mockParseEvent(char* line, mockEvent* event)
+{
+    char* name = mockNextToken(&line);
+    char* what;
+    unsigned int kind;
+
+    if (name == NULL)
+    {
+        return false;
+    }
+    for (kind = 0; kind < mockEventKindCount && strcmp(name, kMockEventNames[kind]) != 0; kind++)
+    {
+    }
+    if (kind == mockEventKindCount)
+    {
+        return false;
+    }
+    event->kind = (mockEventKind)kind;
+    switch (event->kind)
+    {
+    case mockEventClientInfo:
+        what = mockNextToken(&line);
+        if (what == NULL)
+        {
+            return false;
+        }
+        if (strcmp(what, "os") == 0)
+        {
+            event->clientInfo.updateType = gfnOs;
+            event->clientInfo.data.osType = (GfnOsType)(int)mockNumber(&line);
+        }
+        else if (strcmp(what, "ip") == 0)
+        {
+            event->clientInfo.updateType = gfnIP;
+            strncpy(event->clientInfo.data.ipV4, mockRemainder(line), IP_V4_SIZE - 1);
+        }
+        else if (strcmp(what, "resolution") == 0)
+        {
+            event->clientInfo.updateType = gfnClientResolution;
+            event->clientInfo.data.clientResolution.horizontalPixels = (unsigned int)mockNumber(&line);
+            event->clientInfo.data.clientResolution.verticalPixels = (unsigned int)mockNumber(&line);
+        }
+        else if (strcmp(what, "safezone") == 0)
+        {
+            event->clientInfo.updateType = gfnSafeZone;
+            event->clientInfo.data.safeZone.value1 = (float)mockNumber(&line);
+            event->clientInfo.data.safeZone.value2 = (float)mockNumber(&line);
+            event->clientInfo.data.safeZone.value3 = (float)mockNumber(&line);
+            event->clientInfo.data.safeZone.value4 = (float)mockNumber(&line);
+            event->clientInfo.data.safeZone.normalized = true;
+        }
+        else
+        {
+            return false;
+        }
+        break;
+    case mockEventNetworkStatus:
+        event->networkStatus.updateType = gfnRTDAverageLatency;
+        event->networkStatus.data.RTDAverageLatencyMs = (unsigned int)mockNumber(&line);
+        break;
+    case mockEventStreamStatus:
+        event->streamStatus = (GfnStreamStatus)(int)mockNumber(&line);
+        break;
+    case mockEventInstall:
+        what = mockNextToken(&line);
+        mockCopyText(event->text, what != NULL ? what : "");
+        mockCopyText(event->text2, mockRemainder(line));
+        break;
+    case mockEventSessionInit:
+    case mockEventMessage:
+    case mockEventClientMessage:
+        mockCopyText(event->text, mockRemainder(line));
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+// Applies one configuration line. Returns false if the line is not valid.
+static bool mockParseLine(char* line)
+{
+    mockApiBehavior behavior;
+    mockEvent* event;
+    char* directive;
+    char* name;
+    char* kind;
+    bool valid = false;
+
+    memset(&behavior, 0, sizeof(behavior));
+    directive = mockNextToken(&line);
+    if (directive == NULL || directive[0] == '#')
+    {
+        return true;
+    }
+    if (strcmp(directive, "latency") == 0 && (name = mockNextToken(&line)) != NULL && (kind = mockNextToken(&line)) != NULL)
+    {
+        valid = true;
+        if (strcmp(kind, "none") == 0)
+        {
+            behavior.latency = mockLatencyNone;
+        }
+        else if (strcmp(kind, "fixed") == 0)
+        {
+            behavior.latency = mockLatencyFixed;
+        }
+        else if (strcmp(kind, "uniform") == 0)
+        {
+            behavior.latency = mockLatencyUniform;
+        }
+        else if (strcmp(kind, "exponential") == 0)
+        {
+            behavior.latency = mockLatencyExponential;
+        }
+        else if (strcmp(kind, "normal") == 0)
+        {
+            behavior.latency = mockLatencyNormal;
+        }
+        else if (strcmp(kind, "lognormal") == 0)
+        {
+            behavior.latency = mockLatencyLogNormal;
+        }
+        else
+        {
+            valid = false;
+        }
+        behavior.a = mockNumber(&line);
+        behavior.b = mockNumber(&line);
+        valid = valid && mockForApis(name, &behavior, mockApplyLatency);
+    }
+    else if (strcmp(directive, "throttle") == 0 && (name = mockNextToken(&line)) != NULL)
+    {
+        behavior.throttleRate = mockNumber(&line);
+        valid = mockForApis(name, &behavior, mockApplyThrottle);
+    }
+    else if (strcmp(directive, "fail") == 0 && (name = mockNextToken(&line)) != NULL)
+    {
+        behavior.failRate = mockNumber(&line);
+        behavior.failError = (GfnRuntimeError)(int)mockNumber(&line);
+        if (behavior.failError == gfnSuccess)
+        {
+            behavior.failError = gfnInternalError;
+        }
+        valid = mockForApis(name, &behavior, mockApplyFailure);
+    }
+    else if (strcmp(directive, "set") == 0 && (name = mockNextToken(&line)) != NULL)
+    {
+        valid = mockParseSetting(name, mockRemainder(line));
+    }
+    else if ((strcmp(directive, "at") == 0 || strcmp(directive, "every") == 0) && s_config.eventCount < kMockMaxEvents)
+    {
+        event = &s_config.events[s_config.eventCount];
+        memset(event, 0, sizeof(*event));
+        if (directive[0] == 'a')
+        {
+            event->atMs = (uint64_t)mockNumber(&line);
+            event->count = 1;
+        }
+        else
+        {
+            // every <periodMs> [from <ms>] [count <n>] <event>
+            event->periodMs = (uint64_t)mockNumber(&line);
+            event->atMs = event->periodMs;
+            for (;;)
+            {
+                if (mockSkipKeyword(&line, "from"))
+                {
+                    event->atMs = (uint64_t)mockNumber(&line);
+                }
+                else if (mockSkipKeyword(&line, "count"))
+                {
+                    event->count = (unsigned int)mockNumber(&line);
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+        valid = mockParseEvent(line, event);
+        if (valid)
+        {
+            s_config.eventCount++;
+        }
+    }
+    return valid;
+}
+
+static void mockLoadConfig(void)
+{
+    char const* path = getenv("GFN_MOCK_RUNTIME_CONFIG");
+    char line[4096];
+    unsigned int lineNumber = 0;
+    FILE* file;
+
+    mockResetConfig();
+    if (path == NULL || path[0] == '\0')
+    {
+        return;
+    }
+    file = fopen(path, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "GfnSdkMockRuntime: could not open %s\n", path);
+        return;
+    }
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        lineNumber++;
+        if (!mockParseLine(line))
+        {
+            fprintf(stderr, "GfnSdkMockRuntime: ignoring invalid configuration line %u\n", lineNumber);
+        }
+    }
+    fclose(file);
+}
+
+// Delivers a scripted event to the callback registered for it. Called without s_lock held.
+static void mockDeliverEvent(const mockEvent* event, mockCallbackRegistration registration)
+{
+    mockEvent copy = *event;
+    TitleInstallationInformation installInfo;
+    GfnString message;
+
+    switch (copy.kind)
+    {
+    case mockEventClientInfo:
+        ((mockCloudCallback)registration.callback)(copy.status, &copy.clientInfo, registration.context);
+        break;
+    case mockEventNetworkStatus:
+        ((mockCloudCallback)registration.callback)(copy.status, &copy.networkStatus, registration.context);
+        break;
+    case mockEventStreamStatus:
+        ((StreamStatusCallbackSig)registration.callback)(copy.streamStatus, registration.context);
+        break;
+    case mockEventInstall:
+        installInfo.pchPlatformAppId = copy.text;
+        installInfo.pchBuildPath = copy.text2;
+        installInfo.pchMetadataPath = NULL;
+        ((mockCloudCallback)registration.callback)(copy.status, &installInfo, registration.context);
+        break;
+    case mockEventSessionInit:
+        ((mockCloudCallback)registration.callback)(copy.status, copy.text, registration.context);
+        break;
+    case mockEventMessage:
+    case mockEventClientMessage:
+        message.pchString = copy.text;
+        message.length = (unsigned int)strlen(copy.text);
+        if (copy.kind == mockEventMessage)
+        {
+            ((mockCloudCallback)registration.callback)(copy.status, &message, registration.context);
+        }
+        else
+        {
+            ((MessageCallbackSig)registration.callback)(&message, registration.context);
+        }
+        break;
+    default:
+        ((mockCloudCallback)registration.callback)(copy.status, NULL, registration.context);
+        break;
+    }
+}
+
+// Fires scripted events and completes asynchronous calls until the library is shut down
+static GFN_THREAD_PROC mockEventThread(void* arg)
+{
+    mockCallbackRegistration registration;
+    mockPendingCall pending;
+    mockEvent* event;
+    uint64_t nowNs;
+    uint64_t nextNs;
+    uint64_t dueNs;
+    unsigned int i;
+    bool found;
+
+    (void)arg;
+    gfnMutexLock(&s_lock);
+    while (!s_stopThread)
+    {
+        nowNs = gfnGetMonotonicNs();
+        nextNs = nowNs + 1000000000ULL;
+        found = false;
+        for (i = 0; i < s_pendingCount && !found; i++)
+        {
+            if (s_pending[i].dueNs <= nowNs)
+            {
+                pending = s_pending[i];
+                s_pending[i] = s_pending[--s_pendingCount];
+                found = true;
+                gfnMutexUnlock(&s_lock);
+                if (pending.start)
+                {
+                    StartStreamResponse response;
+                    response.downloaded = false;
+                    pending.startCallback(pending.result, &response, pending.context);
+                }
+                else
+                {
+                    pending.stopCallback(pending.result, pending.context);
+                }
+                gfnMutexLock(&s_lock);
+            }
+            else if (s_pending[i].dueNs < nextNs)
+            {
+                nextNs = s_pending[i].dueNs;
+            }
+        }
+        for (i = 0; i < s_config.eventCount && !found; i++)
+        {
+            event = &s_config.events[i];
+            if (event->count != 0 && event->fired >= event->count)
+            {
+                continue;
+            }
+            dueNs = s_initNs + (event->atMs + event->periodMs * event->fired) * 1000000ULL;
+            if (dueNs <= nowNs)
+            {
+                event->fired++;
+                registration = s_callbacks[event->kind];
+                if (registration.callback != NULL)
+                {
+                    found = true;
+                    gfnMutexUnlock(&s_lock);
+                    mockDeliverEvent(event, registration);
+                    gfnMutexLock(&s_lock);
+                }
+            }
+            else if (dueNs < nextNs)
+            {
+                nextNs = dueNs;
+            }
+        }
+        if (!found && !s_stopThread)
+        {
+            gfnCondVarWait(&s_wake, &s_lock, (unsigned int)((nextNs - nowNs + 999999) / 1000000));
+        }
+    }
+    gfnMutexUnlock(&s_lock);
+    return GFN_THREAD_RETURN;
+}
+
+static void mockRelease(void)
+{
+    bool joinThread = false;
+
+    if (gfnAtomicAdd32(&s_initCount, -1) != 0)
+    {
+        return;
+    }
+    gfnMutexLock(&s_lock);
+    s_stopThread = true;
+    gfnCondVarBroadcast(&s_wake);
+    joinThread = s_threadRunning;
+    s_threadRunning = false;
+    gfnMutexUnlock(&s_lock);
+    if (joinThread)
+    {
+        gfnThreadJoin(s_eventThread);
+    }
+    gfnMutexLock(&s_lock);
+    memset(s_callbacks, 0, sizeof(s_callbacks));
+    s_pendingCount = 0;
+    gfnMutexUnlock(&s_lock);
+}
+
+static void mockShutdown(mockApiId api)
+{
+    mockEnter(api);
+    mockRelease();
+}
+
+static GfnRuntimeError mockInitialize(mockApiId api)
+{
+    GfnRuntimeError status;
+
+    if (gfnAtomicAdd32(&s_initCount, 1) == 1)
+    {
+        gfnMutexLock(&s_lock);
+        mockLoadConfig();
+        gfnAtomicAdd32(&s_seedGeneration, 1);
+        s_initNs = gfnGetMonotonicNs();
+        s_stopThread = false;
+        s_threadRunning = gfnThreadCreate(&s_eventThread, mockEventThread, NULL);
+        gfnMutexUnlock(&s_lock);
+    }
+    status = mockEnter(api);
+    if (status == gfnSuccess)
+    {
+        status = s_config.initResult;
+    }
+    if (status < 0)
+    {
+        // A library that fails to initialize is unloaded without being shut down
+        mockRelease();
+    }
+    return status;
+}
+
+static GfnRuntimeError mockRegister(mockApiId api, mockEventKind kind, void* callback, void* context)
+{
+    GfnRuntimeError status = mockEnter(api);
+
+    if (status != gfnSuccess)
+    {
+        return status;
+    }
+    if (callback == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    gfnMutexLock(&s_lock);
+    s_callbacks[kind].callback = callback;
+    s_callbacks[kind].context = context;
+    gfnCondVarBroadcast(&s_wake);
+    gfnMutexUnlock(&s_lock);
+    return gfnSuccess;
+}
+
+static GfnRuntimeError mockReturnString(mockApiId api, const char* value, const char** result)
+{
+    GfnRuntimeError status = mockEnter(api);
+
+    if (status != gfnSuccess)
+    {
+        return status;
+    }
+    if (result == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    if (value[0] == '\0')
+    {
+        return gfnNoData;
+    }
+    *result = mockCopyString(value);
+    return *result != NULL ? gfnSuccess : gfnUnableToAllocateMemory;
+}
+
+static GfnRuntimeError mockQueueCompletion(mockApiId api, bool start, void* callback, void* context)
+{
+    GfnRuntimeError status = mockEnter(api);
+    mockPendingCall* pending;
+
+    gfnMutexLock(&s_lock);
+    if (s_pendingCount == kMockMaxPending)
+    {
+        gfnMutexUnlock(&s_lock);
+        return gfnThrottled;
+    }
+    pending = &s_pending[s_pendingCount++];
+    memset(pending, 0, sizeof(*pending));
+    pending->dueNs = gfnGetMonotonicNs();
+    pending->start = start;
+    pending->startCallback = start ? (StartStreamCallbackSig)callback : NULL;
+    pending->stopCallback = start ? NULL : (StopStreamCallbackSig)callback;
+    pending->context = context;
+    pending->result = status;
+    gfnCondVarBroadcast(&s_wake);
+    gfnMutexUnlock(&s_lock);
+    return gfnSuccess;
+}
+
+// Client library exports
+
+GfnRuntimeError NVGFNSDKApi gfnInitializeRuntimeSdk(GfnDisplayLanguage displayLanguage)
+{
+    (void)displayLanguage;
+    return mockInitialize(mockApiInitializeRuntimeSdk);
+}
+
+void NVGFNSDKApi gfnShutdownRuntimeSdk(void)
+{
+    mockShutdown(mockApiShutdownRuntimeSdk);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterStreamStatusCallback(StreamStatusCallbackSig streamStatusCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterStreamStatusCallback, mockEventStreamStatus, (void*)streamStatusCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterMessageCallback(MessageCallbackSig messageCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterMessageCallback, mockEventClientMessage, (void*)messageCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnStartStream(StartStreamInput* pStartStreamInput, StartStreamResponse* response)
+{
+    GfnRuntimeError status = mockEnter(mockApiStartStream);
+
+    if (status == gfnSuccess && response != NULL)
+    {
+        response->downloaded = false;
+    }
+    (void)pStartStreamInput;
+    return status;
+}
+
+void NVGFNSDKApi gfnStartStreamAsync(const StartStreamInput* pStartStreamInput, StartStreamCallbackSig cb, void* context, unsigned int timeoutMs)
+{
+    (void)pStartStreamInput;
+    (void)timeoutMs;
+    if (cb != NULL)
+    {
+        mockQueueCompletion(mockApiStartStreamAsync, true, (void*)cb, context);
+    }
+}
+
+GfnRuntimeError NVGFNSDKApi gfnStopStream(void)
+{
+    return mockEnter(mockApiStopStream);
+}
+
+void NVGFNSDKApi gfnStopStreamAsync(StopStreamCallbackSig cb, void* context, unsigned int timeoutMs)
+{
+    (void)timeoutMs;
+    if (cb != NULL)
+    {
+        mockQueueCompletion(mockApiStopStreamAsync, false, (void*)cb, context);
+    }
+}
+
+GfnRuntimeError gfnSendMessage(const char* pchMessage, unsigned int length)
+{
+    (void)pchMessage;
+    (void)length;
+    return mockEnter(mockApiSendMessage);
+}
+
+// Cloud library exports
+
+GfnRuntimeError NVGFNSDKApi gfnInitializeRuntimeSdk2(float libVersion)
+{
+    (void)libVersion;
+    return mockInitialize(mockApiInitializeRuntimeSdk2);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnInitializeRuntimeSdk3(char* strLibVersion)
+{
+    (void)strLibVersion;
+    return mockInitialize(mockApiInitializeRuntimeSdk3);
+}
+
+void NVGFNSDKApi gfnShutdownRuntimeSdk2(void)
+{
+    mockShutdown(mockApiShutdownRuntimeSdk2);
+}
+
+bool NVGFNSDKApi gfnIsInitialized(void)
+{
+    mockEnter(mockApiIsInitialized);
+    return gfnAtomicLoadAcquire32(&s_initCount) > 0;
+}
+
+bool NVGFNSDKApi gfnIsRunningInCloud(void)
+{
+    return mockEnter(mockApiIsRunningInCloud) == gfnSuccess && s_config.runningInCloud;
+}
+
+GfnRuntimeError NVGFNSDKApi gfnIsRunningInCloudSecure(GfnIsRunningInCloudAssurance* assurance)
+{
+    GfnRuntimeError status = mockEnter(mockApiIsRunningInCloudSecure);
+
+    if (status == gfnSuccess && assurance != NULL)
+    {
+        *assurance = s_config.runningInCloud ? s_config.assurance : gfnNotCloud;
+    }
+    return status;
+}
+
+GfnRuntimeError gfnCloudCheck(const GfnCloudCheckChallenge* challenge, GfnCloudCheckResponse* response, bool* isCloudEnvironment)
+{
+    GfnRuntimeError status = mockEnter(mockApiCloudCheck);
+    char* attestation;
+
+    if (status != gfnSuccess)
+    {
+        return status;
+    }
+    if (isCloudEnvironment == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    *isCloudEnvironment = s_config.runningInCloud;
+    if (response != NULL)
+    {
+        // The attestation is the nonce itself; nothing is signed
+        response->attestationData = NULL;
+        response->attestationDataSize = 0;
+        if (s_config.runningInCloud && challenge != NULL && challenge->nonce != NULL && challenge->nonceSize > 0)
+        {
+            attestation = (char*)malloc(challenge->nonceSize);
+            if (attestation == NULL)
+            {
+                return gfnUnableToAllocateMemory;
+            }
+            memcpy(attestation, challenge->nonce, challenge->nonceSize);
+            response->attestationData = attestation;
+            response->attestationDataSize = challenge->nonceSize;
+        }
+    }
+    return gfnSuccess;
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterExitCallback(ExitCallbackSig exitCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterExitCallback, mockEventExit, (void*)exitCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterSaveCallback(SaveCallbackSig saveCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterSaveCallback, mockEventSave, (void*)saveCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterSessionInitCallback(SessionInitCallbackSig sessionInitCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterSessionInitCallback, mockEventSessionInit, (void*)sessionInitCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterPauseCallback(PauseCallbackSig pauseCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterPauseCallback, mockEventPause, (void*)pauseCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterInstallCallback(InstallCallbackSig installCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterInstallCallback, mockEventInstall, (void*)installCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterClientInfoCallback(ClientInfoCallbackSig clientInfoCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterClientInfoCallback, mockEventClientInfo, (void*)clientInfoCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterNetworkStatusCallback(NetworkStatusCallbackSig networkStatusCallback, unsigned int updateRateMs, void* pUserContext)
+{
+    // Updates are only sent as scripted, whatever the requested rate
+    (void)updateRateMs;
+    return mockRegister(mockApiRegisterNetworkStatusCallback, mockEventNetworkStatus, (void*)networkStatusCallback, pUserContext);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnRegisterCustomMessageCallback(MessageCallbackSig messageCallback, void* pUserContext)
+{
+    return mockRegister(mockApiRegisterCustomMessageCallback, mockEventMessage, (void*)messageCallback, pUserContext);
+}
+
+bool NVGFNSDKApi gfnIsTitleAvailable(const char* pchPlatformAppId)
+{
+    const char* titles = s_config.titles;
+    size_t length;
+
+    if (mockEnter(mockApiIsTitleAvailable) != gfnSuccess || pchPlatformAppId == NULL)
+    {
+        return false;
+    }
+    length = strlen(pchPlatformAppId);
+    while (*titles != '\0')
+    {
+        if (strncmp(titles, pchPlatformAppId, length) == 0 && (titles[length] == ',' || titles[length] == '\0'))
+        {
+            return true;
+        }
+        titles = strchr(titles, ',');
+        if (titles == NULL)
+        {
+            break;
+        }
+        titles++;
+    }
+    return false;
+}
+
+GfnRuntimeError NVGFNSDKApi gfnGetTitlesAvailable(const char** ppchPlatformAppIds)
+{
+    return mockReturnString(mockApiGetTitlesAvailable, s_config.titles, ppchPlatformAppIds);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnSetupTitle(const char* pchPlatformAppId)
+{
+    (void)pchPlatformAppId;
+    return mockEnter(mockApiSetupTitle);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnTitleExited(const char* pchPlatformId, const char* pchPlatformAppId)
+{
+    (void)pchPlatformId;
+    (void)pchPlatformAppId;
+    return mockEnter(mockApiTitleExited);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnGetClientIp(const char** ppchClientIp)
+{
+    return mockReturnString(mockApiGetClientIp, s_config.clientInfo.ipV4, ppchClientIp);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnGetClientLanguageCode(const char** ppchLanguageCode)
+{
+    return mockReturnString(mockApiGetClientLanguageCode, s_config.clientInfo.locale, ppchLanguageCode);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnGetClientCountryCode(char* pchCountryCode, unsigned int length)
+{
+    GfnRuntimeError status = mockEnter(mockApiGetClientCountryCode);
+
+    if (status != gfnSuccess)
+    {
+        return status;
+    }
+    if (pchCountryCode == NULL || length < CC_SIZE)
+    {
+        return gfnInvalidParameter;
+    }
+    strcpy(pchCountryCode, s_config.clientInfo.country);
+    return gfnSuccess;
+}
+
+GfnRuntimeError gfnGetClientInfo(GfnClientInfo* clientInfo)
+{
+    GfnRuntimeError status = mockEnter(mockApiGetClientInfo);
+
+    if (status != gfnSuccess)
+    {
+        return status;
+    }
+    if (clientInfo == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    *clientInfo = s_config.clientInfo;
+    return gfnSuccess;
+}
+
+GfnRuntimeError gfnGetSessionInfo(GfnSessionInfo* sessionInfo)
+{
+    GfnRuntimeError status = mockEnter(mockApiGetSessionInfo);
+    uint64_t elapsedSec;
+
+    if (status != gfnSuccess)
+    {
+        return status;
+    }
+    if (sessionInfo == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    *sessionInfo = s_config.sessionInfo;
+    elapsedSec = (gfnGetMonotonicNs() - s_initNs) / 1000000000ULL;
+    sessionInfo->sessionTimeRemainingSec = elapsedSec < sessionInfo->sessionTimeRemainingSec ?
+        sessionInfo->sessionTimeRemainingSec - (unsigned int)elapsedSec : 0;
+    return gfnSuccess;
+}
+
+GfnRuntimeError NVGFNSDKApi gfnGetPartnerData(const char** ppchPartnerData)
+{
+    return mockReturnString(mockApiGetPartnerData, s_config.partnerData, ppchPartnerData);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnGetPartnerSecureData(const char** ppchPartnerSecureData)
+{
+    return mockReturnString(mockApiGetPartnerSecureData, s_config.partnerSecureData, ppchPartnerSecureData);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnFree(const char** ppchData)
+{
+    GfnRuntimeError status = mockEnter(mockApiFree);
+
+    if (ppchData == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    // Memory is released even when a failure is injected, so failure tests do not leak
+    free((void*)*ppchData);
+    *ppchData = NULL;
+    return status;
+}
+
+GfnRuntimeError NVGFNSDKApi gfnAppReady(bool success, const char* status)
+{
+    (void)success;
+    (void)status;
+    return mockEnter(mockApiAppReady);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnSetActionZone(GfnActionType type, unsigned int id, GfnRect* zone)
+{
+    (void)type;
+    (void)id;
+    (void)zone;
+    return mockEnter(mockApiSetActionZone);
+}
+
+GfnRuntimeError NVGFNSDKApi gfnSendCustomMessageToClient(const char* pchMessage, unsigned int length)
+{
+    (void)pchMessage;
+    (void)length;
+    return mockEnter(mockApiSendCustomMessageToClient);
+}
+
+GfnRuntimeError gfnOpenURLOnClient(const char* pchUrl)
+{
+    GfnRuntimeError status = mockEnter(mockApiOpenURLOnClient);
+
+    if (status == gfnSuccess && pchUrl == NULL)
+    {
+        return gfnInvalidParameter;
+    }
+    return status;
+}
+
+// Test control exports
+
+// Applies one line in the configuration file format on top of the loaded configuration. Changes
+// are not synchronized with calls in flight, so make them between measurements. Scripted events
+// are timed from initialization.
+GfnRuntimeError NVGFNSDKApi gfnMockConfigure(const char* line)
+{
+    char copy[4096];
+    bool valid;
+
+    if (line == NULL || strlen(line) >= sizeof(copy))
+    {
+        return gfnInvalidParameter;
+    }
+    strcpy(copy, line);
+    gfnMutexLock(&s_lock);
+    valid = mockParseLine(copy);
+    gfnCondVarBroadcast(&s_wake);
+    gfnMutexUnlock(&s_lock);
+    return valid ? gfnSuccess : gfnInvalidParameter;
+}
+
+// Delivers an event, given as in the configuration file, count times to the registered callback
+// on the calling thread. Returns gfnNoData if no callback is registered for it.
+GfnRuntimeError NVGFNSDKApi gfnMockFireEvent(const char* event, unsigned int count)
+{
+    mockCallbackRegistration registration;
+    mockEvent parsed;
+    char copy[4096];
+    unsigned int i;
+
+    if (event == NULL || strlen(event) >= sizeof(copy))
+    {
+        return gfnInvalidParameter;
+    }
+    strcpy(copy, event);
+    memset(&parsed, 0, sizeof(parsed));
+    if (!mockParseEvent(copy, &parsed))
+    {
+        return gfnInvalidParameter;
+    }
+    gfnMutexLock(&s_lock);
+    registration = s_callbacks[parsed.kind];
+    gfnMutexUnlock(&s_lock);
+    if (registration.callback == NULL)
+    {
+        return gfnNoData;
+    }
+    for (i = 0; i < count; i++)
+    {
+        mockDeliverEvent(&parsed, registration);
+    }
+    return gfnSuccess;
+}
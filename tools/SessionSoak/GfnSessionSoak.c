@@ -0,0 +1,1099 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Session soak harness for the GFN SDK wrapper. Replays the callback streams of many concurrent
+// GFN sessions through the wrapper's callback trampolines for a long period, and reports how the
+// integration holds up: callback delivery latency, memory growth per session and allocator churn.
+//
+// Each simulated session sends SessionInit when it starts, NetworkStatus updates at the rate the
+// application asked for with updateRateMs, ClientInfo changes of resolution, IP address and safe
+// zone, custom messages and Save requests at random intervals, and Exit when it ends, after which
+// a new session takes its place. The events are injected into the mock runtime library
+// (tools/MockRuntime) with gfnMockFireEvent, so they reach the application callbacks the same way
+// events from the GFN runtime do. Seat recycles, which shut the SDK down and initialize it again,
+// can be scheduled with --recycle-sec.
+//
+// Delivery latency is measured from the moment an event is injected to the moment the application
+// callback runs. In queued mode, ClientInfo and NetworkStatus updates are coalesced and delivered by
+// a separate pump thread, so only message latencies are measured for them.
+//
+// Allocations are counted by replacing malloc, calloc, realloc and free with counting versions
+// that forward to glibc, so this tool needs glibc.
+//
+// ===============================================================================================
+
+#include "GfnRuntimeSdk_Wrapper.h"
+#include "GfnSdk_Platform.h"
+#include "GfnToolJson.h"
+#include "GfnToolMockRuntime.h"
+
+#include <dlfcn.h>
+#include <limits.h>
+#include <malloc.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define kSoakMaxThreads 64
+#define kSoakMaxSessions 65536
+#define kSoakMaxContexts 64
+#define kSoakLatencyBuckets 256
+#define kSoakEventTextLength 128
+
+typedef GfnRuntimeError (*soakMockFireEventFn)(const char* event, unsigned int count);
+
+typedef enum soakEventKind
+{
+    soakEventSessionInit,
+    soakEventClientInfo,
+    soakEventNetworkStatus,
+    soakEventMessage,
+    soakEventSave,
+    soakEventExit,
+    soakEventKindCount
+} soakEventKind;
+
+static const char* const kSoakEventNames[soakEventKindCount] =
+{
+    "sessionInit", "clientInfo", "networkStatus", "message", "save", "exit"
+};
+
+typedef struct soakOptions
+{
+    unsigned int sessions;          // Concurrent simulated sessions
+    unsigned int threads;           // Threads the sessions are spread over
+    unsigned int contexts;          // Application contexts receiving every callback
+    unsigned int durationSec;
+    unsigned int sessionSec;        // Mean session length
+    unsigned int updateRateMs;      // NetworkStatus update interval requested by the application
+    unsigned int clientInfoMs;      // Mean interval between ClientInfo changes of a session
+    unsigned int messageMs;         // Mean interval between custom messages of a session
+    unsigned int saveMs;            // Mean interval between Save requests of a session
+    unsigned int recycleSec;        // Interval between seat recycles, or 0 for none
+    unsigned int sampleSec;         // Interval between memory samples
+    unsigned int frameMs;           // Pump interval in queued mode
+    bool queued;
+    const char* output;
+    const char* config;
+} soakOptions;
+
+// Times are monotonic nanoseconds
+typedef struct soakSession
+{
+    bool active;
+    uint64_t endNs;
+    uint64_t nextNetworkNs;
+    uint64_t nextClientInfoNs;
+    uint64_t nextMessageNs;
+    uint64_t nextSaveNs;
+} soakSession;
+
+typedef struct soakGenerator
+{
+    gfnThread thread;
+    soakSession* sessions;
+    unsigned int sessionCount;
+    uint64_t random;
+    bool firstSessions;             // The first sessions end at staggered times
+} soakGenerator;
+
+// Memory and progress at one point of the run
+typedef struct soakSample
+{
+    double elapsedSec;
+    uint64_t sessionsCompleted;
+    uint64_t heapInUseBytes;
+    uint64_t rssBytes;
+    uint64_t allocations;
+    uint64_t liveBytes;
+} soakSample;
+
+typedef struct soakLatency
+{
+    gfnAtomic64 buckets[kSoakLatencyBuckets];
+    gfnAtomic64 measured;
+    gfnAtomic64 maxNs;
+} soakLatency;
+
+static soakOptions s_options;
+static soakMockFireEventFn s_fireEvent = NULL;
+static void* s_mockHandle = NULL;
+static char s_mockPath[PATH_MAX];
+static GfnSdkContext s_contexts[kSoakMaxContexts];
+static unsigned int s_contextCount = 0;
+static soakGenerator s_generators[kSoakMaxThreads];
+
+static gfnAtomic32 s_stop = 0;
+static gfnAtomic32 s_pause = 0;
+static gfnAtomic32 s_parked = 0;
+static gfnAtomic64 s_fired[soakEventKindCount];
+static gfnAtomic64 s_fireErrors = 0;
+static gfnAtomic64 s_delivered[soakEventKindCount];
+static soakLatency s_latency[soakEventKindCount];
+static gfnAtomic64 s_sessionsStarted = 0;
+static gfnAtomic64 s_sessionsCompleted = 0;
+static gfnAtomic64 s_sessionsInterrupted = 0;
+
+static gfnAtomic64 s_allocations = 0;
+static gfnAtomic64 s_frees = 0;
+static gfnAtomic64 s_allocatedBytes = 0;
+static gfnAtomic64 s_freedBytes = 0;
+
+static GFN_THREAD_LOCAL uint64_t t_fireNs = 0;      // Injection time of the event being fired on this thread
+
+// Counting allocator
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* p, size_t size);
+extern void __libc_free(void* p);
+
+static void soakCountAllocation(void* p)
+{
+    if (p != NULL)
+    {
+        gfnAtomicAdd64(&s_allocations, 1);
+        gfnAtomicAdd64(&s_allocatedBytes, (int64_t)malloc_usable_size(p));
+    }
+}
+
+static void soakCountFree(void* p)
+{
+    if (p != NULL)
+    {
+        gfnAtomicAdd64(&s_frees, 1);
+        gfnAtomicAdd64(&s_freedBytes, (int64_t)malloc_usable_size(p));
+    }
+}
+
+void* malloc(size_t size)
+{
+    void* p = __libc_malloc(size);
+    soakCountAllocation(p);
+    return p;
+}
+
+void* calloc(size_t count, size_t size)
+{
+    void* p = __libc_calloc(count, size);
+    soakCountAllocation(p);
+    return p;
+}
+
+void* realloc(void* p, size_t size)
+{
+    void* result;
+
+    soakCountFree(p);
+    result = __libc_realloc(p, size);
+    soakCountAllocation(result);
+    return result;
+}
+
+void free(void* p)
+{
+    soakCountFree(p);
+    __libc_free(p);
+}
+
+// Random numbers, per generator
+
+static double soakRandom(soakGenerator* generator)
+{
+    // xorshift64*
+    generator->random ^= generator->random >> 12;
+    generator->random ^= generator->random << 25;
+    generator->random ^= generator->random >> 27;
+    return (double)((generator->random * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+static uint64_t soakExponentialNs(soakGenerator* generator, unsigned int meanMs)
+{
+    return (uint64_t)(-log(1.0 - soakRandom(generator)) * meanMs * 1000000.0);
+}
+
+// Latency recording
+
+static unsigned int soakLatencyBucket(uint64_t ns)
+{
+    unsigned int high;
+
+    if (ns < 4)
+    {
+        return (unsigned int)ns;
+    }
+    high = gfnHighestBit64(ns);
+    return high * 4 + (unsigned int)((ns >> (high - 2)) & 3);
+}
+
+// Largest latency that falls in bucket
+static uint64_t soakLatencyBucketLimit(unsigned int bucket)
+{
+    unsigned int high = bucket / 4;
+
+    if (bucket < 4)
+    {
+        return bucket;
+    }
+    if (high >= 63)
+    {
+        return UINT64_MAX;
+    }
+    return ((uint64_t)(4 + bucket % 4 + 1) << (high - 2)) - 1;
+}
+
+static void soakRecordDelivery(soakEventKind kind, uint64_t fireNs)
+{
+    soakLatency* latency = &s_latency[kind];
+    uint64_t ns;
+    int64_t max;
+
+    gfnAtomicAdd64(&s_delivered[kind], 1);
+    if (fireNs == 0)
+    {
+        return;
+    }
+    ns = gfnGetMonotonicNs() - fireNs;
+    gfnAtomicAdd64(&latency->buckets[soakLatencyBucket(ns)], 1);
+    gfnAtomicAdd64(&latency->measured, 1);
+    max = gfnAtomicLoadRelaxed64(&latency->maxNs);
+    while ((int64_t)ns > max)
+    {
+        if (__atomic_compare_exchange_n(&latency->maxNs, &max, (int64_t)ns, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+}
+
+static uint64_t soakLatencyPercentile(const soakLatency* latency, double percentile)
+{
+    uint64_t measured = (uint64_t)gfnAtomicLoadRelaxed64(&latency->measured);
+    uint64_t target = (uint64_t)ceil(measured * percentile);
+    uint64_t max = (uint64_t)gfnAtomicLoadRelaxed64(&latency->maxNs);
+    uint64_t seen = 0;
+    unsigned int bucket;
+
+    if (measured == 0)
+    {
+        return 0;
+    }
+    for (bucket = 0; bucket < kSoakLatencyBuckets; bucket++)
+    {
+        seen += (uint64_t)gfnAtomicLoadRelaxed64(&latency->buckets[bucket]);
+        if (seen >= target)
+        {
+            return soakLatencyBucketLimit(bucket) < max ? soakLatencyBucketLimit(bucket) : max;
+        }
+    }
+    return max;
+}
+
+// Application callbacks. Immediate callbacks run on the generator thread that fired the event.
+
+static GfnApplicationCallbackResult GFN_CALLBACK soakOnSessionInit(const char* partnerInfo, void* context)
+{
+    (void)partnerInfo;
+    (void)context;
+    soakRecordDelivery(soakEventSessionInit, t_fireNs);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK soakOnClientInfo(GfnClientInfoUpdateData* update, const void* context)
+{
+    (void)update;
+    (void)context;
+    soakRecordDelivery(soakEventClientInfo, t_fireNs);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK soakOnNetworkStatus(GfnNetworkStatusUpdateData* update, const void* context)
+{
+    (void)update;
+    (void)context;
+    soakRecordDelivery(soakEventNetworkStatus, t_fireNs);
+    return crCallbackSuccess;
+}
+
+// Messages carry their injection time, so their latency is measured in queued mode as well
+static GfnApplicationCallbackResult GFN_CALLBACK soakOnMessage(const GfnString* message, void* context)
+{
+    char text[32];
+    size_t length;
+
+    (void)context;
+    length = (message != NULL && message->pchString != NULL) ? message->length : 0;
+    if (length >= sizeof(text))
+    {
+        length = sizeof(text) - 1;
+    }
+    if (length != 0)
+    {
+        memcpy(text, message->pchString, length);
+    }
+    text[length] = '\0';
+    soakRecordDelivery(soakEventMessage, strtoull(text, NULL, 10));
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK soakOnSave(void* context)
+{
+    (void)context;
+    soakRecordDelivery(soakEventSave, t_fireNs);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK soakOnExit(void* context)
+{
+    (void)context;
+    soakRecordDelivery(soakEventExit, t_fireNs);
+    return crCallbackSuccess;
+}
+
+// Event generation
+
+static void soakFire(soakEventKind kind, const char* event)
+{
+    GfnRuntimeError status;
+
+    t_fireNs = gfnGetMonotonicNs();
+    status = s_fireEvent(event, 1);
+    t_fireNs = 0;
+    gfnAtomicAdd64(&s_fired[kind], 1);
+    if (status != gfnSuccess)
+    {
+        gfnAtomicAdd64(&s_fireErrors, 1);
+    }
+}
+
+static void soakStartSession(soakGenerator* generator, soakSession* session, uint64_t nowNs)
+{
+    char event[kSoakEventTextLength];
+    uint64_t sessionNs = (uint64_t)s_options.sessionSec * 1000000000ULL;
+    int64_t id = gfnAtomicAdd64(&s_sessionsStarted, 1);
+
+    // Sessions last between half and one and a half times the mean. The first ones end anywhere
+    // in that range so the sessions of a run do not all recycle together.
+    if (generator->firstSessions)
+    {
+        session->endNs = nowNs + (uint64_t)(soakRandom(generator) * 1.5 * sessionNs);
+    }
+    else
+    {
+        session->endNs = nowNs + sessionNs / 2 + (uint64_t)(soakRandom(generator) * sessionNs);
+    }
+    session->nextNetworkNs = nowNs + (uint64_t)(soakRandom(generator) * s_options.updateRateMs * 1000000.0);
+    session->nextClientInfoNs = nowNs + soakExponentialNs(generator, s_options.clientInfoMs);
+    session->nextMessageNs = nowNs + soakExponentialNs(generator, s_options.messageMs);
+    session->nextSaveNs = nowNs + soakExponentialNs(generator, s_options.saveMs);
+    session->active = true;
+    snprintf(event, sizeof(event), "sessioninit {\"session\":%lld}", (long long)id);
+    soakFire(soakEventSessionInit, event);
+}
+
+static void soakFireClientInfo(soakGenerator* generator)
+{
+    static const unsigned int kResolutions[][2] = { { 1280, 720 }, { 1920, 1080 }, { 2560, 1440 }, { 3840, 2160 } };
+    char event[kSoakEventTextLength];
+    double choice = soakRandom(generator);
+    unsigned int r;
+
+    if (choice < 0.5)
+    {
+        r = (unsigned int)(soakRandom(generator) * 4) & 3;
+        snprintf(event, sizeof(event), "clientinfo resolution %u %u", kResolutions[r][0], kResolutions[r][1]);
+    }
+    else if (choice < 0.8)
+    {
+        snprintf(event, sizeof(event), "clientinfo ip 10.%u.%u.%u",
+            (unsigned int)(soakRandom(generator) * 256), (unsigned int)(soakRandom(generator) * 256),
+            (unsigned int)(soakRandom(generator) * 256));
+    }
+    else
+    {
+        snprintf(event, sizeof(event), "clientinfo safezone %.3f %.3f %.3f %.3f",
+            soakRandom(generator) * 0.05, soakRandom(generator) * 0.05,
+            1.0 - soakRandom(generator) * 0.05, 1.0 - soakRandom(generator) * 0.05);
+    }
+    soakFire(soakEventClientInfo, event);
+}
+
+// Fires the events of session that are due, and lowers *nextNs to its next due event
+static void soakRunSession(soakGenerator* generator, soakSession* session, uint64_t nowNs, uint64_t* nextNs)
+{
+    char event[kSoakEventTextLength];
+    uint64_t rateNs = (uint64_t)s_options.updateRateMs * 1000000ULL;
+
+    if (!session->active)
+    {
+        soakStartSession(generator, session, nowNs);
+    }
+    if (nowNs >= session->endNs)
+    {
+        soakFire(soakEventExit, "exit");
+        session->active = false;
+        gfnAtomicAdd64(&s_sessionsCompleted, 1);
+        *nextNs = nowNs;
+        return;
+    }
+    if (nowNs >= session->nextNetworkNs)
+    {
+        snprintf(event, sizeof(event), "network %u", 10 + (unsigned int)(soakRandom(generator) * 70));
+        soakFire(soakEventNetworkStatus, event);
+        session->nextNetworkNs += rateNs;
+        if (session->nextNetworkNs <= nowNs)
+        {
+            // Fell behind; keep the rate rather than bursting to catch up
+            session->nextNetworkNs = nowNs + rateNs;
+        }
+    }
+    if (nowNs >= session->nextClientInfoNs)
+    {
+        soakFireClientInfo(generator);
+        session->nextClientInfoNs = nowNs + soakExponentialNs(generator, s_options.clientInfoMs);
+    }
+    if (nowNs >= session->nextMessageNs)
+    {
+        snprintf(event, sizeof(event), "message %llu", (unsigned long long)gfnGetMonotonicNs());
+        soakFire(soakEventMessage, event);
+        session->nextMessageNs = nowNs + soakExponentialNs(generator, s_options.messageMs);
+    }
+    if (nowNs >= session->nextSaveNs)
+    {
+        soakFire(soakEventSave, "save");
+        session->nextSaveNs = nowNs + soakExponentialNs(generator, s_options.saveMs);
+    }
+    if (session->endNs < *nextNs)
+    {
+        *nextNs = session->endNs;
+    }
+    if (session->nextNetworkNs < *nextNs)
+    {
+        *nextNs = session->nextNetworkNs;
+    }
+    if (session->nextClientInfoNs < *nextNs)
+    {
+        *nextNs = session->nextClientInfoNs;
+    }
+    if (session->nextMessageNs < *nextNs)
+    {
+        *nextNs = session->nextMessageNs;
+    }
+    if (session->nextSaveNs < *nextNs)
+    {
+        *nextNs = session->nextSaveNs;
+    }
+}
+
+// Waits while a seat recycle is in progress. Returns false once the run is stopping.
+static bool soakWaitWhilePaused(void)
+{
+    if (gfnAtomicLoadAcquire32(&s_pause) == 0)
+    {
+        return gfnAtomicLoadAcquire32(&s_stop) == 0;
+    }
+    gfnAtomicAdd32(&s_parked, 1);
+    while (gfnAtomicLoadAcquire32(&s_pause) != 0 && gfnAtomicLoadAcquire32(&s_stop) == 0)
+    {
+        gfnSleepMs(1);
+    }
+    gfnAtomicAdd32(&s_parked, -1);
+    return gfnAtomicLoadAcquire32(&s_stop) == 0;
+}
+
+static GFN_THREAD_PROC soakGeneratorThread(void* arg)
+{
+    soakGenerator* generator = (soakGenerator*)arg;
+    uint64_t nowNs;
+    uint64_t nextNs;
+    unsigned int i;
+    bool paused;
+
+    while ((paused = (gfnAtomicLoadAcquire32(&s_pause) != 0)), soakWaitWhilePaused())
+    {
+        if (paused)
+        {
+            // A recycle ended every session in progress
+            for (i = 0; i < generator->sessionCount; i++)
+            {
+                if (generator->sessions[i].active)
+                {
+                    generator->sessions[i].active = false;
+                    gfnAtomicAdd64(&s_sessionsInterrupted, 1);
+                }
+            }
+            continue;
+        }
+        nowNs = gfnGetMonotonicNs();
+        nextNs = nowNs + 100000000ULL;
+        for (i = 0; i < generator->sessionCount; i++)
+        {
+            soakRunSession(generator, &generator->sessions[i], nowNs, &nextNs);
+        }
+        generator->firstSessions = false;
+        nowNs = gfnGetMonotonicNs();
+        if (nextNs > nowNs + 1000000ULL)
+        {
+            gfnSleepMs((unsigned int)((nextNs - nowNs) / 1000000ULL));
+        }
+    }
+    return GFN_THREAD_RETURN;
+}
+
+// Delivers queued events once per frame, like a game loop
+static GFN_THREAD_PROC soakPumpThread(void* arg)
+{
+    (void)arg;
+    while (soakWaitWhilePaused())
+    {
+        GfnPumpEvents(0, 0, NULL);
+        gfnSleepMs(s_options.frameMs);
+    }
+    GfnPumpEvents(0, 0, NULL);
+    return GFN_THREAD_RETURN;
+}
+
+// SDK lifetime
+
+static bool soakStartSdk(void)
+{
+    GfnRuntimeError status = GfnInitializeSdk(gfnDefaultLanguage);
+    unsigned int i;
+
+    if (GFNSDK_FAILED(status))
+    {
+        fprintf(stderr, "gfn_session_soak: GfnInitializeSdk failed: %d\n", status);
+        return false;
+    }
+    s_mockHandle = dlopen(s_mockPath, RTLD_NOW | RTLD_NOLOAD);
+    s_fireEvent = s_mockHandle != NULL ? (soakMockFireEventFn)dlsym(s_mockHandle, "gfnMockFireEvent") : NULL;
+    if (s_fireEvent == NULL)
+    {
+        fprintf(stderr, "gfn_session_soak: %s is not the mock runtime library\n", s_mockPath);
+        return false;
+    }
+    GfnSetCallbackDeliveryMode(s_options.queued ? gfnCallbackDeliveryQueued : gfnCallbackDeliveryImmediate);
+    s_contextCount = 0;
+    for (i = 0; i < s_options.contexts; i++)
+    {
+        GfnSdkContext context;
+        if (GFNSDK_FAILED(GfnCreateContext(gfnDefaultLanguage, &context)))
+        {
+            fprintf(stderr, "gfn_session_soak: GfnCreateContext failed\n");
+            return false;
+        }
+        s_contexts[s_contextCount++] = context;
+        GfnContextRegisterSessionInitCallback(context, soakOnSessionInit, NULL);
+        GfnContextRegisterClientInfoCallback(context, soakOnClientInfo, NULL);
+        GfnContextRegisterNetworkStatusCallback(context, soakOnNetworkStatus, s_options.updateRateMs, NULL);
+        GfnContextRegisterMessageCallback(context, soakOnMessage, NULL);
+        GfnContextRegisterSaveCallback(context, soakOnSave, NULL);
+        GfnContextRegisterExitCallback(context, soakOnExit, NULL);
+    }
+    return true;
+}
+
+static void soakStopSdk(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < s_contextCount; i++)
+    {
+        GfnDestroyContext(s_contexts[i]);
+    }
+    s_contextCount = 0;
+    s_fireEvent = NULL;
+    GfnShutdownSdk();
+    if (s_mockHandle != NULL)
+    {
+        dlclose(s_mockHandle);
+        s_mockHandle = NULL;
+    }
+}
+
+// Shuts the SDK down and initializes it again while the generators are parked, ending every
+// session in progress
+static bool soakRecycleSeat(unsigned int parkingThreads)
+{
+    bool started;
+
+    gfnAtomicStoreRelease32(&s_pause, 1);
+    while (gfnAtomicLoadAcquire32(&s_parked) < (int32_t)parkingThreads)
+    {
+        gfnSleepMs(1);
+    }
+    soakStopSdk();
+    started = soakStartSdk();
+    gfnAtomicStoreRelease32(&s_pause, 0);
+    return started;
+}
+
+// Memory sampling
+
+static uint64_t soakResidentBytes(void)
+{
+    unsigned long long pages = 0;
+    unsigned long long resident = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+
+    if (file == NULL)
+    {
+        return 0;
+    }
+    if (fscanf(file, "%llu %llu", &pages, &resident) != 2)
+    {
+        resident = 0;
+    }
+    fclose(file);
+    return resident * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+static void soakTakeSample(soakSample* sample, uint64_t startNs)
+{
+    struct mallinfo2 info = mallinfo2();
+
+    sample->elapsedSec = (double)(gfnGetMonotonicNs() - startNs) / 1e9;
+    sample->sessionsCompleted = (uint64_t)gfnAtomicLoadRelaxed64(&s_sessionsCompleted);
+    sample->heapInUseBytes = (uint64_t)info.uordblks;
+    sample->rssBytes = soakResidentBytes();
+    sample->allocations = (uint64_t)gfnAtomicLoadRelaxed64(&s_allocations);
+    sample->liveBytes = (uint64_t)(gfnAtomicLoadRelaxed64(&s_allocatedBytes) - gfnAtomicLoadRelaxed64(&s_freedBytes));
+}
+
+// Least-squares slope of y over x for the samples taken after the warm-up
+static double soakSlope(const soakSample* samples, unsigned int count, double warmupSec, bool overSessions, bool liveBytes)
+{
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXX = 0.0;
+    double sumXY = 0.0;
+    double n = 0.0;
+    double x;
+    double y;
+    unsigned int i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (samples[i].elapsedSec < warmupSec)
+        {
+            continue;
+        }
+        x = overSessions ? (double)samples[i].sessionsCompleted : samples[i].elapsedSec / 3600.0;
+        y = liveBytes ? (double)samples[i].liveBytes : (double)samples[i].heapInUseBytes;
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+        n += 1.0;
+    }
+    if (n < 2.0 || n * sumXX - sumX * sumX == 0.0)
+    {
+        return 0.0;
+    }
+    return (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+}
+
+// Options
+
+static bool soakParseUnsigned(const char* text, unsigned int* value, bool allowZero)
+{
+    char* end;
+    unsigned long parsed = strtoul(text, &end, 10);
+
+    if (end == text || *end != '\0' || (parsed == 0 && !allowZero) || parsed > UINT_MAX)
+    {
+        return false;
+    }
+    *value = (unsigned int)parsed;
+    return true;
+}
+
+static void soakUsage(void)
+{
+    fprintf(stderr,
+        "Usage: gfn_session_soak [options]\n"
+        "  --sessions <n>           Concurrent simulated sessions, at most %d (default 256)\n"
+        "  --threads <n>            Threads generating the session events, at most %d (default 4)\n"
+        "  --contexts <n>           Application contexts receiving every callback, at most %d (default 1)\n"
+        "  --duration-sec <n>       Length of the run (default 60)\n"
+        "  --session-sec <n>        Mean length of a session (default 30)\n"
+        "  --update-rate-ms <n>     NetworkStatus update interval (default 1000)\n"
+        "  --client-info-ms <n>     Mean interval between ClientInfo changes (default 5000)\n"
+        "  --message-ms <n>         Mean interval between custom messages (default 2000)\n"
+        "  --save-ms <n>            Mean interval between Save requests (default 60000)\n"
+        "  --recycle-sec <n>        Interval between seat recycles, 0 for none (default 0)\n"
+        "  --sample-sec <n>         Interval between memory samples and progress lines (default 10)\n"
+        "  --queued                 Use queued callback delivery, pumped by a separate thread\n"
+        "  --frame-ms <n>           Pump interval in queued mode (default 16)\n"
+        "  --config <path>          Mock runtime configuration, such as injected latencies\n"
+        "  --output <path>          Write the JSON results to a file instead of stdout\n",
+        kSoakMaxSessions, kSoakMaxThreads, kSoakMaxContexts);
+}
+
+static bool soakParseOptions(int argc, char** argv, soakOptions* options)
+{
+    int i;
+    bool valid = true;
+
+    memset(options, 0, sizeof(*options));
+    options->sessions = 256;
+    options->threads = 4;
+    options->contexts = 1;
+    options->durationSec = 60;
+    options->sessionSec = 30;
+    options->updateRateMs = 1000;
+    options->clientInfoMs = 5000;
+    options->messageMs = 2000;
+    options->saveMs = 60000;
+    options->sampleSec = 10;
+    options->frameMs = 16;
+    for (i = 1; i < argc && valid; i++)
+    {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--queued") == 0)
+        {
+            options->queued = true;
+            continue;
+        }
+        if (value == NULL)
+        {
+            valid = false;
+        }
+        else if (strcmp(argv[i], "--sessions") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->sessions, false) && options->sessions <= kSoakMaxSessions;
+        }
+        else if (strcmp(argv[i], "--threads") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->threads, false) && options->threads <= kSoakMaxThreads;
+        }
+        else if (strcmp(argv[i], "--contexts") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->contexts, false) && options->contexts <= kSoakMaxContexts;
+        }
+        else if (strcmp(argv[i], "--duration-sec") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->durationSec, false);
+        }
+        else if (strcmp(argv[i], "--session-sec") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->sessionSec, false);
+        }
+        else if (strcmp(argv[i], "--update-rate-ms") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->updateRateMs, false);
+        }
+        else if (strcmp(argv[i], "--client-info-ms") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->clientInfoMs, false);
+        }
+        else if (strcmp(argv[i], "--message-ms") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->messageMs, false);
+        }
+        else if (strcmp(argv[i], "--save-ms") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->saveMs, false);
+        }
+        else if (strcmp(argv[i], "--recycle-sec") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->recycleSec, true);
+        }
+        else if (strcmp(argv[i], "--sample-sec") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->sampleSec, false);
+        }
+        else if (strcmp(argv[i], "--frame-ms") == 0)
+        {
+            valid = soakParseUnsigned(value, &options->frameMs, false);
+        }
+        else if (strcmp(argv[i], "--config") == 0)
+        {
+            options->config = value;
+        }
+        else if (strcmp(argv[i], "--output") == 0)
+        {
+            options->output = value;
+        }
+        else
+        {
+            valid = false;
+        }
+        i++;
+    }
+    if (options->threads > options->sessions)
+    {
+        options->threads = options->sessions;
+    }
+    return valid;
+}
+
+// Report
+
+static void soakWriteReport(gfnJsonWriter* json, const soakSample* samples, unsigned int sampleCount,
+    const soakSample* afterShutdown, unsigned int recycles, bool healthy)
+{
+    const soakSample* first = &samples[0];
+    const soakSample* last = &samples[sampleCount - 1];
+    double warmupSec = s_options.durationSec / 10.0;
+    uint64_t events = 0;
+    uint64_t sessions = (uint64_t)gfnAtomicLoadRelaxed64(&s_sessionsCompleted);
+    uint64_t allocations = (uint64_t)gfnAtomicLoadRelaxed64(&s_allocations) - first->allocations;
+    unsigned int kind;
+    unsigned int i;
+
+    gfnJsonOpen(json, NULL, '{');
+    gfnJsonString(json, "tool", "gfn_session_soak");
+    gfnJsonString(json, "mockRuntime", s_mockPath);
+    gfnJsonString(json, "mockConfig", s_options.config);
+    gfnJsonBool(json, "completed", healthy);
+    gfnJsonOpen(json, "options", '{');
+    gfnJsonInteger(json, "sessions", s_options.sessions);
+    gfnJsonInteger(json, "threads", s_options.threads);
+    gfnJsonInteger(json, "contexts", s_options.contexts);
+    gfnJsonInteger(json, "durationSec", s_options.durationSec);
+    gfnJsonInteger(json, "sessionSec", s_options.sessionSec);
+    gfnJsonInteger(json, "updateRateMs", s_options.updateRateMs);
+    gfnJsonInteger(json, "clientInfoMs", s_options.clientInfoMs);
+    gfnJsonInteger(json, "messageMs", s_options.messageMs);
+    gfnJsonInteger(json, "saveMs", s_options.saveMs);
+    gfnJsonInteger(json, "recycleSec", s_options.recycleSec);
+    gfnJsonBool(json, "queued", s_options.queued);
+    gfnJsonClose(json, '}');
+
+    gfnJsonOpen(json, "sessions", '{');
+    gfnJsonInteger(json, "started", (uint64_t)gfnAtomicLoadRelaxed64(&s_sessionsStarted));
+    gfnJsonInteger(json, "completed", sessions);
+    gfnJsonInteger(json, "interrupted", (uint64_t)gfnAtomicLoadRelaxed64(&s_sessionsInterrupted));
+    gfnJsonInteger(json, "seatRecycles", recycles);
+    gfnJsonClose(json, '}');
+
+    gfnJsonOpen(json, "events", '{');
+    for (kind = 0; kind < soakEventKindCount; kind++)
+    {
+        const soakLatency* latency = &s_latency[kind];
+        events += (uint64_t)gfnAtomicLoadRelaxed64(&s_fired[kind]);
+        gfnJsonOpen(json, kSoakEventNames[kind], '{');
+        gfnJsonInteger(json, "fired", (uint64_t)gfnAtomicLoadRelaxed64(&s_fired[kind]));
+        gfnJsonInteger(json, "delivered", (uint64_t)gfnAtomicLoadRelaxed64(&s_delivered[kind]));
+        gfnJsonInteger(json, "latencyMeasured", (uint64_t)gfnAtomicLoadRelaxed64(&latency->measured));
+        gfnJsonInteger(json, "latencyP50Ns", soakLatencyPercentile(latency, 0.50));
+        gfnJsonInteger(json, "latencyP90Ns", soakLatencyPercentile(latency, 0.90));
+        gfnJsonInteger(json, "latencyP99Ns", soakLatencyPercentile(latency, 0.99));
+        gfnJsonInteger(json, "latencyP999Ns", soakLatencyPercentile(latency, 0.999));
+        gfnJsonInteger(json, "latencyMaxNs", (uint64_t)gfnAtomicLoadRelaxed64(&latency->maxNs));
+        gfnJsonClose(json, '}');
+    }
+    gfnJsonInteger(json, "injectionErrors", (uint64_t)gfnAtomicLoadRelaxed64(&s_fireErrors));
+    gfnJsonClose(json, '}');
+
+    gfnJsonOpen(json, "memory", '{');
+    gfnJsonInteger(json, "heapInUseStartBytes", first->heapInUseBytes);
+    gfnJsonInteger(json, "heapInUseEndBytes", last->heapInUseBytes);
+    gfnJsonInteger(json, "heapInUseAfterShutdownBytes", afterShutdown->heapInUseBytes);
+    gfnJsonInteger(json, "rssStartBytes", first->rssBytes);
+    gfnJsonInteger(json, "rssEndBytes", last->rssBytes);
+    gfnJsonNumber(json, "warmupSec", warmupSec);
+    gfnJsonNumber(json, "heapGrowthBytesPerSession", soakSlope(samples, sampleCount, warmupSec, true, false));
+    gfnJsonNumber(json, "heapGrowthBytesPerHour", soakSlope(samples, sampleCount, warmupSec, false, false));
+    gfnJsonNumber(json, "liveGrowthBytesPerSession", soakSlope(samples, sampleCount, warmupSec, true, true));
+    gfnJsonClose(json, '}');
+
+    gfnJsonOpen(json, "allocator", '{');
+    gfnJsonInteger(json, "allocations", allocations);
+    gfnJsonInteger(json, "frees", (uint64_t)gfnAtomicLoadRelaxed64(&s_frees));
+    gfnJsonInteger(json, "allocatedBytes", (uint64_t)gfnAtomicLoadRelaxed64(&s_allocatedBytes));
+    gfnJsonNumber(json, "allocationsPerEvent", events != 0 ? (double)allocations / events : 0.0);
+    gfnJsonNumber(json, "allocationsPerSession", sessions != 0 ? (double)allocations / sessions : 0.0);
+    gfnJsonNumber(json, "allocationsPerSec", last->elapsedSec > first->elapsedSec
+        ? (double)(last->allocations - first->allocations) / (last->elapsedSec - first->elapsedSec) : 0.0);
+    gfnJsonInteger(json, "liveBytesAfterShutdown", afterShutdown->liveBytes);
+    gfnJsonClose(json, '}');
+
+    // [elapsedSec, sessionsCompleted, heapInUseBytes, rssBytes, allocations, liveBytes]
+    gfnJsonOpen(json, "samples", '[');
+    for (i = 0; i < sampleCount; i++)
+    {
+        char row[192];
+        snprintf(row, sizeof(row), "[%.1f, %llu, %llu, %llu, %llu, %llu]", samples[i].elapsedSec,
+            (unsigned long long)samples[i].sessionsCompleted, (unsigned long long)samples[i].heapInUseBytes,
+            (unsigned long long)samples[i].rssBytes, (unsigned long long)samples[i].allocations,
+            (unsigned long long)samples[i].liveBytes);
+        gfnJsonRaw(json, NULL, row);
+    }
+    gfnJsonClose(json, ']');
+    gfnJsonClose(json, '}');
+}
+
+int main(int argc, char** argv)
+{
+    soakSample* samples = NULL;
+    soakSample* grown;
+    soakSample afterShutdown;
+    unsigned int sampleCount = 0;
+    unsigned int sampleCapacity = 0;
+    unsigned int started = 0;
+    unsigned int recycles = 0;
+    unsigned int perThread;
+    unsigned int i;
+    uint64_t startNs;
+    uint64_t endNs;
+    uint64_t nowNs;
+    uint64_t nextSampleNs;
+    uint64_t nextRecycleNs;
+    soakSession* sessions;
+    gfnThread pumpThread;
+    bool pumpStarted = false;
+    bool healthy = true;
+    gfnJsonWriter json;
+    FILE* output = stdout;
+
+    if (!soakParseOptions(argc, argv, &s_options))
+    {
+        soakUsage();
+        return 2;
+    }
+    if (!gfnSelectMockRuntime(s_options.config, s_mockPath, sizeof(s_mockPath)))
+    {
+        fprintf(stderr, "gfn_session_soak: could not locate the mock runtime library\n");
+        return 1;
+    }
+    sessions = (soakSession*)calloc(s_options.sessions, sizeof(soakSession));
+    if (sessions == NULL)
+    {
+        return 1;
+    }
+    GfnSetLogLevel(gfnLogLevelError);
+    if (!soakStartSdk())
+    {
+        soakStopSdk();
+        free(sessions);
+        return 1;
+    }
+
+    startNs = gfnGetMonotonicNs();
+    endNs = startNs + (uint64_t)s_options.durationSec * 1000000000ULL;
+    perThread = s_options.sessions / s_options.threads;
+    for (i = 0; i < s_options.threads; i++)
+    {
+        soakGenerator* generator = &s_generators[i];
+        generator->sessions = &sessions[i * perThread];
+        generator->sessionCount = (i + 1 == s_options.threads) ? s_options.sessions - i * perThread : perThread;
+        generator->random = 0x9E3779B97F4A7C15ULL * (i + 1);
+        generator->firstSessions = true;
+        if (!gfnThreadCreate(&generator->thread, soakGeneratorThread, generator))
+        {
+            break;
+        }
+        started++;
+    }
+    if (s_options.queued)
+    {
+        pumpStarted = gfnThreadCreate(&pumpThread, soakPumpThread, NULL);
+    }
+
+    nextSampleNs = startNs;
+    nextRecycleNs = s_options.recycleSec != 0 ? startNs + (uint64_t)s_options.recycleSec * 1000000000ULL : UINT64_MAX;
+    for (;;)
+    {
+        nowNs = gfnGetMonotonicNs();
+        if (nowNs >= nextSampleNs || nowNs >= endNs)
+        {
+            if (sampleCount == sampleCapacity)
+            {
+                sampleCapacity = sampleCapacity != 0 ? sampleCapacity * 2 : 256;
+                grown = (soakSample*)realloc(samples, sampleCapacity * sizeof(soakSample));
+                if (grown == NULL)
+                {
+                    healthy = false;
+                    break;
+                }
+                samples = grown;
+            }
+            soakTakeSample(&samples[sampleCount], startNs);
+            fprintf(stderr, "gfn_session_soak: %.0f s, %llu sessions completed, heap %llu bytes, rss %llu bytes\n",
+                samples[sampleCount].elapsedSec, (unsigned long long)samples[sampleCount].sessionsCompleted,
+                (unsigned long long)samples[sampleCount].heapInUseBytes, (unsigned long long)samples[sampleCount].rssBytes);
+            sampleCount++;
+            nextSampleNs += (uint64_t)s_options.sampleSec * 1000000000ULL;
+        }
+        if (nowNs >= endNs)
+        {
+            break;
+        }
+        if (nowNs >= nextRecycleNs)
+        {
+            if (!soakRecycleSeat(started + (pumpStarted ? 1 : 0)))
+            {
+                healthy = false;
+                break;
+            }
+            recycles++;
+            nextRecycleNs += (uint64_t)s_options.recycleSec * 1000000000ULL;
+        }
+        gfnSleepMs(10);
+    }
+
+    gfnAtomicStoreRelease32(&s_stop, 1);
+    for (i = 0; i < started; i++)
+    {
+        gfnThreadJoin(s_generators[i].thread);
+    }
+    if (pumpStarted)
+    {
+        gfnThreadJoin(pumpThread);
+    }
+    soakStopSdk();
+    soakTakeSample(&afterShutdown, startNs);
+
+    if (sampleCount != 0)
+    {
+        if (s_options.output != NULL)
+        {
+            output = fopen(s_options.output, "w");
+            if (output == NULL)
+            {
+                fprintf(stderr, "gfn_session_soak: could not open %s\n", s_options.output);
+                output = stdout;
+            }
+        }
+        gfnJsonInit(&json, output);
+        soakWriteReport(&json, samples, sampleCount, &afterShutdown, recycles, healthy);
+        if (output != stdout)
+        {
+            fclose(output);
+        }
+    }
+    free(samples);
+    free(sessions);
+    return healthy ? 0 : 1;
+}
@@ -0,0 +1,1111 @@
+// This code contains NVIDIA Confidential Information and is disclosed to you
+// under a form of NVIDIA software license agreement provided separately to you.
+//
+// Notice
+// NVIDIA Corporation and its licensors retain all intellectual property and
+// proprietary rights in and to this software and related documentation and
+// any modifications thereto. Any use, reproduction, disclosure, or
+// distribution of this software and related documentation without an express
+// license agreement from NVIDIA Corporation is strictly prohibited.
+//
+// ALL NVIDIA DESIGN SPECIFICATIONS, CODE ARE PROVIDED "AS IS.". NVIDIA MAKES
+// NO WARRANTIES, EXPRESSED, IMPLIED, STATUTORY, OR OTHERWISE WITH RESPECT TO
+// THE MATERIALS, AND EXPRESSLY DISCLAIMS ALL IMPLIED WARRANTIES OF NONINFRINGEMENT,
+// MERCHANTABILITY, AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// Information and code furnished is believed to be accurate and reliable.
+// However, NVIDIA Corporation assumes no responsibility for the consequences of use of such
+// information or for any infringement of patents or other rights of third parties that may
+// result from its use. No license is granted by implication or otherwise under any patent
+// or patent rights of NVIDIA Corporation. Details are subject to change without notice.
+// This code supersedes and replaces all information previously supplied.
+// NVIDIA Corporation products are not authorized for use as critical
+// components in life support devices or systems without express written approval of
+// NVIDIA Corporation.
+//
+// Copyright (c) 2020-2021 NVIDIA Corporation. All rights reserved.
+
+//
+// ===============================================================================================
+//
+// Benchmark suite for the hot paths of the GFN SDK wrapper. Runs the wrapper against the mock
+// runtime library (tools/MockRuntime), which the build places next to this executable as both
+// the client and the cloud library, and writes the results as one JSON document.
+//
+// Measured:
+//   calls        Time per call of each public API, and of the same library export called
+//                directly, so the difference is the overhead the wrapper adds
+//   lifecycle    Cost of GfnInitializeSdk and GfnShutdownSdk cycles, with the phase timings
+//   callbacks    Callback trampoline dispatch throughput, immediate, queued and fanned out to
+//                several contexts
+//   contention   Throughput of a set of APIs called from 1 up to N threads at once
+//   singleFlight Library calls made when N threads ask for partner data at once
+//
+// Mock exports have no latency unless a configuration is given with --config, so the numbers are
+// the cost of the wrapper itself.
+//
+// ===============================================================================================
+
+#include "GfnRuntimeSdk_Wrapper.h"
+#include "GfnSdk_Platform.h"
+#include "GfnToolJson.h"
+#include "GfnToolMockRuntime.h"
+
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define kBenchMaxThreads 256
+#define kBenchMaxRepeats 64
+
+// Library exports resolved from the mock runtime for the direct baseline
+typedef bool (*benchIsRunningInCloudFn)(void);
+typedef GfnRuntimeError (*benchIsRunningInCloudSecureFn)(GfnIsRunningInCloudAssurance* assurance);
+typedef GfnRuntimeError (*benchGetStringFn)(const char** value);
+typedef GfnRuntimeError (*benchGetClientCountryCodeFn)(char* countryCode, unsigned int length);
+typedef GfnRuntimeError (*benchGetClientInfoFn)(GfnClientInfo* clientInfo);
+typedef GfnRuntimeError (*benchGetSessionInfoFn)(GfnSessionInfo* sessionInfo);
+typedef bool (*benchIsTitleAvailableFn)(const char* platformAppId);
+typedef GfnRuntimeError (*benchSetActionZoneFn)(GfnActionType type, unsigned int id, GfnRect* zone);
+typedef GfnRuntimeError (*benchSendMessageFn)(const char* message, unsigned int length);
+typedef GfnRuntimeError (*benchAppReadyFn)(bool success, const char* status);
+typedef GfnRuntimeError (*benchStartStreamFn)(StartStreamInput* input, StartStreamResponse* response);
+typedef GfnRuntimeError (*benchStopStreamFn)(void);
+typedef GfnRuntimeError (*benchRegisterStreamStatusCallbackFn)(StreamStatusCallbackSig callback, void* context);
+typedef GfnRuntimeError (*benchMockConfigureFn)(const char* line);
+typedef GfnRuntimeError (*benchMockFireEventFn)(const char* event, unsigned int count);
+
+typedef struct benchMockLibrary
+{
+    void* handle;
+    benchIsRunningInCloudFn IsRunningInCloud;
+    benchIsRunningInCloudSecureFn IsRunningInCloudSecure;
+    benchGetStringFn GetClientIp;
+    benchGetStringFn GetClientLanguageCode;
+    benchGetClientCountryCodeFn GetClientCountryCode;
+    benchGetClientInfoFn GetClientInfo;
+    benchGetSessionInfoFn GetSessionInfo;
+    benchGetStringFn GetPartnerData;
+    benchIsTitleAvailableFn IsTitleAvailable;
+    benchSetActionZoneFn SetActionZone;
+    benchSendMessageFn SendCustomMessageToClient;
+    benchAppReadyFn AppReady;
+    benchGetStringFn Free;
+    benchMockConfigureFn Configure;
+    benchMockFireEventFn FireEvent;
+    // Exports of the client library instance, a second copy of the mock loaded from next to the executable
+    void* clientHandle;
+    benchStartStreamFn StartStream;
+    benchStopStreamFn StopStream;
+    benchRegisterStreamStatusCallbackFn RegisterStreamStatusCallback;
+} benchMockLibrary;
+
+typedef struct benchOptions
+{
+    unsigned int iterations;        // Calls per API in the calls benchmark
+    unsigned int repeats;           // Batches the iterations are split into
+    unsigned int cycles;            // Initialize and shutdown cycles
+    unsigned int events;            // Callback deliveries per dispatch benchmark
+    unsigned int maxThreads;        // Highest thread count in the contention benchmark
+    unsigned int threadIterations;  // Calls per thread in the contention benchmark
+    unsigned int rounds;            // Rounds of the single-flight benchmark
+    const char* output;
+    const char* config;
+} benchOptions;
+
+// One benchmarked call. Returns the status of the call.
+typedef GfnRuntimeError (*benchCallFn)(void);
+
+typedef struct benchCallCase
+{
+    const char* name;
+    benchCallFn wrapper;
+    benchCallFn direct;             // Same export called directly, or NULL if there is no single export
+} benchCallCase;
+
+// Time per call of a batched measurement, in nanoseconds
+typedef struct benchSummary
+{
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double maxNs;
+    uint64_t errors;
+    GfnRuntimeError firstError;
+} benchSummary;
+
+typedef struct benchThreadArgs
+{
+    benchCallFn call;
+    unsigned int iterations;
+    uint64_t elapsedNs;
+    uint64_t errors;
+} benchThreadArgs;
+
+static benchMockLibrary s_mock;
+static gfnAtomic32 s_ready = 0;
+static gfnAtomic32 s_go = 0;
+static gfnAtomic64 s_callbacksDelivered = 0;
+static const char* s_titleId = "100012345";
+static GfnRect s_actionZone = { 0.1f, 0.1f, 0.5f, 0.5f, true, gfnRectLTRB };
+
+// JSON output
+
+static void benchJsonSummary(gfnJsonWriter* json, const char* key, const benchSummary* summary)
+{
+    gfnJsonOpen(json, key, '{');
+    gfnJsonNumber(json, "minNs", summary->minNs);
+    gfnJsonNumber(json, "medianNs", summary->medianNs);
+    gfnJsonNumber(json, "meanNs", summary->meanNs);
+    gfnJsonNumber(json, "maxNs", summary->maxNs);
+    gfnJsonInteger(json, "errors", summary->errors);
+    if (summary->errors != 0)
+    {
+        gfnJsonSigned(json, "firstError", summary->firstError);
+    }
+    gfnJsonClose(json, '}');
+}
+
+// Measurement helpers
+
+static int benchCompareDoubles(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void benchSummarize(double* samples, unsigned int count, benchSummary* summary)
+{
+    unsigned int i;
+    double total = 0.0;
+
+    qsort(samples, count, sizeof(double), benchCompareDoubles);
+    for (i = 0; i < count; i++)
+    {
+        total += samples[i];
+    }
+    summary->minNs = samples[0];
+    summary->medianNs = (count % 2 != 0) ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    summary->meanNs = total / count;
+    summary->maxNs = samples[count - 1];
+}
+
+// Calls fn iterations times, split into batches, after a warm-up of a tenth as many calls
+static void benchMeasureCalls(benchCallFn fn, const benchOptions* options, benchSummary* summary)
+{
+    double samples[kBenchMaxRepeats];
+    unsigned int batch = options->iterations / options->repeats;
+    unsigned int i;
+    unsigned int r;
+    uint64_t startNs;
+    GfnRuntimeError status;
+
+    memset(summary, 0, sizeof(*summary));
+    if (batch == 0)
+    {
+        batch = 1;
+    }
+    for (i = 0; i < options->iterations / 10; i++)
+    {
+        fn();
+    }
+    for (r = 0; r < options->repeats; r++)
+    {
+        startNs = gfnGetMonotonicNs();
+        for (i = 0; i < batch; i++)
+        {
+            status = fn();
+            if (GFNSDK_FAILED(status))
+            {
+                if (summary->errors++ == 0)
+                {
+                    summary->firstError = status;
+                }
+            }
+        }
+        samples[r] = (double)(gfnGetMonotonicNs() - startNs) / batch;
+    }
+    benchSummarize(samples, options->repeats, summary);
+}
+
+// Benchmarked calls through the wrapper
+
+static GfnRuntimeError benchWrapperIsRunningInCloud(void)
+{
+    bool runningInCloud;
+    return GfnIsRunningInCloud(&runningInCloud);
+}
+
+static GfnRuntimeError benchWrapperIsRunningInCloudSecure(void)
+{
+    GfnIsRunningInCloudAssurance assurance;
+    return GfnIsRunningInCloudSecure(&assurance);
+}
+
+static GfnRuntimeError benchWrapperGetClientIpV4(void)
+{
+    const char* ip = NULL;
+    GfnRuntimeError status = GfnGetClientIpV4(&ip);
+    GfnFree(&ip);
+    return status;
+}
+
+static GfnRuntimeError benchWrapperGetClientLanguageCode(void)
+{
+    const char* languageCode = NULL;
+    GfnRuntimeError status = GfnGetClientLanguageCode(&languageCode);
+    GfnFree(&languageCode);
+    return status;
+}
+
+static GfnRuntimeError benchWrapperGetClientCountryCode(void)
+{
+    char countryCode[3];
+    return GfnGetClientCountryCode(countryCode, sizeof(countryCode));
+}
+
+static GfnRuntimeError benchWrapperGetClientInfo(void)
+{
+    GfnClientInfo clientInfo;
+    return GfnGetClientInfo(&clientInfo);
+}
+
+static GfnRuntimeError benchWrapperGetSessionInfo(void)
+{
+    GfnSessionInfo sessionInfo;
+    return GfnGetSessionInfo(&sessionInfo);
+}
+
+static GfnRuntimeError benchWrapperGetPartnerData(void)
+{
+    const char* partnerData = NULL;
+    GfnRuntimeError status = GfnGetPartnerData(&partnerData);
+    GfnFree(&partnerData);
+    return status;
+}
+
+static GfnRuntimeError benchWrapperGetSessionSnapshot(void)
+{
+    GfnSessionSnapshot snapshot;
+    return GfnGetSessionSnapshot(&snapshot);
+}
+
+static GfnRuntimeError benchWrapperIsTitleAvailable(void)
+{
+    bool isAvailable;
+    return GfnIsTitleAvailable(s_titleId, &isAvailable);
+}
+
+static GfnRuntimeError benchWrapperSetActionZone(void)
+{
+    return GfnSetActionZone(gfnEditBox, 1, &s_actionZone);
+}
+
+static GfnRuntimeError benchWrapperSendMessage(void)
+{
+    return GfnSendMessage("bench", 5);
+}
+
+static GfnRuntimeError benchWrapperAppReady(void)
+{
+    return GfnAppReady(true, "bench");
+}
+
+static GfnRuntimeError benchWrapperStartStream(void)
+{
+    StartStreamInput input;
+    StartStreamResponse response;
+
+    memset(&input, 0, sizeof(input));
+    return GfnStartStream(&input, &response);
+}
+
+static GfnRuntimeError benchWrapperStopStream(void)
+{
+    return GfnStopStream();
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK benchOnStreamStatus(GfnStreamStatus status, void* context);
+
+static GfnRuntimeError benchWrapperRegisterStreamStatusCallback(void)
+{
+    return GfnRegisterStreamStatusCallback(benchOnStreamStatus, NULL);
+}
+
+// The same exports called directly
+
+static GfnRuntimeError benchDirectIsRunningInCloud(void)
+{
+    return s_mock.IsRunningInCloud() ? gfnSuccess : gfnInternalError;
+}
+
+static GfnRuntimeError benchDirectIsRunningInCloudSecure(void)
+{
+    GfnIsRunningInCloudAssurance assurance;
+    return s_mock.IsRunningInCloudSecure(&assurance);
+}
+
+static GfnRuntimeError benchDirectGetClientIp(void)
+{
+    const char* ip = NULL;
+    GfnRuntimeError status = s_mock.GetClientIp(&ip);
+    s_mock.Free(&ip);
+    return status;
+}
+
+static GfnRuntimeError benchDirectGetClientLanguageCode(void)
+{
+    const char* languageCode = NULL;
+    GfnRuntimeError status = s_mock.GetClientLanguageCode(&languageCode);
+    s_mock.Free(&languageCode);
+    return status;
+}
+
+static GfnRuntimeError benchDirectGetClientCountryCode(void)
+{
+    char countryCode[3];
+    return s_mock.GetClientCountryCode(countryCode, sizeof(countryCode));
+}
+
+static GfnRuntimeError benchDirectGetClientInfo(void)
+{
+    GfnClientInfo clientInfo;
+    return s_mock.GetClientInfo(&clientInfo);
+}
+
+static GfnRuntimeError benchDirectGetSessionInfo(void)
+{
+    GfnSessionInfo sessionInfo;
+    return s_mock.GetSessionInfo(&sessionInfo);
+}
+
+static GfnRuntimeError benchDirectGetPartnerData(void)
+{
+    const char* partnerData = NULL;
+    GfnRuntimeError status = s_mock.GetPartnerData(&partnerData);
+    s_mock.Free(&partnerData);
+    return status;
+}
+
+static GfnRuntimeError benchDirectIsTitleAvailable(void)
+{
+    return s_mock.IsTitleAvailable(s_titleId) ? gfnSuccess : gfnInternalError;
+}
+
+static GfnRuntimeError benchDirectSetActionZone(void)
+{
+    return s_mock.SetActionZone(gfnEditBox, 1, &s_actionZone);
+}
+
+static GfnRuntimeError benchDirectSendMessage(void)
+{
+    return s_mock.SendCustomMessageToClient("bench", 5);
+}
+
+static GfnRuntimeError benchDirectAppReady(void)
+{
+    return s_mock.AppReady(true, "bench");
+}
+
+static GfnRuntimeError benchDirectStartStream(void)
+{
+    StartStreamInput input;
+    StartStreamResponse response;
+
+    memset(&input, 0, sizeof(input));
+    return s_mock.StartStream(&input, &response);
+}
+
+static GfnRuntimeError benchDirectStopStream(void)
+{
+    return s_mock.StopStream();
+}
+
+static GfnRuntimeError benchDirectRegisterStreamStatusCallback(void)
+{
+    return s_mock.RegisterStreamStatusCallback(benchOnStreamStatus, NULL);
+}
+
+static const benchCallCase kCallCases[] =
+{
+    { "GfnIsRunningInCloud", benchWrapperIsRunningInCloud, benchDirectIsRunningInCloud },
+    { "GfnIsRunningInCloudSecure", benchWrapperIsRunningInCloudSecure, benchDirectIsRunningInCloudSecure },
+    { "GfnGetClientIpV4", benchWrapperGetClientIpV4, benchDirectGetClientIp },
+    { "GfnGetClientLanguageCode", benchWrapperGetClientLanguageCode, benchDirectGetClientLanguageCode },
+    { "GfnGetClientCountryCode", benchWrapperGetClientCountryCode, benchDirectGetClientCountryCode },
+    { "GfnGetClientInfo", benchWrapperGetClientInfo, benchDirectGetClientInfo },
+    { "GfnGetSessionInfo", benchWrapperGetSessionInfo, benchDirectGetSessionInfo },
+    { "GfnGetPartnerData", benchWrapperGetPartnerData, benchDirectGetPartnerData },
+    { "GfnGetSessionSnapshot", benchWrapperGetSessionSnapshot, NULL },
+    { "GfnIsTitleAvailable", benchWrapperIsTitleAvailable, benchDirectIsTitleAvailable },
+    { "GfnSetActionZone", benchWrapperSetActionZone, benchDirectSetActionZone },
+    { "GfnSendMessage", benchWrapperSendMessage, benchDirectSendMessage },
+    { "GfnAppReady", benchWrapperAppReady, benchDirectAppReady },
+    // Client library dispatch
+    { "GfnStartStream", benchWrapperStartStream, benchDirectStartStream },
+    { "GfnStopStream", benchWrapperStopStream, benchDirectStopStream },
+    { "GfnRegisterStreamStatusCallback", benchWrapperRegisterStreamStatusCallback, benchDirectRegisterStreamStatusCallback },
+};
+
+// APIs called from several threads at once in the contention benchmark
+static const benchCallCase kContentionCases[] =
+{
+    { "GfnIsRunningInCloud", benchWrapperIsRunningInCloud, NULL },
+    { "GfnGetClientInfo", benchWrapperGetClientInfo, NULL },
+    { "GfnGetClientLanguageCode", benchWrapperGetClientLanguageCode, NULL },
+    { "GfnGetSessionSnapshot", benchWrapperGetSessionSnapshot, NULL },
+    { "GfnSetActionZone", benchWrapperSetActionZone, NULL },
+};
+
+// Application callbacks
+
+static GfnApplicationCallbackResult GFN_CALLBACK benchOnClientInfo(GfnClientInfoUpdateData* update, const void* context)
+{
+    (void)update;
+    (void)context;
+    gfnAtomicAdd64(&s_callbacksDelivered, 1);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK benchOnNetworkStatus(GfnNetworkStatusUpdateData* update, const void* context)
+{
+    (void)update;
+    (void)context;
+    gfnAtomicAdd64(&s_callbacksDelivered, 1);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK benchOnMessage(const GfnString* message, void* context)
+{
+    (void)message;
+    (void)context;
+    gfnAtomicAdd64(&s_callbacksDelivered, 1);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK benchOnPause(void* context)
+{
+    (void)context;
+    gfnAtomicAdd64(&s_callbacksDelivered, 1);
+    return crCallbackSuccess;
+}
+
+static GfnApplicationCallbackResult GFN_CALLBACK benchOnStreamStatus(GfnStreamStatus status, void* context)
+{
+    (void)status;
+    (void)context;
+    gfnAtomicAdd64(&s_callbacksDelivered, 1);
+    return crCallbackSuccess;
+}
+
+// Setup
+
+static bool benchParseUnsigned(const char* text, unsigned int* value)
+{
+    char* end;
+    unsigned long parsed = strtoul(text, &end, 10);
+
+    if (end == text || *end != '\0' || parsed == 0 || parsed > UINT_MAX)
+    {
+        return false;
+    }
+    *value = (unsigned int)parsed;
+    return true;
+}
+
+static void benchUsage(void)
+{
+    fprintf(stderr,
+        "Usage: gfn_wrapper_bench [options]\n"
+        "  --iterations <n>         Calls per API in the per-call benchmark (default 200000)\n"
+        "  --repeats <n>            Batches the calls are split into, at most %d (default 20)\n"
+        "  --cycles <n>             Initialize and shutdown cycles (default 200)\n"
+        "  --events <n>             Callback deliveries per dispatch benchmark (default 200000)\n"
+        "  --threads <n>            Highest thread count for contention, at most %d (default: CPU count)\n"
+        "  --thread-iterations <n>  Calls per thread in the contention benchmark (default 50000)\n"
+        "  --rounds <n>             Rounds of the single-flight benchmark (default 20)\n"
+        "  --config <path>          Mock runtime configuration, such as injected latencies\n"
+        "  --output <path>          Write the JSON results to a file instead of stdout\n",
+        kBenchMaxRepeats, kBenchMaxThreads);
+}
+
+static bool benchParseOptions(int argc, char** argv, benchOptions* options)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int i;
+    bool valid = true;
+
+    options->iterations = 200000;
+    options->repeats = 20;
+    options->cycles = 200;
+    options->events = 200000;
+    options->maxThreads = (cpus > 0 && cpus <= kBenchMaxThreads) ? (unsigned int)cpus : (cpus > 0 ? kBenchMaxThreads : 4);
+    options->threadIterations = 50000;
+    options->rounds = 20;
+    options->output = NULL;
+    options->config = NULL;
+    for (i = 1; i < argc && valid; i++)
+    {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL)
+        {
+            valid = false;
+        }
+        else if (strcmp(argv[i], "--iterations") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->iterations);
+        }
+        else if (strcmp(argv[i], "--repeats") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->repeats) && options->repeats <= kBenchMaxRepeats;
+        }
+        else if (strcmp(argv[i], "--cycles") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->cycles);
+        }
+        else if (strcmp(argv[i], "--events") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->events);
+        }
+        else if (strcmp(argv[i], "--threads") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->maxThreads) && options->maxThreads <= kBenchMaxThreads;
+        }
+        else if (strcmp(argv[i], "--thread-iterations") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->threadIterations);
+        }
+        else if (strcmp(argv[i], "--rounds") == 0)
+        {
+            valid = benchParseUnsigned(value, &options->rounds);
+        }
+        else if (strcmp(argv[i], "--config") == 0)
+        {
+            options->config = value;
+        }
+        else if (strcmp(argv[i], "--output") == 0)
+        {
+            options->output = value;
+        }
+        else
+        {
+            valid = false;
+        }
+        i++;
+    }
+    return valid;
+}
+
+// Resolves the exports of the client library instance the wrapper loaded from next to the executable
+static bool benchResolveClient(void)
+{
+    char clientPath[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe", clientPath, sizeof(clientPath) - 1);
+    char* slash;
+
+    if (length <= 0)
+    {
+        return false;
+    }
+    clientPath[length] = '\0';
+    slash = strrchr(clientPath, '/');
+    if (slash == NULL || (size_t)(slash - clientPath) + sizeof("/GfnRuntimeSdk.so") > sizeof(clientPath))
+    {
+        return false;
+    }
+    strcpy(slash, "/GfnRuntimeSdk.so");
+    s_mock.clientHandle = dlopen(clientPath, RTLD_NOW | RTLD_NOLOAD);
+    if (s_mock.clientHandle == NULL)
+    {
+        return false;
+    }
+    s_mock.StartStream = (benchStartStreamFn)dlsym(s_mock.clientHandle, "gfnStartStream");
+    s_mock.StopStream = (benchStopStreamFn)dlsym(s_mock.clientHandle, "gfnStopStream");
+    s_mock.RegisterStreamStatusCallback = (benchRegisterStreamStatusCallbackFn)dlsym(s_mock.clientHandle, "gfnRegisterStreamStatusCallback");
+    return s_mock.StartStream != NULL && s_mock.StopStream != NULL && s_mock.RegisterStreamStatusCallback != NULL;
+}
+
+// Resolves the exports of the cloud and client library instances the wrapper loaded
+static bool benchResolveMock(const char* mockPath)
+{
+    s_mock.handle = dlopen(mockPath, RTLD_NOW | RTLD_NOLOAD);
+    if (s_mock.handle == NULL || !benchResolveClient())
+    {
+        return false;
+    }
+    s_mock.IsRunningInCloud = (benchIsRunningInCloudFn)dlsym(s_mock.handle, "gfnIsRunningInCloud");
+    s_mock.IsRunningInCloudSecure = (benchIsRunningInCloudSecureFn)dlsym(s_mock.handle, "gfnIsRunningInCloudSecure");
+    s_mock.GetClientIp = (benchGetStringFn)dlsym(s_mock.handle, "gfnGetClientIp");
+    s_mock.GetClientLanguageCode = (benchGetStringFn)dlsym(s_mock.handle, "gfnGetClientLanguageCode");
+    s_mock.GetClientCountryCode = (benchGetClientCountryCodeFn)dlsym(s_mock.handle, "gfnGetClientCountryCode");
+    s_mock.GetClientInfo = (benchGetClientInfoFn)dlsym(s_mock.handle, "gfnGetClientInfo");
+    s_mock.GetSessionInfo = (benchGetSessionInfoFn)dlsym(s_mock.handle, "gfnGetSessionInfo");
+    s_mock.GetPartnerData = (benchGetStringFn)dlsym(s_mock.handle, "gfnGetPartnerData");
+    s_mock.IsTitleAvailable = (benchIsTitleAvailableFn)dlsym(s_mock.handle, "gfnIsTitleAvailable");
+    s_mock.SetActionZone = (benchSetActionZoneFn)dlsym(s_mock.handle, "gfnSetActionZone");
+    s_mock.SendCustomMessageToClient = (benchSendMessageFn)dlsym(s_mock.handle, "gfnSendCustomMessageToClient");
+    s_mock.AppReady = (benchAppReadyFn)dlsym(s_mock.handle, "gfnAppReady");
+    s_mock.Free = (benchGetStringFn)dlsym(s_mock.handle, "gfnFree");
+    s_mock.Configure = (benchMockConfigureFn)dlsym(s_mock.handle, "gfnMockConfigure");
+    s_mock.FireEvent = (benchMockFireEventFn)dlsym(s_mock.handle, "gfnMockFireEvent");
+    // Every export is needed; a real runtime library does not have the mock controls
+    return s_mock.IsRunningInCloud != NULL && s_mock.IsRunningInCloudSecure != NULL && s_mock.GetClientIp != NULL
+        && s_mock.GetClientLanguageCode != NULL && s_mock.GetClientCountryCode != NULL && s_mock.GetClientInfo != NULL
+        && s_mock.GetSessionInfo != NULL && s_mock.GetPartnerData != NULL && s_mock.IsTitleAvailable != NULL
+        && s_mock.SetActionZone != NULL && s_mock.SendCustomMessageToClient != NULL && s_mock.AppReady != NULL
+        && s_mock.Free != NULL && s_mock.Configure != NULL && s_mock.FireEvent != NULL;
+}
+
+// Benchmarks
+
+static void benchLifecycle(gfnJsonWriter* json, const benchOptions* options)
+{
+    double* initSamples = (double*)calloc(options->cycles, sizeof(double));
+    double* shutdownSamples = (double*)calloc(options->cycles, sizeof(double));
+    GfnInitTimings timings;
+    GfnInitTimings totals;
+    benchSummary summary;
+    uint64_t startNs;
+    uint64_t failures = 0;
+    unsigned int i;
+
+    memset(&totals, 0, sizeof(totals));
+    gfnJsonOpen(json, "lifecycle", '{');
+    gfnJsonInteger(json, "cycles", options->cycles);
+    if (initSamples == NULL || shutdownSamples == NULL)
+    {
+        gfnJsonString(json, "error", "out of memory");
+        gfnJsonClose(json, '}');
+        free(initSamples);
+        free(shutdownSamples);
+        return;
+    }
+    for (i = 0; i < options->cycles; i++)
+    {
+        startNs = gfnGetMonotonicNs();
+        if (GFNSDK_FAILED(GfnInitializeSdk(gfnDefaultLanguage)))
+        {
+            failures++;
+        }
+        initSamples[i] = (double)(gfnGetMonotonicNs() - startNs);
+        if (GfnGetInitTimings(&timings) == gfnSuccess)
+        {
+            totals.pathResolutionUs += timings.pathResolutionUs;
+            totals.clientLoadUs += timings.clientLoadUs;
+            totals.clientInitUs += timings.clientInitUs;
+            totals.cloudLoadUs += timings.cloudLoadUs;
+            totals.symbolBindingUs += timings.symbolBindingUs;
+            totals.cloudInitUs += timings.cloudInitUs;
+        }
+        startNs = gfnGetMonotonicNs();
+        GfnShutdownSdk();
+        shutdownSamples[i] = (double)(gfnGetMonotonicNs() - startNs);
+    }
+    gfnJsonInteger(json, "failures", failures);
+    memset(&summary, 0, sizeof(summary));
+    benchSummarize(initSamples, options->cycles, &summary);
+    benchJsonSummary(json, "initialize", &summary);
+    memset(&summary, 0, sizeof(summary));
+    benchSummarize(shutdownSamples, options->cycles, &summary);
+    benchJsonSummary(json, "shutdown", &summary);
+    gfnJsonOpen(json, "initPhasesMeanUs", '{');
+    gfnJsonNumber(json, "pathResolution", (double)totals.pathResolutionUs / options->cycles);
+    gfnJsonNumber(json, "clientLoad", (double)totals.clientLoadUs / options->cycles);
+    gfnJsonNumber(json, "clientInit", (double)totals.clientInitUs / options->cycles);
+    gfnJsonNumber(json, "cloudLoad", (double)totals.cloudLoadUs / options->cycles);
+    gfnJsonNumber(json, "symbolBinding", (double)totals.symbolBindingUs / options->cycles);
+    gfnJsonNumber(json, "cloudInit", (double)totals.cloudInitUs / options->cycles);
+    gfnJsonClose(json, '}');
+    gfnJsonClose(json, '}');
+    free(initSamples);
+    free(shutdownSamples);
+}
+
+static void benchCalls(gfnJsonWriter* json, const benchOptions* options)
+{
+    benchSummary wrapper;
+    benchSummary direct;
+    unsigned int i;
+
+    gfnJsonOpen(json, "calls", '[');
+    for (i = 0; i < sizeof(kCallCases) / sizeof(kCallCases[0]); i++)
+    {
+        benchMeasureCalls(kCallCases[i].wrapper, options, &wrapper);
+        gfnJsonOpen(json, NULL, '{');
+        gfnJsonString(json, "api", kCallCases[i].name);
+        benchJsonSummary(json, "wrapper", &wrapper);
+        if (kCallCases[i].direct != NULL)
+        {
+            benchMeasureCalls(kCallCases[i].direct, options, &direct);
+            benchJsonSummary(json, "direct", &direct);
+            gfnJsonNumber(json, "overheadNs", wrapper.medianNs - direct.medianNs);
+        }
+        gfnJsonClose(json, '}');
+    }
+    gfnJsonClose(json, ']');
+}
+
+// Fires count events through the mock and reports the time per delivered callback
+static void benchDispatch(gfnJsonWriter* json, const char* name, const char* event, unsigned int count, unsigned int receivers)
+{
+    uint64_t startNs;
+    uint64_t elapsedNs;
+    int64_t delivered;
+    GfnRuntimeError status;
+
+    gfnAtomicStoreRelaxed64(&s_callbacksDelivered, 0);
+    startNs = gfnGetMonotonicNs();
+    status = s_mock.FireEvent(event, count);
+    elapsedNs = gfnGetMonotonicNs() - startNs;
+    delivered = gfnAtomicLoadRelaxed64(&s_callbacksDelivered);
+    gfnJsonOpen(json, NULL, '{');
+    gfnJsonString(json, "event", name);
+    gfnJsonInteger(json, "receivers", receivers);
+    gfnJsonInteger(json, "events", count);
+    gfnJsonInteger(json, "delivered", (uint64_t)delivered);
+    if (status != gfnSuccess)
+    {
+        gfnJsonString(json, "error", GfnErrorToString((GfnError)status));
+    }
+    gfnJsonNumber(json, "nsPerEvent", (double)elapsedNs / count);
+    gfnJsonNumber(json, "eventsPerSec", elapsedNs != 0 ? count * 1e9 / elapsedNs : 0.0);
+    gfnJsonClose(json, '}');
+}
+
+// Queues messages in batches of the queue capacity and delivers them with GfnPumpEvents
+static void benchQueuedDispatch(gfnJsonWriter* json, unsigned int count)
+{
+    const unsigned int batch = 256;
+    unsigned int remaining = count;
+    unsigned int fired;
+    unsigned int pumped;
+    uint64_t startNs;
+    uint64_t elapsedNs;
+
+    GfnSetCallbackDeliveryMode(gfnCallbackDeliveryQueued);
+    gfnAtomicStoreRelaxed64(&s_callbacksDelivered, 0);
+    startNs = gfnGetMonotonicNs();
+    while (remaining != 0)
+    {
+        fired = remaining < batch ? remaining : batch;
+        s_mock.FireEvent("message bench", fired);
+        GfnPumpEvents(0, 0, &pumped);
+        remaining -= fired;
+    }
+    elapsedNs = gfnGetMonotonicNs() - startNs;
+    GfnSetCallbackDeliveryMode(gfnCallbackDeliveryImmediate);
+    gfnJsonOpen(json, NULL, '{');
+    gfnJsonString(json, "event", "message (queued)");
+    gfnJsonInteger(json, "receivers", 1);
+    gfnJsonInteger(json, "events", count);
+    gfnJsonInteger(json, "delivered", (uint64_t)gfnAtomicLoadRelaxed64(&s_callbacksDelivered));
+    gfnJsonNumber(json, "nsPerEvent", (double)elapsedNs / count);
+    gfnJsonNumber(json, "eventsPerSec", elapsedNs != 0 ? count * 1e9 / elapsedNs : 0.0);
+    gfnJsonClose(json, '}');
+}
+
+static void benchCallbacks(gfnJsonWriter* json, const benchOptions* options)
+{
+    GfnSdkContext contexts[3];
+    unsigned int contextCount = 0;
+    unsigned int i;
+
+    GfnRegisterClientInfoCallback(benchOnClientInfo, NULL);
+    GfnRegisterNetworkStatusCallback(benchOnNetworkStatus, 0, NULL);
+    GfnRegisterMessageCallback(benchOnMessage, NULL);
+    GfnRegisterPauseCallback(benchOnPause, NULL);
+
+    gfnJsonOpen(json, "callbacks", '[');
+    benchDispatch(json, "clientinfo", "clientinfo resolution 2560 1440", options->events, 1);
+    benchDispatch(json, "network", "network 25", options->events, 1);
+    benchDispatch(json, "message", "message bench", options->events, 1);
+    benchDispatch(json, "pause", "pause", options->events, 1);
+    benchQueuedDispatch(json, options->events);
+    for (i = 0; i < sizeof(contexts) / sizeof(contexts[0]); i++)
+    {
+        if (GFNSDK_SUCCEEDED(GfnCreateContext(gfnDefaultLanguage, &contexts[contextCount])))
+        {
+            GfnContextRegisterNetworkStatusCallback(contexts[contextCount], benchOnNetworkStatus, 0, NULL);
+            contextCount++;
+        }
+    }
+    benchDispatch(json, "network", "network 25", options->events, contextCount + 1);
+    gfnJsonClose(json, ']');
+
+    for (i = 0; i < contextCount; i++)
+    {
+        GfnDestroyContext(contexts[i]);
+    }
+    GfnUnregisterClientInfoCallback();
+    GfnUnregisterNetworkStatusCallback();
+    GfnUnregisterMessageCallback();
+    GfnUnregisterPauseCallback();
+}
+
+static GFN_THREAD_PROC benchContentionThread(void* arg)
+{
+    benchThreadArgs* args = (benchThreadArgs*)arg;
+    uint64_t startNs;
+    unsigned int i;
+
+    gfnAtomicAdd32(&s_ready, 1);
+    while (gfnAtomicLoadAcquire32(&s_go) == 0)
+    {
+        gfnCpuRelax();
+    }
+    startNs = gfnGetMonotonicNs();
+    for (i = 0; i < args->iterations; i++)
+    {
+        if (GFNSDK_FAILED(args->call()))
+        {
+            args->errors++;
+        }
+    }
+    args->elapsedNs = gfnGetMonotonicNs() - startNs;
+    return GFN_THREAD_RETURN;
+}
+
+// Starts threadCount threads calling call at once. Returns the wall time from the start signal
+// until the last thread finished.
+static uint64_t benchRunThreads(benchThreadArgs* args, unsigned int threadCount)
+{
+    gfnThread threads[kBenchMaxThreads];
+    unsigned int started = 0;
+    unsigned int i;
+    uint64_t startNs;
+
+    gfnAtomicStoreRelease32(&s_ready, 0);
+    gfnAtomicStoreRelease32(&s_go, 0);
+    for (i = 0; i < threadCount; i++)
+    {
+        if (!gfnThreadCreate(&threads[started], benchContentionThread, &args[i]))
+        {
+            break;
+        }
+        started++;
+    }
+    while (gfnAtomicLoadAcquire32(&s_ready) < (int32_t)started)
+    {
+        gfnThreadYield();
+    }
+    startNs = gfnGetMonotonicNs();
+    gfnAtomicStoreRelease32(&s_go, 1);
+    for (i = 0; i < started; i++)
+    {
+        gfnThreadJoin(threads[i]);
+    }
+    return gfnGetMonotonicNs() - startNs;
+}
+
+static void benchContention(gfnJsonWriter* json, const benchOptions* options)
+{
+    static benchThreadArgs args[kBenchMaxThreads];
+    unsigned int c;
+    unsigned int threadCount;
+    unsigned int i;
+    uint64_t wallNs;
+    uint64_t errors;
+    double threadNs;
+
+    gfnJsonOpen(json, "contention", '[');
+    for (c = 0; c < sizeof(kContentionCases) / sizeof(kContentionCases[0]); c++)
+    {
+        gfnJsonOpen(json, NULL, '{');
+        gfnJsonString(json, "api", kContentionCases[c].name);
+        gfnJsonOpen(json, "threads", '[');
+        for (threadCount = 1; ; threadCount = (threadCount * 2 < options->maxThreads) ? threadCount * 2 : options->maxThreads)
+        {
+            memset(args, 0, sizeof(args[0]) * threadCount);
+            for (i = 0; i < threadCount; i++)
+            {
+                args[i].call = kContentionCases[c].wrapper;
+                args[i].iterations = options->threadIterations;
+            }
+            wallNs = benchRunThreads(args, threadCount);
+            threadNs = 0.0;
+            errors = 0;
+            for (i = 0; i < threadCount; i++)
+            {
+                threadNs += (double)args[i].elapsedNs;
+                errors += args[i].errors;
+            }
+            gfnJsonOpen(json, NULL, '{');
+            gfnJsonInteger(json, "threads", threadCount);
+            gfnJsonNumber(json, "nsPerCall", threadNs / ((double)threadCount * options->threadIterations));
+            gfnJsonNumber(json, "callsPerSec", wallNs != 0 ? (double)threadCount * options->threadIterations * 1e9 / wallNs : 0.0);
+            gfnJsonInteger(json, "errors", errors);
+            gfnJsonClose(json, '}');
+            if (threadCount >= options->maxThreads)
+            {
+                break;
+            }
+        }
+        gfnJsonClose(json, ']');
+        gfnJsonClose(json, '}');
+    }
+    gfnJsonClose(json, ']');
+}
+
+// Many threads ask for partner data while the library takes 2 ms to answer. Single-flight
+// deduplication should turn each round into one library call.
+static void benchSingleFlight(gfnJsonWriter* json, const benchOptions* options)
+{
+    static benchThreadArgs args[kBenchMaxThreads];
+    GfnRequestSchedulerStats before;
+    GfnRequestSchedulerStats after;
+    double wallNs = 0.0;
+    unsigned int round;
+    unsigned int i;
+    uint64_t errors = 0;
+
+    s_mock.Configure("latency gfnGetPartnerData fixed 2000");
+    GfnGetRequestSchedulerStats(gfnScheduledPartnerData, &before);
+    for (round = 0; round < options->rounds; round++)
+    {
+        memset(args, 0, sizeof(args[0]) * options->maxThreads);
+        for (i = 0; i < options->maxThreads; i++)
+        {
+            args[i].call = benchWrapperGetPartnerData;
+            args[i].iterations = 1;
+        }
+        wallNs += (double)benchRunThreads(args, options->maxThreads);
+        for (i = 0; i < options->maxThreads; i++)
+        {
+            errors += args[i].errors;
+        }
+    }
+    GfnGetRequestSchedulerStats(gfnScheduledPartnerData, &after);
+    s_mock.Configure("latency gfnGetPartnerData none");
+
+    gfnJsonOpen(json, "singleFlight", '{');
+    gfnJsonString(json, "api", "GfnGetPartnerData");
+    gfnJsonInteger(json, "threads", options->maxThreads);
+    gfnJsonInteger(json, "rounds", options->rounds);
+    gfnJsonNumber(json, "libraryLatencyUs", 2000.0);
+    gfnJsonInteger(json, "requests", after.requests - before.requests);
+    gfnJsonInteger(json, "libraryCalls", after.libraryCalls - before.libraryCalls);
+    gfnJsonInteger(json, "deduplicated", after.deduplicated - before.deduplicated);
+    gfnJsonInteger(json, "errors", errors);
+    gfnJsonNumber(json, "meanRoundUs", wallNs / options->rounds / 1000.0);
+    gfnJsonClose(json, '}');
+}
+
+// Counting is compiled out of wrappers built with GFN_SDK_WRAPPER_STATS=0
+static bool benchWrapperStatsEnabled(void)
+{
+    static GfnWrapperStats stats;
+    unsigned int api;
+
+    if (GfnGetWrapperStats(&stats) != gfnSuccess)
+    {
+        return false;
+    }
+    for (api = 0; api < stats.apiCount; api++)
+    {
+        if (stats.apis[api].calls != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void benchWrapperStatsDump(gfnJsonWriter* json)
+{
+    size_t length = 0;
+    char* buffer;
+
+    GfnDumpWrapperStatsJson(NULL, 0, &length);
+    buffer = (char*)malloc(length + 1);
+    if (buffer != NULL && GfnDumpWrapperStatsJson(buffer, length + 1, &length) == gfnSuccess)
+    {
+        gfnJsonRaw(json, "wrapperStats", buffer);
+    }
+    free(buffer);
+}
+
+int main(int argc, char** argv)
+{
+    benchOptions options;
+    gfnJsonWriter json;
+    GfnRequestSchedulerConfig unlimited = { 0, 0, 100, 2000, 5000 };
+    char mockPath[PATH_MAX];
+    GfnRuntimeError status;
+    FILE* output = stdout;
+
+    if (!benchParseOptions(argc, argv, &options))
+    {
+        benchUsage();
+        return 2;
+    }
+    if (!gfnSelectMockRuntime(options.config, mockPath, sizeof(mockPath)))
+    {
+        fprintf(stderr, "gfn_wrapper_bench: could not locate the mock runtime library\n");
+        return 1;
+    }
+    if (options.output != NULL)
+    {
+        output = fopen(options.output, "w");
+        if (output == NULL)
+        {
+            fprintf(stderr, "gfn_wrapper_bench: could not open %s\n", options.output);
+            return 1;
+        }
+    }
+    GfnSetLogLevel(gfnLogLevelError);
+    gfnJsonInit(&json, output);
+
+    gfnJsonOpen(&json, NULL, '{');
+    gfnJsonString(&json, "benchmark", "gfn_wrapper_bench");
+    gfnJsonString(&json, "mockRuntime", mockPath);
+    gfnJsonString(&json, "mockConfig", options.config);
+    gfnJsonInteger(&json, "cpus", (uint64_t)sysconf(_SC_NPROCESSORS_ONLN));
+    gfnJsonOpen(&json, "options", '{');
+    gfnJsonInteger(&json, "iterations", options.iterations);
+    gfnJsonInteger(&json, "repeats", options.repeats);
+    gfnJsonInteger(&json, "cycles", options.cycles);
+    gfnJsonInteger(&json, "events", options.events);
+    gfnJsonInteger(&json, "threads", options.maxThreads);
+    gfnJsonInteger(&json, "threadIterations", options.threadIterations);
+    gfnJsonInteger(&json, "rounds", options.rounds);
+    gfnJsonClose(&json, '}');
+
+    // Cycles first: the remaining benchmarks keep the SDK initialized
+    benchLifecycle(&json, &options);
+    status = GfnInitializeSdk(gfnDefaultLanguage);
+    gfnJsonSigned(&json, "initializeResult", status);
+    if (GFNSDK_FAILED(status) || !benchResolveMock(mockPath))
+    {
+        gfnJsonString(&json, "error", "the mock runtime library could not be initialized and resolved");
+        gfnJsonClose(&json, '}');
+        if (output != stdout)
+        {
+            fclose(output);
+        }
+        GfnShutdownSdk();
+        return 1;
+    }
+    GfnSetRequestSchedulerConfig(gfnScheduledPartnerData, &unlimited);
+    GfnResetWrapperStats();
+
+    benchCalls(&json, &options);
+    benchCallbacks(&json, &options);
+    benchContention(&json, &options);
+    benchSingleFlight(&json, &options);
+
+    gfnJsonBool(&json, "wrapperStatsEnabled", benchWrapperStatsEnabled());
+    benchWrapperStatsDump(&json);
+    gfnJsonClose(&json, '}');
+
+    GfnShutdownSdk();
+    dlclose(s_mock.handle);
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+    return 0;
+}